@@ -35,6 +35,9 @@ DEFINE_int32(meta_client_retry_interval_secs, 1, "meta client sleep interval bet
 DEFINE_int32(meta_client_timeout_ms, 60 * 1000, "meta client timeout");
 DEFINE_string(cluster_id_path, "cluster.id", "file path saved clusterId");
 DEFINE_int32(check_plan_killed_frequency, 8, "check plan killed every 1<<n times");
+DEFINE_int32(stats_cache_ttl_secs,
+             60,
+             "Seconds after which the cached statistics of a space are reloaded from meta");
 DEFINE_uint32(failed_login_attempts,
               0,
               "how many consecutive incorrect passwords input to a SINGLE graph service node cause "
@@ -417,6 +420,7 @@ bool MetaClient::loadData() {
   auto oldMetaData = metadata_.load();
   metadata_.store(newMetaData);
   folly::rcu_retire(oldMetaData);
+  metadataVersion_.fetch_add(1, std::memory_order_release);
   diff(oldCache, localCache_);
   listenerDiff(oldCache, localCache_);
   loadRemoteListeners();
@@ -3261,6 +3265,37 @@ folly::Future<StatusOr<cpp2::StatsItem>> MetaClient::getStats(GraphSpaceID space
   return future;
 }
 
+std::shared_ptr<const cpp2::StatsItem> MetaClient::getStatsFromCache(GraphSpaceID spaceId) {
+  auto now = time::WallClock::fastNowInSec();
+  std::shared_ptr<const cpp2::StatsItem> stats;
+  {
+    std::lock_guard<std::mutex> guard(statsCacheLock_);
+    auto& item = statsCache_[spaceId];
+    stats = item.stats;
+    if (item.loading || now - item.loadTimeInSec < FLAGS_stats_cache_ttl_secs) {
+      return stats;
+    }
+    item.loading = true;
+    item.loadTimeInSec = now;
+  }
+  getStats(spaceId).thenValue([this, spaceId](StatusOr<cpp2::StatsItem> ret) {
+    std::lock_guard<std::mutex> guard(statsCacheLock_);
+    auto& item = statsCache_[spaceId];
+    item.loading = false;
+    if (!ret.ok()) {
+      VLOG(1) << "Load stats of space " << spaceId << " failed: " << ret.status();
+      return;
+    }
+    // Keep the stats of the last finished job
+    if (ret.value().get_status() == cpp2::JobStatus::FINISHED &&
+        (item.stats == nullptr || !(*item.stats == ret.value()))) {
+      item.stats = std::make_shared<const cpp2::StatsItem>(std::move(ret).value());
+      statsVersion_.fetch_add(1, std::memory_order_release);
+    }
+  });
+  return stats;
+}
+
 folly::Future<StatusOr<nebula::cpp2::ErrorCode>> MetaClient::reportTaskFinish(
     GraphSpaceID spaceId,
     int32_t jobId,
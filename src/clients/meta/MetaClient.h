@@ -245,6 +245,18 @@ class MetaClient : public BaseMetaClient {
 
   bool isMetadReady();
 
+  // Increased each time the local cache of spaces, schemas, indexes, users and roles is reloaded,
+  // so the results derived from the metadata are stale once the version changed
+  int64_t metadataVersion() const {
+    return metadataVersion_.load(std::memory_order_acquire);
+  }
+
+  // Increased each time the cached statistics of any space are replaced by the ones of a newer
+  // stats job, see getStatsFromCache
+  int64_t statsVersion() const {
+    return statsVersion_.load(std::memory_order_acquire);
+  }
+
   bool waitForMetadReady(int count = -1, int retryIntervalSecs = FLAGS_heartbeat_interval_secs);
 
   void notifyStop();
@@ -630,6 +642,10 @@ class MetaClient : public BaseMetaClient {
 
   folly::Future<StatusOr<cpp2::StatsItem>> getStats(GraphSpaceID spaceId);
 
+  // Get the statistics of the space collected by the last finished stats job, which are reloaded
+  // in background once older than FLAGS_stats_cache_ttl_secs. Return nullptr if not loaded yet.
+  std::shared_ptr<const cpp2::StatsItem> getStatsFromCache(GraphSpaceID spaceId);
+
   folly::Future<StatusOr<nebula::cpp2::ErrorCode>> reportTaskFinish(
       GraphSpaceID spaceId,
       int32_t jobId,
@@ -760,6 +776,17 @@ class MetaClient : public BaseMetaClient {
   std::atomic<int64_t> localDataLastUpdateTime_{-1};
   std::atomic<int64_t> localCfgLastUpdateTime_{-1};
   std::atomic<int64_t> metadLastUpdateTime_{0};
+  std::atomic<int64_t> metadataVersion_{0};
+
+  struct StatsCacheItem {
+    std::shared_ptr<const cpp2::StatsItem> stats;
+    int64_t loadTimeInSec{0};
+    bool loading{false};
+  };
+  // statsCacheLock_ is used to protect statsCache_
+  std::mutex statsCacheLock_;
+  std::unordered_map<GraphSpaceID, StatsCacheItem> statsCache_;
+  std::atomic<int64_t> statsVersion_{0};
 
   int64_t metaServerVersion_{-1};
   static constexpr int64_t EXPECT_META_VERSION = 3;
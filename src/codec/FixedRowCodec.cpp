@@ -0,0 +1,465 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/FixedRowCodec.h"
+
+#include "codec/RowWriterV2.h"
+#include "common/time/TimeUtils.h"
+#include "common/time/WallClock.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+namespace {
+
+// The codec of the fields of each fixed size type, in the same format as RowReaderV2 and
+// RowWriterV2
+template <PropertyType kType>
+struct FixedField;
+
+template <typename T>
+struct IntField {
+  static Value decode(const char* data, size_t) {
+    T val;
+    memcpy(reinterpret_cast<void*>(&val), data, sizeof(T));
+    return val;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isInt()) {
+      return false;
+    }
+    auto v = value.getInt();
+    if (v > std::numeric_limits<T>::max() || v < std::numeric_limits<T>::min()) {
+      return false;
+    }
+    T iv = v;
+    memcpy(data, reinterpret_cast<void*>(&iv), sizeof(T));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::BOOL> {
+  static Value decode(const char* data, size_t) {
+    return data[0] != 0;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isBool()) {
+      return false;
+    }
+    data[0] = value.getBool() ? 0x01 : 0;
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::INT8> : IntField<int8_t> {};
+
+template <>
+struct FixedField<PropertyType::INT16> : IntField<int16_t> {};
+
+template <>
+struct FixedField<PropertyType::INT32> : IntField<int32_t> {};
+
+template <>
+struct FixedField<PropertyType::INT64> : IntField<int64_t> {};
+
+template <>
+struct FixedField<PropertyType::VID> {
+  static Value decode(const char* data, size_t) {
+    // This is to be compatible with V1, so we treat it as 8-byte long string
+    return std::string(data, sizeof(int64_t));
+  }
+};
+
+template <>
+struct FixedField<PropertyType::FLOAT> {
+  static Value decode(const char* data, size_t) {
+    float val;
+    memcpy(reinterpret_cast<void*>(&val), data, sizeof(float));
+    return val;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isFloat()) {
+      return false;
+    }
+    auto v = value.getFloat();
+    if (v > std::numeric_limits<float>::max() || v < std::numeric_limits<float>::lowest()) {
+      return false;
+    }
+    float fv = v;
+    memcpy(data, reinterpret_cast<void*>(&fv), sizeof(float));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::DOUBLE> {
+  static Value decode(const char* data, size_t) {
+    double val;
+    memcpy(reinterpret_cast<void*>(&val), data, sizeof(double));
+    return val;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isFloat()) {
+      return false;
+    }
+    auto v = value.getFloat();
+    memcpy(data, reinterpret_cast<void*>(&v), sizeof(double));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::FIXED_STRING> {
+  static Value decode(const char* data, size_t size) {
+    return std::string(data, size);
+  }
+
+  static bool encode(const Value& value, char* data, size_t size) {
+    if (!value.isStr()) {
+      return false;
+    }
+    // The string longer than the fixed length is truncated
+    const auto& v = value.getStr();
+    size_t len = v.size() > size ? size : v.size();
+    strncpy(data, v.data(), len);
+    if (len < size) {
+      memset(data + len, 0, size - len);
+    }
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::TIMESTAMP> {
+  static Value decode(const char* data, size_t) {
+    Timestamp ts;
+    memcpy(reinterpret_cast<void*>(&ts), data, sizeof(Timestamp));
+    return ts;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isInt()) {
+      return false;
+    }
+    auto ret = time::TimeUtils::toTimestamp(value.getInt());
+    if (!ret.ok()) {
+      return false;
+    }
+    auto ts = ret.value().getInt();
+    memcpy(data, reinterpret_cast<void*>(&ts), sizeof(int64_t));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::DATE> {
+  static Value decode(const char* data, size_t) {
+    Date dt;
+    memcpy(reinterpret_cast<void*>(&dt.year), data, sizeof(int16_t));
+    memcpy(reinterpret_cast<void*>(&dt.month), data + sizeof(int16_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&dt.day),
+           data + sizeof(int16_t) + sizeof(int8_t),
+           sizeof(int8_t));
+    return dt;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isDate()) {
+      return false;
+    }
+    const auto& v = value.getDate();
+    memcpy(data, reinterpret_cast<const void*>(&v.year), sizeof(int16_t));
+    data[sizeof(int16_t)] = v.month;
+    data[sizeof(int16_t) + sizeof(int8_t)] = v.day;
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::TIME> {
+  static Value decode(const char* data, size_t) {
+    Time t;
+    memcpy(reinterpret_cast<void*>(&t.hour), data, sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&t.minute), data + sizeof(int8_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&t.sec), data + 2 * sizeof(int8_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&t.microsec), data + 3 * sizeof(int8_t), sizeof(int32_t));
+    return t;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isTime()) {
+      return false;
+    }
+    const auto& v = value.getTime();
+    data[0] = v.hour;
+    data[sizeof(int8_t)] = v.minute;
+    data[2 * sizeof(int8_t)] = v.sec;
+    memcpy(data + 3 * sizeof(int8_t), reinterpret_cast<const void*>(&v.microsec), sizeof(int32_t));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::DATETIME> {
+  static Value decode(const char* data, size_t) {
+    DateTime dt;
+    int16_t year;
+    int8_t month;
+    int8_t day;
+    int8_t hour;
+    int8_t minute;
+    int8_t sec;
+    int32_t microsec;
+    memcpy(reinterpret_cast<void*>(&year), data, sizeof(int16_t));
+    memcpy(reinterpret_cast<void*>(&month), data + sizeof(int16_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&day), data + sizeof(int16_t) + sizeof(int8_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&hour),
+           data + sizeof(int16_t) + 2 * sizeof(int8_t),
+           sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&minute),
+           data + sizeof(int16_t) + 3 * sizeof(int8_t),
+           sizeof(int8_t));
+    memcpy(
+        reinterpret_cast<void*>(&sec), data + sizeof(int16_t) + 4 * sizeof(int8_t), sizeof(int8_t));
+    memcpy(reinterpret_cast<void*>(&microsec),
+           data + sizeof(int16_t) + 5 * sizeof(int8_t),
+           sizeof(int32_t));
+    dt.year = year;
+    dt.month = month;
+    dt.day = day;
+    dt.hour = hour;
+    dt.minute = minute;
+    dt.sec = sec;
+    dt.microsec = microsec;
+    return dt;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isDateTime()) {
+      return false;
+    }
+    const auto& v = value.getDateTime();
+    int16_t year = v.year;
+    int32_t microsec = v.microsec;
+    memcpy(data, reinterpret_cast<const void*>(&year), sizeof(int16_t));
+    data[sizeof(int16_t)] = static_cast<int8_t>(v.month);
+    data[sizeof(int16_t) + sizeof(int8_t)] = static_cast<int8_t>(v.day);
+    data[sizeof(int16_t) + 2 * sizeof(int8_t)] = static_cast<int8_t>(v.hour);
+    data[sizeof(int16_t) + 3 * sizeof(int8_t)] = static_cast<int8_t>(v.minute);
+    data[sizeof(int16_t) + 4 * sizeof(int8_t)] = static_cast<int8_t>(v.sec);
+    memcpy(data + sizeof(int16_t) + 5 * sizeof(int8_t),
+           reinterpret_cast<const void*>(&microsec),
+           sizeof(int32_t));
+    return true;
+  }
+};
+
+template <>
+struct FixedField<PropertyType::DURATION> {
+  static Value decode(const char* data, size_t) {
+    Duration d;
+    memcpy(reinterpret_cast<void*>(&d.seconds), data, sizeof(int64_t));
+    memcpy(reinterpret_cast<void*>(&d.microseconds), data + sizeof(int64_t), sizeof(int32_t));
+    memcpy(reinterpret_cast<void*>(&d.months),
+           data + sizeof(int64_t) + sizeof(int32_t),
+           sizeof(int32_t));
+    return d;
+  }
+
+  static bool encode(const Value& value, char* data, size_t) {
+    if (!value.isDuration()) {
+      return false;
+    }
+    const auto& v = value.getDuration();
+    memcpy(data, reinterpret_cast<const void*>(&v.seconds), sizeof(int64_t));
+    memcpy(data + sizeof(int64_t), reinterpret_cast<const void*>(&v.microseconds), sizeof(int32_t));
+    memcpy(data + sizeof(int64_t) + sizeof(int32_t),
+           reinterpret_cast<const void*>(&v.months),
+           sizeof(int32_t));
+    return true;
+  }
+};
+
+}  // namespace
+
+/*static*/
+FixedRowCodec::Decoder FixedRowCodec::decoder(PropertyType type) {
+  switch (type) {
+    case PropertyType::BOOL:
+      return &FixedField<PropertyType::BOOL>::decode;
+    case PropertyType::INT8:
+      return &FixedField<PropertyType::INT8>::decode;
+    case PropertyType::INT16:
+      return &FixedField<PropertyType::INT16>::decode;
+    case PropertyType::INT32:
+      return &FixedField<PropertyType::INT32>::decode;
+    case PropertyType::INT64:
+      return &FixedField<PropertyType::INT64>::decode;
+    case PropertyType::VID:
+      return &FixedField<PropertyType::VID>::decode;
+    case PropertyType::FLOAT:
+      return &FixedField<PropertyType::FLOAT>::decode;
+    case PropertyType::DOUBLE:
+      return &FixedField<PropertyType::DOUBLE>::decode;
+    case PropertyType::FIXED_STRING:
+      return &FixedField<PropertyType::FIXED_STRING>::decode;
+    case PropertyType::TIMESTAMP:
+      return &FixedField<PropertyType::TIMESTAMP>::decode;
+    case PropertyType::DATE:
+      return &FixedField<PropertyType::DATE>::decode;
+    case PropertyType::TIME:
+      return &FixedField<PropertyType::TIME>::decode;
+    case PropertyType::DATETIME:
+      return &FixedField<PropertyType::DATETIME>::decode;
+    case PropertyType::DURATION:
+      return &FixedField<PropertyType::DURATION>::decode;
+    default:
+      return nullptr;
+  }
+}
+
+/*static*/
+FixedRowCodec::Encoder FixedRowCodec::encoder(PropertyType type) {
+  switch (type) {
+    case PropertyType::BOOL:
+      return &FixedField<PropertyType::BOOL>::encode;
+    case PropertyType::INT8:
+      return &FixedField<PropertyType::INT8>::encode;
+    case PropertyType::INT16:
+      return &FixedField<PropertyType::INT16>::encode;
+    case PropertyType::INT32:
+      return &FixedField<PropertyType::INT32>::encode;
+    case PropertyType::INT64:
+      return &FixedField<PropertyType::INT64>::encode;
+    case PropertyType::FLOAT:
+      return &FixedField<PropertyType::FLOAT>::encode;
+    case PropertyType::DOUBLE:
+      return &FixedField<PropertyType::DOUBLE>::encode;
+    case PropertyType::FIXED_STRING:
+      return &FixedField<PropertyType::FIXED_STRING>::encode;
+    case PropertyType::TIMESTAMP:
+      return &FixedField<PropertyType::TIMESTAMP>::encode;
+    case PropertyType::DATE:
+      return &FixedField<PropertyType::DATE>::encode;
+    case PropertyType::TIME:
+      return &FixedField<PropertyType::TIME>::encode;
+    case PropertyType::DATETIME:
+      return &FixedField<PropertyType::DATETIME>::encode;
+    case PropertyType::DURATION:
+      return &FixedField<PropertyType::DURATION>::encode;
+    default:
+      // RowWriterV2 doesn't write VID either
+      return nullptr;
+  }
+}
+
+FixedRowCodec::FixedRowCodec(const meta::SchemaProviderIf* schema) : schema_(schema) {
+  CHECK(!!schema_);
+  // The header and the null flags are the same as the ones of RowWriterV2
+  RowWriterV2 writer(schema_);
+  emptyRow_ = writer.buf_;
+  headerLen_ = writer.headerLen_;
+  numNullBytes_ = writer.numNullBytes_;
+
+  columns_.reserve(schema_->getNumFields());
+  for (size_t i = 0; i < schema_->getNumFields(); i++) {
+    const auto* field = schema_->field(i);
+    CHECK(field->type() != PropertyType::STRING && field->type() != PropertyType::GEOGRAPHY)
+        << "Field " << field->name() << " is not of fixed size";
+    Column column;
+    column.offset_ = headerLen_ + numNullBytes_ + field->offset();
+    column.size_ = field->size();
+    column.nullable_ = field->nullable();
+    column.nullFlagPos_ = field->nullable() ? field->nullFlagPos() : 0;
+    column.hasDefault_ = field->hasDefault();
+    column.encode_ = encoder(field->type());
+    columns_.emplace_back(column);
+  }
+}
+
+bool FixedRowCodec::encode(const std::vector<std::string>& propNames,
+                           const std::vector<Value>& props,
+                           std::string* row) const {
+  row->reserve(rowSize());
+  row->assign(emptyRow_);
+  std::vector<bool> isSet(columns_.size(), false);
+  if (!propNames.empty()) {
+    for (size_t i = 0; i < propNames.size(); i++) {
+      auto index = schema_->getFieldIndex(propNames[i]);
+      if (index < 0 || !write(index, props[i], row)) {
+        return false;
+      }
+      isSet[index] = true;
+    }
+  } else {
+    if (props.size() > columns_.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < props.size(); i++) {
+      if (!write(i, props[i], row)) {
+        return false;
+      }
+      isSet[i] = true;
+    }
+  }
+
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (isSet[i]) {
+      continue;
+    }
+    // The default value is evaluated by RowWriterV2
+    const auto& column = columns_[i];
+    if (column.hasDefault_ || !column.nullable_) {
+      return false;
+    }
+    setNullBit(column.nullFlagPos_, row);
+  }
+
+  // The timestamp will be saved to the tail
+  auto ts = time::WallClock::fastNowInMicroSec();
+  row->append(reinterpret_cast<char*>(&ts), sizeof(int64_t));
+  return true;
+}
+
+bool FixedRowCodec::write(size_t index, const Value& value, std::string* row) const {
+  const auto& column = columns_[index];
+  if (value.isNull()) {
+    if (!column.nullable_) {
+      return false;
+    }
+    setNullBit(column.nullFlagPos_, row);
+    return true;
+  }
+  if (column.encode_ == nullptr || !column.encode_(value, &(*row)[column.offset_], column.size_)) {
+    return false;
+  }
+  if (column.nullable_) {
+    clearNullBit(column.nullFlagPos_, row);
+  }
+  return true;
+}
+
+void FixedRowCodec::setNullBit(size_t pos, std::string* row) const {
+  static const uint8_t orBits[] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+
+  size_t offset = headerLen_ + (pos >> 3);
+  (*row)[offset] = (*row)[offset] | orBits[pos & 0x0000000000000007L];
+}
+
+void FixedRowCodec::clearNullBit(size_t pos, std::string* row) const {
+  static const uint8_t andBits[] = {0x7F, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE};
+
+  size_t offset = headerLen_ + (pos >> 3);
+  (*row)[offset] = (*row)[offset] & andBits[pos & 0x0000000000000007L];
+}
+
+}  // namespace nebula
@@ -0,0 +1,99 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_FIXEDROWCODEC_H_
+#define CODEC_FIXEDROWCODEC_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "common/meta/SchemaProviderIf.h"
+
+namespace nebula {
+
+/**
+ * @brief Encoder of the rows of the schemas with only fixed size fields, i.e. no STRING or
+ * GEOGRAPHY field, see NebulaSchemaProvider::isFixedWidth.
+ *
+ * The rows are in the same format as the ones of RowWriterV2, but they always have the same
+ * size. So the header, the schema version and the null flags are built once, and a row is
+ * encoded by copying them and writing the values in place, each by the function of its field
+ * type chosen when the codec is built. RowWriterV2 looks up the field and switches on the type
+ * of the value and the field for every value instead.
+ *
+ * The codec only handles the values of the same type as their fields, e.g. an int of an INT64
+ * field. The others, which need RowWriterV2 to convert or to report the error, and the fields
+ * not set but with a default value make encode return false, and the caller should encode the
+ * row by RowWriterV2 instead.
+ */
+class FixedRowCodec final {
+ public:
+  // Decode the value of a field from the data at its offset
+  using Decoder = Value (*)(const char* data, size_t size);
+  // Encode the value of a field to the data at its offset, return false if the value is not
+  // of the type of the field
+  using Encoder = bool (*)(const Value& value, char* data, size_t size);
+
+  /**
+   * @brief Return the decoder of the field type, nullptr if it's not of fixed size
+   */
+  static Decoder decoder(nebula::cpp2::PropertyType type);
+
+  /**
+   * @brief Return the encoder of the field type, nullptr if it's not of fixed size
+   */
+  static Encoder encoder(nebula::cpp2::PropertyType type);
+
+  /**
+   * @brief Build the codec of the schema, which must have only fixed size fields
+   *
+   * @param schema
+   */
+  explicit FixedRowCodec(const meta::SchemaProviderIf* schema);
+
+  /**
+   * @brief The size of all the rows of the schema, including the timestamp
+   */
+  size_t rowSize() const {
+    return emptyRow_.size() + sizeof(int64_t);
+  }
+
+  /**
+   * @brief Encode the row in the same way as RowWriterV2::setValue and RowWriterV2::finish
+   *
+   * @param propNames Names of the props, the props are in the order of the schema if empty
+   * @param props Values of the props
+   * @param row Encoded row
+   * @return Whether the row is encoded, see the class comment when it's not
+   */
+  bool encode(const std::vector<std::string>& propNames,
+              const std::vector<Value>& props,
+              std::string* row) const;
+
+ private:
+  struct Column {
+    size_t offset_;
+    size_t size_;
+    bool nullable_;
+    size_t nullFlagPos_;
+    bool hasDefault_;
+    Encoder encode_;
+  };
+
+  bool write(size_t index, const Value& value, std::string* row) const;
+
+  void setNullBit(size_t pos, std::string* row) const;
+
+  void clearNullBit(size_t pos, std::string* row) const;
+
+  const meta::SchemaProviderIf* schema_;
+  // The header, the schema version, the null flags and the fields, all of which are zero
+  std::string emptyRow_;
+  size_t headerLen_;
+  size_t numNullBytes_;
+  std::vector<Column> columns_;
+};
+
+}  // namespace nebula
+#endif  // CODEC_FIXEDROWCODEC_H_
@@ -0,0 +1,39 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowProjection.h"
+
+namespace nebula {
+
+RowProjection::RowProjection(const meta::SchemaProviderIf* schema, std::vector<std::string> props)
+    : props_(std::move(props)) {
+  DCHECK(!!schema);
+  compile(schema);
+}
+
+RowProjection::RowProjection(
+    const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& schemas,
+    std::vector<std::string> props)
+    : props_(std::move(props)) {
+  CHECK(!schemas.empty());
+  schemas_.reserve(schemas.size());
+  columns_.reserve(schemas.size());
+  for (const auto& schema : schemas) {
+    compile(schema.get());
+  }
+}
+
+void RowProjection::compile(const meta::SchemaProviderIf* schema) {
+  std::vector<Column> columns;
+  columns.reserve(props_.size());
+  for (const auto& prop : props_) {
+    const auto* field = schema->field(prop);
+    columns.emplace_back(field == nullptr ? Column() : Column(field));
+  }
+  schemas_.emplace_back(schema);
+  columns_.emplace_back(std::move(columns));
+}
+
+}  // namespace nebula
@@ -0,0 +1,100 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWPROJECTION_H_
+#define CODEC_ROWPROJECTION_H_
+
+#include "codec/FixedRowCodec.h"
+#include "common/base/Base.h"
+#include "common/meta/NebulaSchemaProvider.h"
+#include "common/meta/SchemaProviderIf.h"
+
+namespace nebula {
+
+/**
+ * @brief The projection of some props of a schema, compiled once and used to decode the rows.
+ *
+ * getValueByName looks up the field by name and reads its offset and type from the schema for
+ * every prop of every row. The projection looks them up once per schema version and keeps them
+ * in a table, so the reader decodes the props of a row in one pass over the table, see
+ * RowReader::getValues. The props in the table of the latest version are checked first.
+ */
+class RowProjection final {
+ public:
+  /**
+   * @brief Precomputed info of a prop in a schema version
+   */
+  struct Column {
+    Column() = default;
+
+    explicit Column(const meta::SchemaProviderIf::Field* field)
+        : field_(field),
+          type_(field->type()),
+          offset_(field->offset()),
+          size_(field->size()),
+          nullable_(field->nullable()),
+          nullFlagPos_(field->nullable() ? field->nullFlagPos() : 0),
+          decode_(FixedRowCodec::decoder(type_)) {}
+
+    // nullptr if the prop is not in the schema version
+    const meta::SchemaProviderIf::Field* field_{nullptr};
+    nebula::cpp2::PropertyType type_{nebula::cpp2::PropertyType::UNKNOWN};
+    size_t offset_{0};
+    size_t size_{0};
+    bool nullable_{false};
+    size_t nullFlagPos_{0};
+    // nullptr if the field is not of fixed size
+    FixedRowCodec::Decoder decode_{nullptr};
+  };
+
+  /**
+   * @brief Compile the projection of a schema
+   *
+   * @param schema
+   * @param props Names of the props, in the order to be decoded
+   */
+  RowProjection(const meta::SchemaProviderIf* schema, std::vector<std::string> props);
+
+  /**
+   * @brief Compile the projection of all versions of a schema
+   *
+   * @param schemas Schemas from oldest to newest, as the ones of SchemaManager::getAllVerTagSchema
+   * @param props Names of the props, in the order to be decoded
+   */
+  RowProjection(const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& schemas,
+                std::vector<std::string> props);
+
+  const std::vector<std::string>& props() const {
+    return props_;
+  }
+
+  /**
+   * @brief Return the columns of the props in the schema, nullptr if the schema is not compiled
+   *
+   * @param schema Schema of the row
+   * @return const std::vector<Column>*
+   */
+  const std::vector<Column>* columns(const meta::SchemaProviderIf* schema) const {
+    if (schema == schemas_.back()) {
+      return &columns_.back();
+    }
+    auto ver = schema->getVersion();
+    if (ver >= 0 && static_cast<size_t>(ver) < schemas_.size() && schemas_[ver] == schema) {
+      return &columns_[ver];
+    }
+    return nullptr;
+  }
+
+ private:
+  void compile(const meta::SchemaProviderIf* schema);
+
+  std::vector<std::string> props_;
+  // The compiled schemas and their columns, the latest is the last one
+  std::vector<const meta::SchemaProviderIf*> schemas_;
+  std::vector<std::vector<Column>> columns_;
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWPROJECTION_H_
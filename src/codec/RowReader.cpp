@@ -50,6 +50,15 @@ RowReader::Iterator& RowReader::Iterator::operator++() {
  *
  ********************************************/
 
+void RowReader::getValues(const RowProjection& projection,
+                          std::vector<Value>* values) const noexcept {
+  values->clear();
+  values->reserve(projection.props().size());
+  for (const auto& prop : projection.props()) {
+    values->emplace_back(getValueByName(prop));
+  }
+}
+
 bool RowReader::resetImpl(meta::SchemaProviderIf const* schema, folly::StringPiece row) noexcept {
   schema_ = schema;
   data_ = row;
@@ -7,6 +7,7 @@
 #define CODEC_ROWREADER_H_
 
 #include "codec/Common.h"
+#include "codec/RowProjection.h"
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
 #include "common/meta/SchemaManager.h"
@@ -84,6 +85,16 @@ class RowReader {
    */
   virtual Value getValueByIndex(const int64_t index) const noexcept = 0;
 
+  /**
+   * @brief Get the values of the props of the projection, in the order of its props. The value
+   * of the prop not in the schema is NullType::UNKNOWN_PROP, the same as getValueByName.
+   *
+   * @param projection Props to get
+   * @param values Property values
+   */
+  virtual void getValues(const RowProjection& projection,
+                         std::vector<Value>* values) const noexcept;
+
   /**
    * @brief Get the timestamp in value
    *
@@ -55,54 +55,39 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const noexcept {
     return Value(NullType::UNKNOWN_PROP);
   }
 
-  auto field = schema_->field(index);
-  size_t offset = headerLen_ + numNullBytes_ + field->offset();
+  return getValue(RowProjection::Column(schema_->field(index)));
+}
+
+void RowReaderV2::getValues(const RowProjection& projection,
+                            std::vector<Value>* values) const noexcept {
+  const auto* columns = projection.columns(schema_);
+  if (columns == nullptr) {
+    RowReader::getValues(projection, values);
+    return;
+  }
+  values->clear();
+  values->reserve(columns->size());
+  for (const auto& column : *columns) {
+    if (column.field_ == nullptr) {
+      values->emplace_back(NullType::UNKNOWN_PROP);
+    } else {
+      values->emplace_back(getValue(column));
+    }
+  }
+}
 
-  if (field->nullable() && isNull(field->nullFlagPos())) {
+Value RowReaderV2::getValue(const RowProjection::Column& column) const noexcept {
+  size_t offset = headerLen_ + numNullBytes_ + column.offset_;
+
+  if (column.nullable_ && isNull(column.nullFlagPos_)) {
     return NullType::__NULL__;
   }
 
-  switch (field->type()) {
-    case PropertyType::BOOL: {
-      if (data_[offset]) {
-        return true;
-      } else {
-        return false;
-      }
-    }
-    case PropertyType::INT8: {
-      return static_cast<int8_t>(data_[offset]);
-    }
-    case PropertyType::INT16: {
-      int16_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int16_t));
-      return val;
-    }
-    case PropertyType::INT32: {
-      int32_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int32_t));
-      return val;
-    }
-    case PropertyType::INT64: {
-      int64_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int64_t));
-      return val;
-    }
-    case PropertyType::VID: {
-      // This is to be compatible with V1, so we treat it as
-      // 8-byte long string
-      return std::string(&data_[offset], sizeof(int64_t));
-    }
-    case PropertyType::FLOAT: {
-      float val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(float));
-      return val;
-    }
-    case PropertyType::DOUBLE: {
-      double val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(double));
-      return val;
-    }
+  if (column.decode_ != nullptr) {
+    return column.decode_(&data_[offset], column.size_);
+  }
+
+  switch (column.type_) {
     case PropertyType::STRING: {
       int32_t strOffset;
       int32_t strLen;
@@ -114,79 +99,6 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const noexcept {
       CHECK_LT(strOffset, data_.size());
       return std::string(&data_[strOffset], strLen);
     }
-    case PropertyType::FIXED_STRING: {
-      return std::string(&data_[offset], field->size());
-    }
-    case PropertyType::TIMESTAMP: {
-      Timestamp ts;
-      memcpy(reinterpret_cast<void*>(&ts), &data_[offset], sizeof(Timestamp));
-      return ts;
-    }
-    case PropertyType::DATE: {
-      Date dt;
-      memcpy(reinterpret_cast<void*>(&dt.year), &data_[offset], sizeof(int16_t));
-      memcpy(reinterpret_cast<void*>(&dt.month), &data_[offset + sizeof(int16_t)], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&dt.day),
-             &data_[offset + sizeof(int16_t) + sizeof(int8_t)],
-             sizeof(int8_t));
-      return dt;
-    }
-    case PropertyType::TIME: {
-      Time t;
-      memcpy(reinterpret_cast<void*>(&t.hour), &data_[offset], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&t.minute), &data_[offset + sizeof(int8_t)], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&t.sec), &data_[offset + 2 * sizeof(int8_t)], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&t.microsec),
-             &data_[offset + 3 * sizeof(int8_t)],
-             sizeof(int32_t));
-      return t;
-    }
-    case PropertyType::DATETIME: {
-      DateTime dt;
-      int16_t year;
-      int8_t month;
-      int8_t day;
-      int8_t hour;
-      int8_t minute;
-      int8_t sec;
-      int32_t microsec;
-      memcpy(reinterpret_cast<void*>(&year), &data_[offset], sizeof(int16_t));
-      memcpy(reinterpret_cast<void*>(&month), &data_[offset + sizeof(int16_t)], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&day),
-             &data_[offset + sizeof(int16_t) + sizeof(int8_t)],
-             sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&hour),
-             &data_[offset + sizeof(int16_t) + 2 * sizeof(int8_t)],
-             sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&minute),
-             &data_[offset + sizeof(int16_t) + 3 * sizeof(int8_t)],
-             sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&sec),
-             &data_[offset + sizeof(int16_t) + 4 * sizeof(int8_t)],
-             sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&microsec),
-             &data_[offset + sizeof(int16_t) + 5 * sizeof(int8_t)],
-             sizeof(int32_t));
-      dt.year = year;
-      dt.month = month;
-      dt.day = day;
-      dt.hour = hour;
-      dt.minute = minute;
-      dt.sec = sec;
-      dt.microsec = microsec;
-      return dt;
-    }
-    case PropertyType::DURATION: {
-      Duration d;
-      memcpy(reinterpret_cast<void*>(&d.seconds), &data_[offset], sizeof(int64_t));
-      memcpy(reinterpret_cast<void*>(&d.microseconds),
-             &data_[offset + sizeof(int64_t)],
-             sizeof(int32_t));
-      memcpy(reinterpret_cast<void*>(&d.months),
-             &data_[offset + sizeof(int64_t) + sizeof(int32_t)],
-             sizeof(int32_t));
-      return d;
-    }
     case PropertyType::GEOGRAPHY: {
       int32_t strOffset;
       int32_t strLen;
@@ -205,7 +117,7 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const noexcept {
       }
       return std::move(geogRet).value();
     }
-    case PropertyType::UNKNOWN:
+    default:
       break;
   }
   LOG(FATAL) << "Should not reach here";
@@ -30,6 +30,8 @@ class RowReaderV2 : public RowReader {
 
   Value getValueByName(const std::string& prop) const noexcept override;
   Value getValueByIndex(const int64_t index) const noexcept override;
+  void getValues(const RowProjection& projection,
+                 std::vector<Value>* values) const noexcept override;
   int64_t getTimestamp() const noexcept override;
 
   int32_t readerVer() const noexcept override {
@@ -51,6 +53,9 @@ class RowReaderV2 : public RowReader {
 
   // Check whether the flag at the given position is set or not
   bool isNull(size_t pos) const;
+
+  // Decode the value of the column, which is in the schema of the row
+  Value getValue(const RowProjection::Column& column) const noexcept;
 };
 
 }  // namespace nebula
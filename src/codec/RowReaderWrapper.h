@@ -171,6 +171,12 @@ class RowReaderWrapper : public RowReader {
     return currReader_->getValueByIndex(index);
   }
 
+  void getValues(const RowProjection& projection,
+                 std::vector<Value>* values) const noexcept override {
+    DCHECK(!!currReader_);
+    currReader_->getValues(projection, values);
+  }
+
   int64_t getTimestamp() const noexcept override {
     DCHECK(!!currReader_);
     return currReader_->getTimestamp();
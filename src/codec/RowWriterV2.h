@@ -84,6 +84,8 @@ enum class WriteResult {
 
 ********************************************************************************/
 class RowWriterV2 {
+  friend class FixedRowCodec;
+
  public:
   explicit RowWriterV2(const meta::SchemaProviderIf* schema);
   // This constructor only takes a V2 encoded string
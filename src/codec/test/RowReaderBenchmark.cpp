@@ -6,12 +6,14 @@
 #include <folly/Benchmark.h>
 #include <gtest/gtest.h>
 
+#include "codec/RowProjection.h"
 #include "codec/RowReaderWrapper.h"
 #include "codec/RowWriterV2.h"
 #include "codec/test/RowWriterV1.h"
 #include "codec/test/SchemaWriter.h"
 #include "common/base/Base.h"
 
+using nebula::RowProjection;
 using nebula::RowReader;
 using nebula::RowReaderWrapper;
 using nebula::RowWriterV1;
@@ -30,6 +32,10 @@ std::string dataLongV2;   // NOLINT
 std::vector<size_t> shortRandom;
 std::vector<size_t> longRandom;
 
+// Names of the props to read, one out of every four fields
+std::vector<std::string> shortProps;  // NOLINT
+std::vector<std::string> longProps;   // NOLINT
+
 const double e = 2.71828182845904523536028747135266249775724709369995;
 const float pi = 3.14159265358979;
 const std::string str = "Hello world!";  // NOLINT
@@ -120,6 +126,56 @@ void randomRead(SchemaWriter* schema,
   }
 }
 
+std::vector<std::string> generateProps(SchemaWriter* schema) {
+  std::vector<std::string> props;
+  for (size_t i = 0; i < schema->getNumFields(); i += 4) {
+    props.emplace_back(schema->getFieldName(i));
+  }
+  return props;
+}
+
+void nameRead(SchemaWriter* schema,
+              const std::string& encoded,
+              const std::vector<std::string>& props,
+              size_t iters) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+
+  for (size_t i = 0; i < iters; i++) {
+    for (const auto& prop : props) {
+      auto v = reader->getValueByName(prop);
+      folly::doNotOptimizeAway(v);
+    }
+  }
+}
+
+void projectionRead(SchemaWriter* schema,
+                    const std::string& encoded,
+                    const std::vector<std::string>& props,
+                    size_t iters) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+  RowProjection projection(schema, props);
+  std::vector<nebula::Value> values;
+
+  for (size_t i = 0; i < iters; i++) {
+    reader->getValues(projection, &values);
+    folly::doNotOptimizeAway(values);
+  }
+}
+
+void projectionTest(SchemaWriter* schema,
+                    const std::string& encoded,
+                    const std::vector<std::string>& props) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+  RowProjection projection(schema, props);
+  std::vector<nebula::Value> values;
+  reader->getValues(projection, &values);
+
+  ASSERT_EQ(props.size(), values.size());
+  for (size_t i = 0; i < props.size(); i++) {
+    EXPECT_EQ(reader->getValueByName(props[i]), values[i]);
+  }
+}
+
 void sequentialTest(SchemaWriter* schema,
                     const std::string& encodedV1,
                     const std::string& encodedV2) {
@@ -169,6 +225,16 @@ TEST(RowReader, RandomShort) {
 TEST(RowReader, RandomLong) {
   randomTest(&schemaLong, dataLongV1, dataLongV2, longRandom);
 }
+
+TEST(RowReader, ProjectionShort) {
+  projectionTest(&schemaShort, dataShortV1, shortProps);
+  projectionTest(&schemaShort, dataShortV2, shortProps);
+}
+
+TEST(RowReader, ProjectionLong) {
+  projectionTest(&schemaLong, dataLongV1, longProps);
+  projectionTest(&schemaLong, dataLongV2, longProps);
+}
 /*************************
  * End of Tests
  ************************/
@@ -209,6 +275,24 @@ BENCHMARK(random_read_long_v1, iters) {
 BENCHMARK_RELATIVE(random_read_long_v2, iters) {
   randomRead(&schemaLong, dataLongV2, longRandom, iters);
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(name_read_short_v2, iters) {
+  nameRead(&schemaShort, dataShortV2, shortProps, iters);
+}
+BENCHMARK_RELATIVE(projection_read_short_v2, iters) {
+  projectionRead(&schemaShort, dataShortV2, shortProps, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(name_read_long_v2, iters) {
+  nameRead(&schemaLong, dataLongV2, longProps, iters);
+}
+BENCHMARK_RELATIVE(projection_read_long_v2, iters) {
+  projectionRead(&schemaLong, dataLongV2, longProps, iters);
+}
 /*************************
  * End of benchmarks
  ************************/
@@ -229,6 +313,9 @@ int main(int argc, char** argv) {
   shortRandom = generateRandom(&schemaShort);
   longRandom = generateRandom(&schemaLong);
 
+  shortProps = generateProps(&schemaShort);
+  longProps = generateProps(&schemaLong);
+
   if (FLAGS_benchmark) {
     folly::runBenchmarks();
     return 0;
@@ -5,7 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include "codec/RowProjection.h"
 #include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
 #include "codec/test/SchemaWriter.h"
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
@@ -348,6 +350,102 @@ TEST(RowReaderV2, iterator) {
   EXPECT_EQ(64, index);
 }
 
+TEST(RowReaderV2, projection) {
+  SchemaWriter schema;
+  schema.appendCol("bool_col", PropertyType::BOOL);
+  schema.appendCol("fixed_str_col", PropertyType::FIXED_STRING, 12);
+  schema.appendCol("int64_col", PropertyType::INT64);
+  schema.appendCol("str_col", PropertyType::STRING);
+  schema.appendCol("nullable_col", PropertyType::DOUBLE, 0, true);
+  schema.appendCol("date_col", PropertyType::DATE);
+  schema.appendCol("empty_str_col", PropertyType::STRING, 0, true);
+
+  RowWriterV2 writer(&schema);
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("bool_col", true));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("fixed_str_col", std::string("Hello")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int64_col", 0x7FFFFFFFFFFFFFFFL));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("str_col", std::string("Hello world!")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.setNull("nullable_col"));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("date_col", Date(2022, 1, 1)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("empty_str_col", std::string()));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  auto encoded = writer.moveEncodedStr();
+
+  // Props out of the order of the schema, missing and duplicated
+  std::vector<std::string> props = {"str_col",
+                                    "missing_col",
+                                    "date_col",
+                                    "nullable_col",
+                                    "",
+                                    "fixed_str_col",
+                                    "bool_col",
+                                    "empty_str_col",
+                                    "int64_col",
+                                    "str_col"};
+  auto check = [&props](RowReader* reader, const RowProjection& projection) {
+    std::vector<Value> values = {Value(1)};
+    reader->getValues(projection, &values);
+    ASSERT_EQ(props.size(), values.size());
+    for (size_t i = 0; i < props.size(); i++) {
+      auto expected = reader->getValueByName(props[i]);
+      ASSERT_EQ(expected.type(), values[i].type()) << props[i];
+      if (expected.isNull()) {
+        EXPECT_EQ(expected.getNull(), values[i].getNull()) << props[i];
+      } else {
+        EXPECT_EQ(expected, values[i]) << props[i];
+      }
+    }
+  };
+
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  ASSERT_TRUE(!!reader);
+  RowProjection projection(&schema, props);
+  ASSERT_NE(nullptr, projection.columns(&schema));
+  check(reader.get(), projection);
+  std::vector<Value> values;
+  reader->getValues(projection, &values);
+  EXPECT_EQ("Hello world!", values[0]);
+  EXPECT_EQ(NullType::UNKNOWN_PROP, values[1].getNull());
+  EXPECT_EQ(NullType::__NULL__, values[3].getNull());
+
+  // The projection of another schema, decoded by name
+  SchemaWriter other(1);
+  other.appendCol("str_col", PropertyType::STRING);
+  RowProjection otherProjection(&other, props);
+  EXPECT_EQ(nullptr, otherProjection.columns(&schema));
+  check(reader.get(), otherProjection);
+
+  // All the versions of a schema
+  std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>> schemas;
+  for (SchemaVer ver = 0; ver < 2; ver++) {
+    auto provider = std::make_shared<meta::NebulaSchemaProvider>(ver);
+    provider->addField("name", PropertyType::STRING);
+    provider->addField("age", PropertyType::INT64);
+    if (ver > 0) {
+      provider->addField("score", PropertyType::DOUBLE, 0, true);
+    }
+    schemas.emplace_back(std::move(provider));
+  }
+  props = {"score", "name", "age"};
+  RowProjection versions(schemas, props);
+  for (const auto& provider : schemas) {
+    ASSERT_NE(nullptr, versions.columns(provider.get()));
+
+    RowWriterV2 versionWriter(provider.get());
+    ASSERT_EQ(WriteResult::SUCCEEDED, versionWriter.set("name", std::string("Tim Duncan")));
+    ASSERT_EQ(WriteResult::SUCCEEDED, versionWriter.set("age", 42L));
+    if (provider->getVersion() > 0) {
+      ASSERT_EQ(WriteResult::SUCCEEDED, versionWriter.set("score", 95.5));
+    }
+    ASSERT_EQ(WriteResult::SUCCEEDED, versionWriter.finish());
+    auto row = versionWriter.moveEncodedStr();
+    auto versionReader = RowReaderWrapper::getRowReader(schemas, row);
+    ASSERT_TRUE(!!versionReader);
+    EXPECT_EQ(provider->getVersion(), versionReader->schemaVer());
+    check(versionReader.get(), versions);
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
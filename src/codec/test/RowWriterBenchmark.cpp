@@ -5,11 +5,13 @@
 
 #include <folly/Benchmark.h>
 
+#include "codec/FixedRowCodec.h"
 #include "codec/RowWriterV2.h"
 #include "codec/test/RowWriterV1.h"
 #include "codec/test/SchemaWriter.h"
 #include "common/base/Base.h"
 
+using nebula::FixedRowCodec;
 using nebula::RowWriterV1;
 using nebula::RowWriterV2;
 using nebula::SchemaWriter;
@@ -17,6 +19,12 @@ using nebula::cpp2::PropertyType;
 
 SchemaWriter schemaShort;
 SchemaWriter schemaLong;
+// The schemas with a FIXED_STRING instead of the STRING
+SchemaWriter fixedSchemaShort;
+SchemaWriter fixedSchemaLong;
+
+std::vector<nebula::Value> fixedPropsShort;  // NOLINT
+std::vector<nebula::Value> fixedPropsLong;   // NOLINT
 
 const double e = 2.71828182845904523536028747135266249775724709369995;
 const float pi = 3.14159265358979;
@@ -34,6 +42,26 @@ void prepareSchema(SchemaWriter* schema, size_t numRepeats) {
   }
 }
 
+void prepareFixedSchema(SchemaWriter* schema,
+                        std::vector<nebula::Value>* props,
+                        size_t numRepeats) {
+  int32_t index = 1;
+  for (size_t i = 0; i < numRepeats; i++) {
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::BOOL);
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::INT64);
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::TIMESTAMP);
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::FLOAT);
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::DOUBLE);
+    schema->appendCol(folly::stringPrintf("col%02d", index++), PropertyType::FIXED_STRING, 16);
+    props->emplace_back(true);
+    props->emplace_back(static_cast<int64_t>(i));
+    props->emplace_back(1551331827);
+    props->emplace_back(pi);
+    props->emplace_back(e);
+    props->emplace_back(str);
+  }
+}
+
 void writeDataV1(SchemaWriter* schema, int32_t iters) {
   for (int32_t i = 0; i < iters; i++) {
     RowWriterV1 writer(schema);
@@ -63,6 +91,30 @@ void writeDataV2(SchemaWriter* schema, int32_t iters) {
   }
 }
 
+// The values are set in the same way as the insert processors
+void writeValuesV2(SchemaWriter* schema, const std::vector<nebula::Value>& props, int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    RowWriterV2 writer(schema);
+    for (size_t j = 0; j < props.size(); j++) {
+      writer.setValue(j, props[j]);
+    }
+    writer.finish();
+    std::string encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+void writeValuesFixed(SchemaWriter* schema,
+                      const std::vector<nebula::Value>& props,
+                      int32_t iters) {
+  FixedRowCodec codec(schema);
+  for (int32_t i = 0; i < iters; i++) {
+    std::string encoded;
+    CHECK(codec.encode({}, props, &encoded));
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
 /*************************
  * Beginning of benchmarks
  ************************/
@@ -83,6 +135,26 @@ BENCHMARK(WriteLongRowV1, iters) {
 BENCHMARK_RELATIVE(WriteLongRowV2, iters) {
   writeDataV2(&schemaLong, iters);
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(WriteShortFixedRowV2, iters) {
+  writeValuesV2(&fixedSchemaShort, fixedPropsShort, iters);
+}
+
+BENCHMARK_RELATIVE(WriteShortFixedRowCodec, iters) {
+  writeValuesFixed(&fixedSchemaShort, fixedPropsShort, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(WriteLongFixedRowV2, iters) {
+  writeValuesV2(&fixedSchemaLong, fixedPropsLong, iters);
+}
+
+BENCHMARK_RELATIVE(WriteLongFixedRowCodec, iters) {
+  writeValuesFixed(&fixedSchemaLong, fixedPropsLong, iters);
+}
 /*************************
  * End of benchmarks
  ************************/
@@ -92,6 +164,8 @@ int main(int argc, char** argv) {
 
   prepareSchema(&schemaShort, 2);
   prepareSchema(&schemaLong, 24);
+  prepareFixedSchema(&fixedSchemaShort, &fixedPropsShort, 2);
+  prepareFixedSchema(&fixedSchemaLong, &fixedPropsLong, 24);
 
   folly::runBenchmarks();
   return 0;
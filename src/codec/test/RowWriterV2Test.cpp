@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 
+#include "codec/FixedRowCodec.h"
 #include "codec/RowReaderWrapper.h"
 #include "codec/RowWriterV2.h"
 #include "codec/test/SchemaWriter.h"
@@ -806,6 +807,116 @@ TEST(RowWriterV2, TimestampTest) {
   }
 }
 
+TEST(RowWriterV2, FixedRowCodec) {
+  ObjectPool objPool;
+  auto pool = &objPool;
+
+  SchemaWriter schema(0x0102 /*Schema version*/);
+  schema.appendCol("Col01", PropertyType::BOOL);
+  schema.appendCol("Col02", PropertyType::INT8, 0, true);
+  schema.appendCol("Col03", PropertyType::INT16);
+  schema.appendCol("Col04", PropertyType::INT32, 0, true);
+  schema.appendCol("Col05", PropertyType::INT64);
+  schema.appendCol("Col06", PropertyType::FLOAT);
+  schema.appendCol("Col07", PropertyType::DOUBLE, 0, true);
+  schema.appendCol("Col08", PropertyType::FIXED_STRING, 12);
+  schema.appendCol("Col09", PropertyType::FIXED_STRING, 24, true);
+  schema.appendCol("Col10", PropertyType::TIMESTAMP);
+  schema.appendCol("Col11", PropertyType::DATE);
+  schema.appendCol("Col12", PropertyType::TIME, 0, true);
+  schema.appendCol("Col13", PropertyType::DATETIME);
+  schema.appendCol("Col14", PropertyType::DURATION);
+  FixedRowCodec codec(&schema);
+
+  std::vector<std::string> names;
+  for (size_t i = 0; i < schema.getNumFields(); i++) {
+    names.emplace_back(schema.getFieldName(i));
+  }
+  std::vector<Value> props = {true,
+                              -8,
+                              16,
+                              Value::kNullValue,
+                              0x7FFFFFFFFFFFFFFFL,
+                              pi,
+                              e,
+                              str,
+                              fixed,
+                              now,
+                              date,
+                              t,
+                              dt,
+                              du};
+
+  // The same as the row of RowWriterV2, except the timestamp
+  auto expectSame = [&schema, &codec](const std::vector<std::string>& propNames,
+                                      const std::vector<Value>& values) {
+    RowWriterV2 writer(&schema);
+    for (size_t i = 0; i < values.size(); i++) {
+      if (propNames.empty()) {
+        ASSERT_EQ(WriteResult::SUCCEEDED, writer.setValue(i, values[i]));
+      } else {
+        ASSERT_EQ(WriteResult::SUCCEEDED, writer.setValue(propNames[i], values[i]));
+      }
+    }
+    ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+    auto expected = writer.moveEncodedStr();
+
+    std::string encoded;
+    ASSERT_TRUE(codec.encode(propNames, values, &encoded));
+    ASSERT_EQ(codec.rowSize(), encoded.size());
+    EXPECT_EQ(expected.substr(0, expected.size() - sizeof(int64_t)),
+              encoded.substr(0, encoded.size() - sizeof(int64_t)));
+
+    auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+    ASSERT_TRUE(!!reader);
+    auto expectedReader = RowReaderWrapper::getRowReader(&schema, expected);
+    for (size_t i = 0; i < schema.getNumFields(); i++) {
+      auto v = reader->getValueByIndex(i);
+      ASSERT_EQ(expectedReader->getValueByIndex(i).type(), v.type()) << i;
+      if (!v.isNull()) {
+        EXPECT_EQ(expectedReader->getValueByIndex(i), v) << i;
+      }
+    }
+  };
+
+  // In the order of the schema
+  expectSame({}, props);
+  // By name, out of order
+  std::vector<std::string> reversedNames(names.rbegin(), names.rend());
+  std::vector<Value> reversedProps(props.rbegin(), props.rend());
+  expectSame(reversedNames, reversedProps);
+  // The nullable fields not set are null
+  expectSame({"Col01", "Col03", "Col05", "Col06", "Col08", "Col10", "Col11", "Col13", "Col14"},
+             {false, 0, 0, 0.0, "", 0, date, dt, Duration()});
+  // Set twice
+  expectSame({"Col02", "Col02", "Col01", "Col03", "Col05", "Col06", "Col08", "Col10", "Col11",
+              "Col13", "Col14", "Col08"},
+             {Value::kNullValue, 1, true, 2, 3, 4.5, "A long long string", 5, date, dt,
+              Duration(), "B"});
+
+  // The values RowWriterV2 converts or fails to write are left to it
+  std::string encoded;
+  auto converted = props;
+  converted[5] = 1;
+  EXPECT_FALSE(codec.encode({}, converted, &encoded));
+  auto outOfRange = props;
+  outOfRange[1] = 128;
+  EXPECT_FALSE(codec.encode({}, outOfRange, &encoded));
+  auto notNullable = props;
+  notNullable[0] = Value::kNullValue;
+  EXPECT_FALSE(codec.encode({}, notNullable, &encoded));
+  EXPECT_FALSE(codec.encode({"Col01", "Col00"}, {true, 1}, &encoded));
+  EXPECT_FALSE(codec.encode({"Col01"}, {true}, &encoded));
+
+  // The default values are evaluated by RowWriterV2
+  SchemaWriter withDefault;
+  withDefault.appendCol("Col01", PropertyType::INT64);
+  withDefault.appendCol("Col02", PropertyType::INT64, 0, true, ConstantExpression::make(pool, 1));
+  FixedRowCodec defaultCodec(&withDefault);
+  EXPECT_FALSE(defaultCodec.encode({"Col01"}, {1}, &encoded));
+  EXPECT_TRUE(defaultCodec.encode({"Col01", "Col02"}, {1, 2}, &encoded));
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
@@ -41,4 +41,18 @@ void* Arena::allocateAligned(const std::size_t alloc) {
   }
 }
 
+void Arena::rewind(const Mark& mark) {
+  while (currentChunk_ != mark.chunk) {
+    DCHECK(currentChunk_ != nullptr) << "The mark doesn't belong to this arena.";
+    auto* prev = currentChunk_->prev;
+    delete[] currentChunk_;
+    currentChunk_ = prev;
+  }
+  currentPtr_ = mark.ptr;
+  availableSize_ = mark.availableSize;
+#ifndef NDEBUG
+  allocatedSize_ = mark.allocatedSize;
+#endif
+}
+
 }  // namespace nebula
@@ -38,6 +38,14 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
   // speed up read/write
   void *allocateAligned(const std::size_t alloc);
 
+  struct Mark;
+
+  // Current position of the allocation, see `rewind'
+  Mark mark() const;
+
+  // Release all memory allocated after the mark, the objects in it must have been destructed
+  void rewind(const Mark &mark);
+
 #ifndef NDEBUG
   std::size_t allocatedSize() const {
     return allocatedSize_;
@@ -87,4 +95,24 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
   std::byte *currentPtr_{nullptr};
 };
 
+struct Arena::Mark {
+  Chunk *chunk{nullptr};
+  std::byte *ptr{nullptr};
+  std::size_t availableSize{0};
+#ifndef NDEBUG
+  std::size_t allocatedSize{0};
+#endif
+};
+
+inline Arena::Mark Arena::mark() const {
+  Mark m;
+  m.chunk = currentChunk_;
+  m.ptr = currentPtr_;
+  m.availableSize = availableSize_;
+#ifndef NDEBUG
+  m.allocatedSize = allocatedSize_;
+#endif
+  return m;
+}
+
 }  // namespace nebula
@@ -46,6 +46,28 @@ class ObjectPool final : private boost::noncopyable, private cpp::NonMovable {
     return objects_.empty();
   }
 
+  struct Mark {
+    size_t numObjects{0};
+    Arena::Mark arena;
+  };
+
+  // Current position of the pool, see `rollback'
+  Mark mark() {
+    SLGuard g(lock_);
+    return Mark{objects_.size(), arena_.mark()};
+  }
+
+  // Destruct the objects added after the mark in reverse order and release their memory, so that
+  // the pool could be reused without growing. None of these objects may be referenced any more.
+  void rollback(const Mark &mark) {
+    SLGuard g(lock_);
+    DCHECK_GE(objects_.size(), mark.numObjects);
+    while (objects_.size() > mark.numObjects) {
+      objects_.pop_back();
+    }
+    arena_.rewind(mark.arena);
+  }
+
  private:
   // Holder the ownership of the any object
   class OwnershipHolder {
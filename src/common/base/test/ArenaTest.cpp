@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <type_traits>
+#include <vector>
 
 #include "common/base/Arena.h"
 
@@ -41,4 +42,21 @@ TEST(ArenaTest, Construct) {
   }
 }
 
+TEST(ArenaTest, Rewind) {
+  Arena a;
+  a.allocateAligned(sizeof(int));
+  auto mark = a.mark();
+  for (int round = 0; round < 3; ++round) {
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < 1024; ++i) {
+      ptrs.emplace_back(a.allocateAligned(64));
+    }
+    a.rewind(mark);
+    EXPECT_EQ(a.availableSize(), mark.availableSize);
+    // The memory is reused from the mark
+    EXPECT_EQ(a.allocateAligned(64), ptrs.front());
+    a.rewind(mark);
+  }
+}
+
 }  // namespace nebula
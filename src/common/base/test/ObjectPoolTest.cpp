@@ -33,4 +33,23 @@ TEST(ObjectPoolTest, TestPooling) {
   ASSERT_EQ(instances, 0);
 }
 
+TEST(ObjectPoolTest, Rollback) {
+  ASSERT_EQ(instances, 0);
+
+  ObjectPool pool;
+  ASSERT_NE(pool.makeAndAdd<MyClass>(), nullptr);
+  auto mark = pool.mark();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 10000; ++j) {
+      ASSERT_NE(pool.makeAndAdd<MyClass>(), nullptr);
+    }
+    ASSERT_EQ(instances, 10001);
+    pool.rollback(mark);
+    ASSERT_EQ(instances, 1);
+  }
+
+  pool.clear();
+  ASSERT_EQ(instances, 0);
+}
+
 }  // namespace nebula
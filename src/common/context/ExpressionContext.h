@@ -60,6 +60,35 @@ class ExpressionContext {
   // Get Value by Column index
   virtual Value getColumn(int32_t index) const = 0;
 
+  // A tag or edge property of the input could be resolved to a slot once, then the property is
+  // read by the slot at each row without looking up the names. The slots are valid as long as
+  // the identity of the input slots doesn't change, 0 means the input doesn't support slots.
+  virtual uint64_t propSlotsId() const {
+    return 0;
+  }
+
+  virtual int64_t bindTagProp(const std::string& tag, const std::string& prop) {
+    UNUSED(tag);
+    UNUSED(prop);
+    return -1;
+  }
+
+  virtual int64_t bindEdgeProp(const std::string& edge, const std::string& prop) {
+    UNUSED(edge);
+    UNUSED(prop);
+    return -1;
+  }
+
+  virtual Value getTagPropBySlot(int64_t slot) const {
+    UNUSED(slot);
+    return Value::kEmpty;
+  }
+
+  virtual Value getEdgePropBySlot(int64_t slot) const {
+    UNUSED(slot);
+    return Value::kEmpty;
+  }
+
   // Get regex
   const std::regex& getRegex(const std::string& pattern) {
     auto iter = regex_.find(pattern);
@@ -38,19 +38,21 @@ void AggregateExpression::resetFrom(Decoder& decoder) {
 
 const Value& AggregateExpression::eval(ExpressionContext& ctx) {
   DCHECK(!!aggData_);
-  auto val = arg_->eval(ctx);
-  auto uniques = aggData_->uniques();
+  accumulate(aggData_, arg_->eval(ctx));
+  return aggData_->result();
+}
+
+void AggregateExpression::accumulate(AggData* aggData, const Value& val) const {
   if (distinct_) {
+    auto uniques = aggData->uniques();
     if (uniques->contains(val)) {
-      return aggData_->result();
+      return;
     }
     uniques->values.emplace(val);
   }
 
   DCHECK(aggFunc_);
-  aggFunc_(aggData_, val);
-
-  return aggData_->result();
+  aggFunc_(aggData, val);
 }
 
 void AggregateExpression::apply(AggData* aggData, const Value& val) {
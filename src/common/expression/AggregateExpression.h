@@ -31,6 +31,10 @@ class AggregateExpression final : public Expression {
 
   void apply(AggData* aggData, const Value& val);
 
+  // Accumulate the value of argument into the aggregate data, same as `eval' but with the
+  // argument evaluated by the caller
+  void accumulate(AggData* aggData, const Value& val) const;
+
   bool operator==(const Expression& rhs) const override;
 
   std::string toString() const override;
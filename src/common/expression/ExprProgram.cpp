@@ -0,0 +1,434 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/ExprProgram.h"
+
+#include "common/expression/BinaryExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/expression/VariableExpression.h"
+
+namespace nebula {
+
+namespace {
+
+template <typename T>
+bool compareAs(ExprProgram::OpCode op, const T& lhs, const T& rhs) {
+  switch (op) {
+    case ExprProgram::OpCode::kEQ:
+      return lhs == rhs;
+    case ExprProgram::OpCode::kNE:
+      return lhs != rhs;
+    case ExprProgram::OpCode::kLT:
+      return lhs < rhs;
+    case ExprProgram::OpCode::kLE:
+      return lhs <= rhs;
+    case ExprProgram::OpCode::kGT:
+      return lhs > rhs;
+    case ExprProgram::OpCode::kGE:
+      return lhs >= rhs;
+    default:
+      LOG(FATAL) << "Not a relational instruction: " << static_cast<int>(op);
+  }
+}
+
+// Same as Value::equal and Value::lessThan of the floats
+bool compareFloat(ExprProgram::OpCode op, double lhs, double rhs) {
+  bool eq = std::abs(lhs - rhs) < kEpsilon;
+  bool lt = !eq && lhs < rhs;
+  switch (op) {
+    case ExprProgram::OpCode::kEQ:
+      return eq;
+    case ExprProgram::OpCode::kNE:
+      return !eq;
+    case ExprProgram::OpCode::kLT:
+      return lt;
+    case ExprProgram::OpCode::kLE:
+      return lt || eq;
+    case ExprProgram::OpCode::kGT:
+      return !lt && !eq;
+    case ExprProgram::OpCode::kGE:
+      return !lt || eq;
+    default:
+      LOG(FATAL) << "Not a relational instruction: " << static_cast<int>(op);
+  }
+}
+
+}  // namespace
+
+// static
+std::shared_ptr<const ExprProgram> ExprProgram::compile(const Expression* expr) {
+  DCHECK(expr != nullptr);
+  std::shared_ptr<ExprProgram> program(new ExprProgram());
+  program->result_ = program->lower(expr);
+  return program;
+}
+
+uint32_t ExprProgram::emit(OpCode op, uint32_t a, uint32_t b) {
+  auto dst = numRegisters_++;
+  instructions_.emplace_back(Instruction{op, dst, a, b});
+  return dst;
+}
+
+uint32_t ExprProgram::lower(const Expression* expr) {
+  using Kind = Expression::Kind;
+  auto kind = expr->kind();
+  switch (kind) {
+    case Kind::kConstant: {
+      constants_.emplace_back(static_cast<const ConstantExpression*>(expr)->value());
+      return emit(OpCode::kConstant, constants_.size() - 1);
+    }
+    case Kind::kInputProperty:
+    case Kind::kVarProperty:
+    case Kind::kTagProperty:
+    case Kind::kEdgeProperty:
+    case Kind::kSrcProperty:
+    case Kind::kDstProperty:
+    case Kind::kEdgeSrc:
+    case Kind::kEdgeType:
+    case Kind::kEdgeRank:
+    case Kind::kEdgeDst: {
+      auto* propExpr = static_cast<const PropertyExpression*>(expr);
+      props_.emplace_back(propExpr->sym(), propExpr->prop());
+      OpCode op = OpCode::kEdgeProp;
+      if (kind == Kind::kInputProperty) {
+        op = OpCode::kInputProp;
+      } else if (kind == Kind::kVarProperty) {
+        op = OpCode::kVarProp;
+      } else if (kind == Kind::kTagProperty) {
+        op = OpCode::kTagProp;
+      } else if (kind == Kind::kSrcProperty) {
+        op = OpCode::kSrcProp;
+      } else if (kind == Kind::kDstProperty) {
+        op = OpCode::kDstProp;
+      }
+      return emit(op, props_.size() - 1);
+    }
+    case Kind::kVar: {
+      props_.emplace_back(static_cast<const VariableExpression*>(expr)->var(), "");
+      return emit(OpCode::kVar, props_.size() - 1);
+    }
+    case Kind::kAdd:
+    case Kind::kMinus:
+    case Kind::kMultiply:
+    case Kind::kDivision:
+    case Kind::kMod:
+    case Kind::kRelEQ:
+    case Kind::kRelNE:
+    case Kind::kRelLT:
+    case Kind::kRelLE:
+    case Kind::kRelGT:
+    case Kind::kRelGE: {
+      static const std::unordered_map<Kind, OpCode> ops = {{Kind::kAdd, OpCode::kAdd},
+                                                           {Kind::kMinus, OpCode::kMinus},
+                                                           {Kind::kMultiply, OpCode::kMultiply},
+                                                           {Kind::kDivision, OpCode::kDivision},
+                                                           {Kind::kMod, OpCode::kMod},
+                                                           {Kind::kRelEQ, OpCode::kEQ},
+                                                           {Kind::kRelNE, OpCode::kNE},
+                                                           {Kind::kRelLT, OpCode::kLT},
+                                                           {Kind::kRelLE, OpCode::kLE},
+                                                           {Kind::kRelGT, OpCode::kGT},
+                                                           {Kind::kRelGE, OpCode::kGE}};
+      auto* binary = static_cast<const BinaryExpression*>(expr);
+      auto lhs = lower(binary->left());
+      auto rhs = lower(binary->right());
+      return emit(ops.at(kind), lhs, rhs);
+    }
+    case Kind::kUnaryPlus:
+    case Kind::kUnaryNegate:
+    case Kind::kUnaryNot:
+    case Kind::kIsNull:
+    case Kind::kIsNotNull:
+    case Kind::kIsEmpty:
+    case Kind::kIsNotEmpty: {
+      static const std::unordered_map<Kind, OpCode> ops = {
+          {Kind::kUnaryPlus, OpCode::kPlus},
+          {Kind::kUnaryNegate, OpCode::kNegate},
+          {Kind::kUnaryNot, OpCode::kNot},
+          {Kind::kIsNull, OpCode::kIsNull},
+          {Kind::kIsNotNull, OpCode::kIsNotNull},
+          {Kind::kIsEmpty, OpCode::kIsEmpty},
+          {Kind::kIsNotEmpty, OpCode::kIsNotEmpty}};
+      auto operand = lower(static_cast<const UnaryExpression*>(expr)->operand());
+      return emit(ops.at(kind), operand);
+    }
+    case Kind::kLogicalAnd:
+      return lowerLogical(expr, OpCode::kAndInit, OpCode::kAndStep);
+    case Kind::kLogicalOr:
+      return lowerLogical(expr, OpCode::kOrInit, OpCode::kOrStep);
+    default: {
+      // Including the expressions writing the context, e.g. ++$var, which must be evaluated
+      // by themselves
+      subtrees_.emplace_back(expr);
+      return emit(OpCode::kEval, subtrees_.size() - 1);
+    }
+  }
+}
+
+uint32_t ExprProgram::lowerLogical(const Expression* expr, OpCode init, OpCode step) {
+  auto& operands = static_cast<const LogicalExpression*>(expr)->operands();
+  DCHECK_GE(operands.size(), 2UL);
+  auto dst = emit(init);
+  std::vector<size_t> jumps;
+  jumps.reserve(operands.size());
+  for (auto* operand : operands) {
+    auto value = lower(operand);
+    // All steps accumulate into the register of the init instruction
+    jumps.emplace_back(instructions_.size());
+    instructions_.emplace_back(Instruction{step, dst, value, 0});
+  }
+  for (auto jump : jumps) {
+    instructions_[jump].b = instructions_.size();
+  }
+  return dst;
+}
+
+ExprVM::ExprVM(std::shared_ptr<const ExprProgram> program) : program_(std::move(program)) {
+  registers_.resize(program_->numRegisters_, nullptr);
+  values_.resize(program_->numRegisters_);
+  slots_.resize(program_->props_.size(), std::make_pair(0, -1));
+  subtrees_.reserve(program_->subtrees_.size());
+  for (auto* subtree : program_->subtrees_) {
+    subtrees_.emplace_back(subtree->clone());
+  }
+}
+
+const Value& ExprVM::eval(ExpressionContext& ctx) {
+  auto& instructions = program_->instructions_;
+  auto& props = program_->props_;
+  size_t pc = 0;
+  while (pc < instructions.size()) {
+    auto& inst = instructions[pc++];
+    switch (inst.op) {
+      case OpCode::kConstant:
+        registers_[inst.dst] = &program_->constants_[inst.a];
+        break;
+      case OpCode::kInputProp:
+        registers_[inst.dst] = &ctx.getInputProp(props[inst.a].second);
+        break;
+      case OpCode::kVarProp:
+        registers_[inst.dst] = &ctx.getVarProp(props[inst.a].first, props[inst.a].second);
+        break;
+      case OpCode::kTagProp:
+        output(inst.dst) = tagProp(ctx, inst.a);
+        break;
+      case OpCode::kEdgeProp:
+        output(inst.dst) = edgeProp(ctx, inst.a);
+        break;
+      case OpCode::kSrcProp:
+        output(inst.dst) = ctx.getSrcProp(props[inst.a].first, props[inst.a].second);
+        break;
+      case OpCode::kDstProp:
+        registers_[inst.dst] = &ctx.getDstProp(props[inst.a].first, props[inst.a].second);
+        break;
+      case OpCode::kVar:
+        registers_[inst.dst] = &ctx.getVar(props[inst.a].first);
+        break;
+      case OpCode::kEval:
+        registers_[inst.dst] = &subtrees_[inst.a]->eval(ctx);
+        break;
+      case OpCode::kAdd:
+      case OpCode::kMinus:
+      case OpCode::kMultiply:
+      case OpCode::kDivision:
+      case OpCode::kMod:
+        arithmetic(inst);
+        break;
+      case OpCode::kEQ:
+      case OpCode::kNE:
+      case OpCode::kLT:
+      case OpCode::kLE:
+      case OpCode::kGT:
+      case OpCode::kGE:
+        compare(inst);
+        break;
+      case OpCode::kPlus:
+        registers_[inst.dst] = registers_[inst.a];
+        break;
+      case OpCode::kNegate:
+        output(inst.dst) = -(*registers_[inst.a]);
+        break;
+      case OpCode::kNot:
+        output(inst.dst) = !(*registers_[inst.a]);
+        break;
+      case OpCode::kIsNull:
+        output(inst.dst).setBool(registers_[inst.a]->isNull());
+        break;
+      case OpCode::kIsNotNull:
+        output(inst.dst).setBool(!registers_[inst.a]->isNull());
+        break;
+      case OpCode::kIsEmpty:
+        output(inst.dst).setBool(registers_[inst.a]->empty());
+        break;
+      case OpCode::kIsNotEmpty:
+        output(inst.dst).setBool(!registers_[inst.a]->empty());
+        break;
+      case OpCode::kAndInit:
+        output(inst.dst).setBool(true);
+        break;
+      case OpCode::kOrInit:
+        output(inst.dst).setBool(false);
+        break;
+      case OpCode::kAndStep:
+      case OpCode::kOrStep: {
+        // Same as LogicalExpression::evalAnd and LogicalExpression::evalOr
+        bool isAnd = inst.op == OpCode::kAndStep;
+        auto& result = values_[inst.dst];
+        auto& value = *registers_[inst.a];
+        if (value.isBadNull() || (value.isImplicitBool() && value.implicitBool() != isAnd)) {
+          result = value;
+          pc = inst.b;
+        } else if (!value.isImplicitBool()) {
+          if (value.isNull()) {
+            result = value;
+          } else if (value.empty() && !result.isNull()) {
+            result = value;
+          } else {
+            result = Value::kNullBadType;
+            pc = inst.b;
+          }
+        }
+        break;
+      }
+    }
+  }
+  return *registers_[program_->result_];
+}
+
+void ExprVM::arithmetic(const Instruction& inst) {
+  auto& lhs = *registers_[inst.a];
+  auto& rhs = *registers_[inst.b];
+  auto& result = output(inst.dst);
+  // Leave the checks of the divisor to Value
+  bool divide = inst.op == OpCode::kDivision || inst.op == OpCode::kMod;
+  if (lhs.isInt() && rhs.isInt() && !divide) {
+    int64_t res = 0;
+    bool overflow = false;
+    if (inst.op == OpCode::kAdd) {
+      overflow = __builtin_add_overflow(lhs.getInt(), rhs.getInt(), &res);
+    } else if (inst.op == OpCode::kMinus) {
+      overflow = __builtin_sub_overflow(lhs.getInt(), rhs.getInt(), &res);
+    } else {
+      overflow = __builtin_mul_overflow(lhs.getInt(), rhs.getInt(), &res);
+    }
+    if (overflow) {
+      result = Value::kNullOverflow;
+    } else {
+      result.setInt(res);
+    }
+    return;
+  }
+  if (lhs.isFloat() && rhs.isFloat() && !divide) {
+    if (inst.op == OpCode::kAdd) {
+      result.setFloat(lhs.getFloat() + rhs.getFloat());
+    } else if (inst.op == OpCode::kMinus) {
+      result.setFloat(lhs.getFloat() - rhs.getFloat());
+    } else {
+      result.setFloat(lhs.getFloat() * rhs.getFloat());
+    }
+    return;
+  }
+
+  switch (inst.op) {
+    case OpCode::kAdd:
+      result = lhs + rhs;
+      break;
+    case OpCode::kMinus:
+      result = lhs - rhs;
+      break;
+    case OpCode::kMultiply:
+      result = lhs * rhs;
+      break;
+    case OpCode::kDivision:
+      result = lhs / rhs;
+      break;
+    case OpCode::kMod:
+      result = lhs % rhs;
+      break;
+    default:
+      LOG(FATAL) << "Not an arithmetic instruction: " << static_cast<int>(inst.op);
+  }
+}
+
+void ExprVM::compare(const Instruction& inst) {
+  auto& lhs = *registers_[inst.a];
+  auto& rhs = *registers_[inst.b];
+  auto& result = output(inst.dst);
+  if (lhs.type() == rhs.type()) {
+    switch (lhs.type()) {
+      case Value::Type::BOOL:
+        result.setBool(compareAs(inst.op, lhs.getBool(), rhs.getBool()));
+        return;
+      case Value::Type::INT:
+        result.setBool(compareAs(inst.op, lhs.getInt(), rhs.getInt()));
+        return;
+      case Value::Type::FLOAT:
+        result.setBool(compareFloat(inst.op, lhs.getFloat(), rhs.getFloat()));
+        return;
+      case Value::Type::STRING:
+        result.setBool(compareAs(inst.op, lhs.getStr(), rhs.getStr()));
+        return;
+      default:
+        break;
+    }
+  }
+
+  // Same as RelationalExpression::eval
+  switch (inst.op) {
+    case OpCode::kEQ:
+      result = lhs.equal(rhs);
+      break;
+    case OpCode::kNE:
+      result = !lhs.equal(rhs);
+      break;
+    case OpCode::kLT:
+      result = lhs.lessThan(rhs);
+      break;
+    case OpCode::kLE:
+      result = lhs.lessThan(rhs) || lhs.equal(rhs);
+      break;
+    case OpCode::kGT:
+      result = !lhs.lessThan(rhs) && !lhs.equal(rhs);
+      break;
+    case OpCode::kGE:
+      result = !lhs.lessThan(rhs) || lhs.equal(rhs);
+      break;
+    default:
+      LOG(FATAL) << "Not a relational instruction: " << static_cast<int>(inst.op);
+  }
+}
+
+Value ExprVM::tagProp(ExpressionContext& ctx, uint32_t index) {
+  auto& prop = program_->props_[index];
+  auto propSlotsId = ctx.propSlotsId();
+  if (propSlotsId == 0) {
+    return ctx.getTagProp(prop.first, prop.second);
+  }
+  auto& slot = slots_[index];
+  if (slot.first != propSlotsId) {
+    slot.second = ctx.bindTagProp(prop.first, prop.second);
+    slot.first = propSlotsId;
+  }
+  return ctx.getTagPropBySlot(slot.second);
+}
+
+Value ExprVM::edgeProp(ExpressionContext& ctx, uint32_t index) {
+  auto& prop = program_->props_[index];
+  auto propSlotsId = ctx.propSlotsId();
+  if (propSlotsId == 0) {
+    return ctx.getEdgeProp(prop.first, prop.second);
+  }
+  auto& slot = slots_[index];
+  if (slot.first != propSlotsId) {
+    slot.second = ctx.bindEdgeProp(prop.first, prop.second);
+    slot.first = propSlotsId;
+  }
+  return ctx.getEdgePropBySlot(slot.second);
+}
+
+}  // namespace nebula
@@ -0,0 +1,161 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_EXPRESSION_EXPRPROGRAM_H_
+#define COMMON_EXPRESSION_EXPRPROGRAM_H_
+
+#include "common/base/Base.h"
+#include "common/context/ExpressionContext.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+class Expression;
+
+// A flat register-based program lowered from an expression tree.
+//
+// Each instruction writes one register, so the program is evaluated by a single loop instead of
+// the recursive virtual calls of `Expression::eval'. The arithmetic and relational instructions
+// take fast paths when both operands are of the same primitive type and fall back to the
+// operators of Value otherwise, so the result is always the same as `Expression::eval'. The
+// sub-trees which are not lowered, e.g. function calls, are kept as a single instruction
+// evaluated by `Expression::eval'.
+//
+// A program is immutable once compiled and could be shared by threads, each of which evaluates
+// it by its own ExprVM.
+class ExprProgram final {
+ public:
+  enum class OpCode : uint8_t {
+    // dst = constants[a]
+    kConstant,
+    // dst = the property props[a] of the input, tag, edge, variable or vertex
+    kInputProp,
+    kVarProp,
+    kTagProp,
+    kEdgeProp,
+    kSrcProp,
+    kDstProp,
+    // dst = the variable props[a]
+    kVar,
+    // dst = subtrees[a]
+    kEval,
+    // dst = a op b
+    kAdd,
+    kMinus,
+    kMultiply,
+    kDivision,
+    kMod,
+    kEQ,
+    kNE,
+    kLT,
+    kLE,
+    kGT,
+    kGE,
+    // dst = op a
+    kPlus,
+    kNegate,
+    kNot,
+    kIsNull,
+    kIsNotNull,
+    kIsEmpty,
+    kIsNotEmpty,
+    // dst = dst op a, jump to b once the result is determined
+    kAndInit,
+    kAndStep,
+    kOrInit,
+    kOrStep,
+  };
+
+  struct Instruction {
+    OpCode op;
+    // Register written by the instruction
+    uint32_t dst;
+    // Register of the first operand, or index of the constant, property or sub-tree
+    uint32_t a;
+    // Register of the second operand, or target of the jump
+    uint32_t b;
+  };
+
+  // Never fails, the expression which can't be lowered at all is compiled to a single kEval
+  static std::shared_ptr<const ExprProgram> compile(const Expression* expr);
+
+  const std::vector<Instruction>& instructions() const {
+    return instructions_;
+  }
+
+  // Number of the sub-trees evaluated by `Expression::eval'
+  size_t numSubtrees() const {
+    return subtrees_.size();
+  }
+
+ private:
+  friend class ExprVM;
+
+  ExprProgram() = default;
+
+  // Emit the instructions of the expression, return the register of its result
+  uint32_t lower(const Expression* expr);
+
+  uint32_t emit(OpCode op, uint32_t a = 0, uint32_t b = 0);
+
+  uint32_t lowerLogical(const Expression* expr, OpCode init, OpCode step);
+
+  std::vector<Instruction> instructions_;
+  std::vector<Value> constants_;
+  // (symbol, property) of the property and variable instructions
+  std::vector<std::pair<std::string, std::string>> props_;
+  std::vector<const Expression*> subtrees_;
+  uint32_t numRegisters_{0};
+  uint32_t result_{0};
+};
+
+// Evaluator of an ExprProgram with its own register file, which must not be shared by threads.
+// The sub-trees not lowered are cloned by the VM for the same reason.
+class ExprVM final {
+ public:
+  explicit ExprVM(std::shared_ptr<const ExprProgram> program);
+
+  // Compile the expression for this VM only
+  explicit ExprVM(const Expression* expr) : ExprVM(ExprProgram::compile(expr)) {}
+
+  // The clones of sub-trees are owned by one VM
+  ExprVM(const ExprVM&) = delete;
+  ExprVM& operator=(const ExprVM&) = delete;
+  ExprVM(ExprVM&&) = default;
+  ExprVM& operator=(ExprVM&&) = default;
+
+  // The result is valid until the next evaluation or the context moving to another row
+  const Value& eval(ExpressionContext& ctx);
+
+ private:
+  using Instruction = ExprProgram::Instruction;
+  using OpCode = ExprProgram::OpCode;
+
+  Value& output(uint32_t dst) {
+    registers_[dst] = &values_[dst];
+    return values_[dst];
+  }
+
+  void arithmetic(const Instruction& inst);
+
+  void compare(const Instruction& inst);
+
+  Value tagProp(ExpressionContext& ctx, uint32_t index);
+
+  Value edgeProp(ExpressionContext& ctx, uint32_t index);
+
+  std::shared_ptr<const ExprProgram> program_;
+  std::vector<const Value*> registers_;
+  // Storage of the registers computed by the VM, the others point to the constants of the
+  // program or the values owned by the context
+  std::vector<Value> values_;
+  std::vector<Expression*> subtrees_;
+  // (propSlotsId, slot) of the tag and edge properties, see ExpressionContext::propSlotsId
+  std::vector<std::pair<uint64_t, int64_t>> slots_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_EXPRESSION_EXPRPROGRAM_H_
@@ -49,8 +49,32 @@ const Value& PropertyExpression::eval(ExpressionContext& ctx) {
   LOG(FATAL) << "Unimplemented";
 }
 
+Value PropertyExpression::getTagProp(ExpressionContext& ctx) {
+  auto propSlotsId = ctx.propSlotsId();
+  if (propSlotsId == 0) {
+    return ctx.getTagProp(sym_, prop_);
+  }
+  if (propSlotsId != propSlotsId_) {
+    slot_ = ctx.bindTagProp(sym_, prop_);
+    propSlotsId_ = propSlotsId;
+  }
+  return ctx.getTagPropBySlot(slot_);
+}
+
+Value PropertyExpression::getEdgeProp(ExpressionContext& ctx) {
+  auto propSlotsId = ctx.propSlotsId();
+  if (propSlotsId == 0) {
+    return ctx.getEdgeProp(sym_, prop_);
+  }
+  if (propSlotsId != propSlotsId_) {
+    slot_ = ctx.bindEdgeProp(sym_, prop_);
+    propSlotsId_ = propSlotsId;
+  }
+  return ctx.getEdgePropBySlot(slot_);
+}
+
 const Value& EdgePropertyExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getEdgeProp(sym_, prop_);
+  result_ = getEdgeProp(ctx);
   return result_;
 }
 
@@ -59,7 +83,7 @@ void EdgePropertyExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& TagPropertyExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getTagProp(sym_, prop_);
+  result_ = getTagProp(ctx);
   return result_;
 }
 
@@ -101,7 +125,7 @@ void DestPropertyExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeSrcIdExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getEdgeProp(sym_, prop_);
+  result_ = getEdgeProp(ctx);
   return result_;
 }
 
@@ -110,7 +134,7 @@ void EdgeSrcIdExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeTypeExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getEdgeProp(sym_, prop_);
+  result_ = getEdgeProp(ctx);
   return result_;
 }
 
@@ -119,7 +143,7 @@ void EdgeTypeExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeRankExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getEdgeProp(sym_, prop_);
+  result_ = getEdgeProp(ctx);
   return result_;
 }
 
@@ -128,7 +152,7 @@ void EdgeRankExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeDstIdExpression::eval(ExpressionContext& ctx) {
-  result_ = ctx.getEdgeProp(sym_, prop_);
+  result_ = getEdgeProp(ctx);
   return result_;
 }
 
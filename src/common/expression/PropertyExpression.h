@@ -57,9 +57,18 @@ class PropertyExpression : public Expression {
   void writeTo(Encoder& encoder) const override;
   void resetFrom(Decoder& decoder) override;
 
+  // Get the tag/edge property by the slot bound to the input if the input supports slots,
+  // the property is bound again once the input changes
+  Value getTagProp(ExpressionContext& ctx);
+  Value getEdgeProp(ExpressionContext& ctx);
+
   std::string ref_;
   std::string sym_;
   std::string prop_;
+
+  // The input which `slot_' is bound to, see ExpressionContext::propSlotsId
+  uint64_t propSlotsId_{0};
+  int64_t slot_{-1};
 };
 
 // edge_name.any_prop_name
@@ -28,6 +28,7 @@
 #include "common/expression/ConstantExpression.h"
 #include "common/expression/ContainerExpression.h"
 #include "common/expression/EdgeExpression.h"
+#include "common/expression/ExprProgram.h"
 #include "common/expression/FunctionCallExpression.h"
 #include "common/expression/LabelAttributeExpression.h"
 #include "common/expression/LabelExpression.h"
@@ -78,6 +79,11 @@ class ExpressionTest : public ::testing::Test {
     auto eval = Expression::eval(ep, gExpCtxt);
     EXPECT_EQ(eval.type(), expected.type()) << "type check failed: " << ep->toString();
     EXPECT_EQ(eval, expected) << "check failed: " << ep->toString();
+    // The compiled program must agree with the expression tree
+    ExprVM vm(ep);
+    auto vmEval = vm.eval(gExpCtxt);
+    EXPECT_EQ(vmEval.type(), expected.type()) << "vm type check failed: " << ep->toString();
+    EXPECT_EQ(vmEval, expected) << "vm check failed: " << ep->toString();
   }
 
   void testToString(const std::string &exprSymbol, const char *expected) {
@@ -0,0 +1,503 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/graph/JsonWriter.h"
+
+#include <folly/Conv.h>
+
+#include <cmath>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/Geography.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+
+namespace nebula {
+
+// static
+std::string JsonWriter::toJson(const ExecutionResponse& resp) {
+  std::string out;
+  JsonWriter writer(&out);
+  writer.write(resp);
+  return out;
+}
+
+void JsonWriter::write(const ExecutionResponse& resp) {
+  writeRaw("{\"results\":[{");
+  writeKey("latencyInUs");
+  writeInt(resp.latencyInUs);
+  writeRaw(",\"errors\":");
+  writeErrors(resp);
+  if (resp.data) {
+    writeRaw(",\"columns\":[");
+    const auto& colNames = resp.data->colNames;
+    for (size_t i = 0; i < colNames.size(); ++i) {
+      if (i != 0) {
+        writeChar(',');
+      }
+      writeString(colNames[i]);
+    }
+    writeRaw("],\"data\":");
+    write(*resp.data);
+  }
+  if (resp.spaceName) {
+    writeRaw(",\"spaceName\":");
+    writeString(*resp.spaceName);
+  }
+  if (resp.planDesc) {
+    writeRaw(",\"planDesc\":");
+    write(*resp.planDesc);
+  }
+  if (resp.comment) {
+    writeRaw(",\"comment\":");
+    writeString(*resp.comment);
+  }
+  writeRaw("}],\"errors\":[");
+  writeErrors(resp);
+  writeRaw("]}");
+}
+
+void JsonWriter::writeErrors(const ExecutionResponse& resp) {
+  writeRaw("{\"code\":");
+  writeInt(static_cast<int>(resp.errorCode));
+  if (resp.errorMsg) {
+    writeRaw(",\"message\":");
+    writeString(*resp.errorMsg);
+  }
+  writeChar('}');
+}
+
+void JsonWriter::write(const PlanDescription& planDesc) {
+  writeRaw("{\"planNodeDescs\":[");
+  for (size_t i = 0; i < planDesc.planNodeDescs.size(); ++i) {
+    if (i != 0) {
+      writeChar(',');
+    }
+    writePlanNodeDesc(planDesc.planNodeDescs[i]);
+  }
+  // The int keys are written as strings, the same as PlanDescription::toJson()
+  writeRaw("],\"nodeIndexMap\":{");
+  bool first = true;
+  for (const auto& kv : planDesc.nodeIndexMap) {
+    if (!first) {
+      writeChar(',');
+    }
+    first = false;
+    writeChar('"');
+    writeInt(kv.first);
+    writeRaw("\":");
+    writeInt(kv.second);
+  }
+  writeRaw("},\"format\":");
+  writeString(planDesc.format);
+  writeRaw(",\"optimize_time_in_us\":");
+  writeInt(planDesc.optimize_time_in_us);
+  writeChar('}');
+}
+
+void JsonWriter::writePlanNodeDesc(const PlanNodeDescription& desc) {
+  writeRaw("{\"name\":");
+  writeString(desc.name);
+  writeRaw(",\"id\":");
+  writeInt(desc.id);
+  writeRaw(",\"outputVar\":");
+  writeString(desc.outputVar);
+  if (desc.description) {
+    writeRaw(",\"description\":[");
+    for (size_t i = 0; i < desc.description->size(); ++i) {
+      if (i != 0) {
+        writeChar(',');
+      }
+      const auto& pair = (*desc.description)[i];
+      writeChar('{');
+      writeKey(pair.key);
+      writeString(pair.value);
+      writeChar('}');
+    }
+    writeChar(']');
+  }
+  if (desc.profiles) {
+    writeRaw(",\"profiles\":[");
+    for (size_t i = 0; i < desc.profiles->size(); ++i) {
+      if (i != 0) {
+        writeChar(',');
+      }
+      const auto& profile = (*desc.profiles)[i];
+      writeRaw("{\"rows\":");
+      writeInt(profile.rows);
+      writeRaw(",\"execDurationInUs\":");
+      writeInt(profile.execDurationInUs);
+      writeRaw(",\"totalDurationInUs\":");
+      writeInt(profile.totalDurationInUs);
+      if (profile.otherStats) {
+        writeRaw(",\"otherStats\":{");
+        bool first = true;
+        for (const auto& kv : *profile.otherStats) {
+          if (!first) {
+            writeChar(',');
+          }
+          first = false;
+          writeKey(kv.first);
+          writeString(kv.second);
+        }
+        writeChar('}');
+      }
+      writeChar('}');
+    }
+    writeChar(']');
+  }
+  if (desc.branchInfo) {
+    writeRaw(",\"branchInfo\":{\"isDoBranch\":");
+    writeRaw(desc.branchInfo->isDoBranch ? "true" : "false");
+    writeRaw(",\"conditionNodeId\":");
+    writeInt(desc.branchInfo->conditionNodeId);
+    writeChar('}');
+  }
+  if (desc.dependencies) {
+    writeRaw(",\"dependencies\":[");
+    for (size_t i = 0; i < desc.dependencies->size(); ++i) {
+      if (i != 0) {
+        writeChar(',');
+      }
+      writeInt((*desc.dependencies)[i]);
+    }
+    writeChar(']');
+  }
+  writeChar('}');
+}
+
+void JsonWriter::write(const DataSet& ds) {
+  writeChar('[');
+  for (size_t i = 0; i < ds.rows.size(); ++i) {
+    if (i != 0) {
+      writeChar(',');
+    }
+    writeRow(ds.rows[i]);
+  }
+  writeChar(']');
+}
+
+void JsonWriter::writeRow(const Row& row) {
+  writeRaw("{\"row\":[");
+  for (size_t i = 0; i < row.values.size(); ++i) {
+    if (i != 0) {
+      writeChar(',');
+    }
+    write(row.values[i]);
+  }
+  writeRaw("],\"meta\":[");
+  for (size_t i = 0; i < row.values.size(); ++i) {
+    if (i != 0) {
+      writeChar(',');
+    }
+    writeMetaData(row.values[i]);
+  }
+  writeRaw("]}");
+}
+
+void JsonWriter::write(const Value& value) {
+  switch (value.type()) {
+    case Value::Type::__EMPTY__: {
+      writeRaw("\"__EMPTY__\"");
+      return;
+    }
+    case Value::Type::NULLVALUE: {
+      writeRaw("null");
+      return;
+    }
+    case Value::Type::BOOL: {
+      writeRaw(value.getBool() ? "true" : "false");
+      return;
+    }
+    case Value::Type::INT: {
+      writeInt(value.getInt());
+      return;
+    }
+    case Value::Type::FLOAT: {
+      writeDouble(value.getFloat());
+      return;
+    }
+    case Value::Type::STRING: {
+      writeString(value.getStr());
+      return;
+    }
+    case Value::Type::LIST:
+    case Value::Type::SET: {
+      writeChar('[');
+      bool first = true;
+      auto writeElem = [this, &first](const Value& elem) {
+        if (!first) {
+          writeChar(',');
+        }
+        first = false;
+        write(elem);
+      };
+      if (value.isList()) {
+        std::for_each(value.getList().values.begin(), value.getList().values.end(), writeElem);
+      } else {
+        std::for_each(value.getSet().values.begin(), value.getSet().values.end(), writeElem);
+      }
+      writeChar(']');
+      return;
+    }
+    case Value::Type::MAP: {
+      writeProps(value.getMap().kvs);
+      return;
+    }
+    case Value::Type::DATE: {
+      writeString(value.getDate().toString());
+      return;
+    }
+    case Value::Type::TIME: {
+      writeString(value.getTime().toString() + "Z");
+      return;
+    }
+    case Value::Type::DATETIME: {
+      writeString(value.getDateTime().toString() + "Z");
+      return;
+    }
+    case Value::Type::EDGE: {
+      writeProps(value.getEdge().props);
+      return;
+    }
+    case Value::Type::VERTEX: {
+      writeVertex(value.getVertex());
+      return;
+    }
+    case Value::Type::PATH: {
+      const auto& path = value.getPath();
+      writeChar('[');
+      writeVertex(path.src);
+      for (const auto& step : path.steps) {
+        writeChar(',');
+        writeProps(step.props);
+        writeChar(',');
+        writeVertex(step.dst);
+      }
+      writeChar(']');
+      return;
+    }
+    case Value::Type::DATASET: {
+      write(value.getDataSet());
+      return;
+    }
+    case Value::Type::GEOGRAPHY: {
+      writeString(value.getGeography().asWKT());
+      return;
+    }
+    case Value::Type::DURATION: {
+      writeString(value.getDuration().toString());
+      return;
+    }
+      // no default so the compiler will warning when lack
+  }
+
+  LOG(FATAL) << "Unknown value type " << static_cast<int>(value.type());
+}
+
+void JsonWriter::writeMetaData(const Value& value) {
+  switch (value.type()) {
+    // Privative datatypes has no meta data
+    case Value::Type::__EMPTY__:
+    case Value::Type::BOOL:
+    case Value::Type::INT:
+    case Value::Type::FLOAT:
+    case Value::Type::STRING:
+    case Value::Type::DATASET:
+    case Value::Type::NULLVALUE:
+    case Value::Type::GEOGRAPHY: {
+      writeRaw("null");
+      return;
+    }
+    // The meta data of each element as the one of the container
+    case Value::Type::LIST:
+    case Value::Type::SET:
+    case Value::Type::MAP: {
+      writeChar('[');
+      bool first = true;
+      auto writeElem = [this, &first](const Value& elem) {
+        if (!first) {
+          writeChar(',');
+        }
+        first = false;
+        writeMetaData(elem);
+      };
+      if (value.isList()) {
+        std::for_each(value.getList().values.begin(), value.getList().values.end(), writeElem);
+      } else if (value.isSet()) {
+        std::for_each(value.getSet().values.begin(), value.getSet().values.end(), writeElem);
+      } else {
+        for (const auto& kv : value.getMap().kvs) {
+          writeElem(kv.second);
+        }
+      }
+      writeChar(']');
+      return;
+    }
+    case Value::Type::DURATION:
+    case Value::Type::DATE:
+    case Value::Type::TIME:
+    case Value::Type::DATETIME: {
+      writeRaw("{\"type\":");
+      writeString(value.typeName());
+      writeChar('}');
+      return;
+    }
+    case Value::Type::VERTEX: {
+      writeVertexMetaData(value.getVertex());
+      return;
+    }
+    case Value::Type::EDGE: {
+      const auto& edge = value.getEdge();
+      writeEdgeMetaData(edge.src, edge.dst, edge.type, edge.name, edge.ranking);
+      return;
+    }
+    case Value::Type::PATH: {
+      const auto& path = value.getPath();
+      writeChar('[');
+      writeVertexMetaData(path.src);
+      const auto* src = &path.src.vid;
+      for (const auto& step : path.steps) {
+        writeChar(',');
+        writeEdgeMetaData(*src, step.dst.vid, step.type, step.name, step.ranking);
+        writeChar(',');
+        writeVertexMetaData(step.dst);
+        src = &step.dst.vid;
+      }
+      writeChar(']');
+      return;
+    }
+  }
+
+  LOG(FATAL) << "Unknown value type " << static_cast<int>(value.type());
+}
+
+void JsonWriter::writeVertex(const Vertex& vertex) {
+  writeChar('{');
+  bool first = true;
+  for (const auto& tag : vertex.tags) {
+    for (const auto& prop : tag.props) {
+      if (!first) {
+        writeChar(',');
+      }
+      first = false;
+      writeString(tag.name, prop.first);
+      writeChar(':');
+      write(prop.second);
+    }
+  }
+  writeChar('}');
+}
+
+void JsonWriter::writeProps(const std::unordered_map<std::string, Value>& props) {
+  writeChar('{');
+  bool first = true;
+  for (const auto& prop : props) {
+    if (!first) {
+      writeChar(',');
+    }
+    first = false;
+    writeKey(prop.first);
+    write(prop.second);
+  }
+  writeChar('}');
+}
+
+void JsonWriter::writeVertexMetaData(const Vertex& vertex) {
+  writeRaw("{\"id\":");
+  write(vertex.vid);
+  writeRaw(",\"type\":\"vertex\"}");
+}
+
+void JsonWriter::writeEdgeMetaData(const Value& src,
+                                   const Value& dst,
+                                   EdgeType type,
+                                   const std::string& name,
+                                   EdgeRanking ranking) {
+  writeRaw("{\"id\":{\"name\":");
+  writeString(name);
+  writeRaw(",\"src\":");
+  write(src);
+  writeRaw(",\"dst\":");
+  write(dst);
+  writeRaw(",\"type\":");
+  writeInt(type);
+  writeRaw(",\"ranking\":");
+  writeInt(ranking);
+  writeRaw("},\"type\":\"edge\"}");
+}
+
+void JsonWriter::writeString(folly::StringPiece str) {
+  writeString("", str);
+}
+
+void JsonWriter::writeString(folly::StringPiece prefix, folly::StringPiece str) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  // Escaped the same as folly::toJson, in which the non-ascii bytes are kept as is
+  auto escape = [this](folly::StringPiece s) {
+    auto begin = s.begin();
+    for (auto p = s.begin(); p != s.end(); ++p) {
+      auto c = static_cast<unsigned char>(*p);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      out_->append(begin, p);
+      begin = p + 1;
+      switch (c) {
+        case '"':
+          writeRaw("\\\"");
+          break;
+        case '\\':
+          writeRaw("\\\\");
+          break;
+        case '\b':
+          writeRaw("\\b");
+          break;
+        case '\f':
+          writeRaw("\\f");
+          break;
+        case '\n':
+          writeRaw("\\n");
+          break;
+        case '\r':
+          writeRaw("\\r");
+          break;
+        case '\t':
+          writeRaw("\\t");
+          break;
+        default:
+          writeRaw("\\u00");
+          writeChar(kHex[c >> 4]);
+          writeChar(kHex[c & 0xF]);
+      }
+    }
+    out_->append(begin, s.end());
+  };
+  writeChar('"');
+  if (!prefix.empty()) {
+    escape(prefix);
+    writeChar('.');
+  }
+  escape(str);
+  writeChar('"');
+}
+
+void JsonWriter::writeInt(int64_t i) {
+  folly::toAppend(i, out_);
+}
+
+void JsonWriter::writeDouble(double d) {
+  if (!std::isfinite(d)) {
+    writeRaw("null");
+    return;
+  }
+  // The shortest representation, the same as folly::toJson
+  folly::toAppend(d, out_);
+}
+
+}  // namespace nebula
@@ -0,0 +1,94 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_GRAPH_JSONWRITER_H
+#define COMMON_GRAPH_JSONWRITER_H
+
+#include <string>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Value.h"
+#include "common/datatypes/Vertex.h"
+#include "common/graph/Response.h"
+
+namespace nebula {
+
+// Writes the JSON of the query results directly into a string buffer.
+//
+// The JSON is the same as the one of toJson()/getMetaData(), which builds a tree of
+// folly::dynamic first, i.e. an object and a string key per property of each vertex and edge,
+// and then walks it again to print. The writer appends the values as they are visited instead.
+// The only difference is that the NaN and infinity are written as null, which folly::toJson
+// fails on.
+class JsonWriter final {
+ public:
+  explicit JsonWriter(std::string* out) : out_(out) {}
+
+  // Serializes the response in the form of ExecutionResponse::toJson()
+  static std::string toJson(const ExecutionResponse& resp);
+
+  void write(const ExecutionResponse& resp);
+
+  void write(const PlanDescription& planDesc);
+
+  // The rows of the data set, in the form of DataSet::toJson()
+  void write(const DataSet& ds);
+
+  void write(const Value& value);
+
+  // The metadata of the value, in the form of Value::getMetaData()
+  void writeMetaData(const Value& value);
+
+ private:
+  void writeRaw(folly::StringPiece str) {
+    out_->append(str.data(), str.size());
+  }
+
+  void writeChar(char c) {
+    out_->push_back(c);
+  }
+
+  // Writes the quoted and escaped string
+  void writeString(folly::StringPiece str);
+
+  // Writes the quoted and escaped `prefix.str'
+  void writeString(folly::StringPiece prefix, folly::StringPiece str);
+
+  void writeInt(int64_t i);
+
+  void writeDouble(double d);
+
+  // Writes `"key":'
+  void writeKey(folly::StringPiece key) {
+    writeString(key);
+    writeChar(':');
+  }
+
+  void writeErrors(const ExecutionResponse& resp);
+
+  void writeRow(const Row& row);
+
+  // The props of the tags merged into one object
+  void writeVertex(const Vertex& vertex);
+
+  void writeProps(const std::unordered_map<std::string, Value>& props);
+
+  void writeVertexMetaData(const Vertex& vertex);
+
+  void writeEdgeMetaData(const Value& src,
+                         const Value& dst,
+                         EdgeType type,
+                         const std::string& name,
+                         EdgeRanking ranking);
+
+  void writePlanNodeDesc(const PlanNodeDescription& desc);
+
+  std::string* out_{nullptr};
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_GRAPH_JSONWRITER_H
@@ -0,0 +1,89 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/json.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Vertex.h"
+#include "common/graph/JsonWriter.h"
+
+using nebula::DataSet;
+using nebula::Edge;
+using nebula::ExecutionResponse;
+using nebula::JsonWriter;
+using nebula::Path;
+using nebula::Row;
+using nebula::Step;
+using nebula::Tag;
+using nebula::Value;
+using nebula::Vertex;
+
+namespace {
+
+Vertex player(int64_t i) {
+  return Vertex(folly::to<std::string>("player", i),
+                {Tag("player", {{"name", folly::to<std::string>("name ", i)}, {"age", i % 50}})});
+}
+
+// Rows of `RETURN v, e, p, v.player.name' of the players
+ExecutionResponse makeResponse(size_t numRows) {
+  DataSet ds({"v", "e", "p", "name"});
+  for (size_t i = 0; i < numRows; ++i) {
+    auto src = player(i);
+    auto dst = player(i + 1);
+    Edge edge(src.vid, dst.vid, 1, "like", 0, {{"likeness", static_cast<int64_t>(i % 100)}});
+    Path path(src, {Step(dst, 1, "like", 0, {{"likeness", 90.5}})});
+    Row row;
+    row.values.emplace_back(src);
+    row.values.emplace_back(std::move(edge));
+    row.values.emplace_back(std::move(path));
+    row.values.emplace_back(src.tags.front().props["name"]);
+    ds.rows.emplace_back(std::move(row));
+  }
+  ExecutionResponse resp;
+  resp.latencyInUs = 1000;
+  resp.data = std::make_unique<DataSet>(std::move(ds));
+  resp.spaceName = std::make_unique<std::string>("nba");
+  return resp;
+}
+
+void follyToJson(size_t iters, size_t numRows) {
+  ExecutionResponse resp;
+  BENCHMARK_SUSPEND {
+    resp = makeResponse(numRows);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(folly::toJson(resp.toJson()));
+  }
+}
+
+void jsonWriter(size_t iters, size_t numRows) {
+  ExecutionResponse resp;
+  BENCHMARK_SUSPEND {
+    resp = makeResponse(numRows);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(JsonWriter::toJson(resp));
+  }
+}
+
+}  // namespace
+
+BENCHMARK_NAMED_PARAM(follyToJson, 100_rows, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM(jsonWriter, 100_rows, 100)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(follyToJson, 10K_rows, 10000)
+BENCHMARK_RELATIVE_NAMED_PARAM(jsonWriter, 10K_rows, 10000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(follyToJson, 1M_rows, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(jsonWriter, 1M_rows, 1000000)
+
+int main() {
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,191 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Geography.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+#include "common/graph/JsonWriter.h"
+
+namespace nebula {
+
+namespace {
+
+std::string writeValue(const Value& value) {
+  std::string out;
+  JsonWriter(&out).write(value);
+  return out;
+}
+
+std::string writeMetaData(const Value& value) {
+  std::string out;
+  JsonWriter(&out).writeMetaData(value);
+  return out;
+}
+
+// The same as toJson()/getMetaData() once parsed, since the keys of objects are unordered
+void checkValue(const Value& value) {
+  EXPECT_EQ(value.toJson(), folly::parseJson(writeValue(value))) << value;
+  EXPECT_EQ(value.getMetaData(), folly::parseJson(writeMetaData(value))) << value;
+}
+
+Vertex vertex(Value vid) {
+  return Vertex(std::move(vid),
+                {Tag("player", {{"name", "Tim \"The\" Duncan"}, {"age", 42}}),
+                 Tag("bachelor", {{"speciality", "psychology\n"}, {"score", 3.5}})});
+}
+
+}  // namespace
+
+TEST(JsonWriterTest, Primitive) {
+  checkValue(Value());
+  checkValue(Value::kNullValue);
+  checkValue(Value(NullType::BAD_TYPE));
+  checkValue(Value(true));
+  checkValue(Value(false));
+  checkValue(Value(0));
+  checkValue(Value(std::numeric_limits<int64_t>::min()));
+  checkValue(Value(std::numeric_limits<int64_t>::max()));
+  checkValue(Value(0.0));
+  checkValue(Value(-1.5));
+  checkValue(Value(0.1));
+  checkValue(Value(1e300));
+  checkValue(Value(3.0));
+  checkValue(Value(""));
+  checkValue(Value("vertex"));
+  checkValue(Value("\"quoted\" \\ back/slash\t\r\n\b\f\x01\x1f \xe4\xb8\xad"));
+
+  // Same bytes of the numbers and strings as folly::toJson
+  for (auto& value : {Value(-1.5),
+                      Value(0.1),
+                      Value(1e300),
+                      Value(3.0),
+                      Value(123456789),
+                      Value("\"quoted\" \\ back/slash\t\r\n\b\f\x01\x1f \xe4\xb8\xad")}) {
+    EXPECT_EQ(folly::toJson(value.toJson()), writeValue(value));
+  }
+
+  // NaN and infinity are not valid JSON numbers
+  EXPECT_EQ("null", writeValue(Value(std::numeric_limits<double>::quiet_NaN())));
+  EXPECT_EQ("null", writeValue(Value(std::numeric_limits<double>::infinity())));
+}
+
+TEST(JsonWriterTest, Temporal) {
+  checkValue(Value(Date(2021, 12, 21)));
+  checkValue(Value(Time(13, 30, 15, 1000)));
+  checkValue(Value(DateTime(2021, 12, 21, 13, 30, 15, 1000)));
+  checkValue(Value(Duration(1, 100, 20)));
+}
+
+TEST(JsonWriterTest, Geography) {
+  Value point(Geography(Point(Coordinate(1.5, 2.5))));
+  EXPECT_EQ(point.toJson(), folly::parseJson(writeValue(point)));
+  EXPECT_EQ("null", writeMetaData(point));
+}
+
+TEST(JsonWriterTest, Container) {
+  checkValue(Value(List()));
+  checkValue(Value(List({1, "a", 1.5, Value::kNullValue, vertex("v")})));
+  checkValue(Value(Set({1, 2, 3})));
+  checkValue(Value(Map({{"a", 1}, {"b\"", "c"}, {"d", Value(List({vertex(1)}))}})));
+  checkValue(Value(List({Value(List({1, 2})), Value(Map({{"k", Time(1, 2, 3, 4)}}))})));
+}
+
+TEST(JsonWriterTest, Graph) {
+  checkValue(Value(vertex("Tim Duncan")));
+  checkValue(Value(vertex(100)));
+  checkValue(Value(Vertex("empty", {})));
+  checkValue(Value(Edge("Tim Duncan", "Tony Parker", 1, "like", 0, {{"likeness", 95}})));
+  checkValue(Value(Edge(1, 2, -1, "serve", 3, {{"start", 1997}, {"end", Date(2016, 1, 1)}})));
+  checkValue(Value(Edge(1, 2, 1, "like", 0, {})));
+
+  Path path;
+  path.src = vertex("a");
+  path.steps.emplace_back(Step(vertex("b"), 1, "like", 0, {{"likeness", 90}}));
+  path.steps.emplace_back(Step(vertex("c"), -2, "serve", 1, {{"start", 2001}}));
+  path.steps.emplace_back(Step(Vertex("d", {}), 1, "like", 2, {}));
+  checkValue(Value(path));
+  checkValue(Value(Path(vertex(1), {})));
+}
+
+TEST(JsonWriterTest, DataSet) {
+  DataSet ds({"v", "e", "p", "n"});
+  ds.emplace_back(Row({vertex("a"),
+                       Edge("a", "b", 1, "like", 0, {{"likeness", 95}}),
+                       Path(vertex("a"), {Step(vertex("b"), 1, "like", 0, {})}),
+                       Value::kNullValue}));
+  ds.emplace_back(Row({vertex(1), Value::kEmpty, List({1, 2}), 1.5}));
+  std::string out;
+  JsonWriter(&out).write(ds);
+  EXPECT_EQ(ds.toJson(), folly::parseJson(out));
+  checkValue(Value(ds));
+}
+
+TEST(JsonWriterTest, Response) {
+  std::vector<ExecutionResponse> resps;
+  resps.emplace_back(ExecutionResponse{});
+  resps.emplace_back(ExecutionResponse{ErrorCode::E_SYNTAX_ERROR,
+                                       233,
+                                       nullptr,
+                                       std::make_unique<std::string>("test_space"),
+                                       std::make_unique<std::string>("Error \"Msg\".")});
+
+  DataSet ds({"name", "v"});
+  ds.emplace_back(Row({"Tim Duncan", vertex("Tim Duncan")}));
+  ds.emplace_back(Row({Value::kNullValue, vertex(1)}));
+  PlanDescription planDesc;
+  {
+    PlanNodeDescription desc;
+    desc.name = "Project";
+    desc.id = 1;
+    desc.outputVar = "__Project_1";
+    desc.description = std::make_unique<std::vector<Pair>>();
+    desc.description->emplace_back(Pair{"columns", "[\"name\"]"});
+    desc.profiles = std::make_unique<std::vector<ProfilingStats>>();
+    ProfilingStats stats;
+    stats.rows = 2;
+    stats.execDurationInUs = 10;
+    stats.totalDurationInUs = 20;
+    stats.otherStats = std::make_unique<std::unordered_map<std::string, std::string>>();
+    stats.otherStats->emplace("version", "0");
+    desc.profiles->emplace_back(std::move(stats));
+    desc.branchInfo = std::make_unique<PlanNodeBranchInfo>();
+    desc.branchInfo->isDoBranch = true;
+    desc.branchInfo->conditionNodeId = 3;
+    desc.dependencies = std::make_unique<std::vector<int64_t>>(std::vector<int64_t>{0});
+    planDesc.planNodeDescs.emplace_back(std::move(desc));
+    PlanNodeDescription start;
+    start.name = "Start";
+    start.id = 0;
+    start.outputVar = "__Start_0";
+    planDesc.planNodeDescs.emplace_back(std::move(start));
+    planDesc.nodeIndexMap = {{1, 0}, {0, 1}};
+    planDesc.format = "row";
+    planDesc.optimize_time_in_us = 100;
+  }
+  resps.emplace_back(ExecutionResponse{ErrorCode::SUCCEEDED,
+                                       233,
+                                       std::make_unique<DataSet>(std::move(ds)),
+                                       std::make_unique<std::string>("test_space"),
+                                       nullptr,
+                                       std::make_unique<PlanDescription>(std::move(planDesc)),
+                                       std::make_unique<std::string>("comment")});
+
+  for (const auto& resp : resps) {
+    EXPECT_EQ(resp.toJson(), folly::parseJson(JsonWriter::toJson(resp)));
+  }
+}
+
+}  // namespace nebula
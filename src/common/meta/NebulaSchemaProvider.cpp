@@ -113,6 +113,10 @@ void NebulaSchemaProvider::addField(folly::StringPiece name,
     nullFlagPos = numNullableFields_++;
   }
 
+  if (type == PropertyType::STRING || type == PropertyType::GEOGRAPHY) {
+    numVarLenFields_++;
+  }
+
   fields_.emplace_back(name.toString(),
                        type,
                        nullable,
@@ -128,6 +128,12 @@ class NebulaSchemaProvider : public SchemaProviderIf {
     return numNullableFields_ != 0;
   }
 
+  // Whether all the fields are of fixed size, i.e. there is no STRING or GEOGRAPHY field, so
+  // all the rows of the schema have the same size
+  bool isFixedWidth() const {
+    return numVarLenFields_ == 0;
+  }
+
  protected:
   NebulaSchemaProvider() = default;
 
@@ -138,6 +144,7 @@ class NebulaSchemaProvider : public SchemaProviderIf {
   std::unordered_map<std::string, int64_t> fieldNameIndex_;
   std::vector<SchemaField> fields_;
   size_t numNullableFields_;
+  size_t numVarLenFields_{0};
   cpp2::SchemaProp schemaProp_;
 };
 
@@ -0,0 +1,179 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/utils/StatsUtils.h"
+
+#include <folly/hash/Hash.h>
+
+namespace nebula {
+
+void StatsUtils::Collector::add(const Value& value) {
+  if (value.isNull() || value.empty()) {
+    nullCount_++;
+    return;
+  }
+  count_++;
+
+  auto h = hash(value);
+  if (sketch_.size() < kSketchSize) {
+    sketch_.emplace(h);
+  } else if (h < *sketch_.rbegin() && sketch_.emplace(h).second) {
+    sketch_.erase(std::prev(sketch_.end()));
+  }
+
+  if (samples_.size() < kSampleSize) {
+    samples_.emplace_back(value);
+  } else {
+    // Replace a sampled one with the probability of kSampleSize/count_
+    auto i = std::uniform_int_distribution<int64_t>(0, count_ - 1)(rng_);
+    if (static_cast<size_t>(i) < kSampleSize) {
+      samples_[i] = value;
+    }
+  }
+}
+
+meta::cpp2::PropStats StatsUtils::Collector::partial() const {
+  meta::cpp2::PropStats stats;
+  stats.count_ref() = count_;
+  stats.null_count_ref() = nullCount_;
+  std::vector<int64_t> sketch;
+  sketch.reserve(sketch_.size());
+  for (auto h : sketch_) {
+    sketch.emplace_back(static_cast<int64_t>(h));
+  }
+  stats.ndv_sketch_ref() = std::move(sketch);
+  stats.samples_ref() = samples_;
+  return stats;
+}
+
+// static
+void StatsUtils::merge(meta::cpp2::PropStats& lhs, const meta::cpp2::PropStats& rhs) {
+  // The union of the sketches is the smallest hashes of both
+  std::vector<uint64_t> hashes;
+  hashes.reserve(lhs.get_ndv_sketch().size() + rhs.get_ndv_sketch().size());
+  for (auto* stats : {&lhs, &rhs}) {
+    for (auto h : stats->get_ndv_sketch()) {
+      hashes.emplace_back(static_cast<uint64_t>(h));
+    }
+  }
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  hashes.resize(std::min(hashes.size(), kSketchSize));
+  std::vector<int64_t> sketch;
+  sketch.reserve(hashes.size());
+  for (auto h : hashes) {
+    sketch.emplace_back(static_cast<int64_t>(h));
+  }
+
+  // Take the samples of both in proportion to the number of values they are sampled from
+  auto lhsSamples = lhs.get_samples();
+  auto rhsSamples = rhs.get_samples();
+  int64_t total = lhs.get_count() + rhs.get_count();
+  std::vector<Value> samples;
+  if (total > 0) {
+    size_t size = std::min(kSampleSize, lhsSamples.size() + rhsSamples.size());
+    auto fromLhs = static_cast<size_t>(std::llround(
+        static_cast<double>(size) * static_cast<double>(lhs.get_count()) / total));
+    fromLhs = std::min(fromLhs, lhsSamples.size());
+    auto fromRhs = std::min(size - fromLhs, rhsSamples.size());
+    fromLhs = std::min(size - fromRhs, lhsSamples.size());
+
+    std::mt19937_64 rng(total);
+    std::shuffle(lhsSamples.begin(), lhsSamples.end(), rng);
+    std::shuffle(rhsSamples.begin(), rhsSamples.end(), rng);
+    samples.reserve(fromLhs + fromRhs);
+    std::move(lhsSamples.begin(), lhsSamples.begin() + fromLhs, std::back_inserter(samples));
+    std::move(rhsSamples.begin(), rhsSamples.begin() + fromRhs, std::back_inserter(samples));
+  }
+
+  lhs.count_ref() = total;
+  lhs.null_count_ref() = lhs.get_null_count() + rhs.get_null_count();
+  lhs.ndv_sketch_ref() = std::move(sketch);
+  lhs.samples_ref() = std::move(samples);
+}
+
+// static
+void StatsUtils::mergeProps(meta::cpp2::StatsItem& lhs, const meta::cpp2::StatsItem& rhs) {
+  auto mergeMap = [](auto& l, const auto& r) {
+    for (auto& it : r) {
+      auto iter = l.find(it.first);
+      if (iter == l.end()) {
+        l.emplace(it.first, it.second);
+      } else {
+        merge(iter->second, it.second);
+      }
+    }
+  };
+  for (auto& it : rhs.get_tag_props()) {
+    mergeMap((*lhs.tag_props_ref())[it.first], it.second);
+  }
+  for (auto& it : rhs.get_edge_props()) {
+    mergeMap((*lhs.edge_props_ref())[it.first], it.second);
+  }
+  mergeMap(*lhs.out_degrees_ref(), rhs.get_out_degrees());
+  mergeMap(*lhs.in_degrees_ref(), rhs.get_in_degrees());
+}
+
+// static
+void StatsUtils::finalize(meta::cpp2::PropStats& stats) {
+  if (stats.get_ndv_sketch().empty() && stats.get_samples().empty()) {
+    // Finalized already, or no value at all
+    return;
+  }
+  auto& sketch = *stats.ndv_sketch_ref();
+  if (sketch.size() < kSketchSize) {
+    // All distinct hashes are kept
+    stats.ndv_ref() = static_cast<int64_t>(sketch.size());
+  } else if (!sketch.empty()) {
+    // The k-th smallest of the hashes uniformly distributed in [0, 2^64) is about k/ndv of the
+    // range
+    double kth = static_cast<double>(static_cast<uint64_t>(sketch.back())) / std::pow(2.0, 64);
+    auto ndv = static_cast<int64_t>((kSketchSize - 1) / std::max(kth, 1e-18));
+    stats.ndv_ref() = std::min(ndv, stats.get_count());
+  }
+
+  auto& samples = *stats.samples_ref();
+  std::sort(samples.begin(), samples.end());
+  std::vector<Value> histogram;
+  if (!samples.empty()) {
+    size_t n = samples.size();
+    size_t buckets = std::min(kHistogramBuckets, n);
+    histogram.reserve(buckets + 1);
+    histogram.emplace_back(samples.front());
+    for (size_t i = 1; i <= buckets; ++i) {
+      histogram.emplace_back(samples[(i * n + buckets - 1) / buckets - 1]);
+    }
+  }
+  stats.histogram_ref() = std::move(histogram);
+  stats.ndv_sketch_ref()->clear();
+  stats.samples_ref()->clear();
+}
+
+// static
+void StatsUtils::finalizeProps(meta::cpp2::StatsItem& item) {
+  for (auto& tag : *item.tag_props_ref()) {
+    for (auto& prop : tag.second) {
+      finalize(prop.second);
+    }
+  }
+  for (auto& edge : *item.edge_props_ref()) {
+    for (auto& prop : edge.second) {
+      finalize(prop.second);
+    }
+  }
+  for (auto* degrees : {&*item.out_degrees_ref(), &*item.in_degrees_ref()}) {
+    for (auto& it : *degrees) {
+      finalize(it.second);
+    }
+  }
+}
+
+// static
+uint64_t StatsUtils::hash(const Value& value) {
+  // Mix the hash since the ones of integers are themselves
+  return folly::hash::twang_mix64(std::hash<Value>()(value));
+}
+
+}  // namespace nebula
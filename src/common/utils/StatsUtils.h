@@ -0,0 +1,72 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_UTILS_STATSUTILS_H_
+#define COMMON_UTILS_STATSUTILS_H_
+
+#include <random>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "interface/gen-cpp2/meta_types.h"
+
+namespace nebula {
+
+/**
+ * @brief Utils of the property statistics collected by the stats job.
+ *
+ * Each partition is scanned by a subtask of storaged, which produces the partial statistics of
+ * a property, i.e. the k minimum values sketch of the hashes of values to estimate the number of
+ * distinct values, and a uniform sample of the values. The partial ones are mergeable, so they
+ * are merged by storaged and then by metad, and finalized into the NDV and the equi-depth
+ * histogram when the job is finished.
+ */
+class StatsUtils final {
+ public:
+  // Capacity of the k minimum values sketch
+  static constexpr size_t kSketchSize = 1024;
+  // Capacity of the sample of values
+  static constexpr size_t kSampleSize = 1024;
+  // Number of the buckets of histograms
+  static constexpr size_t kHistogramBuckets = 32;
+
+  // Accumulate the values of a property read from a partition
+  class Collector final {
+   public:
+    void add(const Value& value);
+
+    // The partial statistics of the values added
+    meta::cpp2::PropStats partial() const;
+
+   private:
+    int64_t count_{0};
+    int64_t nullCount_{0};
+    // The smallest hashes of the distinct values
+    std::set<uint64_t> sketch_;
+    // Reservoir of the values sampled
+    std::vector<Value> samples_;
+    std::mt19937_64 rng_{0};
+  };
+
+  StatsUtils() = delete;
+
+  // Merge the partial statistics
+  static void merge(meta::cpp2::PropStats& lhs, const meta::cpp2::PropStats& rhs);
+
+  // Merge the property statistics and the degree distributions of `rhs' into `lhs'
+  static void mergeProps(meta::cpp2::StatsItem& lhs, const meta::cpp2::StatsItem& rhs);
+
+  // Estimate the NDV and build the histogram, then drop the partial statistics
+  static void finalize(meta::cpp2::PropStats& stats);
+
+  static void finalizeProps(meta::cpp2::StatsItem& item);
+
+ private:
+  static uint64_t hash(const Value& value);
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_UTILS_STATSUTILS_H_
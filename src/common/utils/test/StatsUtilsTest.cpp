@@ -0,0 +1,82 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/utils/StatsUtils.h"
+
+namespace nebula {
+
+TEST(StatsUtilsTest, Exact) {
+  // Fewer distinct values than the capacity of the sketch
+  StatsUtils::Collector collector;
+  for (int64_t i = 0; i < 500; ++i) {
+    collector.add(i % 100);
+  }
+  collector.add(Value::kNullValue);
+  auto stats = collector.partial();
+  EXPECT_EQ(500, stats.get_count());
+  EXPECT_EQ(1, stats.get_null_count());
+  EXPECT_EQ(100, stats.get_ndv_sketch().size());
+  EXPECT_EQ(500, stats.get_samples().size());
+
+  StatsUtils::finalize(stats);
+  EXPECT_EQ(100, stats.get_ndv());
+  EXPECT_TRUE(stats.get_ndv_sketch().empty());
+  EXPECT_TRUE(stats.get_samples().empty());
+  const auto& histogram = stats.get_histogram();
+  ASSERT_EQ(StatsUtils::kHistogramBuckets + 1, histogram.size());
+  EXPECT_EQ(Value(0L), histogram.front());
+  EXPECT_EQ(Value(99L), histogram.back());
+  EXPECT_TRUE(std::is_sorted(histogram.begin(), histogram.end()));
+
+  // Finalized already
+  StatsUtils::finalize(stats);
+  EXPECT_EQ(100, stats.get_ndv());
+}
+
+TEST(StatsUtilsTest, Merge) {
+  // Two partitions with the overlapped values
+  StatsUtils::Collector c1, c2;
+  for (int64_t i = 0; i < 100000; ++i) {
+    c1.add(i);
+    c2.add(i + 50000);
+  }
+  auto stats = c1.partial();
+  StatsUtils::merge(stats, c2.partial());
+  EXPECT_EQ(200000, stats.get_count());
+  EXPECT_EQ(StatsUtils::kSketchSize, stats.get_ndv_sketch().size());
+  EXPECT_EQ(StatsUtils::kSampleSize, stats.get_samples().size());
+
+  StatsUtils::finalize(stats);
+  // The standard error of the estimate is about 1/sqrt(k)
+  EXPECT_NEAR(150000, stats.get_ndv(), 150000 * 0.1);
+  const auto& histogram = stats.get_histogram();
+  ASSERT_EQ(StatsUtils::kHistogramBuckets + 1, histogram.size());
+  EXPECT_GE(histogram.front().getInt(), 0);
+  EXPECT_LE(histogram.back().getInt(), 149999);
+  // The median
+  EXPECT_NEAR(75000, histogram[StatsUtils::kHistogramBuckets / 2].getInt(), 10000);
+}
+
+TEST(StatsUtilsTest, MergeProps) {
+  StatsUtils::Collector collector;
+  collector.add(1L);
+  meta::cpp2::StatsItem lhs, rhs;
+  (*lhs.tag_props_ref())["player"].emplace("age", collector.partial());
+  (*rhs.tag_props_ref())["player"].emplace("age", collector.partial());
+  (*rhs.tag_props_ref())["team"].emplace("name", collector.partial());
+  (*rhs.out_degrees_ref()).emplace("serve", collector.partial());
+
+  StatsUtils::mergeProps(lhs, rhs);
+  StatsUtils::finalizeProps(lhs);
+  EXPECT_EQ(2, lhs.get_tag_props().at("player").at("age").get_count());
+  EXPECT_EQ(1, lhs.get_tag_props().at("player").at("age").get_ndv());
+  EXPECT_EQ(1, lhs.get_tag_props().at("team").at("name").get_count());
+  EXPECT_EQ(1, lhs.get_out_degrees().at("serve").get_ndv());
+}
+
+}  // namespace nebula
@@ -0,0 +1,178 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/Column.h"
+
+#include <cmath>
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+bool isPlainNull(const Value& v) {
+  return v.isNull() && v.getNull() == NullType::__NULL__;
+}
+
+template <typename T>
+int threeWay(const T& lhs, const T& rhs) {
+  return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
+}  // namespace
+
+// static
+template <typename Rows>
+bool Column::build(Rows&& rows, size_t index, bool typedOnly, Column* col) {
+  constexpr bool kMovable = !std::is_lvalue_reference<Rows>::value;
+  auto size = rows.size();
+  col->size_ = size;
+  col->nulls_.resize(size);
+  // Type of the non-null cells, which is unknown until the first one
+  auto type = Value::Type::__EMPTY__;
+  size_t i = 0;
+  for (; i < size; ++i) {
+    DCHECK_LT(index, rows[i].size());
+    auto& cell = rows[i].values[index];
+    if (isPlainNull(cell)) {
+      col->nulls_.set(i);
+      continue;
+    }
+    if (cell.type() != type) {
+      if (type != Value::Type::__EMPTY__) {
+        break;
+      }
+      type = cell.type();
+      if (type == Value::Type::BOOL) {
+        col->type_ = Type::kBool;
+        col->bools_.resize(size, 0);
+      } else if (type == Value::Type::INT) {
+        col->type_ = Type::kInt;
+        col->ints_.resize(size, 0);
+      } else if (type == Value::Type::FLOAT) {
+        col->type_ = Type::kFloat;
+        col->floats_.resize(size, 0.0);
+      } else {
+        break;
+      }
+    }
+    col->store(i, cell);
+  }
+  if (i == size && col->isTyped()) {
+    return true;
+  }
+  if (typedOnly) {
+    return false;
+  }
+
+  // Fall back to the generic column, the cells before `i' are all NULL or of the typed column
+  std::vector<Value> values;
+  values.reserve(size);
+  for (size_t j = 0; j < i; ++j) {
+    values.emplace_back(col->nulls_.test(j) ? Value::kNullValue : col->value(j));
+  }
+  for (; i < size; ++i) {
+    if (kMovable) {
+      values.emplace_back(std::move(rows[i].values[index]));
+    } else {
+      values.emplace_back(rows[i].values[index]);
+    }
+  }
+  *col = Column();
+  col->size_ = size;
+  col->values_ = std::move(values);
+  return true;
+}
+
+void Column::store(size_t i, const Value& cell) {
+  switch (type_) {
+    case Type::kBool:
+      bools_[i] = cell.getBool();
+      break;
+    case Type::kInt:
+      ints_[i] = cell.getInt();
+      break;
+    case Type::kFloat:
+      floats_[i] = cell.getFloat();
+      break;
+    case Type::kValue:
+      break;
+  }
+}
+
+// static
+Column Column::fromRows(const std::vector<Row>& rows, size_t index) {
+  Column col;
+  build(rows, index, false, &col);
+  return col;
+}
+
+// static
+Column Column::fromRows(std::vector<Row>&& rows, size_t index) {
+  Column col;
+  build(std::move(rows), index, false, &col);
+  return col;
+}
+
+// static
+bool Column::typedFromRows(const std::vector<Row>& rows, size_t index, Column* col) {
+  *col = Column();
+  return build(rows, index, true, col);
+}
+
+Value Column::value(size_t i) const {
+  DCHECK_LT(i, size_);
+  if (isTyped() && nulls_.test(i)) {
+    return Value::kNullValue;
+  }
+  switch (type_) {
+    case Type::kBool:
+      return Value(static_cast<bool>(bools_[i]));
+    case Type::kInt:
+      return Value(ints_[i]);
+    case Type::kFloat:
+      return Value(floats_[i]);
+    case Type::kValue:
+      return values_[i];
+  }
+  return Value::kEmpty;
+}
+
+int Column::compare(size_t lhs, size_t rhs) const {
+  if (type_ == Type::kValue) {
+    auto& l = values_[lhs];
+    auto& r = values_[rhs];
+    if (l == r) {
+      return 0;
+    }
+    return l < r ? -1 : 1;
+  }
+  // NULL is the greatest one in the order of Value
+  bool lNull = nulls_.test(lhs);
+  bool rNull = nulls_.test(rhs);
+  if (lNull || rNull) {
+    return static_cast<int>(lNull) - static_cast<int>(rNull);
+  }
+  switch (type_) {
+    case Type::kBool:
+      return threeWay(bools_[lhs], bools_[rhs]);
+    case Type::kInt:
+      return threeWay(ints_[lhs], ints_[rhs]);
+    case Type::kFloat: {
+      auto l = floats_[lhs];
+      auto r = floats_[rhs];
+      if (std::abs(l - r) < kEpsilon) {
+        return 0;
+      }
+      return l < r ? -1 : 1;
+    }
+    case Type::kValue:
+      break;
+  }
+  return 0;
+}
+
+}  // namespace graph
+}  // namespace nebula
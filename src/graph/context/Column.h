@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_COLUMN_H_
+#define GRAPH_CONTEXT_COLUMN_H_
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// A column of cells taken from the rows of a DataSet.
+//
+// Columns whose cells are all BOOL, all INT or all FLOAT (plus plain NULLs) are kept unboxed in a
+// typed vector with a null bitmap, so that operators could work on them without touching any
+// `Value'. Every other column, e.g. mixed types, strings, vertices or the special NULL kinds like
+// BAD_TYPE, falls back to a vector of `Value'.
+class Column final {
+ public:
+  enum class Type : uint8_t {
+    kBool,
+    kInt,
+    kFloat,
+    kValue,
+  };
+
+  // Build column from the `index'-th cell of each row, the type is detected while the cells are
+  // copied, and the cells copied already are boxed once a cell doesn't fit the typed column
+  static Column fromRows(const std::vector<Row>& rows, size_t index);
+
+  // Same as above but move the cells of the generic column out of rows
+  static Column fromRows(std::vector<Row>&& rows, size_t index);
+
+  // Build the typed column of the `index'-th cell of each row, return false as soon as a cell
+  // doesn't fit it, or all cells are NULL
+  static bool typedFromRows(const std::vector<Row>& rows, size_t index, Column* col);
+
+  Type type() const {
+    return type_;
+  }
+
+  bool isTyped() const {
+    return type_ != Type::kValue;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool isNull(size_t i) const {
+    return isTyped() ? nulls_.test(i) : values_[i].isNull();
+  }
+
+  const std::vector<uint8_t>& bools() const {
+    DCHECK(type_ == Type::kBool);
+    return bools_;
+  }
+
+  const std::vector<int64_t>& ints() const {
+    DCHECK(type_ == Type::kInt);
+    return ints_;
+  }
+
+  const std::vector<double>& floats() const {
+    DCHECK(type_ == Type::kFloat);
+    return floats_;
+  }
+
+  const std::vector<Value>& values() const {
+    DCHECK(type_ == Type::kValue);
+    return values_;
+  }
+
+  // Box the i-th cell into Value
+  Value value(size_t i) const;
+
+  // Three-way comparison of two cells in this column, which is consistent with
+  // `operator==' and `operator<' of Value, NULL is greater than any other value.
+  int compare(size_t lhs, size_t rhs) const;
+
+ private:
+  // Return false if the cells don't fit a typed column and `typedOnly'
+  template <typename Rows>
+  static bool build(Rows&& rows, size_t index, bool typedOnly, Column* col);
+
+  void store(size_t i, const Value& cell);
+
+  Type type_{Type::kValue};
+  size_t size_{0};
+  boost::dynamic_bitset<> nulls_;
+  std::vector<uint8_t> bools_;
+  std::vector<int64_t> ints_;
+  std::vector<double> floats_;
+  std::vector<Value> values_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_COLUMN_H_
@@ -0,0 +1,31 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/ColumnarBatch.h"
+
+#include <numeric>
+
+namespace nebula {
+namespace graph {
+
+ColumnarBatch::ColumnarBatch(const std::vector<Row>* rows)
+    : rows_(DCHECK_NOTNULL(rows)), selection_(rows->size()) {
+  std::iota(selection_.begin(), selection_.end(), 0);
+}
+
+const Column* ColumnarBatch::typedColumn(size_t index) {
+  auto iter = columns_.find(index);
+  if (iter != columns_.end()) {
+    return iter->second.get();
+  }
+  auto col = std::make_unique<Column>();
+  if (!Column::typedFromRows(*rows_, index, col.get())) {
+    col.reset();
+  }
+  return columns_.emplace(index, std::move(col)).first->second.get();
+}
+
+}  // namespace graph
+}  // namespace nebula
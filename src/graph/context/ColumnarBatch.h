@@ -0,0 +1,64 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_COLUMNARBATCH_H_
+#define GRAPH_CONTEXT_COLUMNARBATCH_H_
+
+#include "graph/context/Column.h"
+
+namespace nebula {
+namespace graph {
+
+// The rows of a DataSet viewed column by column, with a selection vector of the rows which are
+// still alive.
+//
+// The typed columns are built from the rows on demand, once for each column, so an operator only
+// converts the columns it reads. The rows are converted back at the boundary by keeping the
+// selected ones, e.g. by SequentialIter::keep(). The rows must outlive the batch and must not be
+// changed while it's used.
+class ColumnarBatch final {
+ public:
+  // All rows are selected at first
+  explicit ColumnarBatch(const std::vector<Row>* rows);
+
+  size_t numRows() const {
+    return rows_->size();
+  }
+
+  const std::vector<Row>& rows() const {
+    return *rows_;
+  }
+
+  // Ascending indices of the selected rows
+  const std::vector<size_t>& selection() const {
+    return selection_;
+  }
+
+  // Keep the selected rows which satisfy `pred(row index)', in order
+  template <typename Pred>
+  void refine(Pred&& pred) {
+    size_t size = 0;
+    for (auto i : selection_) {
+      if (pred(i)) {
+        selection_[size++] = i;
+      }
+    }
+    selection_.resize(size);
+  }
+
+  // The typed column of the `index'-th cells, nullptr if the cells don't fit a typed column
+  const Column* typedColumn(size_t index);
+
+ private:
+  const std::vector<Row>* rows_{nullptr};
+  std::vector<size_t> selection_;
+  // Column index -> the typed column, or nullptr if it's not typed
+  std::unordered_map<size_t, std::unique_ptr<Column>> columns_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_COLUMNARBATCH_H_
@@ -59,6 +59,9 @@ Value ExecutionContext::moveValue(const std::string& name) {
 }
 
 const Result& ExecutionContext::getResult(const std::string& name) const {
+  if (UNLIKELY(recordReads_)) {
+    hasReads_ = true;
+  }
   auto it = valueMap_.find(name);
   if (it != valueMap_.end() && !it->second.empty()) {
     return it->second.back();
@@ -78,6 +81,9 @@ const Result& ExecutionContext::getVersionedResult(const std::string& name, int6
 }
 
 const std::vector<Result>& ExecutionContext::getHistory(const std::string& name) const {
+  if (UNLIKELY(recordReads_)) {
+    hasReads_ = true;
+  }
   auto it = valueMap_.find(name);
   if (it != valueMap_.end()) {
     return it->second;
@@ -86,5 +92,30 @@ const std::vector<Result>& ExecutionContext::getHistory(const std::string& name)
   }
 }
 
+Value::Type ExecutionContext::type(const std::string& name) const {
+  auto it = valueMap_.find(name);
+  if (it != valueMap_.end() && !it->second.empty()) {
+    return it->second.back().value().type();
+  }
+  return Value::Type::__EMPTY__;
+}
+
+void ExecutionContext::copyTo(ExecutionContext* ectx) const {
+  for (auto& kv : valueMap_) {
+    if (ectx->exist(kv.first)) {
+      continue;
+    }
+    auto& hist = ectx->valueMap_[kv.first];
+    hist.reserve(kv.second.size());
+    for (auto& result : kv.second) {
+      hist.emplace_back(ResultBuilder()
+                            .value(Value(result.value()))
+                            .iter(result.core_.iter->kind())
+                            .state(result.state())
+                            .build());
+    }
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -70,12 +70,35 @@ class ExecutionContext {
     return valueMap_.find(name) != valueMap_.end();
   }
 
+  // Type of the latest version of the value, which is not recorded as a read
+  Value::Type type(const std::string& name) const;
+
+  // Record whether any value is read. Before the execution, only the parameters and the
+  // constants written by the planner could be read, so a plan doesn't depend on the values of
+  // parameters if nothing is read during the planning. Stopping the record keeps `hasReads'.
+  void recordReads(bool record) {
+    recordReads_ = record;
+    if (record) {
+      hasReads_ = false;
+    }
+  }
+
+  bool hasReads() const {
+    return hasReads_;
+  }
+
+  // Deep copy the values of variables which don't exist in `ectx', with the iterators of the same
+  // kinds
+  void copyTo(ExecutionContext* ectx) const;
+
  private:
   friend class QueryInstance;
   Value moveValue(const std::string& name);
 
   // name -> Value with multiple versions
   std::unordered_map<std::string, std::vector<Result>> valueMap_;
+  bool recordReads_{false};
+  mutable bool hasReads_{false};
 };
 
 }  // namespace graph
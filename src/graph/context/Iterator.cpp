@@ -5,6 +5,8 @@
 
 #include "graph/context/Iterator.h"
 
+#include <atomic>
+
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Vertex.h"
 #include "common/memory/MemoryUtils.h"
@@ -425,6 +427,85 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge, const std::s
   return currentEdge_->values[propIndex->second];
 }
 
+int64_t GetNeighborsIter::bindTagProp(const std::string& tag, const std::string& prop) {
+  for (auto& dsIndex : dsIndices_) {
+    std::vector<std::pair<size_t, size_t>> slot;
+    for (auto& index : dsIndex.tagPropsMap) {
+      if (tag != "*" && index.first != tag) {
+        continue;
+      }
+      auto propIndex = index.second.propIndices.find(prop);
+      if (propIndex != index.second.propIndices.end()) {
+        slot.emplace_back(index.second.colIdx, propIndex->second);
+      }
+    }
+    dsIndex.tagPropSlots.emplace_back(std::move(slot));
+  }
+  return numTagPropSlots_++;
+}
+
+int64_t GetNeighborsIter::bindEdgeProp(const std::string& edge, const std::string& prop) {
+  for (auto& dsIndex : dsIndices_) {
+    std::vector<int64_t> slot(dsIndex.ds->colNames.size(), -1);
+    for (auto& index : dsIndex.edgePropsMap) {
+      // The first character of the edge name is +/-.
+      if (edge != "*" && index.first.compare(1, std::string::npos, edge) != 0) {
+        continue;
+      }
+      auto propIndex = index.second.propIndices.find(prop);
+      if (propIndex != index.second.propIndices.end()) {
+        slot[index.second.colIdx] = propIndex->second;
+      }
+    }
+    dsIndex.edgePropSlots.emplace_back(std::move(slot));
+  }
+  return numEdgePropSlots_++;
+}
+
+const Value& GetNeighborsIter::getTagPropBySlot(int64_t slot) const {
+  if (!valid()) {
+    return Value::kNullValue;
+  }
+  DCHECK_LT(static_cast<size_t>(slot), currentDs_->tagPropSlots.size());
+  auto& row = *currentRow_;
+  // Same as `getTagProp', the first non-empty value of the matched tags
+  for (auto& [colId, propId] : currentDs_->tagPropSlots[slot]) {
+    DCHECK_GT(row.size(), colId);
+    if (row[colId].empty()) {
+      continue;
+    }
+    if (!row[colId].isList()) {
+      return Value::kNullBadType;
+    }
+    auto& val = row[colId].getList().values[propId];
+    if (!val.empty()) {
+      return val;
+    }
+  }
+  return Value::kEmpty;
+}
+
+const Value& GetNeighborsIter::getEdgePropBySlot(int64_t slot) const {
+  if (!valid()) {
+    return Value::kNullValue;
+  }
+  if (noEdge_) {
+    return Value::kEmpty;
+  }
+  DCHECK_LT(static_cast<size_t>(slot), currentDs_->edgePropSlots.size());
+  auto propId = currentDs_->edgePropSlots[slot][colIdx_];
+  if (propId < 0) {
+    return Value::kEmpty;
+  }
+  return currentEdge_->values[propId];
+}
+
+// static
+uint64_t GetNeighborsIter::newPropSlotsId() {
+  static std::atomic<uint64_t> propSlotsId{0};
+  return ++propSlotsId;
+}
+
 Value GetNeighborsIter::getVertex(const std::string& name) const {
   UNUSED(name);
   if (!valid()) {
@@ -667,6 +748,20 @@ void SequentialIter::eraseRange(size_t first, size_t last) {
   reset();
 }
 
+void SequentialIter::keep(const std::vector<size_t>& selection) {
+  DCHECK_LE(selection.size(), size());
+  size_t size = 0;
+  for (auto i : selection) {
+    DCHECK(size == 0 || selection[size - 1] < i);
+    if (i != size) {
+      (*rows_)[size] = std::move((*rows_)[i]);
+    }
+    ++size;
+  }
+  rows_->resize(size);
+  reset();
+}
+
 void SequentialIter::doReset(size_t pos) {
   DCHECK((pos == 0 && size() == 0) || (pos < size()));
   iter_ = rows_->begin() + pos;
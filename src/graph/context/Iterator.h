@@ -142,6 +142,33 @@ class Iterator {
     return Value::kEmpty;
   }
 
+  // Identity of the tag and edge property slots bound to the iterator, 0 if the iterator doesn't
+  // support property slots. See ExpressionContext::propSlotsId.
+  virtual uint64_t propSlotsId() const {
+    return 0;
+  }
+
+  // Resolve the property to a slot once, which is read at each row without looking up the names
+  virtual int64_t bindTagProp(const std::string&, const std::string&) {
+    DLOG(FATAL) << "Shouldn't call the unimplemented method";
+    return -1;
+  }
+
+  virtual int64_t bindEdgeProp(const std::string&, const std::string&) {
+    DLOG(FATAL) << "Shouldn't call the unimplemented method";
+    return -1;
+  }
+
+  virtual const Value& getTagPropBySlot(int64_t) const {
+    DLOG(FATAL) << "Shouldn't call the unimplemented method";
+    return Value::kEmpty;
+  }
+
+  virtual const Value& getEdgePropBySlot(int64_t) const {
+    DLOG(FATAL) << "Shouldn't call the unimplemented method";
+    return Value::kEmpty;
+  }
+
   virtual Value getVertex(const std::string& name = "") const {
     UNUSED(name);
     return Value();
@@ -250,6 +277,8 @@ class GetNeighborsIter final : public Iterator {
 
   std::unique_ptr<Iterator> copy() const override {
     auto copy = std::make_unique<GetNeighborsIter>(*this);
+    // The slots bound to the copy diverge from the ones of this iterator
+    copy->propSlotsId_ = newPropSlotsId();
     copy->reset();
     return copy;
   }
@@ -309,6 +338,18 @@ class GetNeighborsIter final : public Iterator {
 
   const Value& getEdgeProp(const std::string& edge, const std::string& prop) const override;
 
+  uint64_t propSlotsId() const override {
+    return propSlotsId_;
+  }
+
+  int64_t bindTagProp(const std::string& tag, const std::string& prop) override;
+
+  int64_t bindEdgeProp(const std::string& edge, const std::string& prop) override;
+
+  const Value& getTagPropBySlot(int64_t slot) const override;
+
+  const Value& getEdgePropBySlot(int64_t slot) const override;
+
   Value getVertex(const std::string& name = "") const override;
 
   Value getEdge() const override;
@@ -369,6 +410,10 @@ class GetNeighborsIter final : public Iterator {
     std::unordered_map<std::string, PropIndex> tagPropsMap;
     // _edge:e1:p1:p2  ->  {e1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
     std::unordered_map<std::string, PropIndex> edgePropsMap;
+    // tag property slot  ->  [(column_idx, prop_idx)] of the matched tags
+    std::vector<std::vector<std::pair<size_t, size_t>>> tagPropSlots;
+    // edge property slot  ->  {column_idx : prop_idx}, -1 if the edge of the column isn't matched
+    std::vector<std::vector<int64_t>> edgePropSlots;
 
     int64_t colLowerBound{-1};
     int64_t colUpperBound{-1};
@@ -387,6 +432,8 @@ class GetNeighborsIter final : public Iterator {
 
   StatusOr<DataSetIndex> makeDataSetIndex(const DataSet& ds);
 
+  static uint64_t newPropSlotsId();
+
   FRIEND_TEST(IteratorTest, TestHead);
 
   bool valid_{false};
@@ -407,6 +454,10 @@ class GetNeighborsIter final : public Iterator {
 
   boost::dynamic_bitset<> bitset_;
   int64_t bitIdx_{-1};
+
+  uint64_t propSlotsId_{newPropSlotsId()};
+  int64_t numTagPropSlots_{0};
+  int64_t numEdgePropSlots_{0};
 };
 
 class SequentialIter : public Iterator {
@@ -435,6 +486,10 @@ class SequentialIter : public Iterator {
 
   void eraseRange(size_t first, size_t last) override;
 
+  // Keep the rows of the ascending indices only, in order, e.g. the selection of a
+  // ColumnarBatch over the rows
+  void keep(const std::vector<size_t>& selection);
+
   void select(std::size_t offset, std::size_t count) override {
     auto size = this->size();
     if (size <= static_cast<size_t>(offset)) {
@@ -500,6 +555,9 @@ class SequentialIter : public Iterator {
   friend class AppendVerticesExecutor;
   friend class TraverseExecutor;
   friend class ShortestPathExecutor;
+  friend class SortExecutor;
+  friend class FilterExecutor;
+  friend class AggregateExecutor;
 
   void doReset(size_t pos) override;
 
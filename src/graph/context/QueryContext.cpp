@@ -31,15 +31,31 @@ void QueryContext::init() {
   objPool_ = std::make_unique<ObjectPool>();
   ep_ = std::make_unique<ExecutionPlan>();
   ectx_ = std::make_unique<ExecutionContext>();
+  initParameters();
+  idGen_ = std::make_unique<IdGenerator>(0);
+  symTable_ = std::make_unique<SymbolTable>(objPool_.get());
+  vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
+}
+
+void QueryContext::initParameters() {
   // copy parameterMap into ExecutionContext
   if (rctx_) {
     for (auto item : rctx_->parameterMap()) {
       ectx_->setValue(std::move(item.first), std::move(item.second));
     }
   }
-  idGen_ = std::make_unique<IdGenerator>(0);
-  symTable_ = std::make_unique<SymbolTable>(objPool_.get());
-  vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
+}
+
+void QueryContext::reset(RequestContextPtr rctx, const ExecutionContext* constants) {
+  rctx_ = std::move(rctx);
+  ectx_ = std::make_unique<ExecutionContext>();
+  initParameters();
+  if (constants != nullptr) {
+    constants->copyTo(ectx_.get());
+  }
+  ep_->renewId();
+  symTable_->resetUserCounts();
+  killed_.store(false);
 }
 
 }  // namespace graph
@@ -137,12 +137,18 @@ class QueryContext {
   }
 
   bool existParameter(const std::string& param) const {
-    return ectx_->exist(param) && (ectx_->getValue(param).type() != Value::Type::DATASET);
+    return ectx_->exist(param) && (ectx_->type(param) != Value::Type::DATASET);
   }
 
+  // Reset the states of execution to run the compiled plan again for another request, with the
+  // variables written by the planner restored from `constants'
+  void reset(RequestContextPtr rctx, const ExecutionContext* constants);
+
  private:
   void init();
 
+  void initParameters();
+
   RequestContextPtr rctx_;
   std::unique_ptr<ValidateContext> vctx_;
   std::unique_ptr<ExecutionContext> ectx_;
@@ -45,6 +45,26 @@ Value QueryExpressionContext::getEdgeProp(const std::string& edge, const std::st
   return iter_->getEdgeProp(edge, prop);
 }
 
+int64_t QueryExpressionContext::bindTagProp(const std::string& tag, const std::string& prop) {
+  DCHECK(iter_ != nullptr);
+  return iter_->bindTagProp(tag, prop);
+}
+
+int64_t QueryExpressionContext::bindEdgeProp(const std::string& edge, const std::string& prop) {
+  DCHECK(iter_ != nullptr);
+  return iter_->bindEdgeProp(edge, prop);
+}
+
+Value QueryExpressionContext::getTagPropBySlot(int64_t slot) const {
+  DCHECK(iter_ != nullptr);
+  return iter_->getTagPropBySlot(slot);
+}
+
+Value QueryExpressionContext::getEdgePropBySlot(int64_t slot) const {
+  DCHECK(iter_ != nullptr);
+  return iter_->getEdgePropBySlot(slot);
+}
+
 Value QueryExpressionContext::getSrcProp(const std::string& tag, const std::string& prop) const {
   if (iter_ == nullptr) {
     return Value::kEmpty;
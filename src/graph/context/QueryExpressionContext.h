@@ -47,6 +47,18 @@ class QueryExpressionContext final : public ExpressionContext {
   // Get the value by column index
   Value getColumn(int32_t index) const override;
 
+  uint64_t propSlotsId() const override {
+    return iter_ == nullptr ? 0 : iter_->propSlotsId();
+  }
+
+  int64_t bindTagProp(const std::string& tag, const std::string& prop) override;
+
+  int64_t bindEdgeProp(const std::string& edge, const std::string& prop) override;
+
+  Value getTagPropBySlot(int64_t slot) const override;
+
+  Value getEdgePropBySlot(int64_t slot) const override;
+
   // Get Vertex
   Value getVertex(const std::string& name = "") const override;
 
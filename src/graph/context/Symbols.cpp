@@ -116,6 +116,12 @@ Variable* SymbolTable::getVar(const std::string& varName) {
   }
 }
 
+void SymbolTable::resetUserCounts() {
+  for (auto& var : vars_) {
+    var.second->userCount.store(0, std::memory_order_relaxed);
+  }
+}
+
 void SymbolTable::setAliasGeneratedBy(const std::vector<std::string>& aliases,
                                       const std::string& varName) {
   for (auto& alias : aliases) {
@@ -72,6 +72,9 @@ class SymbolTable final {
 
   Variable* getVar(const std::string& varName);
 
+  // Clear the user counts left by the last execution
+  void resetUserCounts();
+
   void setAliasGeneratedBy(const std::vector<std::string>& aliases, const std::string& varName);
 
   StatusOr<std::string> getAliasGeneratedBy(const std::string& alias);
@@ -7,6 +7,8 @@
 
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Vertex.h"
+#include "graph/context/Column.h"
+#include "graph/context/ColumnarBatch.h"
 #include "graph/context/Iterator.h"
 
 namespace nebula {
@@ -515,6 +517,39 @@ TEST(IteratorTest, GetNeighbor) {
     result = iter.getEdges();
     EXPECT_EQ(result.values.size(), 40);
   }
+  // property slots
+  {
+    GetNeighborsIter iter(val);
+    std::vector<std::pair<std::string, std::string>> tagProps = {
+        {"tag1", "prop1"}, {"tag2", "prop2"}, {"*", "prop2"}, {"tag1", "none"}, {"none", "prop1"}};
+    std::vector<std::pair<std::string, std::string>> edgeProps = {{"edge1", "prop1"},
+                                                                  {"edge2", "_dst"},
+                                                                  {"*", "_rank"},
+                                                                  {"edge1", "none"},
+                                                                  {"none", "prop1"}};
+    std::vector<int64_t> tagSlots, edgeSlots;
+    for (auto& [tag, prop] : tagProps) {
+      tagSlots.emplace_back(iter.bindTagProp(tag, prop));
+    }
+    for (auto& [edge, prop] : edgeProps) {
+      edgeSlots.emplace_back(iter.bindEdgeProp(edge, prop));
+    }
+    size_t count = 0;
+    for (; iter.valid(); iter.next()) {
+      for (size_t i = 0; i < tagProps.size(); ++i) {
+        EXPECT_EQ(iter.getTagPropBySlot(tagSlots[i]),
+                  iter.getTagProp(tagProps[i].first, tagProps[i].second));
+      }
+      for (size_t i = 0; i < edgeProps.size(); ++i) {
+        EXPECT_EQ(iter.getEdgePropBySlot(edgeSlots[i]),
+                  iter.getEdgeProp(edgeProps[i].first, edgeProps[i].second));
+      }
+      ++count;
+    }
+    EXPECT_EQ(count, 40);
+    EXPECT_NE(iter.propSlotsId(), 0);
+    EXPECT_NE(iter.copy()->propSlotsId(), iter.propSlotsId());
+  }
 }
 
 TEST(IteratorTest, TestHead) {
@@ -836,6 +871,87 @@ TEST(IteratorTest, EraseBySwap) {
   }
   EXPECT_EQ(result, expected);
 }
+
+TEST(IteratorTest, Column) {
+  std::vector<Row> rows;
+  for (auto i = 0; i < 10; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    row.values.emplace_back(folly::to<std::string>(i));
+    if (i % 3 == 0) {
+      row.values.emplace_back(Value::kNullValue);
+    } else {
+      row.values.emplace_back(i * 1.5);
+    }
+    rows.emplace_back(std::move(row));
+  }
+  {
+    auto ints = Column::fromRows(rows, 0);
+    auto strs = Column::fromRows(rows, 1);
+    auto floats = Column::fromRows(rows, 2);
+    EXPECT_EQ(ints.type(), Column::Type::kInt);
+    EXPECT_EQ(strs.type(), Column::Type::kValue);
+    EXPECT_EQ(floats.type(), Column::Type::kFloat);
+    EXPECT_EQ(floats.size(), 10);
+    EXPECT_TRUE(floats.isNull(0));
+    EXPECT_FALSE(floats.isNull(1));
+    EXPECT_EQ(floats.value(0), Value::kNullValue);
+    EXPECT_EQ(floats.value(2), Value(3.0));
+    EXPECT_EQ(strs.value(4), Value("4"));
+    EXPECT_LT(ints.compare(1, 2), 0);
+    EXPECT_GT(floats.compare(3, 2), 0);
+    EXPECT_EQ(floats.compare(3, 6), 0);
+  }
+  {
+    std::vector<Row> mixed;
+    mixed.emplace_back(Row({Value::kNullValue}));
+    mixed.emplace_back(Row({1}));
+    mixed.emplace_back(Row({2.0}));
+    mixed.emplace_back(Row({Value::kNullBadType}));
+    Column typed;
+    EXPECT_FALSE(Column::typedFromRows(mixed, 0, &typed));
+    // The cells before the FLOAT one are boxed back
+    auto col = Column::fromRows(mixed, 0);
+    EXPECT_EQ(col.type(), Column::Type::kValue);
+    EXPECT_EQ(col.values(),
+              std::vector<Value>({Value::kNullValue, 1, 2.0, Value::kNullBadType}));
+  }
+  {
+    std::vector<Row> nulls(3, Row({Value::kNullValue}));
+    Column typed;
+    EXPECT_FALSE(Column::typedFromRows(nulls, 0, &typed));
+    EXPECT_EQ(Column::fromRows(nulls, 0).type(), Column::Type::kValue);
+  }
+}
+
+TEST(IteratorTest, ColumnarBatch) {
+  DataSet ds({"int", "str"});
+  for (auto i = 0; i < 10; ++i) {
+    ds.rows.emplace_back(Row({i, folly::to<std::string>(i)}));
+  }
+  SequentialIter iter(std::make_shared<Value>(std::move(ds)));
+  ColumnarBatch batch(&iter.valuePtr()->getDataSet().rows);
+  EXPECT_EQ(batch.selection().size(), 10);
+  auto* ints = batch.typedColumn(0);
+  ASSERT_NE(ints, nullptr);
+  EXPECT_EQ(ints->type(), Column::Type::kInt);
+  // Built once
+  EXPECT_EQ(batch.typedColumn(0), ints);
+  EXPECT_EQ(batch.typedColumn(1), nullptr);
+
+  batch.refine([ints](size_t i) { return ints->ints()[i] % 3 == 0; });
+  EXPECT_EQ(batch.selection(), std::vector<size_t>({0, 3, 6, 9}));
+  batch.refine([ints](size_t i) { return ints->ints()[i] > 0; });
+  EXPECT_EQ(batch.selection(), std::vector<size_t>({3, 6, 9}));
+
+  // Back to the rows
+  iter.keep(batch.selection());
+  std::vector<Value> strs;
+  for (; iter.valid(); iter.next()) {
+    strs.emplace_back(iter.getColumn("str"));
+  }
+  EXPECT_EQ(strs, std::vector<Value>({"3", "6", "9"}));
+}
 }  // namespace graph
 }  // namespace nebula
 
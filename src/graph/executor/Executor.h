@@ -60,6 +60,11 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
     return successors_;
   }
 
+  // Stats of the last execution other than rows and time, e.g. whether it spilled
+  const std::unordered_map<std::string, std::string> &otherStats() const {
+    return otherStats_;
+  }
+
   Executor *dependsOn(Executor *dep) {
     depends_.emplace(dep);
     dep->successors_.emplace(this);
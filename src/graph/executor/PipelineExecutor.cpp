@@ -0,0 +1,134 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/PipelineExecutor.h"
+
+#include <folly/String.h>
+
+#include "graph/context/Iterator.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/service/GraphFlags.h"
+
+DECLARE_bool(enable_lifetime_optimize);
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> PipelineExecutor::execute() {
+  if (downstream_ != nullptr) {
+    // Executed by the last executor of the pipeline
+    otherStats_.emplace("fused_into", folly::to<std::string>(downstream_->id()));
+    return Status::OK();
+  }
+  if (upstream_ != nullptr) {
+    return executePipeline();
+  }
+  return executeAll();
+}
+
+// static
+void PipelineExecutor::fuse(Executor *exe) {
+  auto *downstream = dynamic_cast<PipelineExecutor *>(exe);
+  if (downstream == nullptr || downstream->upstream_ != nullptr ||
+      downstream->depends().size() != 1) {
+    return;
+  }
+  auto *upstream = dynamic_cast<PipelineExecutor *>(*downstream->depends().begin());
+  if (upstream == nullptr || upstream->successors().size() != 1) {
+    return;
+  }
+  auto *node = downstream->node();
+  auto *upstreamNode = upstream->node();
+  // The lifetime of the variables in loop body is managed by Loop node
+  if (node->loopLayers() != 0 || upstreamNode->loopLayers() != 0) {
+    return;
+  }
+  auto *var = upstreamNode->outputVarPtr();
+  if (node->inputVar() != var->name || var->readBy.size() != 1) {
+    return;
+  }
+  downstream->upstream_ = upstream;
+  upstream->downstream_ = downstream;
+}
+
+folly::Future<Status> PipelineExecutor::executePipeline() {
+  std::vector<PipelineExecutor *> stages;
+  for (auto *stage = this; stage != nullptr; stage = stage->upstream_) {
+    stages.emplace_back(stage);
+  }
+  std::reverse(stages.begin(), stages.end());
+
+  auto *first = stages.front();
+  auto *inputVar = first->node()->inputVarPtr();
+  Result result = ectx_->getResult(inputVar->name);
+  auto iter = result.iter();
+  if (!iter->isSequentialIter() || result.valuePtr()->type() != Value::Type::DATASET) {
+    return executeStages(stages);
+  }
+
+  SCOPED_TIMER(&execTime_);
+  std::vector<std::string> names;
+  names.reserve(stages.size());
+  for (auto *stage : stages) {
+    NG_RETURN_IF_ERROR(stage->openBatch());
+    names.emplace_back(stage->name());
+  }
+  otherStats_.emplace("pipeline", folly::join("->", names));
+
+  const auto &colNames = result.valuePtr()->getDataSet().colNames;
+  bool mv = first->movable(inputVar);
+  size_t batchSize = std::max<size_t>(FLAGS_pipeline_batch_size, 1);
+  size_t numBatches = 0;
+  DataSet ds;
+  ds.colNames = node()->colNames();
+  bool done = false;
+  while (iter->valid() && !done) {
+    DataSet batch;
+    batch.colNames = colNames;
+    batch.rows.reserve(std::min(batchSize, iter->size()));
+    for (size_t i = 0; i < batchSize && iter->valid(); ++i, iter->next()) {
+      batch.rows.emplace_back(mv ? iter->moveRow() : *iter->row());
+    }
+    ++numBatches;
+    for (auto *stage : stages) {
+      DataSet output;
+      output.colNames = batch.colNames;
+      SequentialIter input(std::make_shared<Value>(std::move(batch)));
+      bool stageDone = false;
+      NG_RETURN_IF_ERROR(stage->processBatch(&input, &output, &stageDone));
+      // No more rows will be produced by the stage, so the rest of the input, which is already
+      // materialized, is skipped
+      done = done || stageDone;
+      batch = std::move(output);
+    }
+    ds.rows.insert(ds.rows.end(),
+                   std::make_move_iterator(batch.rows.begin()),
+                   std::make_move_iterator(batch.rows.end()));
+  }
+  otherStats_.emplace("batches", folly::to<std::string>(numBatches));
+
+  if (FLAGS_enable_lifetime_optimize) {
+    // The input of the fused executors are dropped by the last one
+    for (size_t i = 0; i + 1 < stages.size(); ++i) {
+      drop(stages[i]->node());
+    }
+  }
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
+folly::Future<Status> PipelineExecutor::executeStages(
+    const std::vector<PipelineExecutor *> &stages) {
+  otherStats_.emplace("pipeline", "materialized");
+  auto future = folly::makeFuture<Status>(Status::OK());
+  for (auto *stage : stages) {
+    future = std::move(future).thenValue([stage](Status s) -> folly::Future<Status> {
+      NG_RETURN_IF_ERROR(s);
+      return stage->executeAll();
+    });
+  }
+  return future;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,67 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_PIPELINEEXECUTOR_H_
+#define GRAPH_EXECUTOR_PIPELINEEXECUTOR_H_
+
+#include "graph/executor/Executor.h"
+
+namespace nebula {
+namespace graph {
+
+class Iterator;
+
+// Executor of a row-wise operator which could be fused with its upstream row-wise operators into
+// a pipeline when `enable_pipeline_execution' is on.
+//
+// The executor at the end of a pipeline pulls morsels of at most `pipeline_batch_size' rows from
+// the input of the first one and pushes each morsel through the whole chain, so the intermediate
+// results between the fused operators are never materialized, and the remaining morsels are not
+// processed once an operator, e.g. Limit, doesn't want more rows. The fused upstream executors do
+// nothing when they are scheduled.
+//
+// The input of the pipeline is still the dataset materialized by the upstream executor, which
+// runs to completion first, so neither the storage calls behind it are stopped early nor the
+// first row is produced sooner. Only the input of SequentialIter is pipelined, the others, e.g.
+// the output of GetNeighbors, are processed by the fused operators one after another.
+class PipelineExecutor : public Executor {
+ public:
+  folly::Future<Status> execute() final;
+
+  // Fuse the executor with its only dependency if both of them are pipeline executors and the
+  // output of the dependency is only read by the executor
+  static void fuse(Executor *exe);
+
+ protected:
+  PipelineExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
+      : Executor(name, node, qctx) {}
+
+  // Execute the operator on the whole input materialized by the dependency
+  virtual folly::Future<Status> executeAll() = 0;
+
+  // Prepare the states of the operator before the first morsel
+  virtual Status openBatch() {
+    return Status::OK();
+  }
+
+  // Process a morsel of rows and append the result rows to `output', whose column names are the
+  // ones of the input by default. Set `done' if the operator wants no more input.
+  virtual Status processBatch(Iterator *input, DataSet *output, bool *done) = 0;
+
+ private:
+  folly::Future<Status> executePipeline();
+
+  // Fallback for the input which is not a sequential dataset
+  folly::Future<Status> executeStages(const std::vector<PipelineExecutor *> &stages);
+
+  // The upstream executor fused into this one
+  PipelineExecutor *upstream_{nullptr};
+  // The downstream executor which this one is fused into
+  PipelineExecutor *downstream_{nullptr};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_PIPELINEEXECUTOR_H_
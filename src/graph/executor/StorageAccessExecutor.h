@@ -156,8 +156,6 @@ class StorageAccessExecutor : public Executor {
   std::string getStorageDetail(
       apache::thrift::optional_field_ref<const std::map<std::string, int32_t> &> ref) const;
 
-  bool isIntVidType(const SpaceInfo &space) const;
-
   DataSet buildRequestDataSetByVidType(Iterator *iter, Expression *expr, bool dedup);
 };
 
@@ -14,17 +14,23 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
   pathNode_ = asNode<BFSShortestPath>(node());
 
   if (step_ == 1) {
+    // The sets of vids are specialized for the vid type of the space, the int vids visited are
+    // clustered around the start ones, so they are kept in the compressed bitmaps
+    const auto& vidType = *(qctx()->rctx()->session()->space().spaceDesc.vid_type_ref());
+    leftVisitedVids_ = VidBitmapSet(vidType);
+    rightVisitedVids_ = VidBitmapSet(vidType);
     allRightEdges_.emplace_back();
     auto& currentEdges = allRightEdges_.back();
     auto rIter = ectx_->getResult(pathNode_->rightVidVar()).iter();
-    std::unordered_set<Value> rightVids;
+    VidBitmapSet rightVids(vidType);
     for (; rIter->valid(); rIter->next()) {
       auto& vid = rIter->getColumn(0);
-      if (rightVids.emplace(vid).second) {
+      if (rightVids.emplace(vid)) {
         Edge dummy;
         currentEdges.emplace(vid, std::move(dummy));
       }
     }
+    rightFrontier_ = std::move(rightVids);
   }
 
   std::vector<folly::Future<Status>> futures;
@@ -61,7 +67,7 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
   auto iterSize = iter->size();
   visitedVids.reserve(visitedVids.size() + iterSize);
 
-  std::unordered_set<Value> uniqueDst;
+  VidBitmapSet uniqueDst(*(qctx()->rctx()->session()->space().spaceDesc.vid_type_ref()));
   uniqueDst.reserve(iterSize);
   DataSet nextStepVids;
   nextStepVids.colNames = {nebula::kVid};
@@ -74,7 +80,7 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
       auto& edge = edgeVal.getEdge();
       auto dst = edge.dst;
       visitedVids.emplace(edge.src);
-      if (uniqueDst.emplace(dst).second) {
+      if (uniqueDst.emplace(dst)) {
         nextStepVids.rows.emplace_back(Row({dst}));
       }
       currentEdges.emplace(std::move(dst), std::move(edge));
@@ -87,42 +93,38 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
       }
       auto& edge = edgeVal.getEdge();
       auto dst = edge.dst;
-      if (visitedVids.find(dst) != visitedVids.end()) {
+      if (visitedVids.contains(dst)) {
         continue;
       }
-      if (uniqueDst.emplace(dst).second) {
+      if (uniqueDst.emplace(dst)) {
         nextStepVids.rows.emplace_back(Row({dst}));
       }
       currentEdges.emplace(std::move(dst), std::move(edge));
     }
   }
+  for (auto& row : nextStepVids.rows) {
+    visitedVids.emplace(row.values.front());
+  }
+  if (reverse) {
+    prevRightFrontier_ = std::move(rightFrontier_);
+    rightFrontier_ = std::move(uniqueDst);
+  } else {
+    leftFrontier_ = std::move(uniqueDst);
+  }
   // set nextVid
   const auto& nextVidVar = reverse ? pathNode_->rightVidVar() : pathNode_->leftVidVar();
   ectx_->setResult(nextVidVar, ResultBuilder().value(std::move(nextStepVids)).build());
-
-  visitedVids.insert(std::make_move_iterator(uniqueDst.begin()),
-                     std::make_move_iterator(uniqueDst.end()));
   return Status::OK();
 }
 
 folly::Future<Status> BFSShortestPathExecutor::conjunctPath() {
-  const auto& leftEdges = allLeftEdges_.back();
-  const auto& preRightEdges = allRightEdges_[step_ - 1];
-  std::unordered_set<Value> meetVids;
+  // The frontiers are the keys of allLeftEdges_.back(), allRightEdges_[step_ - 1] and
+  // allRightEdges_.back()
+  auto meetVids = leftFrontier_.intersect(prevRightFrontier_);
   bool oddStep = true;
-  for (const auto& edge : leftEdges) {
-    if (preRightEdges.find(edge.first) != preRightEdges.end()) {
-      meetVids.emplace(edge.first);
-    }
-  }
   if (meetVids.empty() && step_ * 2 <= pathNode_->steps()) {
-    const auto& rightEdges = allRightEdges_.back();
-    for (const auto& edge : leftEdges) {
-      if (rightEdges.find(edge.first) != rightEdges.end()) {
-        meetVids.emplace(edge.first);
-        oddStep = false;
-      }
-    }
+    meetVids = leftFrontier_.intersect(rightFrontier_);
+    oddStep = false;
   }
   if (meetVids.empty()) {
     return Status::OK();
@@ -5,6 +5,7 @@
 #ifndef GRAPH_EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
 #define GRAPH_EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
 #include "graph/executor/Executor.h"
+#include "graph/util/VidSet.h"
 
 // BFSShortestPath has two inputs.  GetNeighbors(From) & GetNeighbors(To)
 // There are two Main functions
@@ -36,6 +37,10 @@
 //
 // `leftVisitedVids_` : keep already visited vid to avoid repeated visits (left)
 // `rightVisitedVids_` : keep already visited vid to avoid repeated visits (right)
+// `leftFrontier_` : the vids reached at the current step (left), i.e. the keys of
+//   allLeftEdges_.back(), intersected with the right ones to find the common vids
+// `prevRightFrontier_`, `rightFrontier_` : the vids reached at the previous and current step
+//   (right)
 // `currentDs_`: keep the paths matched in current step
 namespace nebula {
 namespace graph {
@@ -61,8 +66,11 @@ class BFSShortestPathExecutor final : public Executor {
  private:
   const BFSShortestPath* pathNode_{nullptr};
   size_t step_{1};
-  std::unordered_set<Value> leftVisitedVids_;
-  std::unordered_set<Value> rightVisitedVids_;
+  VidBitmapSet leftVisitedVids_;
+  VidBitmapSet rightVisitedVids_;
+  VidBitmapSet leftFrontier_;
+  VidBitmapSet prevRightFrontier_;
+  VidBitmapSet rightFrontier_;
   std::vector<std::unordered_multimap<Value, Edge>> allLeftEdges_;
   std::vector<std::unordered_multimap<Value, Edge>> allRightEdges_;
   DataSet currentDs_;
@@ -28,6 +28,7 @@ folly::Future<Status> BatchShortestPath::execute(const std::unordered_set<Value>
         for (auto& resp : resps) {
           NG_RETURN_IF_ERROR(resp);
         }
+        addExpansionStats();
         result->colNames = pathNode_->colNames();
         for (auto& ds : resultDs_) {
           result->append(std::move(ds));
@@ -46,7 +47,8 @@ size_t BatchShortestPath::init(const std::unordered_set<Value>& startVids,
   allRightPathMaps_.resize(rowSize);
   currentLeftPathMaps_.reserve(rowSize);
   currentRightPathMaps_.reserve(rowSize);
-  preRightPathMaps_.reserve(rowSize);
+  leftSteps_.resize(rowSize, 0);
+  rightSteps_.resize(rowSize, 0);
 
   terminationMaps_.reserve(rowSize);
   resultDs_.resize(rowSize);
@@ -61,18 +63,15 @@ size_t BatchShortestPath::init(const std::unordered_set<Value>& startVids,
     }
     for (auto& _endVids : batchEndVids_) {
       DataSet endDs;
-      PathMap preRightPathMap;
       PathMap rightPathMap;
       for (auto& endVid : _endVids) {
         endDs.rows.emplace_back(Row({endVid}));
         std::vector<CustomPath> dummy;
-        rightPathMap[endVid].emplace(endVid, dummy);
-        preRightPathMap[endVid].emplace(endVid, std::move(dummy));
+        rightPathMap[endVid].emplace(endVid, std::move(dummy));
       }
 
       // set originRightpath
       currentLeftPathMaps_.emplace_back(leftPathMap);
-      preRightPathMaps_.emplace_back(std::move(preRightPathMap));
       currentRightPathMaps_.emplace_back(std::move(rightPathMap));
 
       // set vid for getNeightbor
@@ -94,22 +93,38 @@ size_t BatchShortestPath::init(const std::unordered_set<Value>& startVids,
   return rowSize;
 }
 
+// Only one side is expanded at each step, so the paths found at the `stepNum'th step are
+// `stepNum' long, and the shortest ones once found
 folly::Future<Status> BatchShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
-  std::vector<folly::Future<Status>> futures;
-  futures.emplace_back(getNeighbors(rowNum, stepNum, false));
-  futures.emplace_back(getNeighbors(rowNum, stepNum, true));
-  return folly::collect(futures)
+  bool reverse = startStep(rowNum);
+  auto sideStepNum = (reverse ? rightSteps_ : leftSteps_)[rowNum];
+  return getNeighbors(rowNum, sideStepNum, reverse)
       .via(qctx_->rctx()->runner())
-      .thenValue([this, rowNum, stepNum](auto&& resps) {
-        for (auto& resp : resps) {
-          if (!resp.ok()) {
-            return folly::makeFuture<Status>(std::move(resp));
-          }
+      .thenValue([this, rowNum, stepNum](auto&& status) {
+        if (!status.ok()) {
+          return folly::makeFuture<Status>(std::move(status));
         }
         return handleResponse(rowNum, stepNum);
       });
 }
 
+bool BatchShortestPath::startStep(size_t rowNum) {
+  bool reverse = expandReverse(rowNum);
+  auto& sideStepNum = (reverse ? rightSteps_ : leftSteps_)[rowNum];
+  if (sideStepNum > 0) {
+    // update allPathMap
+    auto& historyPathMap = reverse ? allRightPathMaps_[rowNum] : allLeftPathMaps_[rowNum];
+    auto& currentPathMap = reverse ? currentRightPathMaps_[rowNum] : currentLeftPathMaps_[rowNum];
+    for (auto& iter : currentPathMap) {
+      historyPathMap[iter.first].insert(std::make_move_iterator(iter.second.begin()),
+                                        std::make_move_iterator(iter.second.end()));
+    }
+    currentPathMap.clear();
+  }
+  ++sideStepNum;
+  return reverse;
+}
+
 folly::Future<Status> BatchShortestPath::getNeighbors(size_t rowNum, size_t stepNum, bool reverse) {
   StorageClient* storageClient = qctx_->getStorageClient();
   time::Duration getNbrTime;
@@ -257,19 +272,11 @@ folly::Future<Status> BatchShortestPath::handleResponse(size_t rowNum, size_t st
   return folly::makeFuture(Status::OK())
       .via(qctx_->rctx()->runner())
       .thenValue([this, rowNum](auto&& status) {
-        // odd step
         UNUSED(status);
-        return conjunctPath(rowNum, true);
-      })
-      .thenValue([this, rowNum, stepNum](auto&& terminate) {
-        // even Step
-        if (terminate || stepNum * 2 > maxStep_) {
-          return folly::makeFuture<bool>(true);
-        }
-        return conjunctPath(rowNum, false);
+        return conjunctPath(rowNum);
       })
       .thenValue([this, rowNum, stepNum](auto&& result) {
-        if (result || stepNum * 2 >= maxStep_) {
+        if (result || stepNum >= maxStep_) {
           return folly::makeFuture<Status>(Status::OK());
         }
         auto& leftVids = leftVids_[rowNum].rows;
@@ -277,126 +284,90 @@ folly::Future<Status> BatchShortestPath::handleResponse(size_t rowNum, size_t st
         if (leftVids.empty() || rightVids.empty()) {
           return folly::makeFuture<Status>(Status::OK());
         }
-        // update allPathMap
-        auto& leftPathMap = currentLeftPathMaps_[rowNum];
-        auto& rightPathMap = currentRightPathMaps_[rowNum];
-        preRightPathMaps_[rowNum] = rightPathMap;
-        for (auto& iter : leftPathMap) {
-          allLeftPathMaps_[rowNum][iter.first].insert(std::make_move_iterator(iter.second.begin()),
-                                                      std::make_move_iterator(iter.second.end()));
-        }
-        for (auto& iter : rightPathMap) {
-          allRightPathMaps_[rowNum][iter.first].insert(std::make_move_iterator(iter.second.begin()),
-                                                       std::make_move_iterator(iter.second.end()));
-        }
-        leftPathMap.clear();
-        rightPathMap.clear();
         return shortestPath(rowNum, stepNum + 1);
       });
 }
 
-folly::Future<std::vector<Value>> BatchShortestPath::getMeetVids(size_t rowNum,
-                                                                 bool oddStep,
-                                                                 std::vector<Value>& meetVids) {
-  if (!oddStep) {
-    return getMeetVidsProps(meetVids);
-  }
-  std::vector<Value> vertices;
-  vertices.reserve(meetVids.size());
-  for (auto& meetVid : meetVids) {
-    for (auto& dstPaths : currentRightPathMaps_[rowNum]) {
-      bool flag = false;
-      for (auto& srcPaths : dstPaths.second) {
-        for (auto& path : srcPaths.second) {
-          auto& vertex = path.values[path.size() - 2];
-          auto& vid = vertex.getVertex().vid;
-          if (vid == meetVid) {
-            vertices.emplace_back(vertex);
-            flag = true;
-            break;
-          }
-        }
-        if (flag) {
-          break;
-        }
-      }
-      if (flag) {
-        break;
-      }
-    }
+folly::Future<bool> BatchShortestPath::conjunctPath(size_t rowNum) {
+  auto meetVids = findMeetVids(rowNum);
+  if (meetVids.empty()) {
+    return folly::makeFuture<bool>(false);
   }
-  return folly::makeFuture<std::vector<Value>>(std::move(vertices));
+  auto future = getMeetVidsProps(meetVids);
+  return future.via(qctx_->rctx()->runner()).thenValue([this, rowNum](auto&& vertices) {
+    return buildMeetPath(rowNum, std::move(vertices));
+  });
 }
 
-folly::Future<bool> BatchShortestPath::conjunctPath(size_t rowNum, bool oddStep) {
-  auto& _leftPathMaps = currentLeftPathMaps_[rowNum];
-  auto& _rightPathMaps = oddStep ? preRightPathMaps_[rowNum] : currentRightPathMaps_[rowNum];
+std::vector<Value> BatchShortestPath::findMeetVids(size_t rowNum) const {
+  // Meet at the vids reached by both sides at their last steps
+  const auto& _leftPathMaps = currentLeftPathMaps_[rowNum];
+  const auto& _rightPathMaps = currentRightPathMaps_[rowNum];
+  const auto& smallerPathMaps =
+      _leftPathMaps.size() <= _rightPathMaps.size() ? _leftPathMaps : _rightPathMaps;
+  const auto& largerPathMaps = &smallerPathMaps == &_leftPathMaps ? _rightPathMaps : _leftPathMaps;
 
   std::vector<Value> meetVids;
-  meetVids.reserve(_leftPathMaps.size());
-  for (const auto& leftPathMap : _leftPathMaps) {
-    auto findCommonVid = _rightPathMaps.find(leftPathMap.first);
-    if (findCommonVid != _rightPathMaps.end()) {
-      meetVids.emplace_back(findCommonVid->first);
+  meetVids.reserve(smallerPathMaps.size());
+  for (const auto& pathMap : smallerPathMaps) {
+    if (largerPathMaps.find(pathMap.first) != largerPathMaps.end()) {
+      meetVids.emplace_back(pathMap.first);
     }
   }
-  if (meetVids.empty()) {
-    return folly::makeFuture<bool>(false);
-  }
+  return meetVids;
+}
 
-  auto future = getMeetVids(rowNum, oddStep, meetVids);
-  return future.via(qctx_->rctx()->runner()).thenValue([this, rowNum, oddStep](auto&& vertices) {
-    if (vertices.empty()) {
-      return false;
+bool BatchShortestPath::buildMeetPath(size_t rowNum, std::vector<Value>&& vertices) {
+  if (vertices.empty()) {
+    return false;
+  }
+  std::unordered_map<Value, Value> verticesMap;
+  for (auto& vertex : vertices) {
+    verticesMap[vertex.getVertex().vid] = std::move(vertex);
+  }
+  auto& terminationMap = terminationMaps_[rowNum];
+  auto& leftPathMaps = currentLeftPathMaps_[rowNum];
+  auto& rightPathMaps = currentRightPathMaps_[rowNum];
+  for (const auto& leftPathMap : leftPathMaps) {
+    auto findCommonVid = rightPathMaps.find(leftPathMap.first);
+    if (findCommonVid == rightPathMaps.end()) {
+      continue;
     }
-    std::unordered_map<Value, Value> verticesMap;
-    for (auto& vertex : vertices) {
-      verticesMap[vertex.getVertex().vid] = std::move(vertex);
+    auto findCommonVertex = verticesMap.find(findCommonVid->first);
+    if (findCommonVertex == verticesMap.end()) {
+      continue;
     }
-    auto& terminationMap = terminationMaps_[rowNum];
-    auto& leftPathMaps = currentLeftPathMaps_[rowNum];
-    auto& rightPathMaps = oddStep ? preRightPathMaps_[rowNum] : currentRightPathMaps_[rowNum];
-    for (const auto& leftPathMap : leftPathMaps) {
-      auto findCommonVid = rightPathMaps.find(leftPathMap.first);
-      if (findCommonVid == rightPathMaps.end()) {
+    auto& rightPaths = findCommonVid->second;
+    for (const auto& srcPaths : leftPathMap.second) {
+      auto range = terminationMap.equal_range(srcPaths.first);
+      if (range.first == range.second) {
         continue;
       }
-      auto findCommonVertex = verticesMap.find(findCommonVid->first);
-      if (findCommonVertex == verticesMap.end()) {
-        continue;
-      }
-      auto& rightPaths = findCommonVid->second;
-      for (const auto& srcPaths : leftPathMap.second) {
-        auto range = terminationMap.equal_range(srcPaths.first);
-        if (range.first == range.second) {
-          continue;
-        }
-        for (const auto& dstPaths : rightPaths) {
-          for (auto found = range.first; found != range.second; ++found) {
-            if (found->second.first == dstPaths.first) {
-              if (singleShortest_ && !found->second.second) {
-                break;
-              }
-              doConjunctPath(srcPaths.second, dstPaths.second, findCommonVertex->second, rowNum);
-              found->second.second = false;
+      for (const auto& dstPaths : rightPaths) {
+        for (auto found = range.first; found != range.second; ++found) {
+          if (found->second.first == dstPaths.first) {
+            if (singleShortest_ && !found->second.second) {
+              break;
             }
+            doConjunctPath(srcPaths.second, dstPaths.second, findCommonVertex->second, rowNum);
+            found->second.second = false;
           }
         }
       }
     }
-    // update terminationMap
-    for (auto iter = terminationMap.begin(); iter != terminationMap.end();) {
-      if (!iter->second.second) {
-        iter = terminationMap.erase(iter);
-      } else {
-        ++iter;
-      }
-    }
-    if (terminationMap.empty()) {
-      return true;
+  }
+  // update terminationMap
+  for (auto iter = terminationMap.begin(); iter != terminationMap.end();) {
+    if (!iter->second.second) {
+      iter = terminationMap.erase(iter);
+    } else {
+      ++iter;
     }
-    return false;
-  });
+  }
+  if (terminationMap.empty()) {
+    return true;
+  }
+  return false;
 }
 
 void BatchShortestPath::doConjunctPath(const std::vector<CustomPath>& leftPaths,
@@ -404,6 +375,24 @@ void BatchShortestPath::doConjunctPath(const std::vector<CustomPath>& leftPaths,
                                        const Value& commonVertex,
                                        size_t rowNum) {
   auto& resultDs = resultDs_[rowNum];
+  if (leftPaths.empty()) {
+    // meet at the start vid, which is reached by the right side only
+    for (const auto& rightPath : rightPaths) {
+      auto backwardPath = rightPath.values;
+      std::reverse(backwardPath.begin(), backwardPath.end());
+      auto dst = backwardPath.back();
+      backwardPath.pop_back();
+      Row row;
+      row.emplace_back(commonVertex);
+      row.emplace_back(List(std::move(backwardPath)));
+      row.emplace_back(std::move(dst));
+      resultDs.rows.emplace_back(std::move(row));
+      if (singleShortest_) {
+        return;
+      }
+    }
+    return;
+  }
   if (rightPaths.empty()) {
     for (const auto& leftPath : leftPaths) {
       auto forwardPath = leftPath.values;
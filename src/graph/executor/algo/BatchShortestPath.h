@@ -24,6 +24,8 @@ class BatchShortestPath final : public ShortestPathBase {
   using PathMap = std::unordered_map<DstVid, std::unordered_map<StartVid, std::vector<CustomPath>>>;
 
  private:
+  friend class ShortestPathTest;
+
   size_t splitTask(const std::unordered_set<Value>& startVids,
                    const std::unordered_set<Value>& endVids);
 
@@ -33,17 +35,21 @@ class BatchShortestPath final : public ShortestPathBase {
 
   folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
 
+  // Choose the side to expand at the next step and move its last step to the history, return
+  // true if it's the right side
+  bool startStep(size_t rowNum);
+
   folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum);
 
   Status buildPath(size_t rowNum, RpcResponse&& resp, bool reverse);
 
   Status doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse);
 
-  folly::Future<bool> conjunctPath(size_t rowNum, bool oddStep);
+  folly::Future<bool> conjunctPath(size_t rowNum);
+
+  std::vector<Value> findMeetVids(size_t rowNum) const;
 
-  folly::Future<std::vector<Value>> getMeetVids(size_t rowNum,
-                                                bool oddStep,
-                                                std::vector<Value>& meetVids);
+  bool buildMeetPath(size_t rowNum, std::vector<Value>&& vertices);
 
   void doConjunctPath(const std::vector<CustomPath>& leftPaths,
                       const std::vector<CustomPath>& rightPaths,
@@ -63,7 +69,6 @@ class BatchShortestPath final : public ShortestPathBase {
 
   std::vector<PathMap> currentLeftPathMaps_;
   std::vector<PathMap> currentRightPathMaps_;
-  std::vector<PathMap> preRightPathMaps_;
 };
 
 }  // namespace graph
@@ -220,5 +220,18 @@ void ShortestPathBase::addStats(PropRpcResponse& resp,
   stats->emplace(folly::sformat("get_prop "), ss.str());
 }
 
+void ShortestPathBase::addExpansionStats() const {
+  if (!qctx_->plan()->isProfileEnabled()) {
+    return;
+  }
+  std::stringstream ss;
+  ss << "{\n";
+  for (size_t i = 0; i < leftSteps_.size(); ++i) {
+    ss << folly::sformat("row {}: left {}, right {}", i, leftSteps_[i], rightSteps_[i]) << "\n";
+  }
+  ss << "}";
+  stats_->emplace("expansions", ss.str());
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -80,6 +80,16 @@ class ShortestPathBase {
   std::string getStorageDetail(
       apache::thrift::optional_field_ref<const std::map<std::string, int32_t>&> ref) const;
 
+  // Expand the side with the smaller frontier, which costs fewer edges to scan than the other on
+  // the power-law graphs, return true if it's the right side
+  bool expandReverse(size_t rowNum) const {
+    return rightVids_[rowNum].rows.size() < leftVids_[rowNum].rows.size();
+  }
+
+  // Add the number of the expansions of each side of each row to the profile, only if the query
+  // is profiled
+  void addExpansionStats() const;
+
  protected:
   const ShortestPath* pathNode_{nullptr};
   QueryContext* qctx_{nullptr};
@@ -90,6 +100,9 @@ class ShortestPathBase {
   std::vector<DataSet> resultDs_;
   std::vector<DataSet> leftVids_;
   std::vector<DataSet> rightVids_;
+  // Number of the expansions of each side of each row
+  std::vector<size_t> leftSteps_;
+  std::vector<size_t> rightSteps_;
 };
 
 }  // namespace graph
@@ -27,6 +27,7 @@ folly::Future<Status> SingleShortestPath::execute(const std::unordered_set<Value
         for (auto& resp : resps) {
           NG_RETURN_IF_ERROR(resp);
         }
+        addExpansionStats();
         result->colNames = pathNode_->colNames();
         for (auto& ds : resultDs_) {
           result->append(std::move(ds));
@@ -41,19 +42,25 @@ void SingleShortestPath::init(const std::unordered_set<Value>& startVids,
   leftVids_.reserve(rowSize);
   rightVids_.reserve(rowSize);
 
-  leftVisitedVids_.resize(rowSize);
-  rightVisitedVids_.resize(rowSize);
+  // The sets of vids are specialized for the vid type of the space, the int vids visited are
+  // clustered around the start ones, so they are kept in the compressed bitmaps
+  const auto& vidType = *(qctx_->rctx()->session()->space().spaceDesc.vid_type_ref());
+  leftVisitedVids_.resize(rowSize, VidBitmapSet(vidType));
+  rightVisitedVids_.resize(rowSize, VidBitmapSet(vidType));
 
-  allLeftPaths_.resize(rowSize);
+  allLeftPaths_.reserve(rowSize);
   allRightPaths_.reserve(rowSize);
+  leftSteps_.resize(rowSize, 0);
+  rightSteps_.resize(rowSize, 0);
   resultDs_.resize(rowSize);
   for (const auto& startVid : startVids) {
     for (const auto& endVid : endVids) {
-      std::unordered_map<Value, std::vector<Row>> steps;
-      std::vector<Row> dummy;
-      steps.emplace(endVid, std::move(dummy));
-      HalfPath originRightPath({std::move(steps)});
-      allRightPaths_.emplace_back(std::move(originRightPath));
+      // The first step of each side is the start or end vid itself
+      std::unordered_map<Value, std::vector<Row>> startStep, endStep;
+      startStep.emplace(startVid, std::vector<Row>());
+      endStep.emplace(endVid, std::vector<Row>());
+      allLeftPaths_.emplace_back(HalfPath({std::move(startStep)}));
+      allRightPaths_.emplace_back(HalfPath({std::move(endStep)}));
 
       DataSet startDs, endDs;
       startDs.rows.emplace_back(Row({startVid}));
@@ -64,23 +71,27 @@ void SingleShortestPath::init(const std::unordered_set<Value>& startVids,
   }
 }
 
+// Only one side is expanded at each step, so the paths found at the `stepNum'th step are
+// `stepNum' long, and the shortest ones once found
 folly::Future<Status> SingleShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
-  std::vector<folly::Future<Status>> futures;
-  futures.reserve(2);
-  futures.emplace_back(getNeighbors(rowNum, stepNum, false));
-  futures.emplace_back(getNeighbors(rowNum, stepNum, true));
-  return folly::collect(futures)
+  bool reverse = startStep(rowNum);
+  auto sideStepNum = (reverse ? rightSteps_ : leftSteps_)[rowNum];
+  return getNeighbors(rowNum, sideStepNum, reverse)
       .via(qctx_->rctx()->runner())
-      .thenValue([this, rowNum, stepNum](auto&& resps) {
-        for (auto& resp : resps) {
-          if (!resp.ok()) {
-            return folly::makeFuture<Status>(std::move(resp));
-          }
+      .thenValue([this, rowNum, stepNum, reverse](auto&& status) {
+        if (!status.ok()) {
+          return folly::makeFuture<Status>(std::move(status));
         }
-        return handleResponse(rowNum, stepNum);
+        return handleResponse(rowNum, stepNum, reverse);
       });
 }
 
+bool SingleShortestPath::startStep(size_t rowNum) {
+  bool reverse = expandReverse(rowNum);
+  ++(reverse ? rightSteps_ : leftSteps_)[rowNum];
+  return reverse;
+}
+
 folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
                                                        size_t stepNum,
                                                        bool reverse) {
@@ -139,7 +150,7 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
   allSteps.emplace_back();
   auto& currentStep = allSteps.back();
 
-  std::unordered_set<Value> uniqueDst;
+  VidSet uniqueDst(*(qctx_->rctx()->session()->space().spaceDesc.vid_type_ref()));
   uniqueDst.reserve(iterSize);
   std::vector<Row> nextStepVids;
   nextStepVids.reserve(iterSize);
@@ -152,11 +163,11 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
     }
     auto& edge = edgeVal.getEdge();
     auto dst = edge.dst;
-    if (visitedVids.find(dst) != visitedVids.end()) {
+    if (visitedVids.contains(dst)) {
       continue;
     }
     visitedVids.emplace(edge.src);
-    if (uniqueDst.emplace(dst).second) {
+    if (uniqueDst.emplace(dst)) {
       nextStepVids.emplace_back(Row({dst}));
     }
     auto vertex = iter->getVertex();
@@ -172,8 +183,9 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
       steps.emplace_back(std::move(step));
     }
   }
-  visitedVids.insert(std::make_move_iterator(uniqueDst.begin()),
-                     std::make_move_iterator(uniqueDst.end()));
+  for (auto& row : nextStepVids) {
+    visitedVids.emplace(row.values.front());
+  }
   if (reverse) {
     rightVids_[rowNum].rows.swap(nextStepVids);
   } else {
@@ -182,15 +194,17 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
   return Status::OK();
 }
 
-folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t stepNum) {
+folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum,
+                                                         size_t stepNum,
+                                                         bool reverse) {
   return folly::makeFuture<Status>(Status::OK())
       .via(qctx_->rctx()->runner())
-      .thenValue([this, rowNum, stepNum](auto&& status) {
+      .thenValue([this, rowNum, reverse](auto&& status) {
         UNUSED(status);
-        return conjunctPath(rowNum, stepNum);
+        return conjunctPath(rowNum, reverse);
       })
       .thenValue([this, rowNum, stepNum](auto&& result) {
-        if (result || stepNum * 2 >= maxStep_) {
+        if (result || stepNum >= maxStep_) {
           return folly::makeFuture<Status>(Status::OK());
         }
         auto& leftVids = leftVids_[rowNum].rows;
@@ -202,162 +216,81 @@ folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t s
       });
 }
 
-folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, size_t stepNum) {
-  const auto& leftStep = allLeftPaths_[rowNum].back();
-  const auto& prevRightStep = allRightPaths_[rowNum][stepNum - 1];
-  std::vector<Value> meetVids;
-  for (const auto& step : leftStep) {
-    if (prevRightStep.find(step.first) != prevRightStep.end()) {
-      meetVids.push_back(step.first);
-      if (singleShortest_) {
-        break;
-      }
-    }
-  }
-  if (!meetVids.empty()) {
-    buildOddPath(rowNum, meetVids);
-    return folly::makeFuture<bool>(true);
-  }
-  if (stepNum * 2 > maxStep_) {
+folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, bool reverse) {
+  auto meetVids = findMeetVids(rowNum, reverse);
+  if (meetVids.empty()) {
     return folly::makeFuture<bool>(false);
   }
+  auto future = getMeetVidsProps(meetVids);
+  return future.via(qctx_->rctx()->runner()).thenValue([this, rowNum](auto&& vertices) {
+    return buildMeetPath(rowNum, vertices);
+  });
+}
 
-  const auto& rightStep = allRightPaths_[rowNum].back();
-  for (const auto& step : leftStep) {
-    if (rightStep.find(step.first) != rightStep.end()) {
-      meetVids.push_back(step.first);
+std::vector<Value> SingleShortestPath::findMeetVids(size_t rowNum, bool reverse) const {
+  // Meet at the vids reached by both sides at their last steps
+  const auto& step = reverse ? allRightPaths_[rowNum].back() : allLeftPaths_[rowNum].back();
+  const auto& otherStep = reverse ? allLeftPaths_[rowNum].back() : allRightPaths_[rowNum].back();
+  std::vector<Value> meetVids;
+  for (const auto& dst : step) {
+    if (otherStep.find(dst.first) != otherStep.end()) {
+      meetVids.push_back(dst.first);
       if (singleShortest_) {
         break;
       }
     }
   }
-  if (meetVids.empty()) {
-    return folly::makeFuture<bool>(false);
-  }
-  return buildEvenPath(rowNum, meetVids);
+  return meetVids;
 }
 
-void SingleShortestPath::buildOddPath(size_t rowNum, const std::vector<Value>& meetVids) {
-  for (auto& meetVid : meetVids) {
-    auto leftPaths = createLeftPath(rowNum, meetVid);
-    auto rightPaths = createRightPath(rowNum, meetVid, true);
+bool SingleShortestPath::buildMeetPath(size_t rowNum, const std::vector<Value>& meetVertices) {
+  if (meetVertices.empty()) {
+    return false;
+  }
+  for (auto& meetVertex : meetVertices) {
+    auto meetVid = meetVertex.getVertex().vid;
+    auto leftPaths = createPath(rowNum, meetVid, false);
+    auto rightPaths = createPath(rowNum, meetVid, true);
     for (auto& leftPath : leftPaths) {
       for (auto& rightPath : rightPaths) {
-        Row path = leftPath;
-        auto& steps = path.values.back().mutableList().values;
-        steps.insert(steps.end(), rightPath.values.begin(), rightPath.values.end() - 1);
-        path.emplace_back(rightPath.values.back());
+        // [start vertex, edge, ..., meet vertex, ..., edge, end vertex]
+        auto values = leftPath.values;
+        values.emplace_back(meetVertex);
+        values.insert(values.end(), rightPath.values.rbegin(), rightPath.values.rend());
+        Row path;
+        path.emplace_back(values.front());
+        path.emplace_back(List(std::vector<Value>(values.begin() + 1, values.end() - 1)));
+        path.emplace_back(values.back());
         resultDs_[rowNum].rows.emplace_back(std::move(path));
         if (singleShortest_) {
-          return;
+          return true;
         }
       }
     }
   }
+  return true;
 }
 
-folly::Future<bool> SingleShortestPath::buildEvenPath(size_t rowNum,
-                                                      const std::vector<Value>& meetVids) {
-  auto future = getMeetVidsProps(meetVids);
-  return future.via(qctx_->rctx()->runner()).thenValue([this, rowNum](auto&& vertices) {
-    if (vertices.empty()) {
-      return false;
-    }
-    for (auto& meetVertex : vertices) {
-      auto meetVid = meetVertex.getVertex().vid;
-      auto leftPaths = createLeftPath(rowNum, meetVid);
-      auto rightPaths = createRightPath(rowNum, meetVid, false);
-      for (auto& leftPath : leftPaths) {
-        for (auto& rightPath : rightPaths) {
-          Row path = leftPath;
-          auto& steps = path.values.back().mutableList().values;
-          steps.emplace_back(meetVertex);
-          steps.insert(steps.end(), rightPath.values.begin(), rightPath.values.end() - 1);
-          path.emplace_back(rightPath.values.back());
-          resultDs_[rowNum].rows.emplace_back(std::move(path));
-          if (singleShortest_) {
-            return true;
-          }
-        }
-      }
-    }
-    return true;
-  });
-}
-
-std::vector<Row> SingleShortestPath::createLeftPath(size_t rowNum, const Value& meetVid) {
-  auto& allSteps = allLeftPaths_[rowNum];
-  auto& lastSteps = allSteps.back();
-  auto findMeetVid = lastSteps.find(meetVid);
-  std::vector<Row> leftPaths(findMeetVid->second);
-  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend(); ++stepIter) {
-    std::vector<Row> temp;
-    for (auto& leftPath : leftPaths) {
-      Value id = leftPath.values.front().getVertex().vid;
-      auto findId = stepIter->find(id);
-      for (auto& step : findId->second) {
-        auto newPath = leftPath;
-        newPath.values.insert(newPath.values.begin(), step.values.begin(), step.values.end());
-        temp.emplace_back(std::move(newPath));
-      }
-    }
-    leftPaths.swap(temp);
-  }
-  std::vector<Row> result;
-  result.reserve(leftPaths.size());
-  for (auto& path : leftPaths) {
-    Row row;
-    auto src = path.values.front();
-    path.values.erase(path.values.begin());
-    row.emplace_back(std::move(src));
-    row.emplace_back(std::move(path));
-    result.emplace_back(std::move(row));
-  }
-  return result;
-}
-
-std::vector<Row> SingleShortestPath::createRightPath(size_t rowNum,
-                                                     const Value& meetVid,
-                                                     bool oddStep) {
-  auto& allSteps = allRightPaths_[rowNum];
-  std::vector<Row> rightPaths;
-  auto& lastSteps = allSteps.back();
-  if (oddStep) {
-    for (auto& steps : lastSteps) {
-      bool flag = false;
-      for (auto& step : steps.second) {
-        auto& vertex = step.values.front();
-        if (vertex.getVertex().vid == meetVid) {
-          rightPaths.emplace_back(Row({vertex}));
-          flag = true;
-          break;
-        }
-      }
-      if (flag) {
-        break;
-      }
-    }
-  } else {
-    auto findMeetVid = lastSteps.find(meetVid);
-    rightPaths = findMeetVid->second;
-  }
-  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend() - 1; ++stepIter) {
+// The paths from the start vid, or the end vid if reverse, to the meet vid, e.g.
+// [vertex(a), edge(a->b), vertex(b), edge(b->meetVid)], which is empty if the meet vid is the
+// start or end vid itself
+std::vector<Row> SingleShortestPath::createPath(size_t rowNum, const Value& meetVid, bool reverse) {
+  auto& allSteps = reverse ? allRightPaths_[rowNum] : allLeftPaths_[rowNum];
+  std::vector<Row> paths = {Row()};
+  for (auto stepIter = allSteps.rbegin(); stepIter != allSteps.rend() - 1; ++stepIter) {
     std::vector<Row> temp;
-    for (auto& rightPath : rightPaths) {
-      Value id = rightPath.values.front().getVertex().vid;
+    for (auto& path : paths) {
+      const auto& id = path.values.empty() ? meetVid : path.values.front().getVertex().vid;
       auto findId = stepIter->find(id);
       for (auto& step : findId->second) {
-        auto newPath = rightPath;
+        auto newPath = path;
         newPath.values.insert(newPath.values.begin(), step.values.begin(), step.values.end());
         temp.emplace_back(std::move(newPath));
       }
     }
-    rightPaths.swap(temp);
-  }
-  for (auto& path : rightPaths) {
-    std::reverse(path.values.begin(), path.values.end());
+    paths.swap(temp);
   }
-  return rightPaths;
+  return paths;
 }
 
 }  // namespace graph
@@ -6,6 +6,7 @@
 
 #include "graph/executor/algo/ShortestPathBase.h"
 #include "graph/planner/plan/Algo.h"
+#include "graph/util/VidSet.h"
 
 namespace nebula {
 namespace graph {
@@ -23,33 +24,36 @@ class SingleShortestPath final : public ShortestPathBase {
   using HalfPath = std::vector<std::unordered_map<DstVid, std::vector<CustomStep>>>;
 
  private:
+  friend class ShortestPathTest;
+
   void init(const std::unordered_set<Value>& startVids,
             const std::unordered_set<Value>& endVids,
             size_t rowSize);
 
   folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
 
+  // Choose the side to expand at the next step, return true if it's the right side
+  bool startStep(size_t rowNum);
+
   folly::Future<Status> getNeighbors(size_t rowNum, size_t stepNum, bool reverse);
 
   Status buildPath(size_t rowNum, RpcResponse&& resps, bool reverse);
 
   Status doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse);
 
-  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum);
-
-  folly::Future<bool> conjunctPath(size_t rowNum, size_t stepNum);
+  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum, bool reverse);
 
-  folly::Future<bool> buildEvenPath(size_t rowNum, const std::vector<Value>& meetVids);
+  folly::Future<bool> conjunctPath(size_t rowNum, bool reverse);
 
-  void buildOddPath(size_t rowNum, const std::vector<Value>& meetVids);
+  std::vector<Value> findMeetVids(size_t rowNum, bool reverse) const;
 
-  std::vector<Row> createRightPath(size_t rowNum, const Value& meetVid, bool evenStep);
+  bool buildMeetPath(size_t rowNum, const std::vector<Value>& meetVertices);
 
-  std::vector<Row> createLeftPath(size_t rowNum, const Value& meetVid);
+  std::vector<Row> createPath(size_t rowNum, const Value& meetVid, bool reverse);
 
  private:
-  std::vector<std::unordered_set<Value>> leftVisitedVids_;
-  std::vector<std::unordered_set<Value>> rightVisitedVids_;
+  std::vector<VidBitmapSet> leftVisitedVids_;
+  std::vector<VidBitmapSet> rightVisitedVids_;
   std::vector<HalfPath> allLeftPaths_;
   std::vector<HalfPath> allRightPaths_;
 };
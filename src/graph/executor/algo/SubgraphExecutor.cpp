@@ -27,8 +27,13 @@ folly::Future<Status> SubgraphExecutor::execute() {
   ResultBuilder builder;
   builder.value(iter->valuePtr());
 
-  std::unordered_map<Value, int64_t> currentVids;
+  // The maps of vids are specialized for the vid type of the space
+  const auto& vidType = *(qctx()->rctx()->session()->space().spaceDesc.vid_type_ref());
+  VidMap<int64_t> currentVids(vidType);
   currentVids.reserve(gnSize);
+  if (currentStep == 1) {
+    historyVids_ = VidMap<int64_t>(vidType);
+  }
   historyVids_.reserve(historyVids_.size() + gnSize);
   if (currentStep == 1) {
     for (; iter->valid(); iter->next()) {
@@ -40,8 +45,8 @@ folly::Future<Status> SubgraphExecutor::execute() {
   auto& biDirectEdgeTypes = subgraph->biDirectEdgeTypes();
   while (iter->valid()) {
     const auto& dst = iter->getEdgeProp("*", nebula::kDst);
-    auto findIter = historyVids_.find(dst);
-    if (findIter != historyVids_.end()) {
+    auto* historyStep = historyVids_.find(dst);
+    if (historyStep != nullptr) {
       if (biDirectEdgeTypes.empty()) {
         iter->next();
       } else {
@@ -52,7 +57,7 @@ folly::Future<Status> SubgraphExecutor::execute() {
         }
         auto type = typeVal.getInt();
         if (biDirectEdgeTypes.find(type) != biDirectEdgeTypes.end()) {
-          if (type < 0 || findIter->second + 2 == currentStep) {
+          if (type < 0 || *historyStep + 2 == currentStep) {
             iter->erase();
           } else {
             iter->next();
@@ -78,8 +83,7 @@ folly::Future<Status> SubgraphExecutor::execute() {
   builder.iter(std::move(iter));
   ectx_->setResult(resultVar, builder.build());
   // update historyVids
-  historyVids_.insert(std::make_move_iterator(currentVids.begin()),
-                      std::make_move_iterator(currentVids.end()));
+  historyVids_.merge(currentVids);
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
@@ -4,21 +4,193 @@
 
 #include "graph/executor/query/AggregateExecutor.h"
 
+#include <folly/hash/Hash.h>
+
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/context/ColumnarBatch.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// How a group item is aggregated over the typed columns
+struct TypedItem {
+  enum class Func : uint8_t {
+    // The cell of the last row of the group, i.e. the item not aggregated
+    kLast,
+    kCount,
+    kSum,
+    kAvg,
+    kMax,
+    kMin,
+  };
+
+  Func func;
+  // Index of the input column
+  size_t index;
+  // The typed input column, nullptr for kLast, or kCount of all rows
+  const Column* col;
+};
+
+// The aggregate data of an item of a group, same as AggData of the item but unboxed
+struct TypedAggData {
+  // Number of the non-null cells
+  int64_t count{0};
+  int64_t intValue{0};
+  double floatValue{0.0};
+  bool overflow{false};
+  size_t last{0};
+};
+
+// Get the index of the input column if it's `$-.col'
+bool inputColumn(const Expression* expr,
+                 const std::unordered_map<std::string, size_t>& colIndices,
+                 size_t* index) {
+  if (expr == nullptr || expr->kind() != Expression::Kind::kInputProperty) {
+    return false;
+  }
+  auto iter = colIndices.find(static_cast<const InputPropertyExpression*>(expr)->prop());
+  if (iter == colIndices.end()) {
+    return false;
+  }
+  *index = iter->second;
+  return true;
+}
+
+// The unboxed value of the aggregate data of the cells of type T
+template <typename T>
+T& valueOf(TypedAggData* data) {
+  if constexpr (std::is_floating_point<T>::value) {
+    return data->floatValue;
+  } else {
+    return data->intValue;
+  }
+}
+
+template <typename T>
+void accumulate(TypedItem::Func func, T cell, TypedAggData* data) {
+  auto& value = valueOf<T>(data);
+  switch (func) {
+    case TypedItem::Func::kSum:
+      if constexpr (std::is_floating_point<T>::value) {
+        value += cell;
+      } else if (!data->overflow) {
+        // Same as Value, the sum is NULL once it overflows
+        data->overflow = __builtin_add_overflow(value, cell, &value);
+      }
+      break;
+    case TypedItem::Func::kAvg:
+      data->floatValue += static_cast<double>(cell);
+      break;
+    case TypedItem::Func::kMax:
+      if (data->count == 0 || cell > value) {
+        value = cell;
+      }
+      break;
+    case TypedItem::Func::kMin:
+      if (data->count == 0 || cell < value) {
+        value = cell;
+      }
+      break;
+    default:
+      break;
+  }
+  ++data->count;
+}
+
+void accumulate(const TypedItem& item, size_t row, TypedAggData* data) {
+  if (item.func == TypedItem::Func::kLast) {
+    data->last = row;
+    return;
+  }
+  if (item.col == nullptr) {
+    ++data->count;
+    return;
+  }
+  if (item.col->isNull(row)) {
+    return;
+  }
+  switch (item.col->type()) {
+    case Column::Type::kBool:
+      // Counted only
+      ++data->count;
+      break;
+    case Column::Type::kInt:
+      accumulate(item.func, item.col->ints()[row], data);
+      break;
+    case Column::Type::kFloat:
+      accumulate(item.func, item.col->floats()[row], data);
+      break;
+    case Column::Type::kValue:
+      DLOG(FATAL) << "Untyped column";
+      break;
+  }
+}
+
+// Same as AggData::result() of the item
+Value result(const TypedItem& item, const TypedAggData& data, const std::vector<Row>& rows) {
+  bool isFloat = item.col != nullptr && item.col->type() == Column::Type::kFloat;
+  switch (item.func) {
+    case TypedItem::Func::kLast:
+      return rows[data.last].values[item.index];
+    case TypedItem::Func::kCount:
+      return data.count;
+    case TypedItem::Func::kSum:
+      if (data.overflow) {
+        return Value::kNullOverflow;
+      }
+      // The sum starts from the int 0
+      if (isFloat && data.count > 0) {
+        return data.floatValue;
+      }
+      return data.intValue;
+    case TypedItem::Func::kAvg:
+      if (data.count == 0) {
+        return Value::kNullValue;
+      }
+      return data.floatValue / static_cast<double>(data.count);
+    case TypedItem::Func::kMax:
+    case TypedItem::Func::kMin:
+      if (data.count == 0) {
+        return Value::kNullValue;
+      }
+      return isFloat ? Value(data.floatValue) : Value(data.intValue);
+  }
+  return Value::kNullValue;
+}
+
+}  // namespace
+
 folly::Future<Status> AggregateExecutor::execute() {
   SCOPED_TIMER(&execTime_);
   auto* agg = asNode<Aggregate>(node());
-  auto groupKeys = agg->groupKeys();
-  auto groupItems = agg->groupItems();
+  auto& groupItems = agg->groupItems();
   auto iter = ectx_->getResult(agg->inputVar()).iter();
   DCHECK(!!iter);
+  if (iter->isSequentialIter() && FLAGS_query_memory_budget_bytes > 0) {
+    auto bytes = SpillFile::estimateSize(iter->valuePtr()->getDataSet().rows);
+    if (SpillFile::exceedsBudget(bytes)) {
+      return spillAggregate(iter.get(), bytes);
+    }
+  }
+  if (canParallelize(iter.get())) {
+    return parallelAggregate(std::move(iter));
+  }
+  if (iter->isSequentialIter() && iter->valid()) {
+    DataSet ds;
+    if (aggregateByTypedColumns(static_cast<SequentialIter*>(iter.get()), &ds)) {
+      otherStats_.emplace("aggregate by", "typed columns");
+      return finish(ResultBuilder().value(Value(std::move(ds))).build());
+    }
+  }
   QueryExpressionContext ctx(ectx_);
 
-  std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
+  AggResult result;
 
   // generate default result when input dataset is empty
   if (UNLIKELY(!iter->valid())) {
@@ -45,45 +217,391 @@ folly::Future<Status> AggregateExecutor::execute() {
     }
   }
 
+  auto keys = compileKeys();
+  auto items = compileItems();
   for (; iter->valid(); iter->next()) {
     List list;
-    for (auto* key : groupKeys) {
-      list.values.emplace_back(key->eval(ctx(iter.get())));
+    list.values.reserve(keys.size());
+    for (auto& key : keys) {
+      list.values.emplace_back(key.eval(ctx(iter.get())));
     }
+    aggregateRow(iter.get(), std::move(list), items, ctx, result);
+  }
 
-    auto it = result.find(list);
-    if (it == result.end()) {
-      std::vector<std::unique_ptr<AggData>> cols;
-      for (size_t i = 0; i < groupItems.size(); ++i) {
-        cols.emplace_back(new AggData());
+  DataSet ds;
+  ds.colNames = agg->colNames();
+  ds.rows.reserve(result.size());
+  for (auto& kv : result) {
+    Row row;
+    for (auto& v : kv.second) {
+      row.values.emplace_back(v->result());
+    }
+    ds.rows.emplace_back(std::move(row));
+  }
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
+bool AggregateExecutor::aggregateByTypedColumns(SequentialIter* iter, DataSet* ds) const {
+  auto* agg = asNode<Aggregate>(node());
+  auto& colIndices = iter->getColIndices();
+  ColumnarBatch batch(iter->rows_);
+
+  // The keys of the typed INT or BOOL columns
+  std::vector<const Column*> keys;
+  for (auto* expr : agg->groupKeys()) {
+    size_t index = 0;
+    if (!inputColumn(expr, colIndices, &index)) {
+      return false;
+    }
+    auto* col = batch.typedColumn(index);
+    if (col == nullptr || col->type() == Column::Type::kFloat) {
+      return false;
+    }
+    keys.emplace_back(col);
+  }
+
+  std::vector<TypedItem> items;
+  for (auto* expr : agg->groupItems()) {
+    TypedItem item{TypedItem::Func::kLast, 0, nullptr};
+    const Expression* arg = expr;
+    if (expr->kind() == Expression::Kind::kAggregate) {
+      auto* aggExpr = static_cast<AggregateExpression*>(expr);
+      if (aggExpr->distinct()) {
+        return false;
       }
-      result.emplace(std::make_pair(list, std::move(cols)));
-    } else {
-      DCHECK_EQ(it->second.size(), groupItems.size());
+      auto name = aggExpr->name();
+      std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+      static const std::unordered_map<std::string, TypedItem::Func> kFuncs = {
+          {"", TypedItem::Func::kLast},
+          {"COUNT", TypedItem::Func::kCount},
+          {"SUM", TypedItem::Func::kSum},
+          {"AVG", TypedItem::Func::kAvg},
+          {"MAX", TypedItem::Func::kMax},
+          {"MIN", TypedItem::Func::kMin},
+      };
+      auto func = kFuncs.find(name);
+      if (func == kFuncs.end()) {
+        return false;
+      }
+      item.func = func->second;
+      arg = aggExpr->arg();
     }
+    if (item.func == TypedItem::Func::kCount && arg != nullptr &&
+        arg->kind() == Expression::Kind::kConstant) {
+      // Count all rows, e.g. COUNT(*)
+      auto& constant = static_cast<const ConstantExpression*>(arg)->value();
+      if (constant.isNull() || constant.empty()) {
+        return false;
+      }
+      items.emplace_back(item);
+      continue;
+    }
+    if (!inputColumn(arg, colIndices, &item.index)) {
+      return false;
+    }
+    if (item.func != TypedItem::Func::kLast) {
+      item.col = batch.typedColumn(item.index);
+      if (item.col == nullptr) {
+        return false;
+      }
+      // Only counted, the other functions of BOOL are the bad type
+      if (item.func != TypedItem::Func::kCount && item.col->type() == Column::Type::kBool) {
+        return false;
+      }
+    }
+    items.emplace_back(item);
+  }
 
-    for (size_t i = 0; i < groupItems.size(); ++i) {
-      auto* item = groupItems[i];
-      if (item->kind() == Expression::Kind::kAggregate) {
-        static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
-        item->eval(ctx(iter.get()));
+  // Group key of a row, i.e. whether the key is NULL and its value of each key column
+  std::vector<int64_t> key(keys.size() * 2);
+  auto hash = [](const std::vector<int64_t>& k) {
+    return folly::hash::hash_range(k.begin(), k.end());
+  };
+  std::unordered_map<std::vector<int64_t>, size_t, decltype(hash)> groups(16, hash);
+  // The aggregate data of the items of the groups, in the order the groups first appear
+  std::vector<TypedAggData> aggData;
+  for (auto row : batch.selection()) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto* col = keys[i];
+      bool isNull = col->isNull(row);
+      key[i * 2] = isNull;
+      if (isNull) {
+        key[i * 2 + 1] = 0;
+      } else if (col->type() == Column::Type::kInt) {
+        key[i * 2 + 1] = col->ints()[row];
       } else {
-        result[list][i]->setResult(item->eval(ctx(iter.get())));
+        key[i * 2 + 1] = col->bools()[row];
       }
     }
+    auto group = groups.find(key);
+    if (group == groups.end()) {
+      group = groups.emplace(key, groups.size()).first;
+      aggData.resize(aggData.size() + items.size());
+    }
+    auto* data = &aggData[group->second * items.size()];
+    for (size_t i = 0; i < items.size(); ++i) {
+      accumulate(items[i], row, &data[i]);
+    }
+  }
+
+  ds->colNames = agg->colNames();
+  ds->rows.reserve(groups.size());
+  for (size_t group = 0; group < groups.size(); ++group) {
+    Row row;
+    row.values.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+      row.values.emplace_back(result(items[i], aggData[group * items.size() + i], batch.rows()));
+    }
+    ds->rows.emplace_back(std::move(row));
+  }
+  return true;
+}
+
+void AggregateExecutor::aggregateRow(Iterator* iter,
+                                     List&& key,
+                                     CompiledItems& groupItems,
+                                     QueryExpressionContext& ctx,
+                                     AggResult& result) const {
+  auto it = result.find(key);
+  if (it == result.end()) {
+    std::vector<std::unique_ptr<AggData>> cols;
+    cols.reserve(groupItems.size());
+    for (size_t i = 0; i < groupItems.size(); ++i) {
+      cols.emplace_back(new AggData());
+    }
+    it = result.emplace(std::move(key), std::move(cols)).first;
+  } else {
+    DCHECK_EQ(it->second.size(), groupItems.size());
   }
 
+  auto& cols = it->second;
+  for (size_t i = 0; i < groupItems.size(); ++i) {
+    auto& item = groupItems[i];
+    auto& val = item.vm.eval(ctx(iter));
+    if (item.agg != nullptr) {
+      item.agg->accumulate(cols[i].get(), val);
+    } else {
+      cols[i]->setResult(val);
+    }
+  }
+}
+
+std::vector<ExprVM> AggregateExecutor::compileKeys() const {
+  auto& groupKeys = asNode<Aggregate>(node())->groupKeys();
+  std::vector<ExprVM> keys;
+  keys.reserve(groupKeys.size());
+  for (auto* key : groupKeys) {
+    keys.emplace_back(key);
+  }
+  return keys;
+}
+
+AggregateExecutor::CompiledItems AggregateExecutor::compileItems() const {
+  auto& groupItems = asNode<Aggregate>(node())->groupItems();
+  CompiledItems items;
+  items.reserve(groupItems.size());
+  for (auto* item : groupItems) {
+    if (item->kind() == Expression::Kind::kAggregate) {
+      auto* agg = static_cast<const AggregateExpression*>(item);
+      items.emplace_back(CompiledItem{agg, ExprVM(agg->arg())});
+    } else {
+      items.emplace_back(CompiledItem{nullptr, ExprVM(item)});
+    }
+  }
+  return items;
+}
+
+folly::Future<Status> AggregateExecutor::spillAggregate(Iterator *iter, size_t bytes) {
+  auto *agg = asNode<Aggregate>(node());
+  auto groupKeys = compileKeys();
+  auto groupItems = compileItems();
+  auto partitions = SpillFile::makePartitions(bytes);
+  NG_RETURN_IF_ERROR(partitions);
+  auto files = std::move(partitions).value();
+  auto colNames = iter->valuePtr()->getDataSet().colNames;
+  // Release the memory of input rows once they are written to disk if this is the last user
+  bool mv = movable(agg->inputVars().front());
+  QueryExpressionContext ctx(ectx_);
+  for (; iter->valid(); iter->next()) {
+    List list;
+    list.values.reserve(groupKeys.size());
+    for (auto &key : groupKeys) {
+      list.values.emplace_back(key.eval(ctx(iter)));
+    }
+    auto partId = SpillFile::partitionOf(std::hash<List>()(list), files.size());
+    NG_RETURN_IF_ERROR(files[partId]->append(mv ? iter->moveRow() : *iter->row()));
+  }
+
+  // Each group belongs to exactly one partition, so aggregate the partitions one by one
   DataSet ds;
   ds.colNames = agg->colNames();
-  ds.rows.reserve(result.size());
+  size_t spilledBytes = 0;
+  for (auto &file : files) {
+    spilledBytes += file->bytes();
+    DataSet input;
+    input.colNames = colNames;
+    NG_RETURN_IF_ERROR(file->readAll(&input.rows));
+    file.reset();
+    SequentialIter partIter(std::make_shared<Value>(std::move(input)));
+    AggResult result;
+    for (; partIter.valid(); partIter.next()) {
+      List list;
+      list.values.reserve(groupKeys.size());
+      for (auto &key : groupKeys) {
+        list.values.emplace_back(key.eval(ctx(&partIter)));
+      }
+      aggregateRow(&partIter, std::move(list), groupItems, ctx, result);
+    }
+    for (auto &kv : result) {
+      Row row;
+      row.values.reserve(kv.second.size());
+      for (auto &v : kv.second) {
+        row.values.emplace_back(v->result());
+      }
+      ds.rows.emplace_back(std::move(row));
+    }
+  }
+  otherStats_.emplace("spilled_partitions", folly::to<std::string>(files.size()));
+  otherStats_.emplace("spilled_bytes", folly::to<std::string>(spilledBytes));
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
+bool AggregateExecutor::canParallelize(const Iterator* iter) const {
+  if (FLAGS_num_operator_threads < 2 || iter->size() < FLAGS_min_rows_for_parallel_operator) {
+    return false;
+  }
+  // The default row of the empty input is generated by the serial path
+  if (!iter->valid()) {
+    return false;
+  }
+  // Only the sequential iterators could be positioned to any row in constant time
+  if (!iter->isSequentialIter() && !iter->isPropIter()) {
+    return false;
+  }
+  auto* agg = asNode<Aggregate>(node());
+  for (auto* expr : agg->groupKeys()) {
+    if (ExpressionUtils::writesContextVar(expr)) {
+      return false;
+    }
+  }
+  for (auto* expr : agg->groupItems()) {
+    if (ExpressionUtils::writesContextVar(expr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+folly::Future<Status> AggregateExecutor::parallelAggregate(std::unique_ptr<Iterator> iter) {
+  auto* agg = asNode<Aggregate>(node());
+  auto numThreads = static_cast<size_t>(FLAGS_num_operator_threads);
+  auto totalSize = iter->size();
+  auto batchSize = (totalSize + numThreads - 1) / numThreads;
+
+  // Compile the expressions for each thread before dispatching, the sub-trees which are not
+  // lowered are cloned by the VMs.
+  std::vector<std::vector<ExprVM>> keysOfThreads;
+  std::vector<CompiledItems> itemsOfThreads;
+  for (size_t i = 0; i < numThreads; ++i) {
+    keysOfThreads.emplace_back(compileKeys());
+    itemsOfThreads.emplace_back(compileItems());
+  }
+
+  auto input = std::shared_ptr<Iterator>(std::move(iter));
+  std::vector<folly::Future<Partitions>> futures;
+  for (size_t begin = 0, i = 0; begin < totalSize; begin += batchSize, ++i) {
+    auto end = std::min(begin + batchSize, totalSize);
+    auto future = folly::via(
+        runner(),
+        [this, input, begin, end, numThreads, keys = std::move(keysOfThreads[i])]() mutable {
+          auto threadIter = input->copy();
+          return partition(threadIter.get(), begin, end, keys, numThreads);
+        });
+    futures.emplace_back(std::move(future));
+  }
+
+  return folly::collect(futures)
+      .via(runner())
+      .thenValue([this, input, numThreads, itemsOfThreads = std::move(itemsOfThreads)](
+                     std::vector<Partitions>&& partitions) mutable {
+        auto shared = std::make_shared<std::vector<Partitions>>(std::move(partitions));
+        std::vector<folly::Future<std::vector<Row>>> aggFutures;
+        for (size_t partId = 0; partId < numThreads; ++partId) {
+          auto future = folly::via(
+              runner(),
+              [this, input, shared, partId, items = std::move(itemsOfThreads[partId])]() mutable {
+                auto threadIter = input->copy();
+                return aggregate(threadIter.get(), shared.get(), partId, items);
+              });
+          aggFutures.emplace_back(std::move(future));
+        }
+        return folly::collect(aggFutures).via(runner());
+      })
+      .thenValue([this, agg, numThreads](std::vector<std::vector<Row>>&& rowsOfPartitions) {
+        DataSet ds;
+        ds.colNames = agg->colNames();
+        size_t size = 0;
+        for (auto& rows : rowsOfPartitions) {
+          size += rows.size();
+        }
+        ds.rows.reserve(size);
+        for (auto& rows : rowsOfPartitions) {
+          ds.rows.insert(ds.rows.end(),
+                         std::make_move_iterator(rows.begin()),
+                         std::make_move_iterator(rows.end()));
+        }
+        otherStats_.emplace("parallel", folly::to<std::string>(numThreads));
+        return finish(ResultBuilder().value(Value(std::move(ds))).build());
+      });
+}
+
+AggregateExecutor::Partitions AggregateExecutor::partition(
+    Iterator* iter,
+    size_t begin,
+    size_t end,
+    std::vector<ExprVM>& groupKeys,
+    size_t numPartitions) const {
+  Partitions partitions(numPartitions);
+  QueryExpressionContext ctx(ectx_);
+  iter->reset(begin);
+  for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
+    List list;
+    list.values.reserve(groupKeys.size());
+    for (auto& key : groupKeys) {
+      list.values.emplace_back(key.eval(ctx(iter)));
+    }
+    auto partId = folly::hash::twang_mix64(std::hash<List>()(list)) % numPartitions;
+    partitions[partId].emplace_back(i, std::move(list));
+  }
+  return partitions;
+}
+
+std::vector<Row> AggregateExecutor::aggregate(Iterator* iter,
+                                              std::vector<Partitions>* partitions,
+                                              size_t partId,
+                                              CompiledItems& groupItems) const {
+  AggResult result;
+  QueryExpressionContext ctx(ectx_);
+  // Visit the batches in order, so that the rows of each group are aggregated in input order.
+  // Each partition is only visited by one thread, so it's safe to move the keys.
+  for (auto& batch : *partitions) {
+    for (auto& keyOfRow : batch[partId]) {
+      iter->reset(keyOfRow.first);
+      aggregateRow(iter, std::move(keyOfRow.second), groupItems, ctx, result);
+    }
+  }
+
+  std::vector<Row> rows;
+  rows.reserve(result.size());
   for (auto& kv : result) {
     Row row;
+    row.values.reserve(kv.second.size());
     for (auto& v : kv.second) {
       row.values.emplace_back(v->result());
     }
-    ds.rows.emplace_back(std::move(row));
+    rows.emplace_back(std::move(row));
   }
-  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+  return rows;
 }
 
 }  // namespace graph
@@ -5,9 +5,29 @@
 #ifndef GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 
+#include "common/expression/ExprProgram.h"
+#include "common/function/AggFunctionManager.h"
+#include "graph/context/QueryExpressionContext.h"
 #include "graph/executor/Executor.h"
+#include "graph/util/SpillFile.h"
+
 // calculate a set of data uniformly. use values ​​from multiple records as input
 // and convert those values ​​into one value to aggregate all records
+//
+// Large sequential inputs are aggregated in two phases by `num_operator_threads' threads:
+// First : each thread evaluates the group keys of a contiguous range of rows and scatters
+//         (row index, group key) into partitions by the hash of key
+// Second: each thread aggregates all rows of one partition, so that every group is owned by
+//         exactly one thread and no merge of AggData is required
+// Group keys and the arguments of group items are compiled into ExprVMs, which keep the
+// evaluation results in their registers, so every thread works on its own VMs.
+//
+// Once the input exceeds `query_memory_budget_bytes', the rows are scattered into spill files by
+// the hash of group key (grace hash aggregation), and the partitions are read back and
+// aggregated one at a time, so only the groups of one partition are kept in memory.
+//
+// The other sequential inputs are aggregated over the typed columns if the keys and the items
+// are simple enough, see aggregateByTypedColumns().
 namespace nebula {
 namespace graph {
 
@@ -17,6 +37,52 @@ class AggregateExecutor final : public Executor {
       : Executor("AggregateExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  using AggResult =
+      std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>>;
+  // partition id -> [(row index, group key)]
+  using Partitions = std::vector<std::vector<std::pair<size_t, List>>>;
+
+  struct CompiledItem {
+    // The aggregate expression of the item, nullptr if the item is not aggregated
+    const AggregateExpression *agg;
+    // The argument of the aggregate function, or the item itself
+    ExprVM vm;
+  };
+  using CompiledItems = std::vector<CompiledItem>;
+
+  std::vector<ExprVM> compileKeys() const;
+
+  CompiledItems compileItems() const;
+
+  folly::Future<Status> spillAggregate(Iterator *iter, size_t bytes);
+
+  bool canParallelize(const Iterator *iter) const;
+
+  // Aggregate over the typed columns of the input instead of the rows of Values, if the group
+  // keys are the input columns of INT or BOOL, and the group items are the input columns, or
+  // COUNT, SUM, AVG, MAX and MIN of the input columns of INT or FLOAT, return false otherwise.
+  bool aggregateByTypedColumns(SequentialIter *iter, DataSet *ds) const;
+
+  folly::Future<Status> parallelAggregate(std::unique_ptr<Iterator> iter);
+
+  Partitions partition(Iterator *iter,
+                       size_t begin,
+                       size_t end,
+                       std::vector<ExprVM> &groupKeys,
+                       size_t numPartitions) const;
+
+  std::vector<Row> aggregate(Iterator *iter,
+                             std::vector<Partitions> *partitions,
+                             size_t partId,
+                             CompiledItems &groupItems) const;
+
+  void aggregateRow(Iterator *iter,
+                    List &&key,
+                    CompiledItems &groupItems,
+                    QueryExpressionContext &ctx,
+                    AggResult &result) const;
 };
 
 }  // namespace graph
@@ -5,6 +5,7 @@
 #include "graph/executor/query/DedupExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 namespace nebula {
 namespace graph {
 folly::Future<Status> DedupExecutor::execute() {
@@ -21,6 +22,15 @@ folly::Future<Status> DedupExecutor::execute() {
   if (UNLIKELY(iter->isGetNeighborsIter() || iter->isDefaultIter())) {
     return Status::Error("Invalid iterator kind, %d", static_cast<uint16_t>(iter->kind()));
   }
+  // The hash set only keeps the address of rows, so spill could not save anything unless the
+  // input rows could be released
+  if (iter->isSequentialIter() && FLAGS_query_memory_budget_bytes > 0 &&
+      movable(dedup->inputVars().front())) {
+    auto bytes = SpillFile::estimateSize(iter->valuePtr()->getDataSet().rows);
+    if (SpillFile::exceedsBudget(bytes)) {
+      return spillDedup(iter, bytes);
+    }
+  }
   std::unordered_set<const Row*> unique;
   unique.reserve(iter->size());
   while (iter->valid()) {
@@ -34,5 +44,37 @@ folly::Future<Status> DedupExecutor::execute() {
   return finish(std::move(result));
 }
 
+folly::Future<Status> DedupExecutor::spillDedup(Iterator* iter, size_t bytes) {
+  auto partitions = SpillFile::makePartitions(bytes);
+  NG_RETURN_IF_ERROR(partitions);
+  auto files = std::move(partitions).value();
+  DataSet ds;
+  ds.colNames = iter->valuePtr()->getDataSet().colNames;
+  for (; iter->valid(); iter->next()) {
+    auto partId = SpillFile::partitionOf(std::hash<Row>()(*iter->row()), files.size());
+    NG_RETURN_IF_ERROR(files[partId]->append(iter->moveRow()));
+  }
+
+  // The duplicated rows always belong to the same partition
+  size_t spilledBytes = 0;
+  std::vector<Row> rows;
+  for (auto& file : files) {
+    spilledBytes += file->bytes();
+    NG_RETURN_IF_ERROR(file->readAll(&rows));
+    file.reset();
+    std::unordered_set<Row> unique;
+    unique.reserve(rows.size());
+    for (auto& row : rows) {
+      unique.emplace(std::move(row));
+    }
+    while (!unique.empty()) {
+      ds.rows.emplace_back(std::move(unique.extract(unique.begin()).value()));
+    }
+  }
+  otherStats_.emplace("spilled_partitions", folly::to<std::string>(files.size()));
+  otherStats_.emplace("spilled_bytes", folly::to<std::string>(spilledBytes));
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -6,6 +6,7 @@
 #define GRAPH_EXECUTOR_QUERY_DEDUPEXECUTOR_H_
 
 #include "graph/executor/Executor.h"
+#include "graph/util/SpillFile.h"
 // delete the corresponding iterator, when there are duplicate rows in the dataset.
 // and then save the filtered iterator to the result
 namespace nebula {
@@ -16,6 +17,10 @@ class DedupExecutor final : public Executor {
   DedupExecutor(const PlanNode *node, QueryContext *qctx) : Executor("DedupExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Scatter the rows into spill files by their hash, then dedup the partitions one by one
+  folly::Future<Status> spillDedup(Iterator *iter, size_t bytes);
 };
 
 }  // namespace graph
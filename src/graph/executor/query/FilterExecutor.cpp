@@ -4,12 +4,170 @@
 
 #include "graph/executor/query/FilterExecutor.h"
 
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "graph/context/ColumnarBatch.h"
 #include "graph/planner/plan/Query.h"
 
 namespace nebula {
 namespace graph {
 
-folly::Future<Status> FilterExecutor::execute() {
+namespace {
+
+// Whether the row of `iter' satisfies the condition
+StatusOr<bool> accept(ExprVM* condition, QueryExpressionContext& ctx, Iterator* iter) {
+  auto& val = condition->eval(ctx(iter));
+  if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
+    return Status::Error("Wrong type result, the type should be NULL, EMPTY, BOOL");
+  }
+  return !(val.empty() || val.isNull() || (val.isImplicitBool() && !val.implicitBool()));
+}
+
+// The comparison between an input column and a constant, i.e. `$-.col <op> constant'
+struct Comparison {
+  size_t col;
+  Expression::Kind op;
+  Value constant;
+};
+
+// The operator of `rhs <op> lhs' same as `lhs <op> rhs'
+Expression::Kind flip(Expression::Kind op) {
+  switch (op) {
+    case Expression::Kind::kRelLT:
+      return Expression::Kind::kRelGT;
+    case Expression::Kind::kRelLE:
+      return Expression::Kind::kRelGE;
+    case Expression::Kind::kRelGT:
+      return Expression::Kind::kRelLT;
+    case Expression::Kind::kRelGE:
+      return Expression::Kind::kRelLE;
+    default:
+      return op;
+  }
+}
+
+// Collect the comparisons of the condition if it's a conjunction of them, return false otherwise
+bool collectComparisons(const Expression* expr,
+                        const std::unordered_map<std::string, size_t>& colIndices,
+                        std::vector<Comparison>* comparisons) {
+  switch (expr->kind()) {
+    case Expression::Kind::kLogicalAnd: {
+      for (auto* operand : static_cast<const LogicalExpression*>(expr)->operands()) {
+        if (!collectComparisons(operand, colIndices, comparisons)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Expression::Kind::kRelEQ:
+    case Expression::Kind::kRelNE:
+    case Expression::Kind::kRelLT:
+    case Expression::Kind::kRelLE:
+    case Expression::Kind::kRelGT:
+    case Expression::Kind::kRelGE: {
+      auto* rel = static_cast<const RelationalExpression*>(expr);
+      auto op = expr->kind();
+      auto* prop = rel->left();
+      auto* constant = rel->right();
+      if (prop->kind() == Expression::Kind::kConstant) {
+        std::swap(prop, constant);
+        op = flip(op);
+      }
+      if (prop->kind() != Expression::Kind::kInputProperty ||
+          constant->kind() != Expression::Kind::kConstant) {
+        return false;
+      }
+      auto index = colIndices.find(static_cast<const InputPropertyExpression*>(prop)->prop());
+      auto& value = static_cast<const ConstantExpression*>(constant)->value();
+      if (index == colIndices.end() || !(value.isBool() || value.isNumeric())) {
+        return false;
+      }
+      comparisons->emplace_back(Comparison{index->second, op, value});
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Same as RelationalExpression, which compares the numbers of different types with kEpsilon
+template <typename L, typename R>
+bool compare(Expression::Kind op, L lhs, R rhs) {
+  bool lt, eq;
+  if constexpr (std::is_floating_point<L>::value || std::is_floating_point<R>::value) {
+    auto diff = std::abs(static_cast<double>(lhs) - static_cast<double>(rhs));
+    eq = diff < kEpsilon;
+    lt = !eq && static_cast<double>(lhs) < static_cast<double>(rhs);
+  } else {
+    eq = lhs == rhs;
+    lt = lhs < rhs;
+  }
+  switch (op) {
+    case Expression::Kind::kRelEQ:
+      return eq;
+    case Expression::Kind::kRelNE:
+      return !eq;
+    case Expression::Kind::kRelLT:
+      return lt;
+    case Expression::Kind::kRelLE:
+      return lt || eq;
+    case Expression::Kind::kRelGT:
+      return !lt && !eq;
+    case Expression::Kind::kRelGE:
+      return !lt || eq;
+    default:
+      DLOG(FATAL) << "Unexpected comparison";
+      return false;
+  }
+}
+
+// Keep the selected rows whose cells of the typed column satisfy the comparison, the NULL cells
+// are compared to NULL, which never satisfies it
+template <typename T, typename C>
+void refine(ColumnarBatch* batch,
+            const Column& col,
+            const std::vector<T>& cells,
+            Expression::Kind op,
+            C constant) {
+  batch->refine([&](size_t i) { return !col.isNull(i) && compare(op, cells[i], constant); });
+}
+
+// Whether the comparison of the typed column could be done without Value, the numbers of
+// different types and the BOOLs are compared as Value
+bool comparable(const Column& col, const Value& constant) {
+  return col.type() == Column::Type::kBool ? constant.isBool() : constant.isNumeric();
+}
+
+void refine(ColumnarBatch* batch, const Column& col, const Comparison& cmp) {
+  switch (col.type()) {
+    case Column::Type::kBool:
+      refine(batch, col, col.bools(), cmp.op, static_cast<uint8_t>(cmp.constant.getBool()));
+      break;
+    case Column::Type::kInt:
+      if (cmp.constant.isInt()) {
+        refine(batch, col, col.ints(), cmp.op, cmp.constant.getInt());
+      } else {
+        refine(batch, col, col.ints(), cmp.op, cmp.constant.getFloat());
+      }
+      break;
+    case Column::Type::kFloat:
+      if (cmp.constant.isInt()) {
+        refine(batch, col, col.floats(), cmp.op, cmp.constant.getInt());
+      } else {
+        refine(batch, col, col.floats(), cmp.op, cmp.constant.getFloat());
+      }
+      break;
+    case Column::Type::kValue:
+      DLOG(FATAL) << "Untyped column";
+      break;
+  }
+}
+
+}  // namespace
+
+folly::Future<Status> FilterExecutor::executeAll() {
   SCOPED_TIMER(&execTime_);
   auto* filter = asNode<Filter>(node());
   Result result = ectx_->getResult(filter->inputVar());
@@ -22,14 +180,18 @@ folly::Future<Status> FilterExecutor::execute() {
 
   ResultBuilder builder;
   builder.value(result.valuePtr());
+  if (iter->isSequentialIter() && filterByTypedColumns(static_cast<SequentialIter*>(iter))) {
+    otherStats_.emplace("filter by", "typed columns");
+    builder.iter(std::move(result).iter());
+    return finish(builder.build());
+  }
+
   QueryExpressionContext ctx(ectx_);
-  auto condition = filter->condition();
+  ExprVM condition(filter->condition());
   while (iter->valid()) {
-    auto val = condition->eval(ctx(iter));
-    if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
-      return Status::Error("Wrong type result, the type should be NULL, EMPTY, BOOL");
-    }
-    if (val.empty() || val.isNull() || (val.isImplicitBool() && !val.implicitBool())) {
+    auto ok = accept(&condition, ctx, iter);
+    NG_RETURN_IF_ERROR(ok);
+    if (!ok.value()) {
       if (UNLIKELY(filter->needStableFilter())) {
         iter->erase();
       } else {
@@ -45,5 +207,48 @@ folly::Future<Status> FilterExecutor::execute() {
   return finish(builder.build());
 }
 
+bool FilterExecutor::filterByTypedColumns(SequentialIter* iter) const {
+  std::vector<Comparison> comparisons;
+  if (iter->size() == 0 ||
+      !collectComparisons(
+          asNode<Filter>(node())->condition(), iter->getColIndices(), &comparisons)) {
+    return false;
+  }
+  ColumnarBatch batch(iter->rows_);
+  std::vector<const Column*> cols;
+  cols.reserve(comparisons.size());
+  for (auto& cmp : comparisons) {
+    auto* col = batch.typedColumn(cmp.col);
+    if (col == nullptr || !comparable(*col, cmp.constant)) {
+      return false;
+    }
+    cols.emplace_back(col);
+  }
+  // The row satisfies the conjunction only if it satisfies all comparisons
+  for (size_t i = 0; i < comparisons.size() && !batch.selection().empty(); ++i) {
+    refine(&batch, *cols[i], comparisons[i]);
+  }
+  iter->keep(batch.selection());
+  return true;
+}
+
+Status FilterExecutor::openBatch() {
+  condition_ = std::make_unique<ExprVM>(asNode<Filter>(node())->condition());
+  return Status::OK();
+}
+
+Status FilterExecutor::processBatch(Iterator* input, DataSet* output, bool* done) {
+  UNUSED(done);
+  QueryExpressionContext ctx(ectx_);
+  for (; input->valid(); input->next()) {
+    auto ok = accept(condition_.get(), ctx, input);
+    NG_RETURN_IF_ERROR(ok);
+    if (ok.value()) {
+      output->rows.emplace_back(input->moveRow());
+    }
+  }
+  return Status::OK();
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -5,19 +5,33 @@
 #ifndef GRAPH_EXECUTOR_QUERY_FILTEREXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_FILTEREXECUTOR_H_
 
-#include "graph/executor/Executor.h"
+#include "common/expression/ExprProgram.h"
+#include "graph/executor/PipelineExecutor.h"
 
 // delete the corresponding iterator when the row in the dataset does not meet the conditions
 // and save the filtered iterator to the result
 namespace nebula {
 namespace graph {
 
-class FilterExecutor final : public Executor {
+class FilterExecutor final : public PipelineExecutor {
  public:
   FilterExecutor(const PlanNode *node, QueryContext *qctx)
-      : Executor("FilterExecutor", node, qctx) {}
+      : PipelineExecutor("FilterExecutor", node, qctx) {}
 
-  folly::Future<Status> execute() override;
+  folly::Future<Status> executeAll() override;
+
+  Status openBatch() override;
+
+  Status processBatch(Iterator *input, DataSet *output, bool *done) override;
+
+ private:
+  // Evaluate the condition over the typed columns of the input instead of the rows of Values if
+  // it's a conjunction of the comparisons between the input columns and the constants, return
+  // false if it's not, or any of the columns could not be stored in a typed column.
+  bool filterByTypedColumns(SequentialIter *iter) const;
+
+  // Condition compiled once for all the morsels of a pipeline
+  std::unique_ptr<ExprVM> condition_;
 };
 
 }  // namespace graph
@@ -33,6 +33,15 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
     return finish(ResultBuilder().value(Value(std::move(result))).build());
   }
 
+  auto bytes = spillBytes();
+  if (bytes > 0) {
+    return graceJoin(hashKeys, probeKeys, colNames, bytes);
+  }
+
+  if (canParallelize(hashKeys, probeKeys)) {
+    return parallelJoin(hashKeys, probeKeys, colNames);
+  }
+
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
     std::unordered_map<Value, std::vector<const Row*>> hashTable;
     hashTable.reserve(bucketSize);
@@ -60,6 +69,87 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
   return finish(ResultBuilder().value(Value(std::move(result))).build());
 }
 
+folly::Future<Status> InnerJoinExecutor::parallelJoin(const std::vector<Expression*>& hashKeys,
+                                                      const std::vector<Expression*>& probeKeys,
+                                                      const std::vector<std::string>& colNames) {
+  // Build the hash table from the smaller side
+  exchange_ = lhsIter_->size() >= rhsIter_->size();
+  auto* buildIter = exchange_ ? rhsIter_.get() : lhsIter_.get();
+  auto* probeIter = exchange_ ? lhsIter_.get() : rhsIter_.get();
+  auto& buildKeys = exchange_ ? probeKeys : hashKeys;
+  auto& probeKeysOfIter = exchange_ ? hashKeys : probeKeys;
+
+  folly::Future<DataSet> future = folly::makeFuture(DataSet());
+  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
+    future = partitionedJoin<Value>(
+        buildKeys,
+        buildIter,
+        probeKeysOfIter,
+        probeIter,
+        [this](const HashTable<Value>& hashTable, const Value& val, const Row& row, DataSet& ds) {
+          buildNewRow<Value>(hashTable, val, row, ds);
+        });
+  } else {
+    future = partitionedJoin<List>(
+        buildKeys,
+        buildIter,
+        probeKeysOfIter,
+        probeIter,
+        [this](const HashTable<List>& hashTable, const List& val, const Row& row, DataSet& ds) {
+          buildNewRow<List>(hashTable, val, row, ds);
+        });
+  }
+  return std::move(future).thenValue([this, colNames](DataSet&& result) {
+    result.colNames = colNames;
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  });
+}
+
+folly::Future<Status> InnerJoinExecutor::graceJoin(const std::vector<Expression*>& hashKeys,
+                                                   const std::vector<Expression*>& probeKeys,
+                                                   const std::vector<std::string>& colNames,
+                                                   size_t bytes) {
+  // Build the hash table of each partition from the smaller side
+  exchange_ = lhsIter_->size() >= rhsIter_->size();
+  auto* buildIter = exchange_ ? rhsIter_.get() : lhsIter_.get();
+  auto* probeIter = exchange_ ? lhsIter_.get() : rhsIter_.get();
+  auto& buildKeys = exchange_ ? probeKeys : hashKeys;
+  auto& probeKeysOfIter = exchange_ ? hashKeys : probeKeys;
+  bool buildMovable = inputMovable(exchange_ ? 1 : 0);
+  bool probeMovable = inputMovable(exchange_ ? 0 : 1);
+
+  StatusOr<DataSet> result;
+  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
+    result = spilledJoin<Value>(
+        buildKeys,
+        buildIter,
+        buildMovable,
+        probeKeysOfIter,
+        probeIter,
+        probeMovable,
+        bytes,
+        [this](const HashTable<Value>& hashTable, const Value& val, const Row& row, DataSet& ds) {
+          buildNewRow<Value>(hashTable, val, row, ds);
+        });
+  } else {
+    result = spilledJoin<List>(
+        buildKeys,
+        buildIter,
+        buildMovable,
+        probeKeysOfIter,
+        probeIter,
+        probeMovable,
+        bytes,
+        [this](const HashTable<List>& hashTable, const List& val, const Row& row, DataSet& ds) {
+          buildNewRow<List>(hashTable, val, row, ds);
+        });
+  }
+  NG_RETURN_IF_ERROR(result);
+  auto ds = std::move(result).value();
+  ds.colNames = colNames;
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
 DataSet InnerJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
@@ -4,11 +4,33 @@
 
 #include "graph/executor/query/JoinExecutor.h"
 
+#include <folly/hash/Hash.h>
+
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+template <class T>
+T evalKey(const std::vector<Expression*>& keys, Iterator* iter, QueryExpressionContext& ctx) {
+  T key;
+  if constexpr (std::is_same<T, Value>::value) {
+    key = keys.front()->eval(ctx(iter));
+  } else {
+    key.values.reserve(keys.size());
+    for (auto* col : keys) {
+      key.values.emplace_back(col->eval(ctx(iter)));
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
 Status JoinExecutor::checkInputDataSets() {
   auto* join = asNode<Join>(node());
   lhsIter_ = ectx_->getVersionedResult(join->leftVar().first, join->leftVar().second).iter();
@@ -80,5 +102,269 @@ void JoinExecutor::buildSingleKeyHashTable(
   }
 }
 
+bool JoinExecutor::canParallelize(const std::vector<Expression*>& hashKeys,
+                                  const std::vector<Expression*>& probeKeys) const {
+  if (FLAGS_num_operator_threads < 2 ||
+      lhsIter_->size() + rhsIter_->size() < FLAGS_min_rows_for_parallel_operator) {
+    return false;
+  }
+  // Only the sequential iterators could be positioned to any row in constant time
+  for (auto* iter : {lhsIter_.get(), rhsIter_.get()}) {
+    if (!iter->isSequentialIter() && !iter->isPropIter()) {
+      return false;
+    }
+  }
+  for (auto* keys : {&hashKeys, &probeKeys}) {
+    for (auto* key : *keys) {
+      if (ExpressionUtils::writesContextVar(key)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class T>
+JoinExecutor::Partitions<T> JoinExecutor::partition(Iterator* iter,
+                                                    size_t begin,
+                                                    size_t end,
+                                                    const std::vector<Expression*>& keys,
+                                                    size_t numPartitions) const {
+  Partitions<T> partitions(numPartitions);
+  QueryExpressionContext ctx(ectx_);
+  iter->reset(begin);
+  for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
+    auto key = evalKey<T>(keys, iter, ctx);
+    auto partId = folly::hash::twang_mix64(std::hash<T>()(key)) % numPartitions;
+    partitions[partId].emplace_back(std::move(key), iter->row());
+  }
+  return partitions;
+}
+
+template <class T>
+folly::Future<DataSet> JoinExecutor::partitionedJoin(const std::vector<Expression*>& buildKeys,
+                                                     Iterator* buildIter,
+                                                     const std::vector<Expression*>& probeKeys,
+                                                     Iterator* probeIter,
+                                                     NewRowBuilder<T> builder) {
+  auto numThreads = static_cast<size_t>(FLAGS_num_operator_threads);
+
+  // Clone the join keys for each thread before dispatching, since the object pool is not
+  // thread safe.
+  auto cloneAll = [](const std::vector<Expression*>& exprs) {
+    std::vector<Expression*> clones;
+    clones.reserve(exprs.size());
+    for (auto* expr : exprs) {
+      clones.emplace_back(expr->clone());
+    }
+    return clones;
+  };
+
+  std::vector<folly::Future<Partitions<T>>> futures;
+  auto scatter = [&](Iterator* iter, const std::vector<Expression*>& keys) {
+    auto totalSize = iter->size();
+    auto batchSize = (totalSize + numThreads - 1) / numThreads;
+    for (size_t begin = 0; begin < totalSize; begin += batchSize) {
+      auto end = std::min(begin + batchSize, totalSize);
+      auto future = folly::via(
+          runner(), [this, iter, begin, end, numThreads, keys = cloneAll(keys)]() {
+            auto threadIter = iter->copy();
+            return partition<T>(threadIter.get(), begin, end, keys, numThreads);
+          });
+      futures.emplace_back(std::move(future));
+    }
+    return futures.size();
+  };
+  auto numBuildBatches = scatter(buildIter, buildKeys);
+  scatter(probeIter, probeKeys);
+
+  struct PartitionResult {
+    DataSet ds;
+    uint64_t buildTime{0};
+    uint64_t probeTime{0};
+    size_t numRows{0};
+  };
+
+  return folly::collect(futures)
+      .via(runner())
+      .thenValue([this, numThreads, numBuildBatches, builder = std::move(builder)](
+                     std::vector<Partitions<T>>&& batches) {
+        auto shared = std::make_shared<std::vector<Partitions<T>>>(std::move(batches));
+        std::vector<folly::Future<PartitionResult>> joinFutures;
+        for (size_t partId = 0; partId < numThreads; ++partId) {
+          auto future = folly::via(runner(), [shared, partId, numBuildBatches, builder]() {
+            PartitionResult result;
+            time::Duration buildTime;
+            HashTable<T> hashTable;
+            for (size_t i = 0; i < numBuildBatches; ++i) {
+              for (auto& keyOfRow : (*shared)[i][partId]) {
+                hashTable[keyOfRow.first].emplace_back(keyOfRow.second);
+                ++result.numRows;
+              }
+            }
+            result.buildTime = buildTime.elapsedInUSec();
+
+            time::Duration probeTime;
+            for (size_t i = numBuildBatches; i < shared->size(); ++i) {
+              for (auto& keyOfRow : (*shared)[i][partId]) {
+                builder(hashTable, keyOfRow.first, *keyOfRow.second, result.ds);
+                ++result.numRows;
+              }
+            }
+            result.probeTime = probeTime.elapsedInUSec();
+            return result;
+          });
+          joinFutures.emplace_back(std::move(future));
+        }
+        return folly::collect(joinFutures).via(runner());
+      })
+      .thenValue([this, numThreads](std::vector<PartitionResult>&& results) {
+        DataSet ds;
+        size_t size = 0;
+        uint64_t buildTime = 0;
+        uint64_t probeTime = 0;
+        size_t maxRows = 0;
+        size_t totalRows = 0;
+        for (auto& result : results) {
+          size += result.ds.rows.size();
+          buildTime = std::max(buildTime, result.buildTime);
+          probeTime = std::max(probeTime, result.probeTime);
+          maxRows = std::max(maxRows, result.numRows);
+          totalRows += result.numRows;
+        }
+        ds.rows.reserve(size);
+        for (auto& result : results) {
+          ds.rows.insert(ds.rows.end(),
+                         std::make_move_iterator(result.ds.rows.begin()),
+                         std::make_move_iterator(result.ds.rows.end()));
+        }
+        // The skew is the ratio of the largest partition to the average one, 1.0 is perfect
+        auto avgRows = static_cast<double>(totalRows) / numThreads;
+        auto skew = avgRows > 0 ? maxRows / avgRows : 1.0;
+        otherStats_.emplace("parallel", folly::to<std::string>(numThreads));
+        otherStats_.emplace("build_time", folly::sformat("{}(us)", buildTime));
+        otherStats_.emplace("probe_time", folly::sformat("{}(us)", probeTime));
+        otherStats_.emplace("partition_skew", folly::sformat("{:.2f}", skew));
+        return ds;
+      });
+}
+
+size_t JoinExecutor::spillBytes() {
+  if (FLAGS_query_memory_budget_bytes <= 0 || !lhsIter_->isSequentialIter() ||
+      !rhsIter_->isSequentialIter()) {
+    return 0;
+  }
+  auto bytes = SpillFile::estimateSize(lhsIter_->valuePtr()->getDataSet().rows) +
+               SpillFile::estimateSize(rhsIter_->valuePtr()->getDataSet().rows);
+  if (!SpillFile::exceedsBudget(bytes) || (!inputMovable(0) && !inputMovable(1))) {
+    return 0;
+  }
+  return bytes;
+}
+
+bool JoinExecutor::inputMovable(size_t index) {
+  auto& vars = node()->inputVars();
+  return index < vars.size() && vars[index] != nullptr && movable(vars[index]);
+}
+
+template <class T>
+Status JoinExecutor::spill(const std::vector<Expression*>& keys,
+                           Iterator* iter,
+                           bool mv,
+                           std::vector<std::unique_ptr<SpillFile>>& files) const {
+  QueryExpressionContext ctx(ectx_);
+  for (iter->reset(); iter->valid(); iter->next()) {
+    auto key = evalKey<T>(keys, iter, ctx);
+    auto partId = SpillFile::partitionOf(std::hash<T>()(key), files.size());
+    NG_RETURN_IF_ERROR(files[partId]->append(mv ? iter->moveRow() : *iter->row()));
+  }
+  return Status::OK();
+}
+
+template <class T>
+StatusOr<DataSet> JoinExecutor::spilledJoin(const std::vector<Expression*>& buildKeys,
+                                            Iterator* buildIter,
+                                            bool buildMovable,
+                                            const std::vector<Expression*>& probeKeys,
+                                            Iterator* probeIter,
+                                            bool probeMovable,
+                                            size_t bytes,
+                                            NewRowBuilder<T> builder) {
+  auto buildPartitions = SpillFile::makePartitions(bytes);
+  NG_RETURN_IF_ERROR(buildPartitions);
+  auto probePartitions = SpillFile::makePartitions(bytes);
+  NG_RETURN_IF_ERROR(probePartitions);
+  auto buildFiles = std::move(buildPartitions).value();
+  auto probeFiles = std::move(probePartitions).value();
+  DCHECK_EQ(buildFiles.size(), probeFiles.size());
+  NG_RETURN_IF_ERROR(spill<T>(buildKeys, buildIter, buildMovable, buildFiles));
+  NG_RETURN_IF_ERROR(spill<T>(probeKeys, probeIter, probeMovable, probeFiles));
+
+  auto readPartition = [](std::unique_ptr<SpillFile>& file,
+                          const Iterator* iter) -> StatusOr<DataSet> {
+    DataSet ds;
+    ds.colNames = iter->valuePtr()->getDataSet().colNames;
+    NG_RETURN_IF_ERROR(file->readAll(&ds.rows));
+    file.reset();
+    return ds;
+  };
+
+  DataSet result;
+  size_t spilledBytes = 0;
+  QueryExpressionContext ctx(ectx_);
+  for (size_t partId = 0; partId < buildFiles.size(); ++partId) {
+    spilledBytes += buildFiles[partId]->bytes() + probeFiles[partId]->bytes();
+    auto buildDs = readPartition(buildFiles[partId], buildIter);
+    NG_RETURN_IF_ERROR(buildDs);
+    SequentialIter buildPart(std::make_shared<Value>(std::move(buildDs).value()));
+    HashTable<T> hashTable;
+    for (; buildPart.valid(); buildPart.next()) {
+      hashTable[evalKey<T>(buildKeys, &buildPart, ctx)].emplace_back(buildPart.row());
+    }
+
+    auto probeDs = readPartition(probeFiles[partId], probeIter);
+    NG_RETURN_IF_ERROR(probeDs);
+    SequentialIter probePart(std::make_shared<Value>(std::move(probeDs).value()));
+    for (; probePart.valid(); probePart.next()) {
+      builder(hashTable, evalKey<T>(probeKeys, &probePart, ctx), *probePart.row(), result);
+    }
+  }
+  otherStats_.emplace("spilled_partitions", folly::to<std::string>(buildFiles.size()));
+  otherStats_.emplace("spilled_bytes", folly::to<std::string>(spilledBytes));
+  return result;
+}
+
+template StatusOr<DataSet> JoinExecutor::spilledJoin<Value>(const std::vector<Expression*>&,
+                                                            Iterator*,
+                                                            bool,
+                                                            const std::vector<Expression*>&,
+                                                            Iterator*,
+                                                            bool,
+                                                            size_t,
+                                                            NewRowBuilder<Value>);
+
+template StatusOr<DataSet> JoinExecutor::spilledJoin<List>(const std::vector<Expression*>&,
+                                                           Iterator*,
+                                                           bool,
+                                                           const std::vector<Expression*>&,
+                                                           Iterator*,
+                                                           bool,
+                                                           size_t,
+                                                           NewRowBuilder<List>);
+
+template folly::Future<DataSet> JoinExecutor::partitionedJoin<Value>(
+    const std::vector<Expression*>&,
+    Iterator*,
+    const std::vector<Expression*>&,
+    Iterator*,
+    NewRowBuilder<Value>);
+
+template folly::Future<DataSet> JoinExecutor::partitionedJoin<List>(
+    const std::vector<Expression*>&,
+    Iterator*,
+    const std::vector<Expression*>&,
+    Iterator*,
+    NewRowBuilder<List>);
+
 }  // namespace graph
 }  // namespace nebula
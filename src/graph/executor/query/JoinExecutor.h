@@ -6,6 +6,7 @@
 #define GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 
 #include "graph/executor/Executor.h"
+#include "graph/util/SpillFile.h"
 
 namespace nebula {
 namespace graph {
@@ -30,6 +31,69 @@ class JoinExecutor : public Executor {
                                Iterator* iter,
                                std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
 
+  template <class T>
+  using HashTable = std::unordered_map<T, std::vector<const Row*>>;
+
+  // Append the joined rows of `row' and its matches in hash table to the dataset
+  template <class T>
+  using NewRowBuilder = std::function<void(const HashTable<T>&, const T&, const Row&, DataSet&)>;
+
+  // Whether the inputs are large enough to be joined by `num_operator_threads' threads
+  bool canParallelize(const std::vector<Expression*>& hashKeys,
+                      const std::vector<Expression*>& probeKeys) const;
+
+  // Radix partitioned hash join:
+  // First : both sides are split into contiguous ranges of rows, and each thread evaluates the
+  //         join keys of one range and scatters the rows into partitions by the hash of key
+  // Second: each thread builds the hash table of one partition from the build side and probes
+  //         it with the same partition of the probe side
+  // The outputs of all partitions are concatenated, and the build/probe time and the skew of
+  // partitions are reported in the profiling stats.
+  template <class T>
+  folly::Future<DataSet> partitionedJoin(const std::vector<Expression*>& buildKeys,
+                                         Iterator* buildIter,
+                                         const std::vector<Expression*>& probeKeys,
+                                         Iterator* probeIter,
+                                         NewRowBuilder<T> builder);
+
+  template <class T>
+  using Partitions = std::vector<std::vector<std::pair<T, const Row*>>>;
+
+  template <class T>
+  Partitions<T> partition(Iterator* iter,
+                          size_t begin,
+                          size_t end,
+                          const std::vector<Expression*>& keys,
+                          size_t numPartitions) const;
+
+  // Return the estimated size of both inputs if they exceed `query_memory_budget_bytes' and
+  // at least one of them could be released after being spilled, otherwise return 0. A spill
+  // could not save anything if the inputs are still used by other executors, since the hash
+  // table only keeps the address of rows.
+  size_t spillBytes();
+
+  // Grace hash join: both sides are scattered into spill files by the hash of join key, the
+  // rows of movable inputs are released once written. Then the partitions are read back one by
+  // one, each of them is joined by an in-memory hash join of its own.
+  template <class T>
+  StatusOr<DataSet> spilledJoin(const std::vector<Expression*>& buildKeys,
+                                Iterator* buildIter,
+                                bool buildMovable,
+                                const std::vector<Expression*>& probeKeys,
+                                Iterator* probeIter,
+                                bool probeMovable,
+                                size_t bytes,
+                                NewRowBuilder<T> builder);
+
+  template <class T>
+  Status spill(const std::vector<Expression*>& keys,
+               Iterator* iter,
+               bool mv,
+               std::vector<std::unique_ptr<SpillFile>>& files) const;
+
+  // Whether the left(0) or right(1) input could be moved
+  bool inputMovable(size_t index);
+
   std::unique_ptr<Iterator> lhsIter_;
   std::unique_ptr<Iterator> rhsIter_;
   size_t colSize_{0};
@@ -26,6 +26,13 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
                                              const std::vector<Expression*>& probeKeys,
                                              const std::vector<std::string>& colNames) {
   DCHECK_EQ(hashKeys.size(), probeKeys.size());
+  auto bytes = spillBytes();
+  if (bytes > 0) {
+    return graceJoin(hashKeys, probeKeys, colNames, bytes);
+  }
+  if (!lhsIter_->empty() && canParallelize(hashKeys, probeKeys)) {
+    return parallelJoin(hashKeys, probeKeys, colNames);
+  }
   DataSet result;
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
     std::unordered_map<Value, std::vector<const Row*>> hashTable;
@@ -47,6 +54,71 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
   return finish(ResultBuilder().value(Value(std::move(result))).build());
 }
 
+folly::Future<Status> LeftJoinExecutor::parallelJoin(const std::vector<Expression*>& hashKeys,
+                                                     const std::vector<Expression*>& probeKeys,
+                                                     const std::vector<std::string>& colNames) {
+  folly::Future<DataSet> future = folly::makeFuture(DataSet());
+  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
+    future = partitionedJoin<Value>(
+        probeKeys,
+        rhsIter_.get(),
+        hashKeys,
+        lhsIter_.get(),
+        [this](const HashTable<Value>& hashTable, const Value& val, const Row& row, DataSet& ds) {
+          buildNewRow<Value>(hashTable, val, row, ds);
+        });
+  } else {
+    future = partitionedJoin<List>(
+        probeKeys,
+        rhsIter_.get(),
+        hashKeys,
+        lhsIter_.get(),
+        [this](const HashTable<List>& hashTable, const List& val, const Row& row, DataSet& ds) {
+          buildNewRow<List>(hashTable, val, row, ds);
+        });
+  }
+  return std::move(future).thenValue([this, colNames](DataSet&& result) {
+    result.colNames = colNames;
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  });
+}
+
+folly::Future<Status> LeftJoinExecutor::graceJoin(const std::vector<Expression*>& hashKeys,
+                                                  const std::vector<Expression*>& probeKeys,
+                                                  const std::vector<std::string>& colNames,
+                                                  size_t bytes) {
+  StatusOr<DataSet> result;
+  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
+    result = spilledJoin<Value>(
+        probeKeys,
+        rhsIter_.get(),
+        inputMovable(1),
+        hashKeys,
+        lhsIter_.get(),
+        inputMovable(0),
+        bytes,
+        [this](const HashTable<Value>& hashTable, const Value& val, const Row& row, DataSet& ds) {
+          buildNewRow<Value>(hashTable, val, row, ds);
+        });
+  } else {
+    result = spilledJoin<List>(
+        probeKeys,
+        rhsIter_.get(),
+        inputMovable(1),
+        hashKeys,
+        lhsIter_.get(),
+        inputMovable(0),
+        bytes,
+        [this](const HashTable<List>& hashTable, const List& val, const Row& row, DataSet& ds) {
+          buildNewRow<List>(hashTable, val, row, ds);
+        });
+  }
+  NG_RETURN_IF_ERROR(result);
+  auto ds = std::move(result).value();
+  ds.colNames = colNames;
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
 DataSet LeftJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
@@ -24,6 +24,15 @@ class LeftJoinExecutor : public JoinExecutor {
                              const std::vector<Expression*>& probeKeys,
                              const std::vector<std::string>& colNames);
 
+  folly::Future<Status> parallelJoin(const std::vector<Expression*>& hashKeys,
+                                     const std::vector<Expression*>& probeKeys,
+                                     const std::vector<std::string>& colNames);
+
+  folly::Future<Status> graceJoin(const std::vector<Expression*>& hashKeys,
+                                  const std::vector<Expression*>& probeKeys,
+                                  const std::vector<std::string>& colNames,
+                                  size_t bytes);
+
   DataSet probe(const std::vector<Expression*>& probeKeys,
                 Iterator* probeIter,
                 const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
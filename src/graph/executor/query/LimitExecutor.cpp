@@ -9,7 +9,7 @@
 namespace nebula {
 namespace graph {
 
-folly::Future<Status> LimitExecutor::execute() {
+folly::Future<Status> LimitExecutor::executeAll() {
   SCOPED_TIMER(&execTime_);
 
   auto* limit = asNode<Limit>(node());
@@ -25,5 +25,27 @@ folly::Future<Status> LimitExecutor::execute() {
   return finish(builder.build());
 }
 
+Status LimitExecutor::openBatch() {
+  auto* limit = asNode<Limit>(node());
+  QueryExpressionContext qec(ectx_);
+  auto count = limit->count(qec);
+  offset_ = std::max<int64_t>(limit->offset(), 0);
+  count_ = count < 0 ? std::numeric_limits<int64_t>::max() : count;
+  return Status::OK();
+}
+
+Status LimitExecutor::processBatch(Iterator* input, DataSet* output, bool* done) {
+  for (; input->valid() && count_ > 0; input->next()) {
+    if (offset_ > 0) {
+      --offset_;
+      continue;
+    }
+    output->rows.emplace_back(input->moveRow());
+    --count_;
+  }
+  *done = count_ <= 0;
+  return Status::OK();
+}
+
 }  // namespace graph
 }  // namespace nebula
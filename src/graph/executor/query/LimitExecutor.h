@@ -4,16 +4,26 @@
 #ifndef GRAPH_EXECUTOR_QUERY_LIMITEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_LIMITEXECUTOR_H_
 
-#include "graph/executor/Executor.h"
+#include "graph/executor/PipelineExecutor.h"
 // takes iterators of data with user-specified limits and save them to the result
 namespace nebula {
 namespace graph {
 
-class LimitExecutor final : public Executor {
+class LimitExecutor final : public PipelineExecutor {
  public:
-  LimitExecutor(const PlanNode *node, QueryContext *qctx) : Executor("LimitExecutor", node, qctx) {}
+  LimitExecutor(const PlanNode *node, QueryContext *qctx)
+      : PipelineExecutor("LimitExecutor", node, qctx) {}
 
-  folly::Future<Status> execute() override;
+  folly::Future<Status> executeAll() override;
+
+  Status openBatch() override;
+
+  Status processBatch(Iterator *input, DataSet *output, bool *done) override;
+
+ private:
+  // Rows to skip and to output in the pipeline execution
+  int64_t offset_{0};
+  int64_t count_{0};
 };
 
 }  // namespace graph
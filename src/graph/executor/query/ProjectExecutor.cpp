@@ -9,10 +9,10 @@
 namespace nebula {
 namespace graph {
 
-folly::Future<Status> ProjectExecutor::execute() {
+folly::Future<Status> ProjectExecutor::executeAll() {
   SCOPED_TIMER(&execTime_);
   auto* project = asNode<Project>(node());
-  auto columns = project->columns()->columns();
+  auto columns = compileColumns();
   auto iter = ectx_->getResult(project->inputVar()).iter();
   DCHECK(!!iter);
   QueryExpressionContext ctx(ectx_);
@@ -22,8 +22,9 @@ folly::Future<Status> ProjectExecutor::execute() {
   ds.rows.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
     Row row;
+    row.values.reserve(columns.size());
     for (auto& col : columns) {
-      Value val = col->expr()->eval(ctx(iter.get()));
+      Value val = col.eval(ctx(iter.get()));
       row.values.emplace_back(std::move(val));
     }
     ds.rows.emplace_back(std::move(row));
@@ -31,5 +32,37 @@ folly::Future<Status> ProjectExecutor::execute() {
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
+Status ProjectExecutor::openBatch() {
+  columns_ = compileColumns();
+  return Status::OK();
+}
+
+Status ProjectExecutor::processBatch(Iterator* input, DataSet* output, bool* done) {
+  UNUSED(done);
+  QueryExpressionContext ctx(ectx_);
+  output->colNames = node()->colNames();
+  output->rows.reserve(input->size());
+  for (; input->valid(); input->next()) {
+    Row row;
+    row.values.reserve(columns_.size());
+    for (auto& col : columns_) {
+      Value val = col.eval(ctx(input));
+      row.values.emplace_back(std::move(val));
+    }
+    output->rows.emplace_back(std::move(row));
+  }
+  return Status::OK();
+}
+
+std::vector<ExprVM> ProjectExecutor::compileColumns() const {
+  std::vector<ExprVM> columns;
+  auto cols = asNode<Project>(node())->columns()->columns();
+  columns.reserve(cols.size());
+  for (auto* col : cols) {
+    columns.emplace_back(col->expr());
+  }
+  return columns;
+}
+
 }  // namespace graph
 }  // namespace nebula
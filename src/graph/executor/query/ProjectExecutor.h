@@ -5,17 +5,28 @@
 #ifndef GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 
-#include "graph/executor/Executor.h"
+#include "common/expression/ExprProgram.h"
+#include "graph/executor/PipelineExecutor.h"
 // select user-specified columns from a table
 namespace nebula {
 namespace graph {
 
-class ProjectExecutor final : public Executor {
+class ProjectExecutor final : public PipelineExecutor {
  public:
   ProjectExecutor(const PlanNode *node, QueryContext *qctx)
-      : Executor("ProjectExecutor", node, qctx) {}
+      : PipelineExecutor("ProjectExecutor", node, qctx) {}
 
-  folly::Future<Status> execute() override;
+  folly::Future<Status> executeAll() override;
+
+  Status openBatch() override;
+
+  Status processBatch(Iterator *input, DataSet *output, bool *done) override;
+
+ private:
+  std::vector<ExprVM> compileColumns() const;
+
+  // Columns compiled once for all the morsels of a pipeline
+  std::vector<ExprVM> columns_;
 };
 
 }  // namespace graph
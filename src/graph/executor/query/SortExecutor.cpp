@@ -4,7 +4,11 @@
 
 #include "graph/executor/query/SortExecutor.h"
 
+#include <numeric>
+
+#include "graph/context/ColumnarBatch.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -24,27 +28,134 @@ folly::Future<Status> SortExecutor::execute() {
     return Status::Error(ss.str());
   }
 
-  auto &factors = sort->factors();
-  auto comparator = [&factors](const Row &lhs, const Row &rhs) {
-    for (auto &item : factors) {
-      auto index = item.first;
-      auto orderType = item.second;
-      if (lhs[index] == rhs[index]) {
-        continue;
-      }
+  auto seqIter = static_cast<SequentialIter *>(iter);
+  auto &rows = *seqIter->rows_;
+  if (FLAGS_num_operator_threads > 1 && rows.size() > 1 &&
+      rows.size() >= FLAGS_min_rows_for_parallel_operator) {
+    return parallelSort(std::move(result));
+  }
+
+  if (sortByTypedColumns(seqIter)) {
+    otherStats_.emplace("sort by", "typed columns");
+    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  }
+
+  std::sort(seqIter->begin(), seqIter->end(), Comparator{sort->factors()});
+  return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+}
+
+bool SortExecutor::Comparator::operator()(const Row &lhs, const Row &rhs) const {
+  for (auto &item : factors) {
+    auto index = item.first;
+    auto orderType = item.second;
+    if (lhs[index] == rhs[index]) {
+      continue;
+    }
+
+    if (orderType == OrderFactor::OrderType::ASCEND) {
+      return lhs[index] < rhs[index];
+    } else if (orderType == OrderFactor::OrderType::DESCEND) {
+      return lhs[index] > rhs[index];
+    }
+  }
+  return false;
+}
+
+folly::Future<Status> SortExecutor::parallelSort(Result result) {
+  auto *rows = static_cast<SequentialIter *>(result.iterRef())->rows_;
+  auto numRuns = std::min(static_cast<size_t>(FLAGS_num_operator_threads), rows->size());
+  auto runSize = (rows->size() + numRuns - 1) / numRuns;
+  numRuns = (rows->size() + runSize - 1) / runSize;
+
+  std::vector<folly::Future<folly::Unit>> futures;
+  for (size_t begin = 0; begin < rows->size(); begin += runSize) {
+    auto end = std::min(begin + runSize, rows->size());
+    futures.emplace_back(
+        folly::via(runner(), [this, rows, begin, end]() { sortRun(rows, begin, end); }));
+  }
+
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, result = std::move(result), numRuns, runSize](auto &&) mutable {
+        auto *seqIter = static_cast<SequentialIter *>(result.iterRef());
+        mergeRuns(seqIter->rows_, numRuns, runSize);
+        seqIter->reset();
+        return finish(
+            ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+      });
+}
+
+void SortExecutor::mergeRuns(std::vector<Row> *rows, size_t numRuns, size_t runSize) {
+  Comparator comparator{asNode<Sort>(node())->factors()};
+  // The min-heap of runs ordered by their current rows
+  auto heapCmp = [&comparator](const RunCursor &lhs, const RunCursor &rhs) {
+    return comparator(rhs.row(), lhs.row());
+  };
+  otherStats_.emplace("sorted_runs", folly::to<std::string>(numRuns));
+
+  std::vector<RunCursor> heap;
+  heap.reserve(numRuns);
+  for (size_t begin = 0; begin < rows->size(); begin += runSize) {
+    heap.emplace_back(RunCursor{rows, begin, std::min(begin + runSize, rows->size())});
+  }
+  std::make_heap(heap.begin(), heap.end(), heapCmp);
+  std::vector<Row> sorted;
+  sorted.reserve(rows->size());
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), heapCmp);
+    auto &top = heap.back();
+    sorted.emplace_back(std::move((*rows)[top.pos++]));
+    if (top.pos < top.end) {
+      std::push_heap(heap.begin(), heap.end(), heapCmp);
+    } else {
+      heap.pop_back();
+    }
+  }
+  rows->swap(sorted);
+}
+
+void SortExecutor::sortRun(std::vector<Row> *rows, size_t begin, size_t end) const {
+  Comparator comparator{asNode<Sort>(node())->factors()};
+  std::sort(rows->begin() + begin, rows->begin() + end, comparator);
+}
 
-      if (orderType == OrderFactor::OrderType::ASCEND) {
-        return lhs[index] < rhs[index];
-      } else if (orderType == OrderFactor::OrderType::DESCEND) {
-        return lhs[index] > rhs[index];
+bool SortExecutor::sortByTypedColumns(SequentialIter *iter) const {
+  auto &factors = asNode<Sort>(node())->factors();
+  auto &rows = *iter->rows_;
+  if (rows.size() < 2) {
+    return false;
+  }
+  ColumnarBatch batch(&rows);
+  std::vector<const Column *> keys;
+  keys.reserve(factors.size());
+  for (auto &item : factors) {
+    auto *key = batch.typedColumn(item.first);
+    if (key == nullptr) {
+      return false;
+    }
+    keys.emplace_back(key);
+  }
+
+  std::vector<size_t> indices(rows.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::sort(indices.begin(), indices.end(), [&factors, &keys](size_t lhs, size_t rhs) {
+    for (size_t i = 0; i < factors.size(); ++i) {
+      auto cmp = keys[i]->compare(lhs, rhs);
+      if (cmp == 0) {
+        continue;
       }
+      return factors[i].second == OrderFactor::OrderType::ASCEND ? cmp < 0 : cmp > 0;
     }
     return false;
-  };
+  });
 
-  auto seqIter = static_cast<SequentialIter *>(iter);
-  std::sort(seqIter->begin(), seqIter->end(), comparator);
-  return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  std::vector<Row> sorted;
+  sorted.reserve(rows.size());
+  for (auto index : indices) {
+    sorted.emplace_back(std::move(rows[index]));
+  }
+  rows.swap(sorted);
+  iter->reset();
+  return true;
 }
 
 }  // namespace graph
@@ -6,14 +6,48 @@
 #define GRAPH_EXECUTOR_QUERY_SORTEXECUTOR_H_
 
 #include "graph/executor/Executor.h"
+#include "graph/planner/plan/Query.h"
 
 namespace nebula {
 namespace graph {
+
+// Large inputs are sorted in runs by `num_operator_threads' threads and the sorted runs are
+// k-way merged. The input and the output are both held in memory, so the sort doesn't spill.
 class SortExecutor final : public Executor {
  public:
   SortExecutor(const PlanNode *node, QueryContext *qctx) : Executor("SortExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Sort by the typed sort key columns instead of comparing rows of Values, return false if any
+  // of the sort keys could not be stored in a typed column.
+  bool sortByTypedColumns(SequentialIter *iter) const;
+
+  // Sort the rows in runs in parallel and merge them
+  folly::Future<Status> parallelSort(Result result);
+
+  // Sort the rows in [begin, end)
+  void sortRun(std::vector<Row> *rows, size_t begin, size_t end) const;
+
+  void mergeRuns(std::vector<Row> *rows, size_t numRuns, size_t runSize);
+
+  struct Comparator {
+    bool operator()(const Row &lhs, const Row &rhs) const;
+
+    const std::vector<std::pair<size_t, OrderFactor::OrderType>> &factors;
+  };
+
+  // Position of a sorted run
+  struct RunCursor {
+    const Row &row() const {
+      return (*rows)[pos];
+    }
+
+    std::vector<Row> *rows;
+    size_t pos;
+    size_t end;
+  };
 };
 
 }  // namespace graph
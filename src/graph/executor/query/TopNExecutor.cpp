@@ -5,6 +5,7 @@
 #include "graph/executor/query/TopNExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -59,11 +60,70 @@ folly::Future<Status> TopNExecutor::execute() {
     return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
   }
 
+  if (FLAGS_num_operator_threads > 1 && size >= FLAGS_min_rows_for_parallel_operator) {
+    return parallelTopN(std::move(result));
+  }
+
   executeTopN<SequentialIter>(iter);
   iter->eraseRange(maxCount_, size);
   return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
 }
 
+folly::Future<Status> TopNExecutor::parallelTopN(Result result) {
+  auto *iter = static_cast<SequentialIter *>(result.iterRef());
+  auto size = iter->size();
+  auto numThreads = static_cast<size_t>(FLAGS_num_operator_threads);
+  auto batchSize = (size + numThreads - 1) / numThreads;
+  std::vector<folly::Future<std::vector<Row>>> futures;
+  for (size_t begin = 0; begin < size; begin += batchSize) {
+    auto end = std::min(begin + batchSize, size);
+    futures.emplace_back(
+        folly::via(runner(), [this, iter, begin, end]() { return topNOfRange(iter, begin, end); }));
+  }
+
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, result = std::move(result), numThreads, size](
+          std::vector<std::vector<Row>> &&heaps) mutable {
+        // Every heap keeps the first `heapSize_' rows of its range at most, so the first
+        // `heapSize_' rows of all candidates are the ones of whole input
+        std::vector<Row> candidates;
+        candidates.reserve(heapSize_ * heaps.size());
+        for (auto &heap : heaps) {
+          candidates.insert(candidates.end(),
+                            std::make_move_iterator(heap.begin()),
+                            std::make_move_iterator(heap.end()));
+        }
+        DCHECK_GE(candidates.size(), static_cast<size_t>(heapSize_));
+        std::partial_sort(
+            candidates.begin(), candidates.begin() + heapSize_, candidates.end(), comparator_);
+
+        auto *seqIter = static_cast<SequentialIter *>(result.iterRef());
+        auto beg = seqIter->begin();
+        for (int64_t i = 0; i < maxCount_; ++i) {
+          beg[i] = std::move(candidates[offset_ + i]);
+        }
+        seqIter->eraseRange(maxCount_, size);
+        otherStats_.emplace("parallel", folly::to<std::string>(numThreads));
+        return finish(
+            ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+      });
+}
+
+std::vector<Row> TopNExecutor::topNOfRange(SequentialIter *iter, size_t begin, size_t end) const {
+  auto heapSize = std::min(static_cast<size_t>(heapSize_), end - begin);
+  auto it = iter->begin() + begin;
+  std::vector<Row> heap(it, it + heapSize);
+  std::make_heap(heap.begin(), heap.end(), comparator_);
+  for (it += heapSize; it != iter->begin() + end; ++it) {
+    if (comparator_(*it, heap[0])) {
+      std::pop_heap(heap.begin(), heap.end(), comparator_);
+      heap.back() = *it;
+      std::push_heap(heap.begin(), heap.end(), comparator_);
+    }
+  }
+  return heap;
+}
+
 template <typename U>
 void TopNExecutor::executeTopN(Iterator *iter) {
   auto uIter = static_cast<U *>(iter);
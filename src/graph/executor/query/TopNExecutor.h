@@ -19,6 +19,12 @@ class TopNExecutor final : public Executor {
   template <typename U>
   void executeTopN(Iterator *iter);
 
+  // Each thread keeps a heap of the first `heapSize_' rows in its range of input, then the rows
+  // of all heaps are merged into the result
+  folly::Future<Status> parallelTopN(Result result);
+
+  std::vector<Row> topNOfRange(SequentialIter *iter, size_t begin, size_t end) const;
+
   int64_t offset_;
   int64_t maxCount_;
   int64_t heapSize_;
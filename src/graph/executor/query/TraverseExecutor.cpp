@@ -6,7 +6,9 @@
 
 #include "clients/storage/StorageClient.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
 #include "graph/util/SchemaUtil.h"
+#include "graph/util/VidSet.h"
 
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
@@ -27,6 +29,10 @@ folly::Future<Status> TraverseExecutor::execute() {
 Status TraverseExecutor::close() {
   // clear the members
   reqDs_.rows.clear();
+  paths_.clear();
+  inputRows_.clear();
+  steps_.clear();
+  hops_.clear();
   return Executor::close();
 }
 
@@ -40,11 +46,11 @@ Status TraverseExecutor::buildRequestDataSet() {
   reqDs_.colNames = {kVid};
   reqDs_.rows.reserve(iter->size());
 
-  std::unordered_set<Value> uniqueSet;
-  uniqueSet.reserve(iter->size());
   std::unordered_map<Value, Paths> prev;
   const auto& spaceInfo = qctx()->rctx()->session()->space();
   const auto& vidType = *(spaceInfo.spaceDesc.vid_type_ref());
+  VidSet uniqueSet(vidType);
+  uniqueSet.reserve(iter->size());
   auto* src = traverse_->src();
   QueryExpressionContext ctx(ectx_);
 
@@ -57,9 +63,9 @@ Status TraverseExecutor::buildRequestDataSet() {
       continue;
     }
     // Need copy here, Argument executor may depends on this variable.
-    auto prePath = mv ? iter->moveRow() : *iter->row();
-    buildPath(prev, vid, std::move(prePath));
-    if (!uniqueSet.emplace(vid).second) {
+    inputRows_.emplace_back(mv ? iter->moveRow() : *iter->row());
+    buildPath(prev, vid, inputRows_.size() - 1);
+    if (!uniqueSet.emplace(vid)) {
       continue;
     }
     reqDs_.emplace_back(Row({std::move(vid)}));
@@ -156,64 +162,120 @@ folly::Future<Status> TraverseExecutor::handleResponse(RpcResponse&& resps) {
   auto& responses = resps.responses();
   List list;
   for (auto& resp : responses) {
-    auto dataset = resp.get_vertices();
-    if (dataset == nullptr) {
+    if (!resp.vertices_ref().has_value()) {
       continue;
     }
-    list.values.emplace_back(std::move(*dataset));
+    list.values.emplace_back(std::move(*resp.vertices_ref()));
   }
-  auto listVal = std::make_shared<Value>(std::move(list));
-  auto iter = std::make_unique<GetNeighborsIter>(listVal);
 
-  auto status = buildInterimPath(iter.get());
-  if (!status.ok()) {
-    return folly::makeFuture<Status>(std::move(status));
-  }
-  if (!isFinalStep()) {
-    if (reqDs_.rows.empty()) {
-      if (range_ != nullptr) {
-        return folly::makeFuture<Status>(buildResult());
+  return buildInterimPath(std::move(list)).thenValue([this](Status status) {
+    if (!status.ok()) {
+      return folly::makeFuture<Status>(std::move(status));
+    }
+    if (!isFinalStep()) {
+      if (reqDs_.rows.empty()) {
+        if (range_ != nullptr) {
+          return buildResult();
+        } else {
+          return folly::makeFuture<Status>(Status::OK());
+        }
       } else {
-        return folly::makeFuture<Status>(Status::OK());
+        return getNeighbors();
       }
     } else {
-      return getNeighbors();
+      return buildResult();
     }
-  } else {
-    return folly::makeFuture<Status>(buildResult());
-  }
+  });
 }
 
-Status TraverseExecutor::buildInterimPath(GetNeighborsIter* iter) {
-  const auto& spaceInfo = qctx()->rctx()->session()->space();
-  DataSet reqDs;
-  reqDs.colNames = reqDs_.colNames;
+folly::Future<Status> TraverseExecutor::buildInterimPath(List&& list) {
   size_t count = 0;
-
   const std::unordered_map<Value, Paths>& prev = paths_.back();
   if (currentStep_ == 1 && zeroStep()) {
+    auto listVal = std::make_shared<Value>(std::move(list));
+    GetNeighborsIter iter(listVal);
     paths_.emplace_back();
-    NG_RETURN_IF_ERROR(handleZeroStep(prev, iter->getVertices(), paths_.back(), count));
+    auto status = handleZeroStep(prev, iter.getVertices(), paths_.back(), count);
+    if (!status.ok()) {
+      return folly::makeFuture<Status>(std::move(status));
+    }
     // If 0..0 case, release memory and return immediately.
     if (range_ != nullptr && range_->max() == 0) {
       releasePrevPaths(count);
-      return Status::OK();
+      return folly::makeFuture<Status>(Status::OK());
     }
+    list = std::move(listVal->mutableList());
   }
   paths_.emplace_back();
-  std::unordered_map<Value, Paths>& current = paths_.back();
 
-  auto* vFilter = traverse_->vFilter();
+  auto* vFilter = currentStep_ == 1 ? traverse_->vFilter() : nullptr;
   auto* eFilter = traverse_->eFilter();
+  size_t numRows = 0;
+  for (auto& ds : list.values) {
+    numRows += ds.getDataSet().rowSize();
+  }
+  bool parallel = FLAGS_num_operator_threads > 1 && numRows >= FLAGS_min_rows_for_parallel_operator;
+  for (auto* filter : {vFilter, eFilter}) {
+    if (filter != nullptr && ExpressionUtils::writesContextVar(filter)) {
+      parallel = false;
+    }
+  }
+  if (!parallel) {
+    auto listVal = std::make_shared<Value>(std::move(list));
+    GetNeighborsIter iter(listVal);
+    std::vector<Expansion> expansions;
+    expansions.emplace_back(expand(&iter, prev, vFilter, eFilter));
+    return folly::makeFuture<Status>(mergeExpansions(std::move(expansions), count));
+  }
+
+  // Split the neighbors of the source vertices into batches, each of which is expanded by a
+  // thread, and the paths expanded are merged when all batches are done
+  auto numThreads = static_cast<size_t>(FLAGS_num_operator_threads);
+  auto batchSize = (numRows + numThreads - 1) / numThreads;
+  std::vector<folly::Future<Expansion>> futures;
+  for (auto& val : list.values) {
+    auto& ds = val.mutableDataSet();
+    for (size_t begin = 0; begin < ds.rowSize(); begin += batchSize) {
+      auto end = std::min(begin + batchSize, ds.rowSize());
+      DataSet batch(ds.colNames);
+      batch.rows.reserve(end - begin);
+      std::move(ds.rows.begin() + begin, ds.rows.begin() + end, std::back_inserter(batch.rows));
+      List batchList;
+      batchList.values.emplace_back(std::move(batch));
+      // Clone the filters for each thread before dispatching, since the object pool is not
+      // thread safe
+      auto future = folly::via(runner(),
+                               [this,
+                                &prev,
+                                listVal = std::make_shared<Value>(std::move(batchList)),
+                                vFilter = vFilter == nullptr ? nullptr : vFilter->clone(),
+                                eFilter = eFilter == nullptr ? nullptr : eFilter->clone()]() {
+                                 GetNeighborsIter iter(listVal);
+                                 return expand(&iter, prev, vFilter, eFilter);
+                               });
+      futures.emplace_back(std::move(future));
+    }
+  }
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, count](std::vector<Expansion>&& expansions) {
+        return mergeExpansions(std::move(expansions), count);
+      });
+}
+
+TraverseExecutor::Expansion TraverseExecutor::expand(GetNeighborsIter* iter,
+                                                     const std::unordered_map<Value, Paths>& prev,
+                                                     Expression* vFilter,
+                                                     Expression* eFilter) const {
+  const auto& spaceInfo = qctx()->rctx()->session()->space();
   QueryExpressionContext ctx(ectx_);
-  std::unordered_set<Value> uniqueDst;
+  Expansion expansion;
 
   for (; iter->valid(); iter->next()) {
     auto& dst = iter->getEdgeProp("*", kDst);
     if (!SchemaUtil::isValidVid(dst, *(spaceInfo.spaceDesc.vid_type_ref()))) {
       continue;
     }
-    if (vFilter != nullptr && currentStep_ == 1) {
+    if (vFilter != nullptr) {
       auto& vFilterVal = vFilter->eval(ctx(iter));
       if (!vFilterVal.isBool() || !vFilterVal.getBool()) {
         continue;
@@ -230,86 +292,184 @@ Status TraverseExecutor::buildInterimPath(GetNeighborsIter* iter) {
     // Join on dst = src
     auto pathToSrcFound = prev.find(srcV.getVertex().vid);
     if (pathToSrcFound == prev.end()) {
-      return Status::Error("Can't find prev paths.");
+      expansion.status = Status::Error("Can't find prev paths.");
+      return expansion;
     }
     const auto& paths = pathToSrcFound->second;
-    for (auto& prevPath : paths) {
-      if (hasSameEdge(prevPath, e.getEdge())) {
+    // The hop is added once it's taken by any path
+    size_t hop = expansion.hops.size();
+    for (auto prevPath : paths) {
+      if (hasSameEdge(prevPath, currentStep_ == 1, e.getEdge())) {
         continue;
       }
-      if (uniqueDst.emplace(dst).second) {
-        reqDs.rows.emplace_back(Row({std::move(dst)}));
-      }
-      if (currentStep_ == 1) {
-        Row path;
-        if (traverse_->trackPrevPath()) {
-          path = prevPath;
-        }
-        path.values.emplace_back(srcV);
-        List neighbors;
-        neighbors.values.emplace_back(e);
-        path.values.emplace_back(std::move(neighbors));
-        buildPath(current, dst, std::move(path));
-        ++count;
-      } else {
-        auto path = prevPath;
-        auto& eList = path.values.back().mutableList().values;
-        eList.emplace_back(srcV);
-        eList.emplace_back(e);
-        buildPath(current, dst, std::move(path));
-        ++count;
+      if (hop == expansion.hops.size()) {
+        expansion.hops.emplace_back(srcV, e);
       }
+      expansion.steps.emplace_back(Step{prevPath, currentStep_ == 1, hop});
+      buildPath(expansion.paths, dst, expansion.steps.size() - 1);
     }  // `prevPath'
   }    // `iter'
+  return expansion;
+}
+
+Status TraverseExecutor::mergeExpansions(std::vector<Expansion>&& expansions, size_t count) {
+  DataSet reqDs;
+  reqDs.colNames = reqDs_.colNames;
+  VidSet uniqueDst(*(qctx()->rctx()->session()->space().spaceDesc.vid_type_ref()));
+  auto& current = paths_.back();
+  for (auto& expansion : expansions) {
+    NG_RETURN_IF_ERROR(expansion.status);
+    // Indices of the batch are offset by the steps merged
+    size_t hopOffset = hops_.size();
+    size_t stepOffset = steps_.size();
+    std::move(expansion.hops.begin(), expansion.hops.end(), std::back_inserter(hops_));
+    for (auto& step : expansion.steps) {
+      step.hop += hopOffset;
+      steps_.emplace_back(step);
+    }
+    for (auto& dstPaths : expansion.paths) {
+      auto& paths = current[dstPaths.first];
+      for (auto step : dstPaths.second) {
+        paths.emplace_back(step + stepOffset);
+      }
+      count += dstPaths.second.size();
+      if (uniqueDst.emplace(dstPaths.first)) {
+        reqDs.rows.emplace_back(Row({dstPaths.first}));
+      }
+    }
+  }
 
   releasePrevPaths(count);
   reqDs_ = std::move(reqDs);
   return Status::OK();
 }
 
-void TraverseExecutor::buildPath(std::unordered_map<Value, std::vector<Row>>& currentPaths,
+void TraverseExecutor::buildPath(std::unordered_map<Value, Paths>& currentPaths,
                                  const Value& dst,
-                                 Row&& path) {
-  auto pathToDstFound = currentPaths.find(dst);
-  if (pathToDstFound == currentPaths.end()) {
-    Paths interimPaths;
-    interimPaths.emplace_back(std::move(path));
-    currentPaths.emplace(dst, std::move(interimPaths));
-  } else {
-    auto& interimPaths = pathToDstFound->second;
-    interimPaths.emplace_back(std::move(path));
+                                 size_t path) {
+  currentPaths[dst].emplace_back(path);
+}
+
+Row TraverseExecutor::buildPathRow(size_t step) const {
+  // Collect the steps from the last one to the first one
+  std::vector<const Step*> steps;
+  const Step* s = &steps_[step];
+  steps.emplace_back(s);
+  while (!s->first) {
+    s = &steps_[s->prev];
+    steps.emplace_back(s);
+  }
+
+  Row path;
+  if (traverse_->trackPrevPath()) {
+    path = inputRows_[s->prev];
   }
+  const auto& firstHop = hops_[s->hop];
+  path.values.emplace_back(firstHop.first);
+  List neighbors;
+  neighbors.values.reserve(2 * steps.size() - 1);
+  neighbors.values.emplace_back(firstHop.second);
+  for (auto iter = steps.rbegin() + 1; iter != steps.rend(); ++iter) {
+    const auto& hop = hops_[(*iter)->hop];
+    neighbors.values.emplace_back(hop.first);
+    neighbors.values.emplace_back(hop.second);
+  }
+  path.values.emplace_back(std::move(neighbors));
+  return path;
 }
 
-Status TraverseExecutor::buildResult() {
+folly::Future<Status> TraverseExecutor::buildResult() {
   // This means we are reaching a dead end, return empty.
   if (range_ != nullptr && currentStep_ < range_->min()) {
+    releasePaths();
     return finish(ResultBuilder().value(Value(DataSet())).build());
   }
 
-  DataSet result;
-  result.colNames = traverse_->colNames();
-  result.rows.reserve(cnt_);
+  std::vector<size_t> lastSteps;
+  lastSteps.reserve(cnt_);
   for (auto& currentStepPaths : paths_) {
     for (auto& paths : currentStepPaths) {
-      std::move(paths.second.begin(), paths.second.end(), std::back_inserter(result.rows));
+      lastSteps.insert(lastSteps.end(), paths.second.begin(), paths.second.end());
     }
   }
 
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
+  if (FLAGS_num_operator_threads < 2 || lastSteps.size() < FLAGS_min_rows_for_parallel_operator) {
+    DataSet result;
+    result.colNames = traverse_->colNames();
+    result.rows.reserve(lastSteps.size());
+    for (auto step : lastSteps) {
+      result.rows.emplace_back(buildPathRow(step));
+    }
+    releasePaths();
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  }
+
+  // Materialize the paths by multiple threads, the trie of paths is read only now
+  auto numThreads = static_cast<size_t>(FLAGS_num_operator_threads);
+  auto batchSize = (lastSteps.size() + numThreads - 1) / numThreads;
+  auto shared = std::make_shared<std::vector<size_t>>(std::move(lastSteps));
+  std::vector<folly::Future<std::vector<Row>>> futures;
+  for (size_t begin = 0; begin < shared->size(); begin += batchSize) {
+    auto end = std::min(begin + batchSize, shared->size());
+    futures.emplace_back(folly::via(runner(), [this, shared, begin, end]() {
+      std::vector<Row> rows;
+      rows.reserve(end - begin);
+      for (size_t i = begin; i < end; ++i) {
+        rows.emplace_back(buildPathRow((*shared)[i]));
+      }
+      return rows;
+    }));
+  }
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, total = shared->size()](std::vector<std::vector<Row>>&& batches) {
+        DataSet result;
+        result.colNames = traverse_->colNames();
+        result.rows.reserve(total);
+        for (auto& rows : batches) {
+          std::move(rows.begin(), rows.end(), std::back_inserter(result.rows));
+        }
+        releasePaths();
+        return finish(ResultBuilder().value(Value(std::move(result))).build());
+      });
+}
+
+void TraverseExecutor::releasePaths() {
+  paths_.clear();
+  std::vector<Row>().swap(inputRows_);
+  std::vector<Step>().swap(steps_);
+  std::vector<std::pair<Value, Value>>().swap(hops_);
 }
 
-bool TraverseExecutor::hasSameEdge(const Row& prevPath, const Edge& currentEdge) {
-  for (const auto& v : prevPath.values) {
-    if (v.isList()) {
-      for (const auto& e : v.getList().values) {
-        if (e.isEdge() && e.getEdge().keyEqual(currentEdge)) {
-          return true;
+bool TraverseExecutor::hasSameEdge(size_t prev, bool isInput, const Edge& currentEdge) const {
+  auto inRow = [&currentEdge](const Row& row) {
+    for (const auto& v : row.values) {
+      if (v.isList()) {
+        for (const auto& e : v.getList().values) {
+          if (e.isEdge() && e.getEdge().keyEqual(currentEdge)) {
+            return true;
+          }
         }
       }
     }
+    return false;
+  };
+  if (isInput) {
+    return inRow(inputRows_[prev]);
   }
-  return false;
+
+  const Step* s = &steps_[prev];
+  while (true) {
+    const auto& e = hops_[s->hop].second;
+    if (e.isEdge() && e.getEdge().keyEqual(currentEdge)) {
+      return true;
+    }
+    if (s->first) {
+      break;
+    }
+    s = &steps_[s->prev];
+  }
+  // The input row is only a part of the path if it's tracked
+  return traverse_->trackPrevPath() && inRow(inputRows_[s->prev]);
 }
 
 void TraverseExecutor::releasePrevPaths(size_t cnt) {
@@ -346,16 +506,14 @@ Status TraverseExecutor::handleZeroStep(const std::unordered_map<Value, Paths>&
       return Status::Error("Can't find prev paths.");
     }
     const auto& paths = pathToSrcFound->second;
-    for (auto& p : paths) {
-      Row path;
-      if (traverse_->trackPrevPath()) {
-        path = p;
-      }
-      path.values.emplace_back(srcV);
-      List neighbors;
-      neighbors.values.emplace_back(srcV);
-      path.values.emplace_back(std::move(neighbors));
-      buildPath(zeroSteps, src, std::move(path));
+    if (paths.empty()) {
+      continue;
+    }
+    size_t hop = hops_.size();
+    hops_.emplace_back(srcV, srcV);
+    for (auto p : paths) {
+      steps_.emplace_back(Step{p, true, hop});
+      buildPath(zeroSteps, src, steps_.size() - 1);
       ++count;
     }
   }
@@ -21,14 +21,21 @@
 // `paths_` : hash table array, paths_[i] means that the length that paths in the i-th array
 //  element is i
 //    KEY in the hash table   : the vid of the destination Vertex
-//    VALUE in the hash table : collection of paths that destionation vid is `KEY`
+//    VALUE in the hash table : collection of paths that destionation vid is `KEY`, i.e. the
+//    indices of the last steps of them in `steps_`, or of the input rows in `inputRows_` for the
+//    first element
+// `steps_` : the trie of paths, each step refers to the previous one instead of copying it, so
+//  the paths sharing the same prefix share the steps of it
 //
 // Functions:
 // `buildRequestDataSet` : constructs the input DataSet for getNeightbors
-// `buildInterimPath` : construct collection of paths after expanded and put it into the paths_
+// `buildInterimPath` : construct collection of paths after expanded and put it into the paths_,
+//  the neighbors are split into batches expanded by multiple threads if there are many of them
 // `getNeighbors` : invoke the getNeightbors interface
 // `releasePrevPaths` : deleted The path whose length does not meet the user-defined length
 // `hasSameEdge` : check if there are duplicate edges in path
+// `buildPathRow` : materialize the path ended with the step into a row when building the result
+// `releasePaths` : release the trie of paths once the result is built
 namespace nebula {
 namespace graph {
 
@@ -46,8 +53,20 @@ class TraverseExecutor final : public StorageAccessExecutor {
   Status close() override;
 
  private:
+  friend class TraverseTest;
+
   using Dst = Value;
-  using Paths = std::vector<Row>;
+  using Paths = std::vector<size_t>;
+
+  struct Step {
+    // Index of the previous step in `steps_', or of the input row in `inputRows_' if it's the
+    // first step
+    size_t prev;
+    bool first;
+    // Index of the source vertex and the edge of the step in `hops_'
+    size_t hop;
+  };
+
   Status buildRequestDataSet();
 
   folly::Future<Status> traverse();
@@ -58,9 +77,27 @@ class TraverseExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> handleResponse(RpcResponse&& resps);
 
-  Status buildInterimPath(GetNeighborsIter* iter);
+  // The paths expanded by a batch of the neighbors, which are merged into the trie of paths when
+  // all batches of the step are done
+  struct Expansion {
+    Status status;
+    // The hops are indexed in the batch
+    std::vector<Step> steps;
+    std::vector<std::pair<Value, Value>> hops;
+    // The steps are indexed in the batch
+    std::unordered_map<Value, Paths> paths;
+  };
+
+  folly::Future<Status> buildInterimPath(List&& list);
 
-  Status buildResult();
+  Expansion expand(GetNeighborsIter* iter,
+                   const std::unordered_map<Value, Paths>& prev,
+                   Expression* vFilter,
+                   Expression* eFilter) const;
+
+  Status mergeExpansions(std::vector<Expansion>&& expansions, size_t count);
+
+  folly::Future<Status> buildResult();
 
   bool isFinalStep() const {
     return (range_ == nullptr && currentStep_ == 1) ||
@@ -71,13 +108,18 @@ class TraverseExecutor final : public StorageAccessExecutor {
     return node_->asNode<Traverse>()->zeroStep();
   }
 
-  bool hasSameEdge(const Row& prevPath, const Edge& currentEdge);
+  // Whether the edge is in the path ended with `prev', which is an input row if `isInput'
+  bool hasSameEdge(size_t prev, bool isInput, const Edge& currentEdge) const;
 
   void releasePrevPaths(size_t cnt);
 
-  void buildPath(std::unordered_map<Value, std::vector<Row>>& currentPaths,
-                 const Value& dst,
-                 Row&& path);
+  static void buildPath(std::unordered_map<Value, Paths>& currentPaths,
+                        const Value& dst,
+                        size_t path);
+
+  Row buildPathRow(size_t step) const;
+
+  void releasePaths();
 
   Status handleZeroStep(const std::unordered_map<Value, Paths>& prev,
                         List&& vertices,
@@ -93,6 +135,11 @@ class TraverseExecutor final : public StorageAccessExecutor {
   MatchStepRange* range_{nullptr};
   size_t currentStep_{0};
   std::list<std::unordered_map<Value, Paths>> paths_;
+  std::vector<Row> inputRows_;
+  std::vector<Step> steps_;
+  // The source vertex and the edge of steps, which are shared by all the paths expanded by the
+  // edge. The edge is the source vertex itself for the zero step.
+  std::vector<std::pair<Value, Value>> hops_;
   size_t cnt_{0};
 };
 
@@ -9,7 +9,7 @@
 namespace nebula {
 namespace graph {
 
-folly::Future<Status> UnwindExecutor::execute() {
+folly::Future<Status> UnwindExecutor::executeAll() {
   SCOPED_TIMER(&execTime_);
 
   auto *unwind = asNode<Unwind>(node());
@@ -36,6 +36,24 @@ folly::Future<Status> UnwindExecutor::execute() {
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
+Status UnwindExecutor::processBatch(Iterator *input, DataSet *output, bool *done) {
+  UNUSED(done);
+  auto *unwind = asNode<Unwind>(node());
+  QueryExpressionContext ctx(ectx_);
+  auto *unwindExpr = unwind->unwindExpr();
+  output->colNames = unwind->colNames();
+  for (; input->valid(); input->next()) {
+    const Value &list = unwindExpr->eval(ctx(input));
+    std::vector<Value> vals = extractList(list);
+    for (auto &v : vals) {
+      Row row = *(input->row());
+      row.values.emplace_back(std::move(v));
+      output->rows.emplace_back(std::move(row));
+    }
+  }
+  return Status::OK();
+}
+
 std::vector<Value> UnwindExecutor::extractList(const Value &val) {
   std::vector<Value> ret;
   if (val.isList()) {
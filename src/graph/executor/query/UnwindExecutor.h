@@ -5,17 +5,19 @@
 #ifndef GRAPH_EXECUTOR_QUERY_UNWINDEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_UNWINDEXECUTOR_H_
 
-#include "graph/executor/Executor.h"
+#include "graph/executor/PipelineExecutor.h"
 // expand multiple columns of data into one column
 namespace nebula {
 namespace graph {
 
-class UnwindExecutor final : public Executor {
+class UnwindExecutor final : public PipelineExecutor {
  public:
   UnwindExecutor(const PlanNode *node, QueryContext *qctx)
-      : Executor("UnwindExecutor", node, qctx) {}
+      : PipelineExecutor("UnwindExecutor", node, qctx) {}
 
-  folly::Future<Status> execute() override;
+  folly::Future<Status> executeAll() override;
+
+  Status processBatch(Iterator *input, DataSet *output, bool *done) override;
 
  private:
   std::vector<Value> extractList(const Value &val);
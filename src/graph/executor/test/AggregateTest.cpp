@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 
+#include "common/expression/ArithmeticExpression.h"
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/AggregateExecutor.h"
 #include "graph/planner/plan/Query.h"
@@ -2177,5 +2178,67 @@ TEST_F(AggregateTest, BitXor) {
     TEST_AGG_4("BIT_XOR", "bit_xor", true)
   }
 }
+
+TEST_F(AggregateTest, TypedColumns) {
+  // k is a nullable int key, v a nullable int, f a float and big overflows any
+  // sum of more than one row
+  DataSet ds({"k", "v", "f", "big"});
+  for (int64_t i = 0; i < 20; ++i) {
+    Row row;
+    row.values.emplace_back(i % 7 == 0 ? Value::kNullValue : Value(i % 3));
+    row.values.emplace_back(i % 5 == 0 ? Value::kNullValue : Value(i));
+    row.values.emplace_back(i * 0.25);
+    row.values.emplace_back(std::numeric_limits<int64_t>::max() - i);
+    ds.rows.emplace_back(std::move(row));
+  }
+  std::string input = "input_typed";
+  qctx_->symTable()->newVariable(input);
+  qctx_->ectx()->setResult(input, ResultBuilder().value(Value(std::move(ds))).build());
+
+  // `$-.k + 0` groups like `$-.k` but is not a plain input column, so it takes
+  // the row path, against which the typed one is checked
+  auto aggregate = [&](bool typed) {
+    auto key = [&]() -> Expression* {
+      auto* k = InputPropertyExpression::make(pool_, "k");
+      return typed ? static_cast<Expression*>(k)
+                   : ArithmeticExpression::makeAdd(pool_, k, ConstantExpression::make(pool_, 0));
+    };
+    auto col = [&](const std::string& name) { return InputPropertyExpression::make(pool_, name); };
+    std::vector<Expression*> groupKeys{key()};
+    std::vector<Expression*> groupItems{
+        AggregateExpression::make(pool_, "", key(), false),
+        AggregateExpression::make(pool_, "COUNT", ConstantExpression::make(pool_, "*"), false),
+        AggregateExpression::make(pool_, "COUNT", col("v"), false),
+        AggregateExpression::make(pool_, "SUM", col("v"), false),
+        AggregateExpression::make(pool_, "SUM", col("f"), false),
+        AggregateExpression::make(pool_, "SUM", col("big"), false),
+        AggregateExpression::make(pool_, "AVG", col("v"), false),
+        AggregateExpression::make(pool_, "AVG", col("f"), false),
+        AggregateExpression::make(pool_, "MAX", col("v"), false),
+        AggregateExpression::make(pool_, "MIN", col("f"), false),
+    };
+    auto* agg =
+        Aggregate::make(qctx_.get(), nullptr, std::move(groupKeys), std::move(groupItems));
+    agg->setInputVar(input);
+    agg->setColNames({"k", "count", "count_v", "sum_v", "sum_f", "sum_big", "avg_v", "avg_f",
+                      "max_v", "min_f"});
+
+    AggregateExecutor exe(agg, qctx_.get());
+    EXPECT_TRUE(exe.execute().get().ok());
+    EXPECT_EQ(exe.otherStats().count("aggregate by"), typed ? 1 : 0);
+    DataSet result = qctx_->ectx()->getResult(agg->outputVar()).value().getDataSet();
+    std::sort(result.rows.begin(), result.rows.end(), RowCmp());
+    return result;
+  };
+
+  auto typed = aggregate(true);
+  auto rows = aggregate(false);
+  ASSERT_EQ(typed.rows.size(), 4);
+  EXPECT_EQ(typed, rows);
+  for (auto& row : typed.rows) {
+    EXPECT_TRUE(row.values[5].isNull());
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -75,5 +75,6 @@ TEST_F(DedupTest, WrongTypeIterator) {
   DEDUP_RESULT_CHECK(
       "input_neighbor", "dedup_sequential", "YIELD DISTINCT $-.v_dst as name", expected);
 }
+
 }  // namespace graph
 }  // namespace nebula
@@ -86,5 +86,48 @@ TEST_F(FilterTest, TestEmpty) {
                       "YIELD $^.person.name AS name WHERE study.start_year >= 2010",
                       expected);
 }
+
+TEST_F(FilterTest, TypedColumns) {
+  // (id, i, f, b) of (k, k if k % 4 != 0 else NULL, k * 0.5, k % 2 == 0)
+  DataSet ds({"id", "i", "f", "b"});
+  for (int64_t k = 0; k < 10; ++k) {
+    Row row;
+    row.values.emplace_back(k);
+    row.values.emplace_back(k % 4 == 0 ? Value::kNullValue : Value(k));
+    row.values.emplace_back(k * 0.5);
+    row.values.emplace_back(k % 2 == 0);
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto filter = [this, &ds](const std::string& cond, bool typed) {
+    qctx_->ectx()->setResult("input_typed", ResultBuilder().value(Value(ds)).build());
+    auto* condition = getYieldFilter("YIELD $-.id WHERE " + cond, qctx_.get());
+    auto* node = Filter::make(qctx_.get(), nullptr, condition);
+    node->setInputVar("input_typed");
+    FilterExecutor exe(node, qctx_.get());
+    EXPECT_TRUE(exe.execute().get().ok());
+    EXPECT_EQ(exe.otherStats().count("filter by"), typed ? 1 : 0) << cond;
+    std::vector<int64_t> ids;
+    auto& result = qctx_->ectx()->getResult(node->outputVar());
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      ids.emplace_back(iter->getColumn("id").getInt());
+    }
+    // The rows are reordered by the unstable filter
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  qctx_->symTable()->newVariable("input_typed");
+
+  // NULL never satisfies the comparison
+  EXPECT_EQ(filter("$-.i > 3 AND $-.f <= 4.0", true), std::vector<int64_t>({5, 6, 7}));
+  EXPECT_EQ(filter("2 < $-.i", true), std::vector<int64_t>({3, 5, 6, 7, 9}));
+  EXPECT_EQ(filter("$-.i != 3", true), std::vector<int64_t>({1, 2, 5, 6, 7, 9}));
+  // The numbers of different types are compared with epsilon
+  EXPECT_EQ(filter("$-.f == 1", true), std::vector<int64_t>({2}));
+  EXPECT_EQ(filter("$-.i >= 2.0 AND $-.b == true", true), std::vector<int64_t>({2, 6}));
+  // BOOL is not comparable with numbers
+  EXPECT_EQ(filter("$-.b == 1", false), std::vector<int64_t>());
+  EXPECT_EQ(filter("$-.i > 3 OR $-.f < 1", false), std::vector<int64_t>({0, 1, 5, 6, 7, 9}));
+}
+
 }  // namespace graph
 }  // namespace nebula
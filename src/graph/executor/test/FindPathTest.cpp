@@ -10,6 +10,7 @@
 #include "graph/executor/algo/ProduceAllPathsExecutor.h"
 #include "graph/planner/plan/Algo.h"
 #include "graph/planner/plan/Logic.h"
+#include "graph/session/ClientSession.h"
 
 namespace nebula {
 namespace graph {
@@ -370,6 +371,19 @@ class FindPathTest : public testing::Test {
 
   void SetUp() override {
     qctx_ = std::make_unique<QueryContext>();
+    // The sets of vids are specialized for the vid type of the space, FIXED_STRING(8) by default
+    meta::cpp2::Session session;
+    session.session_id_ref() = 0;
+    session.user_name_ref() = "root";
+    auto clientSession = ClientSession::create(std::move(session), nullptr);
+    SpaceInfo spaceInfo;
+    spaceInfo.name = "test_space";
+    spaceInfo.id = 1;
+    spaceInfo.spaceDesc.space_name_ref() = "test_space";
+    clientSession->setSpace(std::move(spaceInfo));
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(std::move(clientSession));
+    qctx_->setRCtx(std::move(rctx));
     singleSourceInit();
     mulitSourceInit();
     allPathInit();
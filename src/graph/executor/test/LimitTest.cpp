@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include "graph/context/QueryContext.h"
+#include "graph/executor/query/FilterExecutor.h"
 #include "graph/executor/query/LimitExecutor.h"
 #include "graph/executor/query/ProjectExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
@@ -13,6 +14,8 @@
 #include "graph/planner/plan/Query.h"
 #include "graph/util/ExpressionUtils.h"
 
+DECLARE_uint32(pipeline_batch_size);
+
 namespace nebula {
 namespace graph {
 class LimitTest : public QueryTestBase {};
@@ -72,5 +75,44 @@ TEST_F(LimitTest, getNeighborOutRange2) {
   DataSet expected({"name", "start"});
   LIMIT_RESULT_CHECK("limit_out_sequential2", 6, 2, expected);
 }
+
+TEST_F(LimitTest, Pipeline) {
+  gflags::FlagSaver saver;
+  FLAGS_pipeline_batch_size = 2;
+  auto* pool = qctx_->objPool();
+  auto* start = StartNode::make(qctx_.get());
+  auto yieldSentence =
+      getYieldSentence("YIELD $-.v_name AS name, $-.e_start_year AS start", qctx_.get());
+  auto* project = Project::make(qctx_.get(), start, yieldSentence->yieldColumns());
+  project->setInputVar("input_sequential");
+  project->setColNames(std::vector<std::string>{"name", "start"});
+  auto* condition = RelationalExpression::makeGT(
+      pool, InputPropertyExpression::make(pool, "start"), ConstantExpression::make(pool, 2008));
+  auto* filter = Filter::make(qctx_.get(), project, condition);
+  filter->setColNames(project->colNames());
+  auto* limit = Limit::make(qctx_.get(), filter, 1, 2);
+  limit->setColNames(project->colNames());
+
+  auto* limitExe = Executor::create(limit, qctx_.get());
+  auto* filterExe = *limitExe->depends().begin();
+  auto* projectExe = *filterExe->depends().begin();
+  for (auto* exe : {limitExe, filterExe, projectExe}) {
+    PipelineExecutor::fuse(exe);
+  }
+  for (auto* exe : {projectExe, filterExe, limitExe}) {
+    EXPECT_TRUE(exe->execute().get().ok());
+  }
+
+  // The rows are pulled batch by batch and the pipeline stops once Limit has two rows
+  DataSet expected({"name", "start"});
+  expected.emplace_back(Row({Value("Joy"), Value(2009)}));
+  expected.emplace_back(Row({Value("Kate"), Value(2009)}));
+  auto& result = qctx_->ectx()->getResult(limit->outputVar());
+  EXPECT_EQ(result.value().getDataSet(), expected);
+  EXPECT_EQ(result.state(), Result::State::kSuccess);
+  // The intermediate results are not materialized
+  EXPECT_FALSE(qctx_->ectx()->exist(project->outputVar()));
+  EXPECT_FALSE(qctx_->ectx()->exist(filter->outputVar()));
+}
 }  // namespace graph
 }  // namespace nebula
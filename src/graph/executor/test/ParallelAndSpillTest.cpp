@@ -0,0 +1,317 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/context/QueryContext.h"
+#include "graph/executor/query/AggregateExecutor.h"
+#include "graph/executor/query/DedupExecutor.h"
+#include "graph/executor/query/InnerJoinExecutor.h"
+#include "graph/executor/query/LeftJoinExecutor.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+// The operator threads and the memory budget an operator is executed with
+struct ExecutionMode {
+  int32_t numThreads;
+  int64_t budget;
+};
+
+// Each operator is executed in the mode of the test and compared with the serial execution within
+// the memory, see the modes instantiated at the bottom.
+class ParallelAndSpillTest : public testing::TestWithParam<ExecutionMode> {
+ protected:
+  void SetUp() override {
+    qctx_ = std::make_unique<QueryContext>();
+    pool_ = qctx_->objPool();
+    // Restored by saver_
+    FLAGS_min_rows_for_parallel_operator = 1;
+    FLAGS_num_operator_threads = GetParam().numThreads;
+    FLAGS_query_memory_budget_bytes = GetParam().budget;
+  }
+
+  bool parallel() const {
+    return GetParam().numThreads > 1;
+  }
+
+  // Whether the input always exceeds the budget
+  bool spill() const {
+    return GetParam().budget == 1;
+  }
+
+  // Return `run()' executed by one thread without any memory budget
+  template <typename F>
+  static auto serially(F&& run) {
+    gflags::FlagSaver saver;
+    FLAGS_num_operator_threads = 1;
+    FLAGS_query_memory_budget_bytes = 0;
+    return run();
+  }
+
+  void setInput(const std::string& var, const DataSet& ds, bool movable = false) {
+    if (qctx_->symTable()->getVar(var) == nullptr) {
+      qctx_->symTable()->newVariable(var);
+    }
+    qctx_->ectx()->setResult(var, ResultBuilder().value(Value(ds)).build());
+    // The input rows are released after spilled only if it's the last user
+    qctx_->symTable()->getVar(var)->userCount.store(movable ? 1 : 0);
+  }
+
+  // Rows of the result of the executor, sorted if `sorted'
+  DataSet execute(Executor* exe, bool sorted) {
+    EXPECT_TRUE(exe->execute().get().ok());
+    stats_ = exe->otherStats();
+    auto& result = qctx_->ectx()->getResult(exe->node()->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    DataSet ds(result.value().getDataSet().colNames);
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      ds.rows.emplace_back(*iter->row());
+    }
+    if (sorted) {
+      std::sort(ds.rows.begin(), ds.rows.end());
+    }
+    return ds;
+  }
+
+  // 1000 rows of (id, key, name), where key is NULL in every 13 rows and repeats otherwise
+  static DataSet makeInput() {
+    DataSet ds({"id", "key", "name"});
+    for (auto i = 0; i < 1000; ++i) {
+      Row row;
+      row.values.emplace_back(i);
+      if (i % 13 == 0) {
+        row.values.emplace_back(Value::kNullValue);
+      } else {
+        row.values.emplace_back((i * 37) % 101);
+      }
+      row.values.emplace_back(folly::to<std::string>(i));
+      ds.rows.emplace_back(std::move(row));
+    }
+    return ds;
+  }
+
+  gflags::FlagSaver saver_;
+  std::unique_ptr<QueryContext> qctx_;
+  ObjectPool* pool_;
+  std::unordered_map<std::string, std::string> stats_;
+};
+
+TEST_P(ParallelAndSpillTest, Aggregate) {
+  auto input = makeInput();
+  auto runAgg = [&](const std::string& fun, bool distinct) {
+    setInput("agg_input", input);
+    // key = key, items = key, fun(id)
+    auto* key = InputPropertyExpression::make(pool_, "key");
+    std::vector<Expression*> groupKeys = {key};
+    std::vector<Expression*> groupItems;
+    groupItems.emplace_back(AggregateExpression::make(pool_, "", key->clone(), false));
+    auto* arg = InputPropertyExpression::make(pool_, "id");
+    groupItems.emplace_back(AggregateExpression::make(pool_, fun, arg, distinct));
+    auto* agg = Aggregate::make(qctx_.get(), nullptr, std::move(groupKeys), std::move(groupItems));
+    agg->setInputVar("agg_input");
+    agg->setColNames(std::vector<std::string>{"key", fun});
+    AggregateExecutor exe(agg, qctx_.get());
+    return execute(&exe, true);
+  };
+
+  for (auto& fun : {"COUNT", "SUM", "AVG", "MAX", "COLLECT", "COLLECT_SET"}) {
+    for (auto distinct : {false, true}) {
+      auto expected = serially([&]() { return runAgg(fun, distinct); });
+      EXPECT_EQ(stats_.count("parallel"), 0);
+      EXPECT_EQ(stats_.count("spilled_partitions"), 0);
+
+      EXPECT_EQ(runAgg(fun, distinct), expected) << fun << (distinct ? " distinct" : "");
+      EXPECT_EQ(stats_.count("parallel"), parallel() ? 1 : 0) << fun;
+      if (spill()) {
+        EXPECT_EQ(stats_.count("spilled_partitions"), 1) << fun;
+      }
+    }
+  }
+}
+
+TEST_P(ParallelAndSpillTest, AggregateEmptyInput) {
+  FLAGS_min_rows_for_parallel_operator = 0;
+  setInput("agg_empty_input", DataSet(std::vector<std::string>{"id"}));
+  std::vector<Expression*> groupItems;
+  groupItems.emplace_back(
+      AggregateExpression::make(pool_, "COUNT", ConstantExpression::make(pool_, 1), false));
+  groupItems.emplace_back(
+      AggregateExpression::make(pool_, "SUM", InputPropertyExpression::make(pool_, "id"), false));
+  auto* agg = Aggregate::make(qctx_.get(), nullptr, {}, std::move(groupItems));
+  agg->setInputVar("agg_empty_input");
+  agg->setColNames(std::vector<std::string>{"count", "sum"});
+  AggregateExecutor exe(agg, qctx_.get());
+
+  // The default row of all the aggregate items, whatever the parallelism is
+  DataSet expected(std::vector<std::string>{"count", "sum"});
+  expected.emplace_back(Row({0, 0}));
+  EXPECT_EQ(execute(&exe, false), expected);
+  EXPECT_EQ(stats_.count("parallel"), 0);
+}
+
+TEST_P(ParallelAndSpillTest, Join) {
+  DataSet lhs({"src", "dst"});
+  for (auto i = 0; i < 1000; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    // Keep some keys missing and some NULL
+    if (i % 7 == 0) {
+      row.values.emplace_back(Value::kNullValue);
+    } else {
+      row.values.emplace_back(i % 300);
+    }
+    lhs.rows.emplace_back(std::move(row));
+  }
+  DataSet rhs({"id", "prop"});
+  for (auto i = 0; i < 400; ++i) {
+    Row row;
+    row.values.emplace_back(i % 200);
+    row.values.emplace_back(folly::to<std::string>(i));
+    rhs.rows.emplace_back(std::move(row));
+  }
+
+  auto runJoin = [&](bool isLeftJoin, bool movable) {
+    // The inputs are only spilled if they could be released
+    setInput("join_lhs", lhs, movable);
+    setInput("join_rhs", rhs, movable);
+    std::vector<Expression*> hashKeys = {
+        VariablePropertyExpression::make(pool_, "join_lhs", "dst")};
+    std::vector<Expression*> probeKeys = {
+        VariablePropertyExpression::make(pool_, "join_rhs", "id")};
+    std::unique_ptr<Executor> exe;
+    if (isLeftJoin) {
+      auto* join = LeftJoin::make(qctx_.get(),
+                                  nullptr,
+                                  {"join_lhs", 0},
+                                  {"join_rhs", 0},
+                                  std::move(hashKeys),
+                                  std::move(probeKeys));
+      join->setColNames(std::vector<std::string>{"src", "dst", "id", "prop"});
+      exe = std::make_unique<LeftJoinExecutor>(join, qctx_.get());
+    } else {
+      auto* join = InnerJoin::make(qctx_.get(),
+                                   nullptr,
+                                   {"join_lhs", 0},
+                                   {"join_rhs", 0},
+                                   std::move(hashKeys),
+                                   std::move(probeKeys));
+      join->setColNames(std::vector<std::string>{"src", "dst", "id", "prop"});
+      exe = std::make_unique<InnerJoinExecutor>(join, qctx_.get());
+    }
+    return execute(exe.get(), true);
+  };
+
+  for (auto isLeftJoin : {false, true}) {
+    auto name = isLeftJoin ? "LeftJoin" : "InnerJoin";
+    auto expected = serially([&]() { return runJoin(isLeftJoin, false); });
+    EXPECT_FALSE(expected.rows.empty());
+    EXPECT_EQ(stats_.count("parallel"), 0);
+
+    EXPECT_EQ(runJoin(isLeftJoin, GetParam().budget > 0), expected) << name;
+    EXPECT_EQ(stats_.count("parallel"), parallel() ? 1 : 0) << name;
+    EXPECT_EQ(stats_.count("partition_skew"), parallel() ? 1 : 0) << name;
+    if (spill()) {
+      EXPECT_EQ(stats_.count("spilled_partitions"), 1) << name;
+    }
+  }
+}
+
+TEST_P(ParallelAndSpillTest, Sort) {
+  auto input = makeInput();
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+  factors.emplace_back(std::make_pair(1, OrderFactor::OrderType::DESCEND));
+  factors.emplace_back(std::make_pair(0, OrderFactor::OrderType::ASCEND));
+  auto runSort = [&]() {
+    setInput("sort_input", input);
+    auto* sort = Sort::make(qctx_.get(), StartNode::make(qctx_.get()), factors);
+    sort->setInputVar("sort_input");
+    auto exe = Executor::create(sort, qctx_.get());
+    return execute(exe, false);
+  };
+
+  auto expected = serially(runSort);
+  EXPECT_EQ(stats_.count("sorted_runs"), 0);
+  // Sort keeps the input in memory whatever the budget is
+  EXPECT_EQ(runSort(), expected);
+  if (parallel()) {
+    EXPECT_EQ(stats_.at("sorted_runs"), folly::to<std::string>(GetParam().numThreads));
+  } else {
+    EXPECT_EQ(stats_.count("sorted_runs"), 0);
+  }
+}
+
+TEST_P(ParallelAndSpillTest, TopN) {
+  auto input = makeInput();
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+  factors.emplace_back(std::make_pair(1, OrderFactor::OrderType::ASCEND));
+  factors.emplace_back(std::make_pair(0, OrderFactor::OrderType::DESCEND));
+  auto runTopN = [&](int64_t offset, int64_t count) {
+    setInput("topn_input", input);
+    auto* topn = TopN::make(qctx_.get(), StartNode::make(qctx_.get()), factors, offset, count);
+    topn->setInputVar("topn_input");
+    auto exe = Executor::create(topn, qctx_.get());
+    return execute(exe, false);
+  };
+
+  for (auto offsetAndCount : std::vector<std::pair<int64_t, int64_t>>{
+           {0, 1}, {0, 10}, {5, 100}, {990, 100}, {0, 1000}, {1000, 10}}) {
+    auto offset = offsetAndCount.first;
+    auto count = offsetAndCount.second;
+    auto expected = serially([&]() { return runTopN(offset, count); });
+    EXPECT_EQ(expected.rows.size(), std::min<size_t>(count, std::max<int64_t>(1000 - offset, 0)));
+    EXPECT_EQ(stats_.count("parallel"), 0);
+
+    EXPECT_EQ(runTopN(offset, count), expected) << "offset: " << offset << ", count: " << count;
+    // Nothing to sort if the offset skips all rows
+    EXPECT_EQ(stats_.count("parallel"), parallel() && !expected.rows.empty() ? 1 : 0);
+  }
+}
+
+TEST_P(ParallelAndSpillTest, Dedup) {
+  DataSet input({"id", "name"});
+  for (auto i = 0; i < 1000; ++i) {
+    Row row;
+    row.values.emplace_back(i % 97);
+    if (i % 11 == 0) {
+      row.values.emplace_back(Value::kNullValue);
+    } else {
+      row.values.emplace_back(folly::to<std::string>(i % 97));
+    }
+    input.rows.emplace_back(std::move(row));
+  }
+  auto runDedup = [&]() {
+    setInput("dedup_input", input, true);
+    auto* dedup = Dedup::make(qctx_.get(), nullptr);
+    dedup->setInputVar("dedup_input");
+    DedupExecutor exe(dedup, qctx_.get());
+    return execute(&exe, true);
+  };
+
+  auto expected = serially(runDedup);
+  EXPECT_EQ(expected.rows.size(), 97 + 91);
+  EXPECT_EQ(stats_.count("spilled_partitions"), 0);
+  // Dedup is never parallel, but spills once the input exceeds the budget
+  EXPECT_EQ(runDedup(), expected);
+  EXPECT_EQ(stats_.count("spilled_partitions"), GetParam().budget > 0 ? 1 : 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadsAndBudget,
+                         ParallelAndSpillTest,
+                         ::testing::Values(ExecutionMode{2, 0},
+                                           ExecutionMode{3, 0},
+                                           ExecutionMode{16, 0},
+                                           ExecutionMode{1, 1},
+                                           ExecutionMode{1, 4096}),
+                         [](const testing::TestParamInfo<ExecutionMode>& info) {
+                           return folly::sformat(
+                               "Threads{}Budget{}", info.param.numThreads, info.param.budget);
+                         });
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,225 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "graph/context/QueryContext.h"
+#include "graph/executor/algo/BatchShortestPath.h"
+#include "graph/executor/algo/SingleShortestPath.h"
+#include "graph/planner/plan/Algo.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/session/ClientSession.h"
+
+DECLARE_uint32(num_path_thread);
+
+namespace nebula {
+namespace graph {
+
+// Only the side with the smaller frontier is expanded at each step
+class ShortestPathTest : public testing::Test {
+ protected:
+  static constexpr EdgeType kLike = 1;
+
+  void SetUp() override {
+    qctx_ = std::make_unique<QueryContext>();
+    meta::cpp2::Session session;
+    session.session_id_ref() = 0;
+    session.user_name_ref() = "root";
+    auto clientSession = ClientSession::create(std::move(session), nullptr);
+    SpaceInfo spaceInfo;
+    spaceInfo.name = "test_space";
+    spaceInfo.id = 1;
+    spaceInfo.spaceDesc.space_name_ref() = "test_space";
+    spaceInfo.spaceDesc.vid_type_ref()->type_ref() = nebula::cpp2::PropertyType::INT64;
+    clientSession->setSpace(std::move(spaceInfo));
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(std::move(clientSession));
+    qctx_->setRCtx(std::move(rctx));
+
+    // Topology is below
+    // 1->100, 1->101, ..., 1->109
+    // 100->50
+    // 50->2, 3->2
+    edges_.emplace_back(100, 50);
+    edges_.emplace_back(50, 2);
+    edges_.emplace_back(3, 2);
+    for (int64_t dst = 100; dst < 110; ++dst) {
+      edges_.emplace_back(1, dst);
+    }
+  }
+
+  ShortestPath* makePath(size_t maxStep) {
+    auto* path = ShortestPath::make(qctx_.get(), StartNode::make(qctx_.get()), 1, true);
+    path->setStepRange(qctx_->objPool()->makeAndAdd<MatchStepRange>(1, maxStep));
+    path->setColNames({"src", "steps", "dst"});
+    return path;
+  }
+
+  // The out edges of the vids, or the in edges if reverse, as returned by storaged
+  List neighbors(std::vector<Row> vids, bool reverse) const {
+    DataSet ds({kVid,
+                "_stats",
+                reverse ? "_edge:-like:_type:_dst:_rank" : "_edge:+like:_type:_dst:_rank",
+                "_expr"});
+    for (auto& row : vids) {
+      auto vid = row.values.front().getInt();
+      List edges;
+      for (const auto& [src, dst] : edges_) {
+        if (!reverse && src == vid) {
+          edges.values.emplace_back(List({kLike, dst, 0}));
+        } else if (reverse && dst == vid) {
+          edges.values.emplace_back(List({-kLike, src, 0}));
+        }
+      }
+      ds.rows.emplace_back(Row({vid, Value::kEmpty, std::move(edges), Value::kEmpty}));
+    }
+    List list;
+    list.values.emplace_back(std::move(ds));
+    return list;
+  }
+
+  // Run the search of the row step by step as it's driven by the responses of storaged, the meet
+  // vertices are the vids without any tag
+  template <typename T>
+  void run(T* path, size_t maxStep) {
+    for (size_t stepNum = 1;; ++stepNum) {
+      bool reverse = path->startStep(0);
+      auto& vids = reverse ? path->rightVids_[0].rows : path->leftVids_[0].rows;
+      auto listVal = std::make_shared<Value>(neighbors(std::move(vids), reverse));
+      GetNeighborsIter iter(listVal);
+      auto status = path->doBuildPath(0, &iter, reverse);
+      ASSERT_TRUE(status.ok()) << status;
+
+      std::vector<Value> meetVids;
+      if constexpr (std::is_same_v<T, SingleShortestPath>) {
+        meetVids = path->findMeetVids(0, reverse);
+      } else {
+        meetVids = path->findMeetVids(0);
+      }
+      std::vector<Value> vertices;
+      for (auto& vid : meetVids) {
+        vertices.emplace_back(Vertex(vid, {}));
+      }
+      if (!vertices.empty() && path->buildMeetPath(0, std::move(vertices))) {
+        break;
+      }
+      if (stepNum >= maxStep || path->leftVids_[0].rows.empty() ||
+          path->rightVids_[0].rows.empty()) {
+        break;
+      }
+    }
+  }
+
+  DataSet single(int64_t start, int64_t end, size_t maxStep) {
+    auto* node = makePath(maxStep);
+    SingleShortestPath path(node, qctx_.get(), &stats_);
+    path.init({start}, {end}, 1);
+    run(&path, maxStep);
+    leftSteps_ = path.leftSteps_[0];
+    rightSteps_ = path.rightSteps_[0];
+    path.addExpansionStats();
+    return std::move(path.resultDs_[0]);
+  }
+
+  DataSet batch(const std::unordered_set<Value>& starts,
+                const std::unordered_set<Value>& ends,
+                size_t maxStep) {
+    gflags::FlagSaver saver;
+    // All pairs of the start and end vids are in one row
+    FLAGS_num_path_thread = 1;
+    auto* node = makePath(maxStep);
+    BatchShortestPath path(node, qctx_.get(), &stats_);
+    EXPECT_EQ(path.init(starts, ends), 1);
+    run(&path, maxStep);
+    leftSteps_ = path.leftSteps_[0];
+    rightSteps_ = path.rightSteps_[0];
+    return std::move(path.resultDs_[0]);
+  }
+
+  // The vids on the path, each edge of which must connect the vertices beside it
+  static std::vector<int64_t> pathVids(const Row& row) {
+    std::vector<int64_t> vids = {row.values[0].getVertex().vid.getInt()};
+    const auto& steps = row.values[1].getList().values;
+    for (size_t i = 0; i < steps.size(); ++i) {
+      if (steps[i].isVertex()) {
+        vids.emplace_back(steps[i].getVertex().vid.getInt());
+        continue;
+      }
+      const auto& edge = steps[i].getEdge();
+      auto next = i + 1 < steps.size() ? steps[i + 1] : row.values[2];
+      std::set<Value> ends = {edge.src, edge.dst};
+      std::set<Value> expected = {Value(vids.back()), next.getVertex().vid};
+      EXPECT_EQ(expected, ends) << row;
+    }
+    vids.emplace_back(row.values[2].getVertex().vid.getInt());
+    return vids;
+  }
+
+  std::unique_ptr<QueryContext> qctx_;
+  std::vector<std::pair<int64_t, int64_t>> edges_;
+  std::unordered_map<std::string, std::string> stats_;
+  size_t leftSteps_{0};
+  size_t rightSteps_{0};
+};
+
+TEST_F(ShortestPathTest, SmallerFrontierFirst) {
+  // The left frontier grows to 10 vids at the first step, then the right one is expanded until
+  // it meets the left one
+  auto result = single(1, 2, 5);
+  ASSERT_EQ(result.rows.size(), 1);
+  EXPECT_EQ(pathVids(result.rows[0]), std::vector<int64_t>({1, 100, 50, 2}));
+  EXPECT_EQ(leftSteps_, 1);
+  EXPECT_EQ(rightSteps_, 2);
+
+  result = batch({1}, {2}, 5);
+  ASSERT_EQ(result.rows.size(), 1);
+  EXPECT_EQ(pathVids(result.rows[0]), std::vector<int64_t>({1, 100, 50, 2}));
+  EXPECT_EQ(leftSteps_, 1);
+  EXPECT_EQ(rightSteps_, 2);
+
+  // Longer than the steps
+  EXPECT_TRUE(single(1, 2, 2).rows.empty());
+  EXPECT_TRUE(batch({1}, {2}, 2).rows.empty());
+}
+
+TEST_F(ShortestPathTest, MeetAtEnd) {
+  // The right side is never expanded
+  auto result = single(3, 2, 5);
+  ASSERT_EQ(result.rows.size(), 1);
+  EXPECT_EQ(pathVids(result.rows[0]), std::vector<int64_t>({3, 2}));
+  EXPECT_EQ(leftSteps_, 1);
+  EXPECT_EQ(rightSteps_, 0);
+
+  result = batch({3}, {2}, 5);
+  ASSERT_EQ(result.rows.size(), 1);
+  EXPECT_EQ(pathVids(result.rows[0]), std::vector<int64_t>({3, 2}));
+  EXPECT_EQ(leftSteps_, 1);
+  EXPECT_EQ(rightSteps_, 0);
+}
+
+TEST_F(ShortestPathTest, MeetAtStart) {
+  // More start vids than end vids, so the left side is never expanded
+  auto result = batch({1, 5, 6}, {100}, 5);
+  ASSERT_EQ(result.rows.size(), 1);
+  EXPECT_EQ(pathVids(result.rows[0]), std::vector<int64_t>({1, 100}));
+  EXPECT_EQ(leftSteps_, 0);
+  EXPECT_GE(rightSteps_, 1);
+}
+
+TEST_F(ShortestPathTest, ExpansionStats) {
+  single(1, 2, 5);
+  EXPECT_EQ(stats_.count("expansions"), 0);
+
+  // Profiled
+  auto* node = makePath(5);
+  qctx_->plan()->setRoot(node);
+  PlanDescription planDesc;
+  qctx_->plan()->describe(&planDesc);
+  single(1, 2, 5);
+  ASSERT_EQ(stats_.count("expansions"), 1);
+  EXPECT_NE(stats_["expansions"].find("row 0: left 1, right 2"), std::string::npos);
+}
+
+}  // namespace graph
+}  // namespace nebula
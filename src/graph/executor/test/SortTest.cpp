@@ -130,5 +130,6 @@ TEST_F(SortTest, sortTwoColDesDes_union) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
   SORT_RESULT_CHECK("union_sequential", "union_sort_two_cols_des_des", true, factors, expected);
 }
+
 }  // namespace graph
 }  // namespace nebula
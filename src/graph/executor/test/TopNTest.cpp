@@ -112,5 +112,6 @@ TEST_F(TopNTest, topnTwoColDesAsc) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::ASCEND));
   TOPN_RESULT_CHECK("input_sequential", "topn_two_cols_des_asc", true, factors, 1, 9, expected);
 }
+
 }  // namespace graph
 }  // namespace nebula
@@ -0,0 +1,219 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "graph/context/QueryContext.h"
+#include "graph/executor/query/TraverseExecutor.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/session/ClientSession.h"
+
+namespace nebula {
+namespace graph {
+
+class TraverseTest : public testing::Test {
+ protected:
+  static constexpr EdgeType kLike = 1;
+
+  void SetUp() override {
+    qctx_ = std::make_unique<QueryContext>();
+    meta::cpp2::Session session;
+    session.session_id_ref() = 0;
+    session.user_name_ref() = "root";
+    auto clientSession = ClientSession::create(std::move(session), nullptr);
+    SpaceInfo spaceInfo;
+    spaceInfo.name = "test_space";
+    spaceInfo.id = 1;
+    spaceInfo.spaceDesc.space_name_ref() = "test_space";
+    spaceInfo.spaceDesc.vid_type_ref()->type_ref() = nebula::cpp2::PropertyType::FIXED_STRING;
+    clientSession->setSpace(std::move(spaceInfo));
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(std::move(clientSession));
+    rctx->setRunner(&runner_);
+    qctx_->setRCtx(std::move(rctx));
+
+    // The same vertex is the source of two input rows
+    DataSet input({"v"});
+    for (const auto* vid : {"a", "b", "a"}) {
+      input.rows.emplace_back(Row({vid}));
+    }
+    qctx_->symTable()->newVariable("input_traverse");
+    qctx_->ectx()->setResult("input_traverse", ResultBuilder().value(std::move(input)).build());
+  }
+
+  Traverse* makeTraverse(size_t minHop, size_t maxHop, Expression* eFilter = nullptr) {
+    auto* pool = qctx_->objPool();
+    auto* traverse = Traverse::make(qctx_.get(),
+                                    nullptr,
+                                    1,
+                                    InputPropertyExpression::make(pool, "v"),
+                                    {kLike, -kLike},
+                                    storage::cpp2::EdgeDirection::BOTH,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr);
+    traverse->setInputVar("input_traverse");
+    traverse->setColNames({"v", "src", "steps"});
+    traverse->setStepRange(pool->makeAndAdd<MatchStepRange>(minHop, maxHop));
+    traverse->setEdgeFilter(eFilter);
+    return traverse;
+  }
+
+  // The neighbors of the vertices as returned by storaged, there are two edges with different
+  // ranks from a to b, and the cycles a->b->c->a and a->c->d->a
+  static List neighbors(std::vector<Row> vids) {
+    static const std::vector<std::tuple<std::string, std::string, int64_t>> edges = {
+        {"a", "b", 0},
+        {"a", "b", 1},
+        {"a", "c", 0},
+        {"b", "c", 0},
+        {"c", "a", 0},
+        {"c", "d", 0},
+        {"d", "a", 0},
+    };
+    DataSet ds({kVid,
+                "_stats",
+                "_edge:+like:_type:_dst:_rank",
+                "_edge:-like:_type:_dst:_rank",
+                "_expr"});
+    for (auto& row : vids) {
+      const auto& vid = row.values.front().getStr();
+      List outEdges, inEdges;
+      for (const auto& [src, dst, rank] : edges) {
+        if (src == vid) {
+          outEdges.values.emplace_back(List({kLike, dst, rank}));
+        }
+        if (dst == vid) {
+          inEdges.values.emplace_back(List({-kLike, src, rank}));
+        }
+      }
+      ds.rows.emplace_back(
+          Row({vid, Value::kEmpty, std::move(outEdges), std::move(inEdges), Value::kEmpty}));
+    }
+    List list;
+    list.values.emplace_back(std::move(ds));
+    return list;
+  }
+
+  // Run the executor step by step as it's driven by the responses of storaged
+  DataSet traverse(const Traverse* node) {
+    TraverseExecutor exe(node, qctx_.get());
+    exe.range_ = node->stepRange();
+    auto status = exe.buildRequestDataSet();
+    EXPECT_TRUE(status.ok()) << status;
+    while (status.ok() && !exe.reqDs_.rows.empty()) {
+      exe.currentStep_++;
+      status = exe.buildInterimPath(neighbors(std::move(exe.reqDs_.rows))).get();
+      EXPECT_TRUE(status.ok()) << status;
+      if (exe.isFinalStep()) {
+        break;
+      }
+    }
+    status = exe.buildResult().get();
+    EXPECT_TRUE(status.ok()) << status;
+    // The trie of paths is released once the result is built
+    EXPECT_TRUE(exe.steps_.empty());
+    EXPECT_TRUE(exe.hops_.empty());
+    EXPECT_TRUE(exe.paths_.empty());
+    return qctx_->ectx()->getResult(node->outputVar()).value().getDataSet();
+  }
+
+  // Traverse by one thread and by multiple threads, which expand and materialize the paths in
+  // batches of a row, and check that the results are the same
+  DataSet checkParallel(const Traverse* node) {
+    DataSet serial, parallel;
+    {
+      gflags::FlagSaver saver;
+      FLAGS_num_operator_threads = 1;
+      serial = traverse(node);
+    }
+    {
+      gflags::FlagSaver saver;
+      FLAGS_num_operator_threads = 4;
+      FLAGS_min_rows_for_parallel_operator = 1;
+      parallel = traverse(node);
+    }
+    EXPECT_EQ(serial.colNames, parallel.colNames);
+    std::sort(serial.rows.begin(), serial.rows.end());
+    std::sort(parallel.rows.begin(), parallel.rows.end());
+    EXPECT_EQ(serial.rows, parallel.rows);
+
+    // No edge is taken twice by a path
+    for (const auto& row : serial.rows) {
+      const auto& steps = row.values.back().getList().values;
+      for (size_t i = 0; i < steps.size(); ++i) {
+        for (size_t j = i + 1; j < steps.size(); ++j) {
+          if (steps[i].isEdge() && steps[j].isEdge()) {
+            EXPECT_FALSE(steps[i].getEdge().keyEqual(steps[j].getEdge())) << row;
+          }
+        }
+      }
+    }
+    return serial;
+  }
+
+  folly::CPUThreadPoolExecutor runner_{4};
+  std::unique_ptr<QueryContext> qctx_;
+};
+
+TEST_F(TraverseTest, OneHop) {
+  // a: a->b twice, a->c, c->a, d->a; b: b->c, a->b twice
+  auto result = checkParallel(makeTraverse(1, 1));
+  EXPECT_EQ(result.rows.size(), 5 + 3 + 5);
+  for (const auto& row : result.rows) {
+    // The input row, the source vertex and the steps
+    ASSERT_EQ(row.size(), 3);
+    EXPECT_EQ(row.values[1].getVertex().vid, row.values[0]);
+    EXPECT_EQ(row.values[2].getList().size(), 1);
+  }
+}
+
+TEST_F(TraverseTest, MultiHopWithFilter) {
+  checkParallel(makeTraverse(1, 3));
+  checkParallel(makeTraverse(2, 4));
+
+  // Never walk into d
+  auto* pool = qctx_->objPool();
+  auto* eFilter = RelationalExpression::makeNE(
+      pool, EdgePropertyExpression::make(pool, "like", kDst), ConstantExpression::make(pool, "d"));
+  auto result = checkParallel(makeTraverse(1, 3, eFilter));
+  ASSERT_FALSE(result.rows.empty());
+  for (const auto& row : result.rows) {
+    for (const auto& step : row.values.back().getList().values) {
+      if (step.isEdge()) {
+        EXPECT_NE(step.getEdge().dst, Value("d")) << row;
+      }
+    }
+  }
+
+  // No path takes more than the 7 edges, so all paths end at the dead end
+  result = checkParallel(makeTraverse(9, 10));
+  EXPECT_TRUE(result.rows.empty());
+}
+
+TEST_F(TraverseTest, ZeroStep) {
+  auto result = checkParallel(makeTraverse(0, 2));
+  // [srcV, [srcV]] of each input row
+  size_t zeroSteps = 0;
+  for (const auto& row : result.rows) {
+    const auto& steps = row.values.back().getList().values;
+    if (steps.size() == 1 && steps.front().isVertex()) {
+      EXPECT_EQ(steps.front(), row.values[1]);
+      ++zeroSteps;
+    }
+  }
+  EXPECT_EQ(zeroSteps, 3);
+
+  result = checkParallel(makeTraverse(0, 0));
+  EXPECT_EQ(result.rows.size(), 3);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,148 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+
+#include "graph/util/VidSet.h"
+
+// The visited and frontier sets of BFS shortest path on the int vids
+namespace nebula {
+namespace graph {
+
+// The clustered vids, e.g. the auto increment ones, and the random ones
+std::vector<Value> gClusteredVids;
+std::vector<Value> gRandomVids;
+
+static meta::cpp2::ColumnTypeDef intVidType() {
+  meta::cpp2::ColumnTypeDef def;
+  def.type_ref() = nebula::cpp2::PropertyType::INT64;
+  return def;
+}
+
+static std::vector<Value> makeVids(size_t n, bool clustered) {
+  std::vector<Value> vids;
+  vids.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    vids.emplace_back(clustered ? static_cast<int64_t>(i * 3)
+                                : static_cast<int64_t>(folly::Random::rand64()));
+  }
+  return vids;
+}
+
+// Insert the vids, then look up each of them
+template <typename Set>
+void visit(Set& set, const std::vector<Value>& vids) {
+  for (auto& vid : vids) {
+    set.emplace(vid);
+  }
+  size_t found = 0;
+  for (auto& vid : vids) {
+    found += set.contains(vid) ? 1 : 0;
+  }
+  folly::doNotOptimizeAway(found);
+}
+
+void unorderedSetVisit(size_t iters, const std::vector<Value>& vids) {
+  for (size_t i = 0; i < iters; ++i) {
+    std::unordered_set<Value> set;
+    for (auto& vid : vids) {
+      set.emplace(vid);
+    }
+    size_t found = 0;
+    for (auto& vid : vids) {
+      found += set.find(vid) != set.end() ? 1 : 0;
+    }
+    folly::doNotOptimizeAway(found);
+  }
+}
+
+template <typename Set>
+void vidSetVisit(size_t iters, const std::vector<Value>& vids) {
+  for (size_t i = 0; i < iters; ++i) {
+    Set set(intVidType());
+    visit(set, vids);
+  }
+}
+
+// Intersect the first two thirds of the vids with the last two thirds
+void unorderedSetIntersect(size_t iters, const std::vector<Value>& vids) {
+  std::unordered_set<Value> left(vids.begin(), vids.begin() + vids.size() * 2 / 3);
+  std::unordered_set<Value> right(vids.begin() + vids.size() / 3, vids.end());
+  for (size_t i = 0; i < iters; ++i) {
+    std::vector<Value> meetVids;
+    for (auto& vid : left) {
+      if (right.find(vid) != right.end()) {
+        meetVids.emplace_back(vid);
+      }
+    }
+    folly::doNotOptimizeAway(meetVids);
+  }
+}
+
+template <typename Set>
+void vidSetIntersect(size_t iters, const std::vector<Value>& vids) {
+  Set left(intVidType()), right(intVidType());
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < vids.size() * 2 / 3; ++i) {
+      left.emplace(vids[i]);
+    }
+    for (size_t i = vids.size() / 3; i < vids.size(); ++i) {
+      right.emplace(vids[i]);
+    }
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(left.intersect(right));
+  }
+}
+
+BENCHMARK(UnorderedSetVisitClustered, iters) {
+  unorderedSetVisit(iters, gClusteredVids);
+}
+BENCHMARK_RELATIVE(VidSetVisitClustered, iters) {
+  vidSetVisit<VidSet>(iters, gClusteredVids);
+}
+BENCHMARK_RELATIVE(VidBitmapSetVisitClustered, iters) {
+  vidSetVisit<VidBitmapSet>(iters, gClusteredVids);
+}
+BENCHMARK(UnorderedSetVisitRandom, iters) {
+  unorderedSetVisit(iters, gRandomVids);
+}
+BENCHMARK_RELATIVE(VidSetVisitRandom, iters) {
+  vidSetVisit<VidSet>(iters, gRandomVids);
+}
+BENCHMARK_RELATIVE(VidBitmapSetVisitRandom, iters) {
+  vidSetVisit<VidBitmapSet>(iters, gRandomVids);
+}
+BENCHMARK_DRAW_LINE();
+BENCHMARK(UnorderedSetIntersectClustered, iters) {
+  unorderedSetIntersect(iters, gClusteredVids);
+}
+BENCHMARK_RELATIVE(VidSetIntersectClustered, iters) {
+  vidSetIntersect<VidSet>(iters, gClusteredVids);
+}
+BENCHMARK_RELATIVE(VidBitmapSetIntersectClustered, iters) {
+  vidSetIntersect<VidBitmapSet>(iters, gClusteredVids);
+}
+BENCHMARK(UnorderedSetIntersectRandom, iters) {
+  unorderedSetIntersect(iters, gRandomVids);
+}
+BENCHMARK_RELATIVE(VidSetIntersectRandom, iters) {
+  vidSetIntersect<VidSet>(iters, gRandomVids);
+}
+BENCHMARK_RELATIVE(VidBitmapSetIntersectRandom, iters) {
+  vidSetIntersect<VidBitmapSet>(iters, gRandomVids);
+}
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  nebula::graph::gClusteredVids = nebula::graph::makeVids(1000000, true);
+  nebula::graph::gRandomVids = nebula::graph::makeVids(1000000, false);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,413 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/CostModel.h"
+
+#include "common/expression/ConstantExpression.h"
+#include "graph/context/QueryContext.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::AppendVertices;
+using nebula::graph::Explore;
+using nebula::graph::GetNeighbors;
+using nebula::graph::IndexScan;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+using nebula::graph::ScanEdges;
+using nebula::graph::ScanVertices;
+using nebula::graph::Traverse;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// The estimates are capped to keep the costs comparable
+constexpr double kMaxRows = 1e15;
+// Steps of the variable length patterns are estimated up to
+constexpr size_t kMaxEstimatedSteps = 8;
+// Fraction of the input rows left after grouped by keys
+constexpr double kGroupReduction = 0.1;
+
+double capped(double rows) {
+  return std::min(std::max(rows, 0.0), kMaxRows);
+}
+
+// Fraction of the rows with a non-null value of the property
+double nonNullFraction(const meta::cpp2::PropStats &stats) {
+  double total = static_cast<double>(stats.get_count() + stats.get_null_count());
+  return total > 0 ? stats.get_count() / total : 1.0;
+}
+
+}  // namespace
+
+CostModel::CostModel(QueryContext *qctx) : qctx_(DCHECK_NOTNULL(qctx)) {
+  if (qctx_->rctx() != nullptr && qctx_->rctx()->session() != nullptr) {
+    space_ = qctx_->rctx()->session()->space().id;
+  }
+  if (space_ > 0 && qctx_->getMetaClient() != nullptr) {
+    stats_ = qctx_->getMetaClient()->getStatsFromCache(space_);
+  }
+}
+
+double CostModel::numVertices(folly::Optional<TagID> tagId) const {
+  if (stats_ == nullptr) {
+    return kDefaultNumVertices;
+  }
+  if (tagId.has_value() && qctx_->schemaMng() != nullptr) {
+    auto name = qctx_->schemaMng()->toTagName(space_, *tagId);
+    if (name.ok()) {
+      auto &tags = stats_->get_tag_vertices();
+      auto iter = tags.find(name.value());
+      if (iter != tags.end()) {
+        return iter->second;
+      }
+    }
+  }
+  return stats_->get_space_vertices();
+}
+
+double CostModel::numEdges(folly::Optional<EdgeType> edgeType) const {
+  if (stats_ == nullptr) {
+    return kDefaultNumVertices * kDefaultDegree;
+  }
+  if (edgeType.has_value() && qctx_->schemaMng() != nullptr) {
+    auto name = qctx_->schemaMng()->toEdgeName(space_, std::abs(*edgeType));
+    if (name.ok()) {
+      auto &edges = stats_->get_edges();
+      auto iter = edges.find(name.value());
+      if (iter != edges.end()) {
+        return iter->second;
+      }
+    }
+  }
+  return stats_->get_space_edges();
+}
+
+double CostModel::avgDegree(const std::vector<EdgeType> &edgeTypes,
+                            storage::cpp2::EdgeDirection direction) const {
+  double vertices = std::max(numVertices(), 1.0);
+  double edges = 0.0;
+  if (edgeTypes.empty()) {
+    edges = numEdges();
+    if (direction == storage::cpp2::EdgeDirection::BOTH) {
+      edges *= 2;
+    }
+  } else {
+    // The reversely traversed types are given as the negative ones
+    for (auto type : edgeTypes) {
+      edges += numEdges(type);
+    }
+  }
+  return edges / vertices;
+}
+
+double CostModel::indexSelectivity(const IndexScan *scan) const {
+  const auto &contexts = scan->queryContext();
+  if (contexts.empty()) {
+    return 1.0;
+  }
+  // The results of multiple contexts are united
+  double selectivity = 0.0;
+  for (const auto &ictx : contexts) {
+    selectivity += hintsSelectivity(scan->isEdge(), scan->schemaId(), ictx.get_column_hints());
+  }
+  return std::min(selectivity, 1.0);
+}
+
+double CostModel::hintsSelectivity(bool isEdge,
+                                   int32_t schemaId,
+                                   const std::vector<storage::cpp2::IndexColumnHint> &hints) const {
+  // The columns are assumed to be independent
+  double selectivity = 1.0;
+  for (const auto &hint : hints) {
+    const auto *stats = propStats(isEdge, schemaId, hint.get_column_name());
+    selectivity *= hint.get_scan_type() == storage::cpp2::ScanType::PREFIX
+                       ? equalSelectivity(stats)
+                       : rangeSelectivity(stats, hint);
+  }
+  return selectivity;
+}
+
+const meta::cpp2::PropStats *CostModel::propStats(bool isEdge,
+                                                  int32_t schemaId,
+                                                  const std::string &prop) const {
+  if (stats_ == nullptr || qctx_->schemaMng() == nullptr) {
+    return nullptr;
+  }
+  auto name = isEdge ? qctx_->schemaMng()->toEdgeName(space_, std::abs(schemaId))
+                     : qctx_->schemaMng()->toTagName(space_, schemaId);
+  if (!name.ok()) {
+    return nullptr;
+  }
+  const auto &schemas = isEdge ? stats_->get_edge_props() : stats_->get_tag_props();
+  auto schemaIter = schemas.find(name.value());
+  if (schemaIter == schemas.end()) {
+    return nullptr;
+  }
+  auto propIter = schemaIter->second.find(prop);
+  return propIter == schemaIter->second.end() ? nullptr : &propIter->second;
+}
+
+// static
+double CostModel::equalSelectivity(const meta::cpp2::PropStats *stats) {
+  if (stats == nullptr || stats->get_ndv() <= 0) {
+    return kEqualSelectivity;
+  }
+  return nonNullFraction(*stats) / stats->get_ndv();
+}
+
+// static
+double CostModel::rangeSelectivity(const meta::cpp2::PropStats *stats,
+                                   const storage::cpp2::IndexColumnHint &hint) {
+  if (stats == nullptr || stats->get_histogram().size() < 2) {
+    return kRangeSelectivity;
+  }
+  // The buckets overlapped with the range, the unset bound is unlimited
+  const auto &bounds = stats->get_histogram();
+  auto upperBounds = bounds.begin() + 1;
+  size_t numBuckets = bounds.size() - 1;
+  size_t first = 0, last = numBuckets - 1;
+  const auto &begin = hint.get_begin_value();
+  if (!begin.empty()) {
+    first = std::lower_bound(upperBounds, bounds.end(), begin) - upperBounds;
+  }
+  const auto &end = hint.get_end_value();
+  if (!end.empty()) {
+    last = std::min<size_t>(std::upper_bound(upperBounds, bounds.end(), end) - upperBounds, last);
+  }
+  // Half a bucket at least, since the range may be inside of a bucket
+  double buckets = first <= last ? static_cast<double>(last - first + 1) : 0.0;
+  return nonNullFraction(*stats) * std::max(buckets, 0.5) / numBuckets;
+}
+
+// static
+folly::Optional<double> CostModel::constLimit(const Expression *limit) {
+  if (limit == nullptr || limit->kind() != Expression::Kind::kConstant) {
+    return folly::none;
+  }
+  const auto &value = static_cast<const ConstantExpression *>(limit)->value();
+  if (!value.isInt() || value.getInt() < 0) {
+    return folly::none;
+  }
+  return static_cast<double>(value.getInt());
+}
+
+Estimate CostModel::estimate(const PlanNode *node,
+                             const std::vector<Estimate> &deps,
+                             const std::vector<Estimate> &bodies) const {
+  Estimate est;
+  for (const auto &dep : deps) {
+    est.cost += dep.cost;
+  }
+  double input = deps.empty() ? 1.0 : deps.front().rows;
+
+  // Apply the filter and the limit pushed down into the explore node
+  auto explored = [](const Explore *explore, double rows) {
+    if (explore->filter() != nullptr) {
+      rows *= kFilterSelectivity;
+    }
+    auto limit = constLimit(explore->limitExpr());
+    return limit.has_value() ? std::min(rows, *limit) : rows;
+  };
+
+  switch (node->kind()) {
+    case PlanNode::Kind::kStart: {
+      est.rows = 1.0;
+      break;
+    }
+    case PlanNode::Kind::kArgument: {
+      // Unknown if the estimate of the input variable isn't given
+      est.rows = deps.empty() ? kDefaultNumVertices : input;
+      break;
+    }
+    case PlanNode::Kind::kGetNeighbors: {
+      auto *gn = node->asNode<GetNeighbors>();
+      double neighbors = input * avgDegree(gn->edgeTypes(), gn->edgeDirection());
+      est.rows = explored(gn, neighbors);
+      est.cost += input * kRandomReadCost + neighbors * kScanRowCost;
+      break;
+    }
+    case PlanNode::Kind::kTraverse: {
+      auto *traverse = node->asNode<Traverse>();
+      double degree = avgDegree(traverse->edgeTypes(), traverse->edgeDirection());
+      if (traverse->eFilter() != nullptr) {
+        degree *= kFilterSelectivity;
+      }
+      size_t minSteps = 1, maxSteps = 1;
+      if (traverse->stepRange() != nullptr) {
+        minSteps = traverse->stepRange()->min();
+        maxSteps = std::min(traverse->stepRange()->max(), kMaxEstimatedSteps);
+      }
+      double frontier = input;
+      double paths = minSteps == 0 ? input : 0.0;
+      for (size_t step = 1; step <= maxSteps; ++step) {
+        double next = capped(frontier * degree);
+        est.cost += frontier * kRandomReadCost + next * kScanRowCost;
+        if (step >= minSteps) {
+          paths += next;
+        }
+        frontier = next;
+      }
+      est.rows = explored(traverse, paths);
+      break;
+    }
+    case PlanNode::Kind::kAppendVertices: {
+      auto *av = node->asNode<AppendVertices>();
+      est.rows = av->vFilter() != nullptr ? input * kFilterSelectivity : input;
+      est.rows = explored(av, est.rows);
+      est.cost += input * kRandomReadCost;
+      break;
+    }
+    case PlanNode::Kind::kGetVertices:
+    case PlanNode::Kind::kGetEdges: {
+      est.rows = explored(node->asNode<Explore>(), input);
+      est.cost += input * kRandomReadCost;
+      break;
+    }
+    case PlanNode::Kind::kIndexScan:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kTagIndexRangeScan:
+    case PlanNode::Kind::kEdgeIndexFullScan:
+    case PlanNode::Kind::kEdgeIndexPrefixScan:
+    case PlanNode::Kind::kEdgeIndexRangeScan: {
+      auto *scan = node->asNode<IndexScan>();
+      if (scan->isEmptyResultSet()) {
+        est.rows = 0.0;
+        break;
+      }
+      double total = scan->isEdge() ? numEdges(scan->schemaId()) : numVertices(scan->schemaId());
+      double scanned = total * indexSelectivity(scan);
+      est.rows = explored(scan, scanned);
+      // The scan stops once enough rows are returned
+      auto limit = constLimit(scan->limitExpr());
+      if (limit.has_value()) {
+        double selectivity = scan->filter() != nullptr ? kFilterSelectivity : 1.0;
+        scanned = std::min(scanned, *limit / selectivity);
+      }
+      est.cost += kRandomReadCost + scanned * kScanRowCost;
+      break;
+    }
+    case PlanNode::Kind::kScanVertices: {
+      auto *scan = node->asNode<ScanVertices>();
+      double total = numVertices();
+      if (scan->props() != nullptr && scan->props()->size() == 1) {
+        total = numVertices(scan->props()->front().get_tag());
+      }
+      est.rows = explored(scan, total);
+      est.cost += total * kScanRowCost;
+      break;
+    }
+    case PlanNode::Kind::kScanEdges: {
+      auto *scan = node->asNode<ScanEdges>();
+      double total = numEdges();
+      if (scan->props() != nullptr && scan->props()->size() == 1) {
+        total = numEdges(scan->props()->front().get_type());
+      }
+      est.rows = explored(scan, total);
+      est.cost += total * kScanRowCost;
+      break;
+    }
+    case PlanNode::Kind::kFilter: {
+      est.rows = input * kFilterSelectivity;
+      est.cost += input;
+      break;
+    }
+    case PlanNode::Kind::kSort: {
+      est.rows = input;
+      est.cost += input * std::log2(std::max(input, 2.0));
+      break;
+    }
+    case PlanNode::Kind::kTopN: {
+      auto *topN = node->asNode<graph::TopN>();
+      double k = static_cast<double>(topN->offset() + topN->count());
+      est.rows = std::min(input, static_cast<double>(topN->count()));
+      est.cost += input * std::log2(std::max(k, 2.0));
+      break;
+    }
+    case PlanNode::Kind::kLimit: {
+      auto count = constLimit(node->asNode<graph::Limit>()->countExpr());
+      est.rows = count.has_value() ? std::min(input, *count) : input;
+      est.cost += est.rows;
+      break;
+    }
+    case PlanNode::Kind::kSample: {
+      auto count = constLimit(node->asNode<graph::Sample>()->countExpr());
+      est.rows = count.has_value() ? std::min(input, *count) : input;
+      est.cost += input;
+      break;
+    }
+    case PlanNode::Kind::kAggregate: {
+      auto *agg = node->asNode<graph::Aggregate>();
+      est.rows = agg->groupKeys().empty() ? 1.0 : std::max(input * kGroupReduction, 1.0);
+      est.cost += input * kHashBuildCost;
+      break;
+    }
+    case PlanNode::Kind::kDedup:
+    case PlanNode::Kind::kInnerJoin:
+    case PlanNode::Kind::kLeftJoin: {
+      // The inputs of Join are read from variables other than the dependency
+      est.rows = input;
+      est.cost += input * kHashBuildCost;
+      break;
+    }
+    case PlanNode::Kind::kBiInnerJoin:
+    case PlanNode::Kind::kBiLeftJoin:
+    case PlanNode::Kind::kIntersect:
+    case PlanNode::Kind::kMinus: {
+      DCHECK_EQ(deps.size(), 2u);
+      double left = deps[0].rows, right = deps[1].rows;
+      // The hash table is built on the smaller side
+      est.cost += std::min(left, right) * kHashBuildCost + std::max(left, right);
+      if (node->kind() == PlanNode::Kind::kBiInnerJoin) {
+        est.rows = std::max(left, right);
+      } else {
+        est.rows = left;
+      }
+      break;
+    }
+    case PlanNode::Kind::kUnion: {
+      for (const auto &dep : deps) {
+        est.rows += dep.rows;
+      }
+      est.cost += est.rows;
+      break;
+    }
+    case PlanNode::Kind::kCartesianProduct:
+    case PlanNode::Kind::kBiCartesianProduct: {
+      est.rows = 1.0;
+      for (const auto &dep : deps) {
+        est.rows = capped(est.rows * dep.rows);
+      }
+      est.cost += est.rows;
+      break;
+    }
+    case PlanNode::Kind::kSelect:
+    case PlanNode::Kind::kLoop: {
+      // Either of the branches is executed, and the number of iterations is unknown
+      double body = 0.0;
+      for (const auto &b : bodies) {
+        body = std::max(body, b.cost);
+      }
+      est.rows = input;
+      est.cost += body;
+      break;
+    }
+    default: {
+      est.rows = input;
+      est.cost += input;
+      break;
+    }
+  }
+  est.rows = capped(est.rows);
+  est.cost = capped(est.cost);
+  return est;
+}
+
+}  // namespace opt
+}  // namespace nebula
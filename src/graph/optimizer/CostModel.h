@@ -0,0 +1,108 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_COSTMODEL_H_
+#define GRAPH_OPTIMIZER_COSTMODEL_H_
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftTypes.h"
+#include "interface/gen-cpp2/meta_types.h"
+#include "interface/gen-cpp2/storage_types.h"
+
+namespace nebula {
+
+class Expression;
+
+namespace graph {
+class PlanNode;
+class QueryContext;
+class IndexScan;
+}  // namespace graph
+
+namespace opt {
+
+// Estimated number of rows produced by a plan and the accumulated cost to produce them
+struct Estimate {
+  double rows{0.0};
+  double cost{0.0};
+};
+
+// CostModel estimates the cardinality and the cost of plan nodes with the statistics of the
+// space collected by the stats job, i.e. the number of vertices of each tag and edges of each edge
+// type, and the distinct counts and histograms of the indexed properties, and falls back to the
+// default ones if the statistics are not available.
+//
+// The cost is in the unit of processing a row in graphd, and the rows read from storaged are
+// weighted by the overhead of RPC, so it only makes sense when comparing the alternatives of the
+// same result.
+class CostModel final {
+ public:
+  explicit CostModel(graph::QueryContext* qctx);
+
+  // Estimate the plan rooted at `node' with the estimates of its dependencies, and the bodies of
+  // Select and Loop. The dependency of Argument is the estimate of its input variable instead.
+  Estimate estimate(const graph::PlanNode* node,
+                    const std::vector<Estimate>& deps,
+                    const std::vector<Estimate>& bodies) const;
+
+  // Number of vertices with the tag, or all vertices of the space if `tagId' is not given
+  double numVertices(folly::Optional<TagID> tagId = folly::none) const;
+
+  // Number of edges of the type, or all edges of the space if `edgeType' is not given
+  double numEdges(folly::Optional<EdgeType> edgeType = folly::none) const;
+
+  // Average number of the edges of the types from a vertex in the direction, all edge types if
+  // `edgeTypes' is empty
+  double avgDegree(const std::vector<EdgeType>& edgeTypes,
+                   storage::cpp2::EdgeDirection direction) const;
+
+  // Fraction of the rows of the schema read by the index scan
+  double indexSelectivity(const graph::IndexScan* scan) const;
+
+  // Fraction of the rows of the tag or edge type matched by the column hints of an index
+  double hintsSelectivity(bool isEdge,
+                          int32_t schemaId,
+                          const std::vector<storage::cpp2::IndexColumnHint>& hints) const;
+
+  // Statistics of the property of the tag or edge type, nullptr if it's not collected
+  const meta::cpp2::PropStats* propStats(bool isEdge,
+                                         int32_t schemaId,
+                                         const std::string& prop) const;
+
+  // Selectivity of the prefix and the range column hints by the statistics of the property, the
+  // default ones are used if `stats' is nullptr
+  static double equalSelectivity(const meta::cpp2::PropStats* stats);
+  static double rangeSelectivity(const meta::cpp2::PropStats* stats,
+                                 const storage::cpp2::IndexColumnHint& hint);
+
+  // Default selectivity of the predicates which are not estimated by the statistics
+  static constexpr double kEqualSelectivity = 0.01;
+  static constexpr double kRangeSelectivity = 1.0 / 3;
+  static constexpr double kFilterSelectivity = 0.5;
+
+  // Cost of a row read from storaged sequentially, e.g. by a scan
+  static constexpr double kScanRowCost = 2.0;
+  // Cost of a random read of storaged, e.g. fetching the properties or neighbors of a vertex
+  static constexpr double kRandomReadCost = 10.0;
+  // Cost of inserting a row into the hash table
+  static constexpr double kHashBuildCost = 2.0;
+
+  // Used when the statistics of the space are not available
+  static constexpr double kDefaultNumVertices = 100000.0;
+  static constexpr double kDefaultDegree = 10.0;
+
+ private:
+  // Constant limit of the node, or none if it's unknown until running
+  static folly::Optional<double> constLimit(const Expression* limit);
+
+  graph::QueryContext* qctx_{nullptr};
+  GraphSpaceID space_{-1};
+  std::shared_ptr<const meta::cpp2::StatsItem> stats_;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_COSTMODEL_H_
@@ -7,8 +7,11 @@
 
 #include "common/base/Logging.h"
 #include "common/base/ObjectPool.h"
+#include "graph/context/QueryContext.h"
+#include "graph/optimizer/CostModel.h"
 #include "graph/optimizer/OptGroup.h"
 #include "graph/planner/Planner.h"
+#include "graph/planner/plan/PlanNode.h"
 
 namespace nebula {
 namespace opt {
@@ -16,6 +19,15 @@ namespace opt {
 OptContext::OptContext(graph::QueryContext *qctx)
     : qctx_(DCHECK_NOTNULL(qctx)), objPool_(std::make_unique<ObjectPool>()) {}
 
+OptContext::~OptContext() = default;
+
+const CostModel *OptContext::costModel() const {
+  if (costModel_ == nullptr) {
+    costModel_ = std::make_unique<CostModel>(qctx_);
+  }
+  return costModel_.get();
+}
+
 void OptContext::addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode) {
   auto pair = planNodeToOptGroupNodeMap_.emplace(planNodeId, optGroupNode);
   if (UNLIKELY(!pair.second)) {
@@ -29,5 +41,19 @@ const OptGroupNode *OptContext::findOptGroupNodeByPlanNodeId(int64_t planNodeId)
   return found == planNodeToOptGroupNodeMap_.end() ? nullptr : found->second;
 }
 
+const OptGroup *OptContext::findOptGroupByOutputVar(const std::string &var) const {
+  auto *variable = qctx_->symTable()->getVar(var);
+  if (variable == nullptr) {
+    return nullptr;
+  }
+  for (auto *node : variable->writtenBy) {
+    auto *groupNode = findOptGroupNodeByPlanNodeId(node->id());
+    if (groupNode != nullptr) {
+      return groupNode->group();
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace opt
 }  // namespace nebula
@@ -8,6 +8,7 @@
 
 #include <boost/core/noncopyable.hpp>
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 #include "common/cpp/helpers.h"
@@ -22,11 +23,14 @@ class QueryContext;
 
 namespace opt {
 
+class CostModel;
+class OptGroup;
 class OptGroupNode;
 
 class OptContext final : private boost::noncopyable, private cpp::NonMovable {
  public:
   explicit OptContext(graph::QueryContext *qctx);
+  ~OptContext();
 
   graph::QueryContext *qctx() const {
     return qctx_;
@@ -44,8 +48,13 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
     changed_ = changed;
   }
 
+  // Created on the first use, since it's only needed when choosing the best plan
+  const CostModel *costModel() const;
+
   void addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode);
   const OptGroupNode *findOptGroupNodeByPlanNodeId(int64_t planNodeId) const;
+  // Group of the node writing the variable, nullptr if it's not in the memo
+  const OptGroup *findOptGroupByOutputVar(const std::string &var) const;
 
  private:
   // A global flag to record whether this iteration caused a change to the plan
@@ -54,6 +63,7 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
   // Memo memory management in the Optimizer phase
   std::unique_ptr<ObjectPool> objPool_;
   std::unordered_map<int64_t, const OptGroupNode *> planNodeToOptGroupNodeMap_;
+  mutable std::unique_ptr<CostModel> costModel_;
 };
 
 }  // namespace opt
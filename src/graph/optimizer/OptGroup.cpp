@@ -154,6 +154,12 @@ double OptGroup::getCost() const {
   return findMinCostGroupNode().first;
 }
 
+Estimate OptGroup::estimate() const {
+  const OptGroupNode *minGroupNode = findMinCostGroupNode().second;
+  DCHECK(minGroupNode != nullptr);
+  return minGroupNode->estimate();
+}
+
 const PlanNode *OptGroup::getPlan() const {
   const OptGroupNode *minGroupNode = findMinCostGroupNode().second;
   DCHECK(minGroupNode != nullptr);
@@ -204,10 +210,36 @@ Status OptGroupNode::explore(const OptRule *rule) {
 }
 
 double OptGroupNode::getCost() const {
-  return node_->cost();
+  return estimate().cost;
+}
+
+Estimate OptGroupNode::estimate() const {
+  if (!estimated_) {
+    std::vector<Estimate> deps, bodies;
+    if (node_->kind() == PlanNode::Kind::kArgument) {
+      // Argument yields the rows of its input variable instead of its dependency, whose cost is
+      // accumulated by the writer of the variable
+      const auto *input = group_->ctx()->findOptGroupByOutputVar(node_->inputVar());
+      if (input != nullptr) {
+        deps.emplace_back(Estimate{input->estimate().rows, 0.0});
+      }
+    } else {
+      deps.reserve(dependencies_.size());
+      for (auto *dep : dependencies_) {
+        deps.emplace_back(dep->estimate());
+      }
+    }
+    for (auto *body : bodies_) {
+      bodies.emplace_back(body->estimate());
+    }
+    estimate_ = group_->ctx()->costModel()->estimate(node_, deps, bodies);
+    estimated_ = true;
+  }
+  return estimate_;
 }
 
 const PlanNode *OptGroupNode::getPlan() const {
+  node_->setCost(getCost());
   if (node_->kind() == PlanNode::Kind::kSelect) {
     DCHECK_EQ(bodies_.size(), 2U);
     auto select = static_cast<Select *>(node_);
@@ -8,6 +8,7 @@
 
 #include "common/base/ObjectPool.h"
 #include "common/base/Status.h"
+#include "graph/optimizer/CostModel.h"
 
 namespace nebula {
 namespace graph {
@@ -43,11 +44,17 @@ class OptGroup final {
   Status explore(const OptRule *rule);
   Status exploreUntilMaxRound(const OptRule *rule);
   double getCost() const;
+  // Estimate of the cheapest group node
+  Estimate estimate() const;
   const graph::PlanNode *getPlan() const;
   const std::string &outputVar() const {
     return outputVar_;
   }
 
+  OptContext *ctx() const {
+    return ctx_;
+  }
+
  private:
   friend ObjectPool;
   explicit OptGroup(OptContext *ctx) noexcept;
@@ -106,7 +113,10 @@ class OptGroupNode final {
   }
 
   Status explore(const OptRule *rule);
+  // Accumulated cost of the plan rooted at the group node, which is estimated once the
+  // exploration is done
   double getCost() const;
+  Estimate estimate() const;
   const graph::PlanNode *getPlan() const;
 
  private:
@@ -118,6 +128,8 @@ class OptGroupNode final {
   std::vector<OptGroup *> dependencies_;
   std::vector<OptGroup *> bodies_;
   std::vector<const OptRule *> exploredRules_;
+  mutable bool estimated_{false};
+  mutable Estimate estimate_;
 };
 
 }  // namespace opt
@@ -42,6 +42,7 @@ StatusOr<const PlanNode *> Optimizer::findBestPlan(QueryContext *qctx) {
 
   NG_RETURN_IF_ERROR(doExploration(optCtx.get(), rootGroup));
   auto *newRoot = rootGroup->getPlan();
+  releaseUnchosen(rootGroup, newRoot);
 
   auto status2 = postprocess(const_cast<PlanNode *>(newRoot), qctx, spaceID);
   if (!status2.ok()) {
@@ -86,6 +87,48 @@ Status Optimizer::doExploration(OptContext *octx, OptGroup *rootGroup) {
   return Status::OK();
 }
 
+// static
+void Optimizer::releaseUnchosen(const OptGroup *rootGroup, const PlanNode *root) {
+  std::unordered_set<const PlanNode *> chosen;
+  std::vector<const PlanNode *> nodes = {root};
+  while (!nodes.empty()) {
+    const auto *node = nodes.back();
+    nodes.pop_back();
+    if (!chosen.emplace(node).second) {
+      continue;
+    }
+    for (const auto *dep : node->dependencies()) {
+      nodes.emplace_back(dep);
+    }
+    if (node->kind() == PlanNode::Kind::kSelect) {
+      auto select = static_cast<const Select *>(node);
+      nodes.emplace_back(select->then());
+      nodes.emplace_back(select->otherwise());
+    } else if (node->kind() == PlanNode::Kind::kLoop) {
+      nodes.emplace_back(static_cast<const Loop *>(node)->body());
+    }
+  }
+
+  std::unordered_set<const OptGroup *> visited;
+  std::vector<const OptGroup *> groups = {rootGroup};
+  while (!groups.empty()) {
+    const auto *group = groups.back();
+    groups.pop_back();
+    if (!visited.emplace(group).second) {
+      continue;
+    }
+    for (const auto *groupNode : group->groupNodes()) {
+      if (chosen.find(groupNode->node()) == chosen.end()) {
+        groupNode->node()->releaseSymbols();
+      }
+      const auto &deps = groupNode->dependencies();
+      groups.insert(groups.end(), deps.begin(), deps.end());
+      const auto &bodies = groupNode->bodies();
+      groups.insert(groups.end(), bodies.begin(), bodies.end());
+    }
+  }
+}
+
 // Create Memo structure
 OptGroup *Optimizer::convertToGroup(OptContext *ctx,
                                     PlanNode *node,
@@ -39,6 +39,10 @@ class Optimizer final {
 
   Status doExploration(OptContext *octx, OptGroup *rootGroup);
 
+  // Release the symbols of the alternatives which are not chosen, so that the variables are only
+  // read and written by the nodes of the plan
+  static void releaseUnchosen(const OptGroup *rootGroup, const graph::PlanNode *root);
+
   OptGroup *convertToGroup(OptContext *ctx,
                            graph::PlanNode *node,
                            std::unordered_map<int64_t, OptGroup *> *visited);
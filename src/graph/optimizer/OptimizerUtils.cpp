@@ -7,6 +7,7 @@
 
 #include "common/base/Status.h"
 #include "common/datatypes/Value.h"
+#include "graph/optimizer/CostModel.h"
 #include "graph/planner/plan/Query.h"
 
 using nebula::meta::cpp2::ColumnDef;
@@ -331,7 +332,8 @@ void OptimizerUtils::eraseInvalidIndexItems(
 bool OptimizerUtils::findOptimalIndex(const Expression* condition,
                                       const std::vector<std::shared_ptr<IndexItem>>& indexItems,
                                       bool* isPrefixScan,
-                                      IndexQueryContext* ictx) {
+                                      IndexQueryContext* ictx,
+                                      const opt::CostModel* costModel) {
   // Return directly if there is no valid index to use.
   if (indexItems.empty()) {
     return false;
@@ -351,42 +353,74 @@ bool OptimizerUtils::findOptimalIndex(const Expression* condition,
 
   std::sort(results.begin(), results.end());
 
-  auto& index = results.back();
-  if (index.hints.empty()) {
-    return false;
-  }
-
-  *isPrefixScan = false;
-  std::vector<storage::cpp2::IndexColumnHint> hints;
-  hints.reserve(index.hints.size());
-  auto iter = index.hints.begin();
+  // The column hints used by the index scan, and whether the condition is still needed as the
+  // filter
+  struct Candidate {
+    IndexResult* index;
+    std::vector<storage::cpp2::IndexColumnHint> hints;
+    bool isPrefixScan{false};
+    bool needFilter{false};
+  };
+  auto toCandidate = [](IndexResult& index) {
+    Candidate candidate{&index, {}, false, false};
+    candidate.hints.reserve(index.hints.size());
+    auto iter = index.hints.begin();
+    for (; iter != index.hints.end(); ++iter) {
+      auto& hint = *iter;
+      if (hint.score == IndexScore::kPrefix) {
+        candidate.hints.emplace_back(hint.hint);
+        candidate.isPrefixScan = true;
+        continue;
+      }
+      if (hint.score == IndexScore::kRange) {
+        candidate.hints.emplace_back(hint.hint);
+        // skip the case first range hint is the last hint
+        // when set filter in index query context
+        ++iter;
+      }
+      break;
+    }
+    // The filter can always be pushed down for lookup query
+    candidate.needFilter = iter != index.hints.end() || !index.unusedExprs.empty();
+    return candidate;
+  };
 
   // Use full scan if the highest index score is NotEqual
-  if (iter->score == IndexScore::kNotEqual) {
+  auto& best = results.back();
+  if (best.hints.empty() || best.hints.front().score == IndexScore::kNotEqual) {
     return false;
   }
-
-  for (; iter != index.hints.end(); ++iter) {
-    auto& hint = *iter;
-    if (hint.score == IndexScore::kPrefix) {
-      hints.emplace_back(std::move(hint.hint));
-      *isPrefixScan = true;
-      continue;
-    }
-    if (hint.score == IndexScore::kRange) {
-      hints.emplace_back(std::move(hint.hint));
-      // skip the case first range hint is the last hint
-      // when set filter in index query context
-      ++iter;
+  auto chosen = toCandidate(best);
+
+  // Choose the one which reads the fewest rows by the statistics of the properties, and prefer
+  // the higher score if the selectivities are the same
+  if (costModel != nullptr) {
+    auto selectivity = [costModel](const Candidate& candidate) {
+      const auto& schema = candidate.index->index->get_schema_id();
+      bool isEdge = schema.edge_type_ref().has_value();
+      return costModel->hintsSelectivity(
+          isEdge, isEdge ? schema.get_edge_type() : schema.get_tag_id(), candidate.hints);
+    };
+    double minSelectivity = selectivity(chosen);
+    for (auto iter = std::next(results.rbegin()); iter != results.rend(); ++iter) {
+      if (iter->hints.empty() || iter->hints.front().score == IndexScore::kNotEqual) {
+        continue;
+      }
+      auto candidate = toCandidate(*iter);
+      auto s = selectivity(candidate);
+      if (s < minSelectivity) {
+        minSelectivity = s;
+        chosen = std::move(candidate);
+      }
     }
-    break;
   }
-  // The filter can always be pushed down for lookup query
-  if (iter != index.hints.end() || !index.unusedExprs.empty()) {
+
+  *isPrefixScan = chosen.isPrefixScan;
+  if (chosen.needFilter) {
     ictx->filter_ref() = condition->encode();
   }
-  ictx->index_id_ref() = index.index->get_index_id();
-  ictx->column_hints_ref() = std::move(hints);
+  ictx->index_id_ref() = chosen.index->index->get_index_id();
+  ictx->column_hints_ref() = std::move(chosen.hints);
   return true;
 }
 
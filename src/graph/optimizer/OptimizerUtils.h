@@ -24,6 +24,10 @@ class IndexQueryContext;
 }  // namespace cpp2
 }  // namespace storage
 
+namespace opt {
+class CostModel;
+}  // namespace opt
+
 namespace graph {
 
 class IndexScan;
@@ -53,7 +57,8 @@ class OptimizerUtils {
   //     * process collected column hints, for example, merge the begin and end values of
   //       range scan
   //   3. sort all index results generated by each index
-  //   4. select the largest score index result
+  //   4. select the largest score index result, or the one with the lowest selectivity estimated
+  //      by `costModel' if it's given, which takes the statistics of the properties into account
   //   5. process the selected index result:
   //     * find the first not prefix column hint and ignore all followed hints except first
   //       range hint
@@ -67,7 +72,8 @@ class OptimizerUtils {
       const Expression* condition,
       const std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>>& indexItems,
       bool* isPrefixScan,
-      nebula::storage::cpp2::IndexQueryContext* ictx);
+      nebula::storage::cpp2::IndexQueryContext* ictx,
+      const opt::CostModel* costModel = nullptr);
 
   static bool relExprHasIndex(
       const Expression* expr,
@@ -129,7 +129,8 @@ StatusOr<TransformResult> OptimizeEdgeIndexScanByFilterRule::transform(
 
   IndexQueryContext ictx;
   bool isPrefixScan = false;
-  if (!OptimizerUtils::findOptimalIndex(transformedExpr, indexItems, &isPrefixScan, &ictx)) {
+  if (!OptimizerUtils::findOptimalIndex(
+          transformedExpr, indexItems, &isPrefixScan, &ictx, ctx->costModel())) {
     return TransformResult::noTransform();
   }
 
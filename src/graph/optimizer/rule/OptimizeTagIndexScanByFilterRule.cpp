@@ -145,7 +145,8 @@ StatusOr<TransformResult> OptimizeTagIndexScanByFilterRule::transform(
 
   IndexQueryContext ictx;
   bool isPrefixScan = false;
-  if (!OptimizerUtils::findOptimalIndex(transformedExpr, indexItems, &isPrefixScan, &ictx)) {
+  if (!OptimizerUtils::findOptimalIndex(
+          transformedExpr, indexItems, &isPrefixScan, &ictx, ctx->costModel())) {
     return TransformResult::noTransform();
   }
 
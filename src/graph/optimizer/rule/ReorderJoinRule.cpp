@@ -0,0 +1,356 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/ReorderJoinRule.h"
+
+#include "common/expression/ColumnExpression.h"
+#include "graph/optimizer/CostModel.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/Algo.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::BiCartesianProduct;
+using nebula::graph::BiInnerJoin;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+bool isJoin(const PlanNode *node) {
+  return node->kind() == PlanNode::Kind::kBiInnerJoin ||
+         node->kind() == PlanNode::Kind::kBiCartesianProduct;
+}
+
+// The join under the Project restoring the column order of the reordered tree, or the node itself
+const OptGroupNode *skipProject(const OptGroupNode *groupNode) {
+  if (groupNode->node()->kind() != PlanNode::Kind::kProject) {
+    return groupNode;
+  }
+  const auto &deps = groupNode->dependencies();
+  if (deps.size() != 1 || deps.front()->groupNodes().size() != 1) {
+    return groupNode;
+  }
+  return deps.front()->groupNodes().front();
+}
+
+// All group nodes of a group have the same columns
+const std::vector<std::string> &colNamesOf(const OptGroup *group) {
+  return group->groupNodes().front()->node()->colNames();
+}
+
+std::unordered_set<std::string> sharedColNames(const std::unordered_set<std::string> &left,
+                                               const std::vector<std::string> &right) {
+  std::unordered_set<std::string> shared;
+  for (auto &col : right) {
+    if (left.find(col) != left.end()) {
+      shared.emplace(col);
+    }
+  }
+  return shared;
+}
+
+// Get the alias of the join key in the form of id($-.alias)
+bool keyAlias(const Expression *key, std::string *alias) {
+  if (key->kind() != Expression::Kind::kFunctionCall) {
+    return false;
+  }
+  auto *func = static_cast<const FunctionCallExpression *>(key);
+  if (func->name() != "id" || func->args()->numArgs() != 1) {
+    return false;
+  }
+  auto *arg = func->args()->args().front();
+  if (arg->kind() != Expression::Kind::kInputProperty) {
+    return false;
+  }
+  *alias = static_cast<const InputPropertyExpression *>(arg)->prop();
+  return true;
+}
+
+// Estimate the group by its first group node, don't use the memoized estimates of the group
+// nodes since the groups are still being explored
+Estimate estimateGroup(OptContext *ctx,
+                       const OptGroup *group,
+                       std::unordered_map<const OptGroup *, Estimate> &estimates) {
+  auto iter = estimates.find(group);
+  if (iter != estimates.end()) {
+    return iter->second;
+  }
+  const auto *groupNode = group->groupNodes().front();
+  std::vector<Estimate> deps, bodies;
+  if (groupNode->node()->kind() == PlanNode::Kind::kArgument) {
+    // Same as OptGroupNode::estimate()
+    const auto *input = ctx->findOptGroupByOutputVar(groupNode->node()->inputVar());
+    if (input != nullptr) {
+      deps.emplace_back(Estimate{estimateGroup(ctx, input, estimates).rows, 0.0});
+    }
+  } else {
+    for (auto *dep : groupNode->dependencies()) {
+      deps.emplace_back(estimateGroup(ctx, dep, estimates));
+    }
+  }
+  for (auto *body : groupNode->bodies()) {
+    bodies.emplace_back(estimateGroup(ctx, body, estimates));
+  }
+  auto est = ctx->costModel()->estimate(groupNode->node(), deps, bodies);
+  estimates.emplace(group, est);
+  return est;
+}
+
+}  // namespace
+
+std::unique_ptr<OptRule> ReorderJoinRule::kInstance =
+    std::unique_ptr<ReorderJoinRule>(new ReorderJoinRule());
+
+ReorderJoinRule::ReorderJoinRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &ReorderJoinRule::pattern() const {
+  static Pattern pattern =
+      Pattern::create({PlanNode::Kind::kBiInnerJoin, PlanNode::Kind::kBiCartesianProduct});
+  return pattern;
+}
+
+bool ReorderJoinRule::match(OptContext *ctx, const MatchedResult &matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  JoinTree tree;
+  if (!flatten(ctx, matched.node, &tree) || tree.inputs.size() < 3 ||
+      inGreedyOrder(ctx, tree)) {
+    return false;
+  }
+  // The reordered tree is kept along with the current one, so don't reorder again once it's there
+  for (const auto *groupNode : matched.node->group()->groupNodes()) {
+    groupNode = skipProject(groupNode);
+    if (groupNode == matched.node || !isJoin(groupNode->node())) {
+      continue;
+    }
+    JoinTree other;
+    if (flatten(ctx, groupNode, &other) && other.inputs.size() >= 3 &&
+        inGreedyOrder(ctx, other)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+StatusOr<OptRule::TransformResult> ReorderJoinRule::transform(OptContext *ctx,
+                                                              const MatchedResult &matched) const {
+  auto *qctx = ctx->qctx();
+  auto *pool = qctx->objPool();
+  const auto *rootGroupNode = matched.node;
+  JoinTree tree;
+  if (!flatten(ctx, rootGroupNode, &tree)) {
+    return TransformResult::noTransform();
+  }
+  auto order = joinOrder(ctx, tree.inputs);
+
+  // All group nodes of a group must have the same columns, so the columns of the reordered tree
+  // are projected to the ones of the current tree if they're not in the same order. The current
+  // tree yields the columns of its inputs one by one.
+  std::vector<size_t> reorderedStart(order.size(), 0);
+  size_t numCols = 0;
+  for (auto i : order) {
+    reorderedStart[i] = numCols;
+    numCols += colNamesOf(tree.inputs[i]).size();
+  }
+  auto *columns = pool->makeAndAdd<YieldColumns>();
+  bool reordered = false;
+  for (size_t i = 0, col = 0; i < tree.inputs.size(); ++i) {
+    const auto &colNames = colNamesOf(tree.inputs[i]);
+    for (size_t j = 0; j < colNames.size(); ++j, ++col) {
+      auto index = reorderedStart[i] + j;
+      reordered = reordered || index != col;
+      columns->addColumn(new YieldColumn(ColumnExpression::make(pool, index), colNames[j]));
+    }
+  }
+  DCHECK_EQ(numCols, rootGroupNode->node()->colNames().size());
+
+  OptGroup *leftGroup = tree.inputs[order.front()];
+  PlanNode *left = leftGroup->groupNodes().front()->node();
+  std::unordered_set<std::string> leftColNames(colNamesOf(leftGroup).begin(),
+                                               colNamesOf(leftGroup).end());
+  OptGroupNode *newRootGroupNode = nullptr;
+  for (size_t i = 1; i < order.size(); ++i) {
+    auto *rightGroup = tree.inputs[order[i]];
+    auto *right = rightGroup->groupNodes().front()->node();
+    const auto &rightColNames = colNamesOf(rightGroup);
+
+    PlanNode *join = nullptr;
+    auto shared = sharedColNames(leftColNames, rightColNames);
+    if (shared.empty()) {
+      join = BiCartesianProduct::make(qctx, left, right);
+    } else {
+      std::vector<std::string> aliases(shared.begin(), shared.end());
+      std::sort(aliases.begin(), aliases.end());
+      std::vector<Expression *> hashKeys;
+      std::vector<Expression *> probeKeys;
+      for (auto &alias : aliases) {
+        auto *args = ArgumentList::make(pool);
+        args->addArgument(InputPropertyExpression::make(pool, alias));
+        auto *expr = FunctionCallExpression::make(pool, "id", args);
+        hashKeys.emplace_back(expr);
+        probeKeys.emplace_back(expr->clone());
+      }
+      join = BiInnerJoin::make(qctx, left, right, std::move(hashKeys), std::move(probeKeys));
+    }
+
+    OptGroupNode *joinGroupNode = nullptr;
+    std::vector<OptGroup *> deps = {leftGroup, rightGroup};
+    if (i + 1 == order.size() && !reordered) {
+      // The root writes the result of the replaced one
+      auto colNames = join->colNames();
+      join->setOutputVar(rootGroupNode->node()->outputVar());
+      join->setColNames(std::move(colNames));
+      joinGroupNode = OptGroupNode::create(ctx, join, rootGroupNode->group());
+      newRootGroupNode = joinGroupNode;
+    } else {
+      auto *joinGroup = OptGroup::create(ctx);
+      joinGroupNode = joinGroup->makeGroupNode(join);
+      leftGroup = joinGroup;
+    }
+    joinGroupNode->setDeps(deps);
+    left = join;
+    leftColNames.insert(rightColNames.begin(), rightColNames.end());
+  }
+
+  if (reordered) {
+    // The Project writes the result of the replaced one
+    auto *project = Project::make(qctx, left, columns);
+    auto colNames = project->colNames();
+    project->setOutputVar(rootGroupNode->node()->outputVar());
+    project->setColNames(std::move(colNames));
+    newRootGroupNode = OptGroupNode::create(ctx, project, rootGroupNode->group());
+    newRootGroupNode->setDeps({leftGroup});
+  }
+
+  // Keep the current tree as an alternative, the cheaper one is chosen by the cost model
+  TransformResult result;
+  result.newGroupNodes.emplace_back(newRootGroupNode);
+  return result;
+}
+
+std::string ReorderJoinRule::toString() const {
+  return "ReorderJoinRule";
+}
+
+// static
+bool ReorderJoinRule::flatten(OptContext *ctx, const OptGroupNode *groupNode, JoinTree *tree) {
+  const auto *node = groupNode->node();
+  const auto &deps = groupNode->dependencies();
+  DCHECK_EQ(deps.size(), 2U);
+  const auto &leftColNames = colNamesOf(deps[0]);
+  auto shared = sharedColNames({leftColNames.begin(), leftColNames.end()}, colNamesOf(deps[1]));
+  if (node->kind() == PlanNode::Kind::kBiInnerJoin) {
+    // Joined on the ids of exactly the shared aliases
+    auto *join = static_cast<const BiInnerJoin *>(node);
+    const auto &hashKeys = join->hashKeys();
+    const auto &probeKeys = join->probeKeys();
+    if (hashKeys.size() != probeKeys.size() || hashKeys.size() != shared.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < hashKeys.size(); ++i) {
+      std::string hashAlias, probeAlias;
+      if (!keyAlias(hashKeys[i], &hashAlias) || !keyAlias(probeKeys[i], &probeAlias) ||
+          hashAlias != probeAlias || shared.erase(hashAlias) == 0) {
+        return false;
+      }
+    }
+  } else if (!shared.empty()) {
+    return false;
+  }
+
+  auto *symTable = ctx->qctx()->symTable();
+  for (size_t i = 0; i < deps.size(); ++i) {
+    auto *dep = deps[i];
+    const auto &groupNodes = dep->groupNodes();
+    if (groupNodes.size() == 1 && isJoin(groupNodes.front()->node()) &&
+        symTable->getVar(dep->outputVar())->readBy.size() == 1) {
+      if (i != 0) {
+        tree->leftDeep = false;
+      }
+      if (!flatten(ctx, groupNodes.front(), tree)) {
+        return false;
+      }
+    } else {
+      tree->inputs.emplace_back(dep);
+    }
+  }
+  return true;
+}
+
+// static
+bool ReorderJoinRule::inGreedyOrder(OptContext *ctx, const JoinTree &tree) {
+  if (!tree.leftDeep) {
+    return false;
+  }
+  // Same as the current one if the first two are the same and the others are joined in order
+  auto order = joinOrder(ctx, tree.inputs);
+  if (std::min(order[0], order[1]) != 0 || std::max(order[0], order[1]) != 1) {
+    return false;
+  }
+  for (size_t i = 2; i < order.size(); ++i) {
+    if (order[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+std::vector<size_t> ReorderJoinRule::joinOrder(OptContext *ctx,
+                                               const std::vector<OptGroup *> &inputs) {
+  std::unordered_map<const OptGroup *, Estimate> estimates;
+  std::vector<double> rows;
+  rows.reserve(inputs.size());
+  for (auto *input : inputs) {
+    rows.emplace_back(estimateGroup(ctx, input, estimates).rows);
+  }
+
+  // Start from the smallest one
+  std::vector<size_t> order;
+  std::vector<bool> joined(inputs.size(), false);
+  size_t first = std::min_element(rows.begin(), rows.end()) - rows.begin();
+  order.emplace_back(first);
+  joined[first] = true;
+  std::unordered_set<std::string> colNames(colNamesOf(inputs[first]).begin(),
+                                           colNamesOf(inputs[first]).end());
+  double joinedRows = rows[first];
+
+  while (order.size() < inputs.size()) {
+    // Prefer the one sharing some alias, then the fewer rows yielded, the earlier one at last
+    size_t next = inputs.size();
+    bool nextConnected = false;
+    double nextRows = 0.0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (joined[i]) {
+        continue;
+      }
+      bool connected = !sharedColNames(colNames, colNamesOf(inputs[i])).empty();
+      // The shared alias is mostly the key of the rows of either side
+      double rowsYielded = connected ? std::max(joinedRows, rows[i]) : joinedRows * rows[i];
+      if (next == inputs.size() || (connected && !nextConnected) ||
+          (connected == nextConnected && rowsYielded < nextRows)) {
+        next = i;
+        nextConnected = connected;
+        nextRows = rowsYielded;
+      }
+    }
+    order.emplace_back(next);
+    joined[next] = true;
+    colNames.insert(colNamesOf(inputs[next]).begin(), colNamesOf(inputs[next]).end());
+    joinedRows = nextRows;
+  }
+  return order;
+}
+
+}  // namespace opt
+}  // namespace nebula
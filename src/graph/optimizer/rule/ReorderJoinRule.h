@@ -0,0 +1,95 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_REORDERJOINRULE_H_
+#define GRAPH_OPTIMIZER_RULE_REORDERJOINRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Reorder the joins of the pattern parts of MATCH by the estimated cardinality of the parts
+//  Required conditions:
+//   1. Match the pattern, i.e. a tree of at least three parts connected by [[BiInnerJoin]] on the
+//      ids of all the aliases shared by both sides, or [[BiCartesianProduct]] if none is shared
+//   2. The intermediate results of the tree are only read by the joins of the tree
+//   3. The greedy order differs from the current one, and the group doesn't hold the reordered
+//      tree yet
+//  Benefits:
+//   1. Join the small parts first and avoid the cartesian product if they could be joined on a
+//      shared alias, which keeps the intermediate results small
+//
+//  Transformation:
+//  The parts are joined left-deep, started from the smallest one, and followed by the one which
+//  shares some alias with the joined ones and yields the fewest rows. The cartesian product is
+//  only used when there is no such one. The reordered tree is added to the group along with the
+//  current one, and the cheaper one is chosen by the cost model.
+//  Before:
+//
+//                 +--------+--------+
+//                 |   BiInnerJoin   |
+//                 |  (id($-.b))     |
+//                 +--------+--------+
+//                     /          \
+//  +-----------------+---+   +----+----+
+//  | BiCartesianProduct  |   | (b)-(c) |
+//  +-----+-----------+---+   +---------+
+//       /             \
+//  +---+---+       +---+---+
+//  |  (a)  |       |  (b)  |
+//  +-------+       +-------+
+//
+//  After:
+//
+//                 +--------+--------+
+//                 |BiCartesianProduct|
+//                 +--------+--------+
+//                     /          \
+//       +------------+----+   +---+---+
+//       |   BiInnerJoin   |   |  (a)  |
+//       |   (id($-.b))    |   +-------+
+//       +------+-----+----+
+//             /       \
+//       +---+---+  +----+----+
+//       |  (b)  |  | (b)-(c) |
+//       +-------+  +---------+
+
+class ReorderJoinRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  ReorderJoinRule();
+
+  // The parts joined by the tree of joins
+  struct JoinTree {
+    std::vector<OptGroup *> inputs;
+    // Whether the parts are joined one by one from the first one
+    bool leftDeep{true};
+  };
+
+  // Flatten the tree of joins rooted at the group node, return false if it's not reorderable
+  static bool flatten(OptContext *ctx, const OptGroupNode *groupNode, JoinTree *tree);
+
+  // Whether the inputs of the tree are joined left-deep in the greedy order
+  static bool inGreedyOrder(OptContext *ctx, const JoinTree &tree);
+
+  // Order of the inputs to join greedily by their estimated rows
+  static std::vector<size_t> joinOrder(OptContext *ctx, const std::vector<OptGroup *> &inputs);
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_REORDERJOINRULE_H_
@@ -170,7 +170,8 @@ StatusOr<TransformResult> UnionAllIndexScanBaseRule::transform(OptContext* ctx,
   for (auto operand : logicalExpr->operands()) {
     IndexQueryContext ictx;
     bool isPrefixScan = false;
-    if (!OptimizerUtils::findOptimalIndex(operand, indexItems, &isPrefixScan, &ictx)) {
+    if (!OptimizerUtils::findOptimalIndex(
+            operand, indexItems, &isPrefixScan, &ictx, ctx->costModel())) {
       return TransformResult::noTransform();
     }
     idxCtxs.emplace_back(std::move(ictx));
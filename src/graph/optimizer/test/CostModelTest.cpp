@@ -0,0 +1,159 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/context/QueryContext.h"
+#include "graph/optimizer/CostModel.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::Argument;
+using nebula::graph::BiInnerJoin;
+using nebula::graph::GetNeighbors;
+using nebula::graph::IndexScan;
+using nebula::graph::QueryContext;
+using nebula::graph::StartNode;
+
+namespace nebula {
+namespace opt {
+
+class CostModelTest : public ::testing::Test {
+ protected:
+  // No statistics of the space without a session, so the default ones are used
+  QueryContext qctx_;
+  CostModel model_{&qctx_};
+};
+
+TEST_F(CostModelTest, GetNeighbors) {
+  auto* start = StartNode::make(&qctx_);
+  auto* gn = GetNeighbors::make(&qctx_, start, 1);
+  gn->setEdgeTypes({1, -2});
+
+  auto est = model_.estimate(gn, {Estimate{100.0, 50.0}}, {});
+  double neighbors = 100.0 * 2 * CostModel::kDefaultDegree;
+  EXPECT_DOUBLE_EQ(neighbors, est.rows);
+  EXPECT_DOUBLE_EQ(
+      50.0 + 100.0 * CostModel::kRandomReadCost + neighbors * CostModel::kScanRowCost, est.cost);
+
+  gn->setLimit(10);
+  est = model_.estimate(gn, {Estimate{100.0, 50.0}}, {});
+  EXPECT_DOUBLE_EQ(10.0, est.rows);
+}
+
+TEST_F(CostModelTest, IndexSelectivity) {
+  auto hint = [](storage::cpp2::ScanType type) {
+    storage::cpp2::IndexColumnHint h;
+    h.scan_type_ref() = type;
+    return h;
+  };
+  auto context = [](std::vector<storage::cpp2::IndexColumnHint> hints) {
+    IndexScan::IndexQueryContext ictx;
+    ictx.column_hints_ref() = std::move(hints);
+    return ictx;
+  };
+  {
+    auto* scan = IndexScan::make(&qctx_, nullptr, 1);
+    EXPECT_DOUBLE_EQ(1.0, model_.indexSelectivity(scan));
+  }
+  {
+    auto* scan = IndexScan::make(&qctx_, nullptr, 1, {context({})});
+    EXPECT_DOUBLE_EQ(1.0, model_.indexSelectivity(scan));
+  }
+  {
+    auto* scan = IndexScan::make(
+        &qctx_,
+        nullptr,
+        1,
+        {context({hint(storage::cpp2::ScanType::PREFIX), hint(storage::cpp2::ScanType::RANGE)})});
+    EXPECT_DOUBLE_EQ(CostModel::kEqualSelectivity * CostModel::kRangeSelectivity,
+                     model_.indexSelectivity(scan));
+  }
+  {
+    // Prefer the prefix scan to the range one
+    auto* prefix = IndexScan::make(
+        &qctx_, nullptr, 1, {context({hint(storage::cpp2::ScanType::PREFIX)})});
+    auto* range =
+        IndexScan::make(&qctx_, nullptr, 1, {context({hint(storage::cpp2::ScanType::RANGE)})});
+    EXPECT_LT(model_.estimate(prefix, {}, {}).cost, model_.estimate(range, {}, {}).cost);
+  }
+  {
+    // United
+    auto* scan = IndexScan::make(&qctx_,
+                                 nullptr,
+                                 1,
+                                 {context({hint(storage::cpp2::ScanType::PREFIX)}),
+                                  context({hint(storage::cpp2::ScanType::PREFIX)})});
+    EXPECT_DOUBLE_EQ(2 * CostModel::kEqualSelectivity, model_.indexSelectivity(scan));
+  }
+}
+
+TEST_F(CostModelTest, PropStatsSelectivity) {
+  // 100 non-null values of 0..99 and 100 nulls
+  meta::cpp2::PropStats stats;
+  stats.count_ref() = 100;
+  stats.null_count_ref() = 100;
+  stats.ndv_ref() = 100;
+  std::vector<Value> histogram;
+  for (int64_t i = 0; i <= 100; i += 25) {
+    histogram.emplace_back(std::max(i - 1, 0L));
+  }
+  stats.histogram_ref() = std::move(histogram);
+
+  EXPECT_DOUBLE_EQ(CostModel::kEqualSelectivity, CostModel::equalSelectivity(nullptr));
+  EXPECT_DOUBLE_EQ(0.5 / 100, CostModel::equalSelectivity(&stats));
+
+  auto range = [](Value begin, Value end) {
+    storage::cpp2::IndexColumnHint h;
+    h.scan_type_ref() = storage::cpp2::ScanType::RANGE;
+    h.begin_value_ref() = std::move(begin);
+    h.end_value_ref() = std::move(end);
+    return h;
+  };
+  EXPECT_DOUBLE_EQ(CostModel::kRangeSelectivity,
+                   CostModel::rangeSelectivity(nullptr, range(Value(), 10)));
+  // Unlimited
+  EXPECT_DOUBLE_EQ(0.5, CostModel::rangeSelectivity(&stats, range(Value(), Value())));
+  // The first bucket
+  EXPECT_DOUBLE_EQ(0.5 / 4, CostModel::rangeSelectivity(&stats, range(Value(), 10)));
+  // The last two buckets
+  EXPECT_DOUBLE_EQ(0.5 / 2, CostModel::rangeSelectivity(&stats, range(60, Value())));
+  // Out of the range of values
+  EXPECT_DOUBLE_EQ(0.5 * 0.5 / 4, CostModel::rangeSelectivity(&stats, range(1000, Value())));
+}
+
+TEST_F(CostModelTest, Join) {
+  auto* left = StartNode::make(&qctx_);
+  auto* right = StartNode::make(&qctx_);
+  auto* join = BiInnerJoin::make(&qctx_, left, right);
+  // The hash table is built on the smaller side whichever it's
+  auto est1 = model_.estimate(join, {Estimate{10.0, 0.0}, Estimate{1000.0, 0.0}}, {});
+  auto est2 = model_.estimate(join, {Estimate{1000.0, 0.0}, Estimate{10.0, 0.0}}, {});
+  EXPECT_DOUBLE_EQ(est1.cost, est2.cost);
+  EXPECT_DOUBLE_EQ(10.0 * CostModel::kHashBuildCost + 1000.0, est1.cost);
+}
+
+TEST_F(CostModelTest, Argument) {
+  auto* arg = Argument::make(&qctx_, "a");
+  // As many rows as the input variable
+  auto est = model_.estimate(arg, {Estimate{1000.0, 0.0}}, {});
+  EXPECT_DOUBLE_EQ(1000.0, est.rows);
+  EXPECT_DOUBLE_EQ(0.0, est.cost);
+  // Unknown
+  est = model_.estimate(arg, {}, {});
+  EXPECT_DOUBLE_EQ(CostModel::kDefaultNumVertices, est.rows);
+}
+
+TEST_F(CostModelTest, Aggregate) {
+  auto* start = StartNode::make(&qctx_);
+  auto* agg = Aggregate::make(&qctx_, start);
+  auto est = model_.estimate(agg, {Estimate{1000.0, 0.0}}, {});
+  EXPECT_DOUBLE_EQ(1.0, est.rows);
+  EXPECT_DOUBLE_EQ(1000.0 * CostModel::kHashBuildCost, est.cost);
+}
+
+}  // namespace opt
+}  // namespace nebula
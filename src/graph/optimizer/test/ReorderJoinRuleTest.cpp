@@ -0,0 +1,151 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/context/QueryContext.h"
+#include "graph/optimizer/OptRule.h"
+#include "graph/optimizer/Optimizer.h"
+#include "graph/planner/plan/Algo.h"
+#include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/session/ClientSession.h"
+
+DECLARE_bool(enable_optimizer_property_pruner_rule);
+
+using nebula::graph::BiCartesianProduct;
+using nebula::graph::BiInnerJoin;
+using nebula::graph::ClientSession;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+using nebula::graph::RequestContext;
+using nebula::graph::ScanVertices;
+using nebula::graph::SpaceInfo;
+using nebula::graph::StartNode;
+
+namespace nebula {
+namespace opt {
+
+// No statistics of the space without the meta client, so the parts are estimated by the default
+// number of vertices and their limits
+class ReorderJoinRuleTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+    SpaceInfo space;
+    space.id = 1;
+    space.name = "test_space";
+    session->setSpace(std::move(space));
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(std::move(session));
+    qctx_.setRCtx(std::move(rctx));
+  }
+
+  // A pattern part yields the columns of its aliases
+  PlanNode* part(std::vector<std::string> aliases, int64_t limit = -1) {
+    auto* scan = ScanVertices::make(&qctx_, StartNode::make(&qctx_), 1);
+    scan->setLimit(limit);
+    scan->setColNames(std::move(aliases));
+    return scan;
+  }
+
+  PlanNode* join(PlanNode* left, PlanNode* right, const std::string& alias) {
+    auto* pool = qctx_.objPool();
+    auto key = [pool, &alias]() {
+      auto* args = ArgumentList::make(pool);
+      args->addArgument(InputPropertyExpression::make(pool, alias));
+      return FunctionCallExpression::make(pool, "id", args);
+    };
+    return BiInnerJoin::make(&qctx_, left, right, {key()}, {key()});
+  }
+
+  const PlanNode* optimize(PlanNode* root) {
+    qctx_.plan()->setRoot(root);
+    Optimizer optimizer({&RuleSet::QueryRules()});
+    auto result = optimizer.findBestPlan(&qctx_);
+    CHECK(result.ok()) << result.status();
+    return result.value();
+  }
+
+  size_t numReaders(const PlanNode* node) {
+    return qctx_.symTable()->getVar(node->outputVar())->readBy.size();
+  }
+
+  size_t numWriters(const PlanNode* node) {
+    return qctx_.symTable()->getVar(node->outputVar())->writtenBy.size();
+  }
+
+  QueryContext qctx_;
+};
+
+TEST_F(ReorderJoinRuleTest, ChooseReordered) {
+  gflags::FlagSaver saver;
+  FLAGS_enable_optimizer_property_pruner_rule = false;
+  auto* a = part({"a"}, 1000);
+  auto* b = part({"b"}, 50000);
+  auto* bc = part({"b", "c"});
+  // ((b, c) x (a)) join (b), the cartesian product of the largest parts comes first
+  auto* product = BiCartesianProduct::make(&qctx_, bc, a);
+  auto* root = join(product, b, "b");
+
+  // (a) x (b) join (b, c) is cheaper, whose columns are projected to the ones of the current tree
+  auto* plan = optimize(root);
+  ASSERT_NE(plan, root);
+  ASSERT_EQ(plan->kind(), PlanNode::Kind::kProject);
+  EXPECT_EQ(plan->outputVar(), root->outputVar());
+  EXPECT_EQ(plan->colNames(), root->colNames());
+  auto* newJoin = plan->dep(0);
+  ASSERT_EQ(newJoin->kind(), PlanNode::Kind::kBiInnerJoin);
+  EXPECT_EQ(newJoin->colNames(), std::vector<std::string>({"a", "b", "b", "c"}));
+  EXPECT_EQ(newJoin->dep(1), bc);
+  auto* newProduct = newJoin->dep(0);
+  ASSERT_EQ(newProduct->kind(), PlanNode::Kind::kBiCartesianProduct);
+  EXPECT_EQ(newProduct->dep(0), a);
+  EXPECT_EQ(newProduct->dep(1), b);
+
+  // Columns (b, c, a, b) of the current tree from (a, b, b, c)
+  const auto& columns = static_cast<const nebula::graph::Project*>(plan)->columns()->columns();
+  std::vector<std::string> exprs;
+  for (auto* column : columns) {
+    exprs.emplace_back(column->expr()->toString());
+  }
+  EXPECT_EQ(exprs,
+            std::vector<std::string>({"COLUMN[2]", "COLUMN[3]", "COLUMN[0]", "COLUMN[1]"}));
+
+  // The joins not chosen neither read nor write the variables
+  EXPECT_EQ(numWriters(plan), 1);
+  EXPECT_EQ(numReaders(a), 1);
+  EXPECT_EQ(numReaders(b), 1);
+  EXPECT_EQ(numReaders(bc), 1);
+}
+
+TEST_F(ReorderJoinRuleTest, KeepCurrent) {
+  gflags::FlagSaver saver;
+  FLAGS_enable_optimizer_property_pruner_rule = false;
+  auto* a = part({"a"}, 2);
+  auto* b = part({"b"});
+  auto* bc = part({"b", "c"});
+  // ((b) join (b, c)) x (a)
+  auto* inner = join(b, bc, "b");
+  auto* root = BiCartesianProduct::make(&qctx_, inner, a);
+
+  // The greedy order starts from the smallest part, i.e. (a) x (b) join (b, c), which is estimated
+  // to be more expensive than the current one, so the current one is kept
+  auto* plan = optimize(root);
+  EXPECT_EQ(plan, root);
+  EXPECT_EQ(plan->dep(0), inner);
+  EXPECT_EQ(plan->dep(1), a);
+
+  EXPECT_EQ(numWriters(plan), 1);
+  EXPECT_EQ(numReaders(a), 1);
+  EXPECT_EQ(numReaders(b), 1);
+  EXPECT_EQ(numReaders(bc), 1);
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -19,6 +19,10 @@ ExecutionPlan::ExecutionPlan(PlanNode* root) : id_(EPIdGenerator::instance().id(
 
 ExecutionPlan::~ExecutionPlan() {}
 
+void ExecutionPlan::renewId() {
+  id_ = EPIdGenerator::instance().id();
+}
+
 uint64_t ExecutionPlan::makePlanNodeDesc(const PlanNode* node) {
   DCHECK(planDescription_ != nullptr);
   auto found = planDescription_->nodeIndexMap.find(node->id());
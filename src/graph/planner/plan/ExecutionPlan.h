@@ -33,6 +33,9 @@ class ExecutionPlan final {
     return id_;
   }
 
+  // Assign a new id to run the plan again
+  void renewId();
+
   void setRoot(PlanNode* root) {
     root_ = root;
   }
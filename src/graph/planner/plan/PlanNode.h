@@ -283,10 +283,15 @@ class PlanNode {
   static const char* toString(Kind kind);
   std::string toString() const;
 
+  // Estimated cost of the plan rooted at this node, see opt::CostModel
   double cost() const {
     return cost_;
   }
 
+  void setCost(double cost) {
+    cost_ = cost;
+  }
+
   void setLoopLayers(std::size_t c) {
     loopLayers_ = c;
   }
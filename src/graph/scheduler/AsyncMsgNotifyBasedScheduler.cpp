@@ -5,6 +5,9 @@
 
 #include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
 
+#include "graph/executor/PipelineExecutor.h"
+#include "graph/service/GraphFlags.h"
+
 DECLARE_bool(enable_lifetime_optimize);
 
 namespace nebula {
@@ -44,6 +47,9 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::doSchedule(Executor* root) c
     auto* exe = queue.front();
     queue.pop();
     queue2.push(exe);
+    if (FLAGS_enable_pipeline_execution) {
+      PipelineExecutor::fuse(exe);
+    }
 
     std::vector<folly::Future<Status>>& futures = futureMap[exe->id()];
     if (exe->node()->kind() == PlanNode::Kind::kArgument) {
@@ -19,6 +19,50 @@ DEFINE_int32(num_netio_threads,
 DEFINE_int32(num_accept_threads, 1, "Number of threads to accept incoming connections");
 DEFINE_int32(num_worker_threads, 0, "Number of threads to execute user queries");
 DEFINE_int32(num_operator_threads, 2, "Number of threads to execute a single operator");
+DEFINE_uint32(min_rows_for_parallel_operator,
+              100000,
+              "Minimum number of input rows to execute an operator in parallel by "
+              "num_operator_threads threads");
+DEFINE_int64(query_memory_budget_bytes,
+             0,
+             "Memory budget of the rows buffered by an operator of a query, the operators "
+             "supporting spill write the exceeding rows to disk, 0 means no limit");
+DEFINE_string(spill_tmp_dir, "/tmp", "Directory of the temporary files spilled by operators");
+DEFINE_bool(enable_pipeline_execution,
+            false,
+            "Whether to fuse the chains of row-wise operators, e.g. Filter, Project, Unwind and "
+            "Limit, into pipelines which process the rows batch by batch");
+DEFINE_uint32(pipeline_batch_size, 1024, "Number of rows in a batch of the pipeline execution");
+DEFINE_uint32(plan_cache_capacity,
+              0,
+              "Number of statements whose optimized plans are cached for the later requests of "
+              "the same statement with different parameters, 0 means disabled");
+DEFINE_uint32(max_cached_plans_per_statement,
+              4,
+              "Maximum number of idle plans cached for a statement, each running request of the "
+              "statement owns a plan exclusively");
+DEFINE_uint32(prepared_plan_cache_capacity,
+              1024,
+              "Number of prepared statements whose plans are pinned in the plan cache, which are "
+              "cached apart from the plans of the other statements");
+DEFINE_uint32(max_prepared_statements_per_session,
+              256,
+              "Maximum number of prepared statements kept by a session");
+DEFINE_uint32(max_cursors_per_session,
+              16,
+              "Maximum number of open cursors kept by a session, each of which holds the rows of "
+              "a result not fetched yet");
+DEFINE_uint32(max_cursor_batch_size,
+              100000,
+              "Maximum number of rows returned by a batch of a cursor");
+DEFINE_uint64(max_cursor_bytes_per_session,
+              256UL << 20,
+              "Maximum bytes of the rows kept by all open cursors of a session, a result which "
+              "exceeds it is not kept in a cursor");
+DEFINE_uint32(cursor_idle_timeout_secs,
+              300,
+              "The number of seconds before a cursor not fetched is closed, it's checked every "
+              "session_reclaim_interval_secs");
 DEFINE_bool(reuse_port, true, "Whether to turn on the SO_REUSEPORT option");
 DEFINE_int32(listen_backlog, 1024, "Backlog of the listen socket");
 DEFINE_string(listen_netdev, "any", "The network device to listen on");
@@ -16,6 +16,19 @@ DECLARE_int32(num_netio_threads);
 DECLARE_int32(num_accept_threads);
 DECLARE_int32(num_worker_threads);
 DECLARE_int32(num_operator_threads);
+DECLARE_uint32(min_rows_for_parallel_operator);
+DECLARE_int64(query_memory_budget_bytes);
+DECLARE_string(spill_tmp_dir);
+DECLARE_bool(enable_pipeline_execution);
+DECLARE_uint32(pipeline_batch_size);
+DECLARE_uint32(plan_cache_capacity);
+DECLARE_uint32(max_cached_plans_per_statement);
+DECLARE_uint32(prepared_plan_cache_capacity);
+DECLARE_uint32(max_prepared_statements_per_session);
+DECLARE_uint32(max_cursors_per_session);
+DECLARE_uint32(max_cursor_batch_size);
+DECLARE_uint64(max_cursor_bytes_per_session);
+DECLARE_uint32(cursor_idle_timeout_secs);
 DECLARE_bool(reuse_port);
 DECLARE_int32(listen_backlog);
 DECLARE_string(listen_netdev);
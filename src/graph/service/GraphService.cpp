@@ -11,14 +11,17 @@
 
 #include "clients/storage/StorageClient.h"
 #include "common/base/Base.h"
+#include "common/graph/JsonWriter.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
 #include "common/time/TimezoneInfo.h"
+#include "graph/context/QueryContext.h"
 #include "graph/service/CloudAuthenticator.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/PasswordAuthenticator.h"
 #include "graph/service/RequestContext.h"
 #include "graph/stats/GraphStats.h"
+#include "parser/GQLParser.h"
 #include "version/Version.h"
 
 namespace nebula {
@@ -131,6 +134,14 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
     int64_t sessionId,
     const std::string& query,
     const std::unordered_map<std::string, Value>& parameterMap) {
+  return doExecute(sessionId, query, folly::none, parameterMap);
+}
+
+folly::Future<ExecutionResponse> GraphService::doExecute(
+    int64_t sessionId,
+    const std::string& query,
+    folly::Optional<int64_t> statementId,
+    const std::unordered_map<std::string, Value>& parameterMap) {
   auto ctx = std::make_unique<RequestContext<ExecutionResponse>>();
   ctx->setQuery(query);
   ctx->setRunner(getThreadManager());
@@ -143,7 +154,11 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
     ctx->finish();
     return future;
   }
-  auto cb = [this, sessionId, ctx = std::move(ctx), parameterMap = std::move(parameterMap)](
+  auto cb = [this,
+             sessionId,
+             statementId,
+             ctx = std::move(ctx),
+             parameterMap = std::move(parameterMap)](
                 StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
     if (!ret.ok()) {
       LOG(ERROR) << "Get session for sessionId: " << sessionId << " failed: " << ret.status();
@@ -160,6 +175,16 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
           new std::string(folly::stringPrintf("SessionId[%ld] does not exist", sessionId)));
       return ctx->finish();
     }
+    if (statementId.has_value()) {
+      auto stmt = sessionPtr->findPreparedStatement(*statementId);
+      if (!stmt.ok()) {
+        ctx->resp().errorCode = ErrorCode::E_EXECUTION_ERROR;
+        ctx->resp().errorMsg.reset(new std::string(stmt.status().toString()));
+        return ctx->finish();
+      }
+      ctx->setQuery(std::move(stmt).value());
+      ctx->setPrepared(true);
+    }
     stats::StatsManager::addValue(kNumQueries);
     stats::StatsManager::addValue(kNumActiveQueries);
     if (FLAGS_enable_space_level_metrics && sessionPtr->space().name != "") {
@@ -182,6 +207,170 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
   return future;
 }
 
+folly::Future<cpp2::PrepareResp> GraphService::future_prepare(int64_t sessionId,
+                                                             const std::string& stmt) {
+  cpp2::PrepareResp resp;
+  // Check the syntax only, the statement is validated when executed since the plan depends on
+  // the space and the parameters
+  QueryContext qctx;
+  auto result = GQLParser(&qctx).parse(stmt);
+  if (!result.ok()) {
+    resp.error_code_ref() = result.status().isStatementEmpty()
+                                ? nebula::cpp2::ErrorCode::E_STATEMENT_EMPTY
+                                : nebula::cpp2::ErrorCode::E_SYNTAX_ERROR;
+    resp.error_msg_ref() = result.status().toString();
+    return folly::makeFuture<cpp2::PrepareResp>(std::move(resp));
+  }
+
+  auto cb = [sessionId, stmt](StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
+    cpp2::PrepareResp resp;
+    if (!ret.ok() || ret.value() == nullptr) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_SESSION_INVALID;
+      resp.error_msg_ref() = folly::stringPrintf("SessionId[%ld] does not exist", sessionId);
+      return resp;
+    }
+    auto stmtId = ret.value()->addPreparedStatement(std::move(stmt));
+    if (!stmtId.ok()) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_EXECUTION_ERROR;
+      resp.error_msg_ref() = stmtId.status().toString();
+      return resp;
+    }
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
+    resp.statement_id_ref() = stmtId.value();
+    return resp;
+  };
+  return sessionManager_->findSession(sessionId, getThreadManager()).thenValue(std::move(cb));
+}
+
+folly::Future<ExecutionResponse> GraphService::future_executePrepared(
+    int64_t sessionId,
+    int64_t statementId,
+    const std::unordered_map<std::string, Value>& parameterMap) {
+  return doExecute(sessionId, "", statementId, parameterMap);
+}
+
+folly::Future<folly::Unit> GraphService::future_deallocatePrepared(int64_t sessionId,
+                                                                   int64_t statementId) {
+  VLOG(2) << "Deallocate prepared statement " << statementId << " of session " << sessionId;
+  // Reply once the statement is deleted, so the following requests of the client never see it
+  return sessionManager_->findSession(sessionId, getThreadManager())
+      .thenValue([this, statementId](StatusOr<std::shared_ptr<ClientSession>> ret) {
+        if (!ret.ok() || ret.value() == nullptr) {
+          return;
+        }
+        auto& session = ret.value();
+        auto stmt = session->findPreparedStatement(statementId);
+        if (!stmt.ok()) {
+          return;
+        }
+        session->deletePreparedStatement(statementId);
+        // The pinned plans of the statement are not evicted by the other prepared statements
+        queryEngine_->planCache()->evictPrepared(session->user(), stmt.value());
+      });
+}
+
+folly::Future<cpp2::CursorResponse> GraphService::future_executeWithCursor(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap,
+    int32_t batchSize) {
+  if (batchSize <= 0 || static_cast<uint32_t>(batchSize) > FLAGS_max_cursor_batch_size) {
+    cpp2::CursorResponse resp;
+    resp.response_ref()->errorCode = ErrorCode::E_EXECUTION_ERROR;
+    resp.response_ref()->errorMsg = std::make_unique<std::string>(folly::stringPrintf(
+        "Batch size %d is out of range (0, %u]", batchSize, FLAGS_max_cursor_batch_size));
+    return folly::makeFuture<cpp2::CursorResponse>(std::move(resp));
+  }
+  // The result is materialized before the first batch is returned, so reject the query before
+  // executing it if the session has no room for another cursor
+  auto cb = [this, sessionId, query, parameterMap, batchSize](
+                StatusOr<std::shared_ptr<ClientSession>> ret) {
+    cpp2::CursorResponse resp;
+    if (!ret.ok() || ret.value() == nullptr) {
+      resp.response_ref()->errorCode = ErrorCode::E_SESSION_INVALID;
+      resp.response_ref()->errorMsg = std::make_unique<std::string>(
+          folly::stringPrintf("SessionId[%ld] does not exist", sessionId));
+      return folly::makeFuture<cpp2::CursorResponse>(std::move(resp));
+    }
+    auto session = std::move(ret).value();
+    auto status = session->checkCursorBudget();
+    if (!status.ok()) {
+      resp.response_ref()->errorCode = ErrorCode::E_EXECUTION_ERROR;
+      resp.response_ref()->errorMsg = std::make_unique<std::string>(status.toString());
+      return folly::makeFuture<cpp2::CursorResponse>(std::move(resp));
+    }
+    return doExecute(sessionId, query, folly::none, parameterMap)
+        .thenValue([session = std::move(session), batchSize](ExecutionResponse&& execResp) {
+          cpp2::CursorResponse cursorResp;
+          auto data = std::move(execResp.data);
+          cursorResp.response_ref() = std::move(execResp);
+          if (data == nullptr || data->rowSize() <= static_cast<size_t>(batchSize)) {
+            cursorResp.response_ref()->data = std::move(data);
+            return cursorResp;
+          }
+          // Keep the rows after the first batch in a cursor of the session
+          auto& rows = data->rows;
+          auto batch = std::make_unique<DataSet>(data->colNames);
+          batch->rows.insert(batch->rows.end(),
+                             std::make_move_iterator(rows.begin()),
+                             std::make_move_iterator(rows.begin() + batchSize));
+          auto cursorId = session->addCursor(std::move(*data), batchSize);
+          if (!cursorId.ok()) {
+            cursorResp.response_ref()->errorCode = ErrorCode::E_EXECUTION_ERROR;
+            cursorResp.response_ref()->errorMsg =
+                std::make_unique<std::string>(cursorId.status().toString());
+            return cursorResp;
+          }
+          cursorResp.response_ref()->data = std::move(batch);
+          cursorResp.cursor_id_ref() = cursorId.value();
+          return cursorResp;
+        });
+  };
+  return sessionManager_->findSession(sessionId, getThreadManager()).thenValue(std::move(cb));
+}
+
+folly::Future<cpp2::FetchResp> GraphService::future_fetchNext(int64_t sessionId,
+                                                              int64_t cursorId,
+                                                              int32_t batchSize) {
+  if (batchSize <= 0 || static_cast<uint32_t>(batchSize) > FLAGS_max_cursor_batch_size) {
+    cpp2::FetchResp resp;
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::E_EXECUTION_ERROR;
+    resp.error_msg_ref() = folly::stringPrintf(
+        "Batch size %d is out of range (0, %u]", batchSize, FLAGS_max_cursor_batch_size);
+    return folly::makeFuture<cpp2::FetchResp>(std::move(resp));
+  }
+  auto cb = [sessionId, cursorId, batchSize](StatusOr<std::shared_ptr<ClientSession>> ret) {
+    cpp2::FetchResp resp;
+    if (!ret.ok() || ret.value() == nullptr) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_SESSION_INVALID;
+      resp.error_msg_ref() = folly::stringPrintf("SessionId[%ld] does not exist", sessionId);
+      return resp;
+    }
+    bool hasMore = false;
+    auto batch = ret.value()->fetchCursor(cursorId, batchSize, &hasMore);
+    if (!batch.ok()) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_EXECUTION_ERROR;
+      resp.error_msg_ref() = batch.status().toString();
+      return resp;
+    }
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
+    resp.data_ref() = std::move(batch).value();
+    resp.has_more_ref() = hasMore;
+    return resp;
+  };
+  return sessionManager_->findSession(sessionId, getThreadManager()).thenValue(std::move(cb));
+}
+
+void GraphService::closeCursor(int64_t sessionId, int64_t cursorId) {
+  VLOG(2) << "Close cursor " << cursorId << " of session " << sessionId;
+  sessionManager_->findSession(sessionId, getThreadManager())
+      .thenValue([cursorId](StatusOr<std::shared_ptr<ClientSession>> ret) {
+        if (ret.ok() && ret.value() != nullptr) {
+          ret.value()->closeCursor(cursorId);
+        }
+      });
+}
+
 folly::Future<ExecutionResponse> GraphService::future_execute(int64_t sessionId,
                                                               const std::string& query) {
   return future_executeWithParameter(sessionId, query, std::unordered_map<std::string, Value>{});
@@ -198,7 +387,7 @@ folly::Future<std::string> GraphService::future_executeJsonWithParameter(
     const std::string& query,
     const std::unordered_map<std::string, Value>& parameterMap) {
   return future_executeWithParameter(sessionId, query, parameterMap).thenValue([](auto&& resp) {
-    return folly::toJson(resp.toJson());
+    return JsonWriter::toJson(resp);
   });
 }
 
@@ -48,6 +48,29 @@ class GraphService final : public cpp2::GraphServiceSvIf {
   folly::Future<std::string> future_executeJson(int64_t sessionId,
                                                 const std::string& stmt) override;
 
+  folly::Future<cpp2::PrepareResp> future_prepare(int64_t sessionId,
+                                                 const std::string& stmt) override;
+
+  folly::Future<ExecutionResponse> future_executePrepared(
+      int64_t sessionId,
+      int64_t statementId,
+      const std::unordered_map<std::string, Value>& parameterMap) override;
+
+  folly::Future<folly::Unit> future_deallocatePrepared(int64_t sessionId,
+                                                       int64_t statementId) override;
+
+  folly::Future<cpp2::CursorResponse> future_executeWithCursor(
+      int64_t sessionId,
+      const std::string& stmt,
+      const std::unordered_map<std::string, Value>& parameterMap,
+      int32_t batchSize) override;
+
+  folly::Future<cpp2::FetchResp> future_fetchNext(int64_t sessionId,
+                                                  int64_t cursorId,
+                                                  int32_t batchSize) override;
+
+  void closeCursor(int64_t sessionId, int64_t cursorId) override;
+
   folly::Future<cpp2::VerifyClientVersionResp> future_verifyClientVersion(
       const cpp2::VerifyClientVersionReq& req) override;
 
@@ -56,6 +79,13 @@ class GraphService final : public cpp2::GraphServiceSvIf {
  private:
   Status auth(const std::string& username, const std::string& password);
 
+  // Execute the query, or the prepared statement of the session if `statementId' is given
+  folly::Future<ExecutionResponse> doExecute(
+      int64_t sessionId,
+      const std::string& query,
+      folly::Optional<int64_t> statementId,
+      const std::unordered_map<std::string, Value>& parameterMap);
+
   std::unique_ptr<GraphSessionManager> sessionManager_;
   std::unique_ptr<QueryEngine> queryEngine_;
 };
@@ -0,0 +1,284 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/PlanCache.h"
+
+#include <folly/Format.h>
+#include <folly/String.h>
+
+#include "common/stats/StatsManager.h"
+#include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
+#include "parser/SequentialSentences.h"
+
+namespace nebula {
+namespace graph {
+
+bool PlanCache::enabled(const RequestContext<ExecutionResponse>& rctx) const {
+  return rctx.prepared() ? FLAGS_prepared_plan_cache_capacity > 0 : FLAGS_plan_cache_capacity > 0;
+}
+
+PlanCache::PlanCache(meta::MetaClient* metaClient) : metaClient_(metaClient) {
+  version_ = [metaClient]() -> int64_t {
+    if (metaClient == nullptr) {
+      return 0;
+    }
+    // Both versions only grow, so the sum changes once either of them changed
+    return metaClient->metadataVersion() + metaClient->statsVersion();
+  };
+}
+
+std::unique_ptr<PlanCache::CachedPlan> PlanCache::acquire(
+    const RequestContext<ExecutionResponse>& rctx) {
+  if (!enabled(rctx)) {
+    return nullptr;
+  }
+  auto spaceId = rctx.session()->space().id;
+  if (metaClient_ != nullptr && spaceId > 0) {
+    // The optimizer, which reloads the expired statistics, is skipped by the cached plans
+    metaClient_->getStatsFromCache(spaceId);
+  }
+  auto key = keyOf(rctx);
+  std::unique_ptr<CachedPlan> plan;
+  std::list<Entry> dropped;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    checkVersion(version(), &dropped);
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+      auto& entries = iter->second->pinned ? pinnedEntries_ : entries_;
+      entries.splice(entries.begin(), entries, iter->second);
+      auto& plans = iter->second->plans;
+      if (!plans.empty()) {
+        plan = std::move(plans.back());
+        plans.pop_back();
+      }
+    }
+  }
+  stats::StatsManager::addValue(plan != nullptr ? kNumPlanCacheHits : kNumPlanCacheMisses);
+  return plan;
+}
+
+std::unique_ptr<PlanCache::CachedPlan> PlanCache::prepare(QueryContext* qctx,
+                                                          const Sentence* sentence,
+                                                          int64_t version) {
+  if (!enabled(*qctx->rctx()) || sentence->kind() == Sentence::Kind::kExplain) {
+    return nullptr;
+  }
+  // The plan may depend on the values of parameters
+  if (qctx->ectx()->hasReads()) {
+    return nullptr;
+  }
+  if (!isCacheable(qctx->plan()->root())) {
+    return nullptr;
+  }
+
+  auto plan = std::make_unique<CachedPlan>();
+  plan->key = keyOf(*qctx->rctx());
+  plan->pinned = qctx->rctx()->prepared();
+  plan->version = version;
+  if (sentence->kind() == Sentence::Kind::kSequential) {
+    plan->numSentences = static_cast<const SequentialSentences*>(sentence)->numSentences();
+  }
+  plan->mark = qctx->objPool()->mark();
+  plan->constants = std::make_unique<ExecutionContext>();
+  qctx->ectx()->copyTo(plan->constants.get());
+  return plan;
+}
+
+void PlanCache::release(std::unique_ptr<CachedPlan> plan) {
+  DCHECK(plan->qctx != nullptr);
+  auto* qctx = plan->qctx.get();
+  // Release the request and the results of execution before rolling back the executors
+  qctx->reset(nullptr, nullptr);
+  qctx->objPool()->rollback(plan->mark);
+
+  std::list<Entry> dropped;
+  std::lock_guard<std::mutex> guard(lock_);
+  checkVersion(version(), &dropped);
+  if (plan->version != cachedVersion_) {
+    // Destroyed after the lock is released
+    dropped.emplace_back(Entry{plan->key, plan->pinned, {}});
+    dropped.back().plans.emplace_back(std::move(plan));
+    return;
+  }
+  auto& entries = plan->pinned ? pinnedEntries_ : entries_;
+  auto iter = index_.find(plan->key);
+  if (iter == index_.end()) {
+    entries.emplace_front(Entry{plan->key, plan->pinned, {}});
+    iter = index_.emplace(plan->key, entries.begin()).first;
+  } else {
+    entries.splice(entries.begin(), entries, iter->second);
+  }
+  auto& plans = iter->second->plans;
+  if (plans.size() < FLAGS_max_cached_plans_per_statement) {
+    plans.emplace_back(std::move(plan));
+  }
+  auto capacity = &entries == &pinnedEntries_ ? FLAGS_prepared_plan_cache_capacity
+                                               : FLAGS_plan_cache_capacity;
+  while (entries.size() > capacity) {
+    index_.erase(entries.back().key);
+    dropped.splice(dropped.end(), entries, std::prev(entries.end()));
+  }
+}
+
+void PlanCache::evictPrepared(const std::string& user, const std::string& stmt) {
+  // The keys are "P<space>\n<user>\n<names of parameters>\n<statement>", see keyOf
+  auto userLine = folly::sformat("\n{}\n", FLAGS_enable_authorize ? user : "");
+  std::list<Entry> dropped;
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto iter = pinnedEntries_.begin(); iter != pinnedEntries_.end();) {
+    const auto& key = iter->key;
+    auto pos = key.find('\n');
+    if (pos == std::string::npos || key.compare(pos, userLine.size(), userLine) != 0) {
+      ++iter;
+      continue;
+    }
+    pos = key.find('\n', pos + userLine.size());
+    if (pos == std::string::npos || key.compare(pos + 1, std::string::npos, stmt) != 0) {
+      ++iter;
+      continue;
+    }
+    index_.erase(key);
+    auto next = std::next(iter);
+    // Destroyed after the lock is released
+    dropped.splice(dropped.end(), pinnedEntries_, iter);
+    iter = next;
+  }
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  size_t size = 0;
+  for (auto* entries : {&entries_, &pinnedEntries_}) {
+    for (auto& entry : *entries) {
+      size += entry.plans.size();
+    }
+  }
+  return size;
+}
+
+void PlanCache::checkVersion(int64_t version, std::list<Entry>* dropped) {
+  if (version == cachedVersion_) {
+    return;
+  }
+  VLOG(1) << "Metadata changed from version " << cachedVersion_ << " to " << version
+          << ", drop " << index_.size() << " cached statements";
+  cachedVersion_ = version;
+  index_.clear();
+  dropped->splice(dropped->end(), entries_);
+  dropped->splice(dropped->end(), pinnedEntries_);
+}
+
+// static
+std::string PlanCache::keyOf(const RequestContext<ExecutionResponse>& rctx) {
+  auto* session = rctx.session();
+  std::vector<std::string> params;
+  params.reserve(rctx.parameterMap().size());
+  for (auto& kv : rctx.parameterMap()) {
+    // See QueryContext::existParameter
+    params.emplace_back(kv.second.isDataSet() ? kv.first + ":dataset" : kv.first);
+  }
+  std::sort(params.begin(), params.end());
+  // The plans of prepared statements are cached apart
+  return folly::sformat("{}{}\n{}\n{}\n{}",
+                        rctx.prepared() ? "P" : "",
+                        session->space().id,
+                        FLAGS_enable_authorize ? session->user() : "",
+                        folly::join(",", params),
+                        rctx.query());
+}
+
+// static
+namespace {
+
+// Only the query and logic nodes, the plans of mutations and administrations are never cached.
+// The new kinds are not cached until they are listed here.
+bool isCacheableKind(PlanNode::Kind kind) {
+  switch (kind) {
+    case PlanNode::Kind::kGetNeighbors:
+    case PlanNode::Kind::kGetVertices:
+    case PlanNode::Kind::kGetEdges:
+    case PlanNode::Kind::kTraverse:
+    case PlanNode::Kind::kAppendVertices:
+    case PlanNode::Kind::kShortestPath:
+    case PlanNode::Kind::kIndexScan:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kTagIndexRangeScan:
+    case PlanNode::Kind::kEdgeIndexFullScan:
+    case PlanNode::Kind::kEdgeIndexPrefixScan:
+    case PlanNode::Kind::kEdgeIndexRangeScan:
+    case PlanNode::Kind::kScanVertices:
+    case PlanNode::Kind::kScanEdges:
+    case PlanNode::Kind::kFilter:
+    case PlanNode::Kind::kUnion:
+    case PlanNode::Kind::kUnionAllVersionVar:
+    case PlanNode::Kind::kIntersect:
+    case PlanNode::Kind::kMinus:
+    case PlanNode::Kind::kProject:
+    case PlanNode::Kind::kUnwind:
+    case PlanNode::Kind::kSort:
+    case PlanNode::Kind::kTopN:
+    case PlanNode::Kind::kLimit:
+    case PlanNode::Kind::kSample:
+    case PlanNode::Kind::kAggregate:
+    case PlanNode::Kind::kDedup:
+    case PlanNode::Kind::kAssign:
+    case PlanNode::Kind::kBFSShortest:
+    case PlanNode::Kind::kMultiShortestPath:
+    case PlanNode::Kind::kProduceAllPaths:
+    case PlanNode::Kind::kCartesianProduct:
+    case PlanNode::Kind::kSubgraph:
+    case PlanNode::Kind::kDataCollect:
+    case PlanNode::Kind::kLeftJoin:
+    case PlanNode::Kind::kInnerJoin:
+    case PlanNode::Kind::kBiLeftJoin:
+    case PlanNode::Kind::kBiInnerJoin:
+    case PlanNode::Kind::kBiCartesianProduct:
+    case PlanNode::Kind::kRollUpApply:
+    case PlanNode::Kind::kArgument:
+    case PlanNode::Kind::kStart:
+    case PlanNode::Kind::kSelect:
+    case PlanNode::Kind::kLoop:
+    case PlanNode::Kind::kPassThrough:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool PlanCache::isCacheable(const PlanNode* root) {
+  std::vector<const PlanNode*> stack{root};
+  std::unordered_set<const PlanNode*> visited;
+  while (!stack.empty()) {
+    auto* node = stack.back();
+    stack.pop_back();
+    if (node == nullptr || !visited.emplace(node).second) {
+      continue;
+    }
+    if (!isCacheableKind(node->kind())) {
+      return false;
+    }
+    if (node->kind() == PlanNode::Kind::kSelect) {
+      auto* select = node->asNode<Select>();
+      stack.emplace_back(select->then());
+      stack.emplace_back(select->otherwise());
+    } else if (node->kind() == PlanNode::Kind::kLoop) {
+      stack.emplace_back(node->asNode<Loop>()->body());
+    }
+    for (auto* dep : node->dependencies()) {
+      stack.emplace_back(dep);
+    }
+  }
+  return true;
+}
+
+}  // namespace graph
+}  // namespace nebula
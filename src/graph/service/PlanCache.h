@@ -0,0 +1,125 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_PLANCACHE_H_
+#define GRAPH_SERVICE_PLANCACHE_H_
+
+#include <boost/core/noncopyable.hpp>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include "clients/meta/MetaClient.h"
+#include "common/base/ObjectPool.h"
+#include "graph/context/QueryContext.h"
+#include "parser/Sentence.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanNode;
+
+/**
+ * PlanCache keeps the optimized plans of statements for the later requests of the same
+ * statement, which differ only in the values of parameters.
+ *
+ * A plan is bound to the QueryContext it's compiled in, since the plan nodes and expressions are
+ * allocated in its object pool and the expressions keep the evaluation results in themselves.
+ * So rather than a shared template, the cache keeps the idle QueryContexts of a statement, each
+ * of which is checked out by one request at a time. When a request finishes, the objects created
+ * during the execution, e.g. the executors, are rolled back from the pool of its context before
+ * the context is cached again, and the variables written by the planner are restored when the
+ * context is reused.
+ *
+ * The key of a plan is (space, user, names of parameters, statement). Only the plans of
+ * read-only statements which don't read any value of parameters during the planning are cached,
+ * since the planning may depend on the values, e.g. index selection. All cached plans are
+ * dropped once the metadata is reloaded by MetaClient, e.g. a schema or an index was changed, or
+ * once the statistics of a newer stats job are loaded, which the cost model chooses plans by.
+ *
+ * The plans of prepared statements are pinned, i.e. cached even if the cache is disabled and
+ * evicted only by the other prepared statements, so they never miss for the ad-hoc queries.
+ */
+class PlanCache final : private boost::noncopyable {
+ public:
+  // A compiled plan with the states to restore before running it again
+  struct CachedPlan {
+    std::string key;
+    // Whether the plan is of a prepared statement
+    bool pinned{false};
+    // Version of the metadata and statistics the plan is compiled with
+    int64_t version{0};
+    std::unique_ptr<QueryContext> qctx;
+    // The sentence referred by the plan
+    std::unique_ptr<Sentence> sentence;
+    size_t numSentences{1};
+    // Position of the object pool of qctx when the plan is compiled
+    ObjectPool::Mark mark;
+    // Variables written by the validator and the planner
+    std::unique_ptr<ExecutionContext> constants;
+  };
+
+  explicit PlanCache(meta::MetaClient* metaClient);
+
+  // Read the version by `version' instead of MetaClient, e.g. in tests
+  explicit PlanCache(std::function<int64_t()> version) : version_(std::move(version)) {}
+
+  // Whether the plan of the request could be cached
+  bool enabled(const RequestContext<ExecutionResponse>& rctx) const;
+
+  // Version of the metadata and statistics now, read it before compiling a plan
+  int64_t version() const {
+    return version_();
+  }
+
+  // Check out an idle plan of the statement, return nullptr if missed
+  std::unique_ptr<CachedPlan> acquire(const RequestContext<ExecutionResponse>& rctx);
+
+  // Return the cached plan of the context just compiled, or nullptr if the plan couldn't be
+  // cached. The plan is put into the cache by `release' after executed.
+  std::unique_ptr<CachedPlan> prepare(QueryContext* qctx,
+                                      const Sentence* sentence,
+                                      int64_t version);
+
+  // Cache the plan again after a successful execution
+  void release(std::unique_ptr<CachedPlan> plan);
+
+  // Evict the pinned plans of the prepared statement of the user once it's deallocated, in any
+  // space and with any parameters. The same statement prepared by another session of the user is
+  // compiled again when executed next time.
+  void evictPrepared(const std::string& user, const std::string& stmt);
+
+  size_t size() const;
+
+  static std::string keyOf(const RequestContext<ExecutionResponse>& rctx);
+
+  static bool isCacheable(const PlanNode* root);
+
+ private:
+  struct Entry {
+    std::string key;
+    bool pinned{false};
+    std::vector<std::unique_ptr<CachedPlan>> plans;
+  };
+
+  // Drop all plans if the metadata changed, the dropped ones are moved into `dropped' to be
+  // destroyed out of the lock
+  void checkVersion(int64_t version, std::list<Entry>* dropped);
+
+  meta::MetaClient* metaClient_{nullptr};
+  std::function<int64_t()> version_;
+
+  mutable std::mutex lock_;
+  int64_t cachedVersion_{0};
+  // The most recently used statement is at the front
+  std::list<Entry> entries_;
+  std::list<Entry> pinnedEntries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_PLANCACHE_H_
@@ -40,19 +40,32 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
     rulesets.emplace_back(&opt::RuleSet::QueryRules());
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
+  planCache_ = std::make_unique<PlanCache>(metaClient_);
 
   return setupMemoryMonitorThread();
 }
 
 // Create query context and query instance and execute it
 void QueryEngine::execute(RequestContextPtr rctx) {
-  auto qctx = std::make_unique<QueryContext>(std::move(rctx),
-                                             schemaManager_.get(),
-                                             indexManager_.get(),
-                                             storage_.get(),
-                                             metaClient_,
-                                             charsetInfo_);
-  auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
+  std::unique_ptr<PlanCache::CachedPlan> cachedPlan;
+  if (planCache_->enabled(*rctx)) {
+    cachedPlan = planCache_->acquire(*rctx);
+  }
+  std::unique_ptr<QueryContext> qctx;
+  if (cachedPlan != nullptr) {
+    // Reuse the compiled plan
+    qctx = std::move(cachedPlan->qctx);
+    qctx->reset(std::move(rctx), cachedPlan->constants.get());
+  } else {
+    qctx = std::make_unique<QueryContext>(std::move(rctx),
+                                          schemaManager_.get(),
+                                          indexManager_.get(),
+                                          storage_.get(),
+                                          metaClient_,
+                                          charsetInfo_);
+  }
+  auto* instance = new QueryInstance(
+      std::move(qctx), optimizer_.get(), planCache_.get(), std::move(cachedPlan));
   instance->execute();
 }
 
@@ -18,6 +18,7 @@
 #include "common/meta/SchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/service/PlanCache.h"
 #include "graph/service/RequestContext.h"
 #include "interface/gen-cpp2/GraphService.h"
 
@@ -26,8 +27,8 @@ namespace graph {
 
 /**
  * QueryEngine is responsible to create and manage ExecutionPlan.
- * For the time being, we don't have the execution plan cache support,
- * instead we create a plan for each query, and destroy it upon finish.
+ * A plan is created for each query and destroyed upon finish, unless the plan
+ * cache is enabled, see PlanCache.
  */
 class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
  public:
@@ -44,6 +45,10 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
     return metaClient_;
   }
 
+  PlanCache* planCache() {
+    return planCache_.get();
+  }
+
  private:
   Status setupMemoryMonitorThread();
 
@@ -51,6 +56,7 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
   std::unique_ptr<meta::IndexManager> indexManager_;
   std::unique_ptr<storage::StorageClient> storage_;
   std::unique_ptr<opt::Optimizer> optimizer_;
+  std::unique_ptr<PlanCache> planCache_;
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
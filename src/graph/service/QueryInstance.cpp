@@ -29,24 +29,35 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
-QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
+QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx,
+                             Optimizer *optimizer,
+                             PlanCache *planCache,
+                             std::unique_ptr<PlanCache::CachedPlan> cachedPlan) {
   qctx_ = std::move(qctx);
   optimizer_ = DCHECK_NOTNULL(optimizer);
+  planCache_ = planCache;
+  cachedPlan_ = std::move(cachedPlan);
+  cacheHit_ = cachedPlan_ != nullptr;
   scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
   qctx_->rctx()->session()->addQuery(qctx_.get());
 }
 
 void QueryInstance::execute() {
-  Status status = validateAndOptimize();
-  if (!status.ok()) {
-    onError(std::move(status));
-    return;
-  }
+  if (cacheHit_) {
+    VLOG(1) << "Hit plan cache: " << qctx()->rctx()->query();
+    addSentenceStats(cachedPlan_->numSentences, qctx()->rctx()->session()->space().name);
+  } else {
+    Status status = validateAndOptimize();
+    if (!status.ok()) {
+      onError(std::move(status));
+      return;
+    }
 
-  // Sentence is explain query, finish
-  if (!explainOrContinue()) {
-    onFinish();
-    return;
+    // Sentence is explain query, finish
+    if (!explainOrContinue()) {
+      onFinish();
+      return;
+    }
   }
 
   // The execution engine converts the physical execution plan generated by the Planner into a
@@ -74,24 +85,25 @@ Status QueryInstance::validateAndOptimize() {
   NG_RETURN_IF_ERROR(result);
   sentence_ = std::move(result).value();
   if (sentence_->kind() == Sentence::Kind::kSequential) {
-    size_t num = static_cast<const SequentialSentences *>(sentence_.get())->numSentences();
-    stats::StatsManager::addValue(kNumSentences, num);
-    if (FLAGS_enable_space_level_metrics && spaceName != "") {
-      stats::StatsManager::addValue(
-          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}), num);
-    }
+    addSentenceStats(static_cast<const SequentialSentences *>(sentence_.get())->numSentences(),
+                     spaceName);
   } else {
-    stats::StatsManager::addValue(kNumSentences);
-    if (FLAGS_enable_space_level_metrics && spaceName != "") {
-      stats::StatsManager::addValue(
-          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}));
-    }
+    addSentenceStats(1, spaceName);
   }
 
+  bool cacheable = planCache_ != nullptr && planCache_->enabled(*rctx);
+  // Read before compiling, so the plan compiled with the stale metadata is never cached
+  int64_t version = cacheable ? planCache_->version() : 0;
+  // The plan reading the values of parameters is not cacheable
+  qctx()->ectx()->recordReads(cacheable);
   // Validate the query, if failed, return
   NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
   // Optimize the query, and get the execution plan
   NG_RETURN_IF_ERROR(findBestPlan());
+  qctx()->ectx()->recordReads(false);
+  if (cacheable) {
+    cachedPlan_ = planCache_->prepare(qctx(), sentence_.get(), version);
+  }
   stats::StatsManager::addValue(kOptimizerLatencyUs, *(qctx_->plan()->optimizeTimeInUs()));
   if (FLAGS_enable_space_level_metrics && spaceName != "") {
     stats::StatsManager::addValue(
@@ -125,6 +137,15 @@ void QueryInstance::onFinish() {
   rctx->finish();
 
   rctx->session()->deleteQuery(qctx_.get());
+  if (cachedPlan_ != nullptr) {
+    // No executor is running now, so the context could be handed over to the next query
+    scheduler_.reset();
+    if (sentence_ != nullptr) {
+      cachedPlan_->sentence = std::move(sentence_);
+    }
+    cachedPlan_->qctx = std::move(qctx_);
+    planCache_->release(std::move(cachedPlan_));
+  }
   // The `QueryInstance' is the root node holding all resources during the
   // execution. When the whole query process is done, it's safe to release this
   // object, as long as no other contexts have chances to access these resources
@@ -196,6 +217,14 @@ void QueryInstance::onError(Status status) {
   delete this;
 }
 
+void QueryInstance::addSentenceStats(size_t num, const std::string &spaceName) const {
+  stats::StatsManager::addValue(kNumSentences, num);
+  if (FLAGS_enable_space_level_metrics && spaceName != "") {
+    stats::StatsManager::addValue(
+        stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}), num);
+  }
+}
+
 void QueryInstance::addSlowQueryStats(uint64_t latency, const std::string &spaceName) const {
   stats::StatsManager::addValue(kQueryLatencyUs, latency);
   if (FLAGS_enable_space_level_metrics && spaceName != "") {
@@ -13,6 +13,7 @@
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/Optimizer.h"
 #include "graph/scheduler/Scheduler.h"
+#include "graph/service/PlanCache.h"
 #include "parser/GQLParser.h"
 
 /**
@@ -26,7 +27,12 @@ namespace graph {
 
 class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
  public:
-  QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+  // The plan is compiled from the query unless `cachedPlan' is given, in which case `qctx' must be
+  // the context of the cached plan
+  QueryInstance(std::unique_ptr<QueryContext> qctx,
+                opt::Optimizer* optimizer,
+                PlanCache* planCache = nullptr,
+                std::unique_ptr<PlanCache::CachedPlan> cachedPlan = nullptr);
   ~QueryInstance() = default;
 
   // Entrance of the Validate, Optimize, Schedule, Execute process
@@ -54,6 +60,7 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   Status validateAndOptimize();
   // Return true if continue to execute
   bool explainOrContinue();
+  void addSentenceStats(size_t num, const std::string& spaceName) const;
   void addSlowQueryStats(uint64_t latency, const std::string& spaceName) const;
   void fillRespData(ExecutionResponse* resp);
   Status findBestPlan();
@@ -62,6 +69,11 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
+  PlanCache* planCache_{nullptr};
+  // The plan to put into the cache after a successful execution, or the plan checked out from
+  // the cache for this query
+  std::unique_ptr<PlanCache::CachedPlan> cachedPlan_;
+  bool cacheHit_{false};
 };
 
 }  // namespace graph
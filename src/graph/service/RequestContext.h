@@ -98,6 +98,15 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
     return parameterMap_;
   }
 
+  // Whether the query is a prepared statement, see GraphService::future_executePrepared
+  void setPrepared(bool prepared) {
+    prepared_ = prepared;
+  }
+
+  bool prepared() const {
+    return prepared_;
+  }
+
  private:
   time::Duration duration_;
   std::string query_;
@@ -107,6 +116,7 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
   folly::Executor* runner_{nullptr};
   GraphSessionManager* sessionMgr_{nullptr};
   std::unordered_map<std::string, Value> parameterMap_;
+  bool prepared_{false};
 };
 
 }  // namespace graph
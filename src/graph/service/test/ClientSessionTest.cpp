@@ -0,0 +1,162 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "graph/service/GraphFlags.h"
+#include "graph/session/ClientSession.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(ClientSessionTest, PreparedStatement) {
+  gflags::FlagSaver saver;
+  FLAGS_max_prepared_statements_per_session = 2;
+  auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+
+  auto stmt1 = session->addPreparedStatement("YIELD $a");
+  ASSERT_TRUE(stmt1.ok());
+  auto stmt2 = session->addPreparedStatement("YIELD $b");
+  ASSERT_TRUE(stmt2.ok());
+  EXPECT_NE(stmt1.value(), stmt2.value());
+  EXPECT_EQ(session->findPreparedStatement(stmt1.value()).value(), "YIELD $a");
+  EXPECT_EQ(session->findPreparedStatement(stmt2.value()).value(), "YIELD $b");
+
+  // Unknown statement
+  EXPECT_FALSE(session->findPreparedStatement(stmt2.value() + 1).ok());
+  // Too many statements
+  EXPECT_FALSE(session->addPreparedStatement("YIELD $c").ok());
+
+  session->deletePreparedStatement(stmt1.value());
+  EXPECT_FALSE(session->findPreparedStatement(stmt1.value()).ok());
+  // Deleting twice is fine
+  session->deletePreparedStatement(stmt1.value());
+  auto stmt3 = session->addPreparedStatement("YIELD $c");
+  ASSERT_TRUE(stmt3.ok());
+  // The id of a deallocated statement is never reused
+  EXPECT_NE(stmt3.value(), stmt1.value());
+  EXPECT_EQ(session->findPreparedStatement(stmt3.value()).value(), "YIELD $c");
+  EXPECT_EQ(session->findPreparedStatement(stmt2.value()).value(), "YIELD $b");
+}
+
+// A result of the rows [0, numRows)
+static DataSet makeResult(int64_t numRows) {
+  DataSet ds({"id", "name"});
+  for (int64_t i = 0; i < numRows; ++i) {
+    ds.rows.emplace_back(Row({i, std::string(100, 'a')}));
+  }
+  return ds;
+}
+
+// The ids of the rows in the batch
+static std::vector<int64_t> ids(const DataSet& batch) {
+  std::vector<int64_t> result;
+  for (const auto& row : batch.rows) {
+    result.emplace_back(row.values[0].getInt());
+  }
+  return result;
+}
+
+TEST(ClientSessionTest, FetchCursor) {
+  auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+  // The first 3 rows are returned by the execution
+  auto cursor = session->addCursor(makeResult(10), 3);
+  ASSERT_TRUE(cursor.ok());
+  auto bytes = session->cursorBytes();
+  EXPECT_GT(bytes, 7 * 100UL);
+
+  bool hasMore = false;
+  auto batch = session->fetchCursor(cursor.value(), 4, &hasMore);
+  ASSERT_TRUE(batch.ok());
+  EXPECT_EQ(batch.value().colNames, std::vector<std::string>({"id", "name"}));
+  EXPECT_EQ(ids(batch.value()), std::vector<int64_t>({3, 4, 5, 6}));
+  EXPECT_TRUE(hasMore);
+  EXPECT_LT(session->cursorBytes(), bytes);
+
+  // The cursor is closed with the last batch
+  batch = session->fetchCursor(cursor.value(), 4, &hasMore);
+  ASSERT_TRUE(batch.ok());
+  EXPECT_EQ(ids(batch.value()), std::vector<int64_t>({7, 8, 9}));
+  EXPECT_FALSE(hasMore);
+  EXPECT_EQ(session->cursorBytes(), 0);
+  EXPECT_FALSE(session->fetchCursor(cursor.value(), 4, &hasMore).ok());
+}
+
+TEST(ClientSessionTest, CloseCursor) {
+  auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+  bool hasMore = false;
+  // Unknown cursor
+  EXPECT_FALSE(session->fetchCursor(1, 1, &hasMore).ok());
+
+  auto cursor1 = session->addCursor(makeResult(10), 1);
+  ASSERT_TRUE(cursor1.ok());
+  auto cursor2 = session->addCursor(makeResult(10), 1);
+  ASSERT_TRUE(cursor2.ok());
+  EXPECT_NE(cursor1.value(), cursor2.value());
+
+  session->closeCursor(cursor1.value());
+  EXPECT_FALSE(session->fetchCursor(cursor1.value(), 1, &hasMore).ok());
+  // Closing twice is fine
+  session->closeCursor(cursor1.value());
+  auto batch = session->fetchCursor(cursor2.value(), 1, &hasMore);
+  ASSERT_TRUE(batch.ok());
+  EXPECT_EQ(ids(batch.value()), std::vector<int64_t>({1}));
+  EXPECT_TRUE(hasMore);
+
+  session->closeCursor(cursor2.value());
+  EXPECT_EQ(session->cursorBytes(), 0);
+}
+
+TEST(ClientSessionTest, CursorLimits) {
+  gflags::FlagSaver saver;
+  FLAGS_max_cursors_per_session = 2;
+  auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+
+  auto cursor1 = session->addCursor(makeResult(10), 1);
+  ASSERT_TRUE(cursor1.ok());
+  ASSERT_TRUE(session->addCursor(makeResult(10), 1).ok());
+  // Too many cursors, which is checked before the query is executed too
+  EXPECT_FALSE(session->checkCursorBudget().ok());
+  EXPECT_FALSE(session->addCursor(makeResult(10), 1).ok());
+  session->closeCursor(cursor1.value());
+  EXPECT_TRUE(session->checkCursorBudget().ok());
+  ASSERT_TRUE(session->addCursor(makeResult(10), 1).ok());
+
+  // Too many bytes in all cursors of the session
+  FLAGS_max_cursors_per_session = 16;
+  auto bytes = session->cursorBytes();
+  FLAGS_max_cursor_bytes_per_session = bytes + 10 * 100;
+  EXPECT_FALSE(session->addCursor(makeResult(20), 1).ok());
+  EXPECT_EQ(session->cursorBytes(), bytes);
+  // The rows fetched already are not counted
+  EXPECT_TRUE(session->addCursor(makeResult(20), 19).ok());
+  // No bytes left for another cursor
+  FLAGS_max_cursor_bytes_per_session = session->cursorBytes();
+  EXPECT_FALSE(session->checkCursorBudget().ok());
+}
+
+TEST(ClientSessionTest, ReclaimIdleCursors) {
+  gflags::FlagSaver saver;
+  FLAGS_cursor_idle_timeout_secs = 1;
+  auto session = ClientSession::create(meta::cpp2::Session(), nullptr);
+  auto cursor1 = session->addCursor(makeResult(10), 1);
+  ASSERT_TRUE(cursor1.ok());
+  auto cursor2 = session->addCursor(makeResult(10), 1);
+  ASSERT_TRUE(cursor2.ok());
+  EXPECT_EQ(session->reclaimIdleCursors(), 0);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  // The fetch keeps the cursor alive
+  bool hasMore = false;
+  ASSERT_TRUE(session->fetchCursor(cursor2.value(), 1, &hasMore).ok());
+  EXPECT_EQ(session->reclaimIdleCursors(), 1);
+  EXPECT_FALSE(session->fetchCursor(cursor1.value(), 1, &hasMore).ok());
+  EXPECT_TRUE(session->fetchCursor(cursor2.value(), 1, &hasMore).ok());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,220 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/stats/StatsManager.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/service/PlanCache.h"
+#include "graph/session/ClientSession.h"
+#include "graph/stats/GraphStats.h"
+#include "parser/GQLParser.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    session_ = ClientSession::create(meta::cpp2::Session(), nullptr);
+    SpaceInfo space;
+    space.id = 1;
+    space.name = "test_space";
+    session_->setSpace(std::move(space));
+    cache_ = std::make_unique<PlanCache>([this]() { return version_; });
+  }
+
+  std::unique_ptr<RequestContext<ExecutionResponse>> makeRequest(
+      const std::string& query, std::unordered_map<std::string, Value> params = {}) {
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setQuery(query);
+    rctx->setSession(session_);
+    rctx->setParameterMap(std::move(params));
+    rctx->setPrepared(prepared_);
+    return rctx;
+  }
+
+  // Compile the query into a plan of one Start node as the query engine does, return nullptr if
+  // the plan is not cacheable
+  std::unique_ptr<PlanCache::CachedPlan> compile(const std::string& query,
+                                                 std::unordered_map<std::string, Value> params = {},
+                                                 bool readParams = false) {
+    auto version = cache_->version();
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->setRCtx(makeRequest(query, std::move(params)));
+    auto result = GQLParser(qctx.get()).parse(query);
+    CHECK(result.ok()) << result.status();
+    auto sentence = std::move(result).value();
+    qctx->ectx()->recordReads(true);
+    if (readParams) {
+      for (auto& kv : qctx->rctx()->parameterMap()) {
+        qctx->ectx()->getValue(kv.first);
+      }
+    }
+    qctx->plan()->setRoot(StartNode::make(qctx.get()));
+    qctx->ectx()->recordReads(false);
+    auto plan = cache_->prepare(qctx.get(), sentence.get(), version);
+    if (plan != nullptr) {
+      plan->sentence = std::move(sentence);
+      plan->qctx = std::move(qctx);
+    }
+    return plan;
+  }
+
+  // Compile and cache the plan of the query
+  void cache(const std::string& query, std::unordered_map<std::string, Value> params = {}) {
+    auto plan = compile(query, std::move(params));
+    ASSERT_NE(plan, nullptr) << query;
+    cache_->release(std::move(plan));
+  }
+
+  bool hit(const std::string& query, std::unordered_map<std::string, Value> params = {}) {
+    auto rctx = makeRequest(query, std::move(params));
+    auto plan = cache_->acquire(*rctx);
+    if (plan == nullptr) {
+      return false;
+    }
+    // Put it back as the query instance does after the execution
+    plan->qctx->reset(std::move(rctx), plan->constants.get());
+    cache_->release(std::move(plan));
+    return true;
+  }
+
+  std::shared_ptr<ClientSession> session_;
+  // Whether the requests are of prepared statements
+  bool prepared_{false};
+  int64_t version_{0};
+  std::unique_ptr<PlanCache> cache_;
+};
+
+TEST_F(PlanCacheTest, HitAndMiss) {
+  gflags::FlagSaver saver;
+  FLAGS_plan_cache_capacity = 16;
+  initGraphStats();
+  auto hits = stats::StatsManager::readValue("num_plan_cache_hits.sum.60").value();
+  auto misses = stats::StatsManager::readValue("num_plan_cache_misses.sum.60").value();
+
+  EXPECT_FALSE(hit("YIELD $a + 1", {{"a", 1}}));
+  cache("YIELD $a + 1", {{"a", 1}});
+  EXPECT_EQ(cache_->size(), 1);
+  // Only the values of parameters differ
+  EXPECT_TRUE(hit("YIELD $a + 1", {{"a", 2}}));
+  EXPECT_TRUE(hit("YIELD $a + 1", {{"a", "str"}}));
+  // The names of parameters differ
+  EXPECT_FALSE(hit("YIELD $a + 1", {{"a", 1}, {"b", 2}}));
+  EXPECT_FALSE(hit("YIELD $a + 2", {{"a", 1}}));
+  // Another space
+  SpaceInfo space;
+  space.id = 2;
+  session_->setSpace(std::move(space));
+  EXPECT_FALSE(hit("YIELD $a + 1", {{"a", 1}}));
+
+  EXPECT_EQ(stats::StatsManager::readValue("num_plan_cache_hits.sum.60").value() - hits, 2);
+  EXPECT_EQ(stats::StatsManager::readValue("num_plan_cache_misses.sum.60").value() - misses, 4);
+}
+
+TEST_F(PlanCacheTest, NotCacheable) {
+  gflags::FlagSaver saver;
+  // Disabled
+  FLAGS_plan_cache_capacity = 0;
+  EXPECT_EQ(compile("YIELD 1"), nullptr);
+
+  FLAGS_plan_cache_capacity = 16;
+  EXPECT_NE(compile("YIELD $a", {{"a", 1}}), nullptr);
+  // The plan depends on the value of a parameter
+  EXPECT_EQ(compile("YIELD $a", {{"a", 1}}, true), nullptr);
+  EXPECT_EQ(compile("EXPLAIN YIELD 1"), nullptr);
+}
+
+TEST_F(PlanCacheTest, LRU) {
+  gflags::FlagSaver saver;
+  FLAGS_plan_cache_capacity = 2;
+  FLAGS_max_cached_plans_per_statement = 1;
+  cache("YIELD 1");
+  cache("YIELD 2");
+  // Touch the first one, so the second is the least recently used
+  EXPECT_TRUE(hit("YIELD 1"));
+  cache("YIELD 3");
+  EXPECT_EQ(cache_->size(), 2);
+  EXPECT_FALSE(hit("YIELD 2"));
+  EXPECT_TRUE(hit("YIELD 1"));
+  EXPECT_TRUE(hit("YIELD 3"));
+
+  // At most one idle plan is kept for a statement
+  cache("YIELD 1");
+  EXPECT_EQ(cache_->size(), 2);
+}
+
+TEST_F(PlanCacheTest, Invalidation) {
+  gflags::FlagSaver saver;
+  FLAGS_plan_cache_capacity = 16;
+  cache("YIELD 1");
+  cache("YIELD 2");
+  EXPECT_TRUE(hit("YIELD 1"));
+
+  // The schema, index or statistics changed
+  ++version_;
+  EXPECT_FALSE(hit("YIELD 1"));
+  EXPECT_FALSE(hit("YIELD 2"));
+  EXPECT_EQ(cache_->size(), 0);
+
+  // The plan compiled before the change is never cached
+  auto stale = compile("YIELD 1");
+  ASSERT_NE(stale, nullptr);
+  ++version_;
+  cache("YIELD 2");
+  cache_->release(std::move(stale));
+  EXPECT_EQ(cache_->size(), 1);
+  EXPECT_FALSE(hit("YIELD 1"));
+  EXPECT_TRUE(hit("YIELD 2"));
+}
+
+TEST_F(PlanCacheTest, PreparedStatement) {
+  gflags::FlagSaver saver;
+  // The plans of prepared statements are cached even if the cache of ad-hoc queries is disabled
+  FLAGS_plan_cache_capacity = 0;
+  FLAGS_prepared_plan_cache_capacity = 16;
+  prepared_ = true;
+  cache("YIELD $a + 1", {{"a", 1}});
+  EXPECT_TRUE(hit("YIELD $a + 1", {{"a", 2}}));
+  EXPECT_TRUE(hit("YIELD $a + 1", {{"a", 3}}));
+  prepared_ = false;
+  EXPECT_EQ(compile("YIELD $a + 1", {{"a", 1}}), nullptr);
+  EXPECT_FALSE(hit("YIELD $a + 1", {{"a", 2}}));
+
+  // Nor are they evicted by the ad-hoc queries
+  FLAGS_plan_cache_capacity = 1;
+  cache("YIELD $a + 1", {{"a", 1}});
+  cache("YIELD $a + 2", {{"a", 1}});
+  EXPECT_EQ(cache_->size(), 2);
+  prepared_ = true;
+  EXPECT_TRUE(hit("YIELD $a + 1", {{"a", 4}}));
+
+  // But by the other prepared statements
+  FLAGS_prepared_plan_cache_capacity = 1;
+  cache("YIELD $a + 3", {{"a", 1}});
+  EXPECT_FALSE(hit("YIELD $a + 1", {{"a", 4}}));
+  EXPECT_TRUE(hit("YIELD $a + 3", {{"a", 5}}));
+
+  // Or once the statement is deallocated, whatever the parameters are
+  FLAGS_prepared_plan_cache_capacity = 16;
+  cache("YIELD $a + 3", {{"a", 1}, {"b", 1}});
+  cache("YIELD $a + 4", {{"a", 1}});
+  EXPECT_EQ(cache_->size(), 4);
+  cache_->evictPrepared(session_->user(), "YIELD $a + 3");
+  EXPECT_EQ(cache_->size(), 2);
+  EXPECT_FALSE(hit("YIELD $a + 3", {{"a", 5}}));
+  EXPECT_FALSE(hit("YIELD $a + 3", {{"a", 5}, {"b", 5}}));
+  EXPECT_TRUE(hit("YIELD $a + 4", {{"a", 5}}));
+  // But not the plans of the ad-hoc queries
+  cache_->evictPrepared(session_->user(), "YIELD $a + 2");
+  EXPECT_EQ(cache_->size(), 2);
+  prepared_ = false;
+  EXPECT_TRUE(hit("YIELD $a + 2", {{"a", 4}}));
+}
+
+}  // namespace graph
+}  // namespace nebula
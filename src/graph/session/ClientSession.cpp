@@ -8,10 +8,29 @@
 #include "common/time/WallClock.h"
 #include "graph/context/QueryContext.h"
 #include "graph/stats/GraphStats.h"
+#include "graph/util/SpillFile.h"
+
+DECLARE_uint32(max_prepared_statements_per_session);
+DECLARE_uint32(max_cursors_per_session);
+DECLARE_uint64(max_cursor_bytes_per_session);
+DECLARE_uint32(cursor_idle_timeout_secs);
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// The memory taken by the rows, which is only an estimation to bound the rows kept by the cursors
+size_t estimateSize(std::vector<Row>::const_iterator begin, std::vector<Row>::const_iterator end) {
+  size_t bytes = 0;
+  for (auto iter = begin; iter != end; ++iter) {
+    bytes += SpillFile::estimateSize(*iter);
+  }
+  return bytes;
+}
+
+}  // namespace
+
 ClientSession::ClientSession(meta::cpp2::Session&& session, meta::MetaClient* metaClient) {
   session_ = std::move(session);
   metaClient_ = metaClient;
@@ -104,5 +123,134 @@ void ClientSession::markAllQueryKilled() {
         contexts_.size());
   }
 }
+
+StatusOr<int64_t> ClientSession::addPreparedStatement(std::string stmt) {
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  if (preparedStatements_.size() >= FLAGS_max_prepared_statements_per_session) {
+    return Status::Error("Too many prepared statements in session %ld, the limit is %u",
+                         session_.get_session_id(),
+                         FLAGS_max_prepared_statements_per_session);
+  }
+  auto stmtId = nextStatementId_++;
+  preparedStatements_.emplace(stmtId, std::move(stmt));
+  return stmtId;
+}
+
+StatusOr<std::string> ClientSession::findPreparedStatement(int64_t stmtId) const {
+  folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+  auto iter = preparedStatements_.find(stmtId);
+  if (iter == preparedStatements_.end()) {
+    return Status::Error("Prepared statement %ld does not exist", stmtId);
+  }
+  return iter->second;
+}
+
+void ClientSession::deletePreparedStatement(int64_t stmtId) {
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  preparedStatements_.erase(stmtId);
+}
+
+Status ClientSession::checkCursorBudget() const {
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  if (cursors_.size() >= FLAGS_max_cursors_per_session) {
+    return Status::Error("Too many cursors in session %ld, the limit is %u",
+                         id(),
+                         FLAGS_max_cursors_per_session);
+  }
+  if (cursorBytes_ >= FLAGS_max_cursor_bytes_per_session) {
+    return Status::Error(
+        "The rows not fetched in session %ld take %lu bytes, the limit is %lu, fetch or close the "
+        "open cursors",
+        id(),
+        cursorBytes_,
+        FLAGS_max_cursor_bytes_per_session);
+  }
+  return Status::OK();
+}
+
+StatusOr<int64_t> ClientSession::addCursor(DataSet data, size_t offset) {
+  auto bytes = estimateSize(data.rows.cbegin() + offset, data.rows.cend());
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  if (cursors_.size() >= FLAGS_max_cursors_per_session) {
+    return Status::Error("Too many cursors in session %ld, the limit is %u",
+                         id(),
+                         FLAGS_max_cursors_per_session);
+  }
+  if (cursorBytes_ + bytes > FLAGS_max_cursor_bytes_per_session) {
+    return Status::Error(
+        "The rows not fetched in session %ld would take %lu bytes, the limit is %lu, fetch or "
+        "close the open cursors, or use a smaller result",
+        id(),
+        cursorBytes_ + bytes,
+        FLAGS_max_cursor_bytes_per_session);
+  }
+  auto cursorId = nextCursorId_++;
+  Cursor cursor;
+  cursor.data = std::move(data);
+  cursor.offset = offset;
+  cursor.bytes = bytes;
+  cursors_.emplace(cursorId, std::move(cursor));
+  cursorBytes_ += bytes;
+  return cursorId;
+}
+
+StatusOr<DataSet> ClientSession::fetchCursor(int64_t cursorId, size_t batchSize, bool* hasMore) {
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  auto iter = cursors_.find(cursorId);
+  if (iter == cursors_.end()) {
+    return Status::Error("Cursor %ld does not exist", cursorId);
+  }
+  auto& cursor = iter->second;
+  auto& rows = cursor.data.rows;
+  auto end = std::min(rows.size(), cursor.offset + batchSize);
+  auto bytes =
+      std::min(cursor.bytes, estimateSize(rows.cbegin() + cursor.offset, rows.cbegin() + end));
+  cursor.bytes -= bytes;
+  cursorBytes_ -= bytes;
+  cursor.idleDuration.reset();
+  DataSet batch(cursor.data.colNames);
+  batch.rows.reserve(end - cursor.offset);
+  batch.rows.insert(batch.rows.end(),
+                    std::make_move_iterator(rows.begin() + cursor.offset),
+                    std::make_move_iterator(rows.begin() + end));
+  cursor.offset = end;
+  *hasMore = end < rows.size();
+  if (!*hasMore) {
+    cursorBytes_ -= cursor.bytes;
+    cursors_.erase(iter);
+  }
+  return batch;
+}
+
+void ClientSession::closeCursor(int64_t cursorId) {
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  auto iter = cursors_.find(cursorId);
+  if (iter != cursors_.end()) {
+    cursorBytes_ -= iter->second.bytes;
+    cursors_.erase(iter);
+  }
+}
+
+size_t ClientSession::reclaimIdleCursors() {
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  size_t reclaimed = 0;
+  for (auto iter = cursors_.begin(); iter != cursors_.end();) {
+    if (iter->second.idleDuration.elapsedInSec() < FLAGS_cursor_idle_timeout_secs) {
+      ++iter;
+      continue;
+    }
+    VLOG(2) << "Cursor " << iter->first << " of session " << id() << " has expired";
+    cursorBytes_ -= iter->second.bytes;
+    iter = cursors_.erase(iter);
+    ++reclaimed;
+  }
+  return reclaimed;
+}
+
+size_t ClientSession::cursorBytes() const {
+  std::lock_guard<std::mutex> lock(cursorsLock_);
+  return cursorBytes_;
+}
+
 }  // namespace graph
 }  // namespace nebula
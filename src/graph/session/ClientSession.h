@@ -160,6 +160,48 @@ class ClientSession final {
   // Marks all queries as killed.
   void markAllQueryKilled();
 
+  // Saves a prepared statement in the session.
+  // stmt: text of the statement.
+  // return: id of the statement, or an error if there are too many prepared statements.
+  StatusOr<int64_t> addPreparedStatement(std::string stmt);
+
+  // Finds a prepared statement within the session.
+  // stmtId: id of the statement.
+  StatusOr<std::string> findPreparedStatement(int64_t stmtId) const;
+
+  // Deletes a prepared statement from the session.
+  // stmtId: id of the statement.
+  void deletePreparedStatement(int64_t stmtId);
+
+  // Checks whether a cursor could be opened before the query is executed, i.e. the session has
+  // less than FLAGS_max_cursors_per_session cursors and its cursors take less than
+  // FLAGS_max_cursor_bytes_per_session.
+  Status checkCursorBudget() const;
+
+  // Keeps the rows of a result not fetched yet in a cursor of the session.
+  // data: the rows.
+  // offset: number of the rows fetched already.
+  // return: id of the cursor, or an error if there are too many cursors or the rows of all cursors
+  // of the session would take more than FLAGS_max_cursor_bytes_per_session.
+  StatusOr<int64_t> addCursor(DataSet data, size_t offset);
+
+  // Fetches the next batch of the rows of a cursor, which is closed once all rows are fetched.
+  // cursorId: id of the cursor.
+  // batchSize: maximum number of the rows fetched.
+  // hasMore: set to whether there are more rows.
+  StatusOr<DataSet> fetchCursor(int64_t cursorId, size_t batchSize, bool* hasMore);
+
+  // Closes a cursor and drops its rows.
+  // cursorId: id of the cursor.
+  void closeCursor(int64_t cursorId);
+
+  // Closes the cursors not fetched for FLAGS_cursor_idle_timeout_secs.
+  // return: number of the cursors closed.
+  size_t reclaimIdleCursors();
+
+  // Approximate bytes of the rows kept by the cursors of the session.
+  size_t cursorBytes() const;
+
  private:
   ClientSession() = default;
 
@@ -181,6 +223,27 @@ class ClientSession final {
   // An ExecutionPlanID represents a query.
   // A QueryContext also represents a query.
   std::unordered_map<ExecutionPlanID, QueryContext*> contexts_;
+  // map<statementId, statement>
+  std::unordered_map<int64_t, std::string> preparedStatements_;
+  int64_t nextStatementId_{1};
+
+  // Rows of a result to be fetched by batches
+  struct Cursor {
+    DataSet data;
+    // Number of the rows fetched, which are moved out of `data'
+    size_t offset{0};
+    // Approximate bytes of the rows not fetched yet
+    size_t bytes{0};
+    // Reset by each fetch, the cursor is closed once it's idle for FLAGS_cursor_idle_timeout_secs
+    time::Duration idleDuration;
+  };
+  // Guards the cursors only, the rows are moved while fetching
+  mutable std::mutex cursorsLock_;
+  // map<cursorId, cursor>
+  std::unordered_map<int64_t, Cursor> cursors_;
+  // Sum of the bytes of all cursors
+  size_t cursorBytes_{0};
+  int64_t nextCursorId_{1};
 };
 
 }  // namespace graph
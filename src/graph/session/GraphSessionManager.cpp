@@ -213,6 +213,8 @@ void GraphSessionManager::reclaimExpiredSessions() {
     int32_t idleSecs = iter->second->idleSeconds();
     VLOG(2) << "SessionId: " << iter->first << ", idleSecs: " << idleSecs;
     if (idleSecs < FLAGS_session_idle_timeout_secs) {
+      // The rows of the cursors abandoned by the client are dropped before the session expires
+      iter->second->reclaimIdleCursors();
       ++iter;
       continue;
     }
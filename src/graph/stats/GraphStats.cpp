@@ -29,6 +29,8 @@ stats::CounterId kNumKilledQueries;
 stats::CounterId kNumQueriesHitMemoryWatermark;
 
 stats::CounterId kOptimizerLatencyUs;
+stats::CounterId kNumPlanCacheHits;
+stats::CounterId kNumPlanCacheMisses;
 
 stats::CounterId kNumAggregateExecutors;
 stats::CounterId kNumSortExecutors;
@@ -59,6 +61,8 @@ void initGraphStats() {
 
   kOptimizerLatencyUs = stats::StatsManager::registerHisto(
       "optimizer_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+  kNumPlanCacheHits = stats::StatsManager::registerStats("num_plan_cache_hits", "rate, sum");
+  kNumPlanCacheMisses = stats::StatsManager::registerStats("num_plan_cache_misses", "rate, sum");
 
   kNumAggregateExecutors =
       stats::StatsManager::registerStats("num_aggregate_executors", "rate, sum");
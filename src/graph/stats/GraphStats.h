@@ -29,6 +29,8 @@ extern stats::CounterId kNumKilledQueries;
 extern stats::CounterId kNumQueriesHitMemoryWatermark;
 
 extern stats::CounterId kOptimizerLatencyUs;
+extern stats::CounterId kNumPlanCacheHits;
+extern stats::CounterId kNumPlanCacheMisses;
 
 // Executor
 extern stats::CounterId kNumAggregateExecutors;
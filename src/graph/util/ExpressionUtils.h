@@ -59,6 +59,18 @@ class ExpressionUtils {
   // Determines if the
   static bool checkVarExprIfExist(const Expression* expr, const QueryContext* qctx);
 
+  // Checks if the given expression writes variables into the expression context when evaluating,
+  // e.g. list comprehension, predicate, reduce and ++/--. Such expressions couldn't be evaluated
+  // by multiple threads concurrently even if each thread works on its own clone.
+  static bool writesContextVar(const Expression* expr) {
+    return hasAny(expr,
+                  {Expression::Kind::kListComprehension,
+                   Expression::Kind::kPredicate,
+                   Expression::Kind::kReduce,
+                   Expression::Kind::kUnaryIncr,
+                   Expression::Kind::kUnaryDecr});
+  }
+
   // ** Expression rewrite **
   // rewrites Attribute to LabelTagProp
   static Expression* rewriteAttr2LabelTagProp(
@@ -0,0 +1,203 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/util/SpillFile.h"
+
+#include <folly/hash/Hash.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/datatypes/ValueOps-inl.h"
+#include "common/fs/FileUtils.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+using PropMap = std::unordered_map<std::string, Value>;
+
+size_t estimateValue(const Value& v);
+
+size_t estimateProps(const PropMap& props) {
+  size_t size = 0;
+  for (auto& kv : props) {
+    size += sizeof(kv) + kv.first.size() + estimateValue(kv.second);
+  }
+  return size;
+}
+
+size_t estimateValue(const Value& v) {
+  size_t size = sizeof(Value);
+  switch (v.type()) {
+    case Value::Type::STRING:
+      size += v.getStr().size();
+      break;
+    case Value::Type::LIST:
+      size += SpillFile::estimateSize(v.getList());
+      break;
+    case Value::Type::SET:
+      for (auto& item : v.getSet().values) {
+        size += estimateValue(item);
+      }
+      break;
+    case Value::Type::MAP:
+      size += estimateProps(v.getMap().kvs);
+      break;
+    case Value::Type::VERTEX: {
+      auto& vertex = v.getVertex();
+      size += estimateValue(vertex.vid);
+      for (auto& tag : vertex.tags) {
+        size += sizeof(tag) + tag.name.size() + estimateProps(tag.props);
+      }
+      break;
+    }
+    case Value::Type::EDGE: {
+      auto& edge = v.getEdge();
+      size += sizeof(edge) + edge.name.size() + estimateProps(edge.props);
+      break;
+    }
+    case Value::Type::PATH: {
+      auto& path = v.getPath();
+      size += sizeof(path);
+      for (auto& step : path.steps) {
+        size += sizeof(step) + step.name.size() + estimateProps(step.props);
+      }
+      break;
+    }
+    case Value::Type::DATASET:
+      size += SpillFile::estimateSize(v.getDataSet().rows);
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
+}  // namespace
+
+SpillFile::~SpillFile() {
+  if (stream_.is_open()) {
+    stream_.close();
+  }
+}
+
+Status SpillFile::open() {
+  auto path = fs::FileUtils::joinPath(FLAGS_spill_tmp_dir, "nebula-spill.XXXXXX");
+  try {
+    file_ = std::make_unique<fs::TempFile>(path.c_str());
+  } catch (const std::exception& e) {
+    return Status::Error("Failed to create spill file: %s", e.what());
+  }
+  stream_.open(file_->path(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream_.is_open()) {
+    return Status::Error("Failed to open spill file: %s", file_->path());
+  }
+  return Status::OK();
+}
+
+Status SpillFile::append(const Row& row) {
+  buffer_.clear();
+  apache::thrift::CompactSerializer::serialize(row, &buffer_);
+  uint32_t len = buffer_.size();
+  stream_.write(reinterpret_cast<const char*>(&len), sizeof(len));
+  stream_.write(buffer_.data(), len);
+  if (UNLIKELY(!stream_.good())) {
+    return Status::Error("Failed to write spill file: %s", file_->path());
+  }
+  ++numRows_;
+  bytes_ += sizeof(len) + len;
+  return Status::OK();
+}
+
+Status SpillFile::rewind() {
+  stream_.flush();
+  stream_.clear();
+  stream_.seekg(0);
+  if (UNLIKELY(!stream_.good())) {
+    return Status::Error("Failed to rewind spill file: %s", file_->path());
+  }
+  numRowsRead_ = 0;
+  return Status::OK();
+}
+
+Status SpillFile::next(Row* row) {
+  DCHECK(hasNext());
+  uint32_t len = 0;
+  stream_.read(reinterpret_cast<char*>(&len), sizeof(len));
+  buffer_.resize(len);
+  stream_.read(&buffer_[0], len);
+  if (UNLIKELY(!stream_.good())) {
+    return Status::Error("Failed to read spill file: %s", file_->path());
+  }
+  row->clear();
+  apache::thrift::CompactSerializer::deserialize(buffer_, *row);
+  ++numRowsRead_;
+  return Status::OK();
+}
+
+Status SpillFile::readAll(std::vector<Row>* rows) {
+  NG_RETURN_IF_ERROR(rewind());
+  rows->clear();
+  rows->reserve(numRows_);
+  while (hasNext()) {
+    rows->emplace_back();
+    NG_RETURN_IF_ERROR(next(&rows->back()));
+  }
+  return Status::OK();
+}
+
+// static
+StatusOr<std::vector<std::unique_ptr<SpillFile>>> SpillFile::makePartitions(size_t bytes) {
+  DCHECK_GT(FLAGS_query_memory_budget_bytes, 0);
+  auto budget = static_cast<size_t>(FLAGS_query_memory_budget_bytes);
+  auto numPartitions = std::max<size_t>((bytes + budget - 1) / budget, 2);
+  numPartitions = std::min(numPartitions, kMaxNumPartitions);
+  std::vector<std::unique_ptr<SpillFile>> partitions;
+  partitions.reserve(numPartitions);
+  for (size_t i = 0; i < numPartitions; ++i) {
+    auto file = std::make_unique<SpillFile>();
+    NG_RETURN_IF_ERROR(file->open());
+    partitions.emplace_back(std::move(file));
+  }
+  return partitions;
+}
+
+// static
+size_t SpillFile::partitionOf(size_t hash, size_t numPartitions) {
+  return folly::hash::twang_mix64(hash) % numPartitions;
+}
+
+// static
+bool SpillFile::exceedsBudget(size_t bytes) {
+  return FLAGS_query_memory_budget_bytes > 0 &&
+         bytes > static_cast<size_t>(FLAGS_query_memory_budget_bytes);
+}
+
+// static
+size_t SpillFile::estimateSize(const Row& row) {
+  size_t size = sizeof(Row);
+  for (auto& v : row.values) {
+    size += estimateValue(v);
+  }
+  return size;
+}
+
+// static
+size_t SpillFile::estimateSize(const std::vector<Row>& rows) {
+  if (rows.empty()) {
+    return 0;
+  }
+  auto step = std::max<size_t>(rows.size() / kNumSamples, 1);
+  size_t numSamples = 0;
+  size_t size = 0;
+  for (size_t i = 0; i < rows.size(); i += step) {
+    size += estimateSize(rows[i]);
+    ++numSamples;
+  }
+  return size / numSamples * rows.size();
+}
+
+}  // namespace graph
+}  // namespace nebula
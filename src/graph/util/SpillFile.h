@@ -0,0 +1,86 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_SPILLFILE_H_
+#define GRAPH_UTIL_SPILLFILE_H_
+
+#include <fstream>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/DataSet.h"
+#include "common/fs/TempFile.h"
+
+namespace nebula {
+namespace graph {
+
+// A temporary file under `spill_tmp_dir' which keeps the rows spilled by an operator once the
+// rows it buffers exceed `query_memory_budget_bytes'.
+//
+// Rows are appended in the write phase and read back sequentially in the same order after
+// `rewind', each of them is serialized by the thrift compact protocol with a length prefix.
+// The file is removed on destruction.
+class SpillFile final {
+ public:
+  SpillFile() = default;
+  ~SpillFile();
+
+  // Create the temporary file
+  Status open();
+
+  Status append(const Row& row);
+
+  // Flush the written rows and seek to the first one
+  Status rewind();
+
+  bool hasNext() const {
+    return numRowsRead_ < numRows_;
+  }
+
+  // Read the next row, REQUIRES: hasNext()
+  Status next(Row* row);
+
+  // Read all rows from the first one
+  Status readAll(std::vector<Row>* rows);
+
+  size_t numRows() const {
+    return numRows_;
+  }
+
+  // Bytes written to disk
+  size_t bytes() const {
+    return bytes_;
+  }
+
+  // Whether the rows exceed the memory budget of a query, always false if the budget is 0
+  static bool exceedsBudget(size_t bytes);
+
+  // Rough estimation of the memory held by a row
+  static size_t estimateSize(const Row& row);
+
+  // Estimate the memory held by the rows by sampling at most `kNumSamples' of them
+  static size_t estimateSize(const std::vector<Row>& rows);
+
+  // Create the spill files of the grace hash algorithms, which scatter the `bytes' of rows into
+  // partitions by the hash of keys and process one partition at a time
+  static StatusOr<std::vector<std::unique_ptr<SpillFile>>> makePartitions(size_t bytes);
+
+  static size_t partitionOf(size_t hash, size_t numPartitions);
+
+  static constexpr size_t kNumSamples = 1024;
+  static constexpr size_t kMaxNumPartitions = 256;
+
+ private:
+  std::unique_ptr<fs::TempFile> file_;
+  std::fstream stream_;
+  std::string buffer_;
+  size_t numRows_{0};
+  size_t numRowsRead_{0};
+  size_t bytes_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_SPILLFILE_H_
@@ -0,0 +1,196 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_UTIL_VIDBITMAP_H_
+#define GRAPH_UTIL_VIDBITMAP_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace graph {
+
+// Roaring style compressed bitmap of the int64 vids.
+//
+// The vids are partitioned into chunks by the high 48 bits. The low 16 bits of the vids of a
+// chunk are kept in a sorted array if there are at most 4096 of them, otherwise in a bitmap of
+// 65536 bits. So it costs about 2 bytes a vid in the sparse chunks and 1 bit a vid in the dense
+// ones, and the intersection of two bitmaps is computed chunk by chunk with the words of bits.
+class VidBitmap final {
+ public:
+  // Return false if the vid is in the bitmap already
+  bool add(int64_t vid) {
+    if (containers_[high(vid)].add(low(vid))) {
+      ++size_;
+      return true;
+    }
+    return false;
+  }
+
+  bool contains(int64_t vid) const {
+    auto iter = containers_.find(high(vid));
+    return iter != containers_.end() && iter->second.contains(low(vid));
+  }
+
+  // The bitmap grows by chunks, nothing to reserve
+  void reserve(size_t) {}
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  void clear() {
+    containers_.clear();
+    size_ = 0;
+  }
+
+  // Call `f(vid)' of each vid in the bitmap
+  template <typename F>
+  void forEach(F&& f) const {
+    for (auto& it : containers_) {
+      it.second.forEach([&f, h = it.first](uint16_t l) { f(vid(h, l)); });
+    }
+  }
+
+  // Call `f(vid)' of each vid in both bitmaps
+  template <typename F>
+  void forEachIntersection(const VidBitmap& other, F&& f) const {
+    const auto& smaller = containers_.size() <= other.containers_.size() ? *this : other;
+    const auto& larger = &smaller == this ? other : *this;
+    for (auto& it : smaller.containers_) {
+      auto found = larger.containers_.find(it.first);
+      if (found != larger.containers_.end()) {
+        it.second.intersect(found->second, [&f, h = it.first](uint16_t l) { f(vid(h, l)); });
+      }
+    }
+  }
+
+ private:
+  // The low 16 bits of the vids of a chunk
+  class Container final {
+   public:
+    bool add(uint16_t low) {
+      if (bits_.empty()) {
+        auto iter = std::lower_bound(array_.begin(), array_.end(), low);
+        if (iter != array_.end() && *iter == low) {
+          return false;
+        }
+        if (array_.size() < kMaxArraySize) {
+          array_.insert(iter, low);
+          return true;
+        }
+        toBitmap();
+      }
+      auto& word = bits_[low >> 6];
+      uint64_t mask = 1UL << (low & 63);
+      if (word & mask) {
+        return false;
+      }
+      word |= mask;
+      return true;
+    }
+
+    bool contains(uint16_t low) const {
+      if (bits_.empty()) {
+        return std::binary_search(array_.begin(), array_.end(), low);
+      }
+      return bits_[low >> 6] & (1UL << (low & 63));
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+      if (bits_.empty()) {
+        for (auto low : array_) {
+          f(low);
+        }
+        return;
+      }
+      for (size_t i = 0; i < kNumWords; ++i) {
+        forEachBit(i, bits_[i], f);
+      }
+    }
+
+    template <typename F>
+    void intersect(const Container& other, F&& f) const {
+      if (!bits_.empty() && !other.bits_.empty()) {
+        for (size_t i = 0; i < kNumWords; ++i) {
+          forEachBit(i, bits_[i] & other.bits_[i], f);
+        }
+      } else if (bits_.empty() && other.bits_.empty()) {
+        // Merge the sorted arrays
+        auto i = array_.begin(), j = other.array_.begin();
+        while (i != array_.end() && j != other.array_.end()) {
+          if (*i < *j) {
+            ++i;
+          } else if (*j < *i) {
+            ++j;
+          } else {
+            f(*i);
+            ++i;
+            ++j;
+          }
+        }
+      } else {
+        const auto& array = bits_.empty() ? *this : other;
+        const auto& bitmap = bits_.empty() ? other : *this;
+        for (auto low : array.array_) {
+          if (bitmap.contains(low)) {
+            f(low);
+          }
+        }
+      }
+    }
+
+   private:
+    // An array of more low bits costs more than the bitmap
+    static constexpr size_t kMaxArraySize = 4096;
+    static constexpr size_t kNumWords = 65536 / 64;
+
+    template <typename F>
+    static void forEachBit(size_t i, uint64_t word, F&& f) {
+      while (word != 0) {
+        f(static_cast<uint16_t>(i * 64 + __builtin_ctzll(word)));
+        word &= word - 1;
+      }
+    }
+
+    void toBitmap() {
+      bits_.assign(kNumWords, 0);
+      for (auto low : array_) {
+        bits_[low >> 6] |= 1UL << (low & 63);
+      }
+      array_.clear();
+      array_.shrink_to_fit();
+    }
+
+    // Sorted low bits if the chunk is sparse
+    std::vector<uint16_t> array_;
+    // Bitmap of the low bits if the chunk is dense
+    std::vector<uint64_t> bits_;
+  };
+
+  static uint64_t high(int64_t vid) {
+    return static_cast<uint64_t>(vid) >> 16;
+  }
+
+  static uint16_t low(int64_t vid) {
+    return static_cast<uint16_t>(vid & 0xFFFF);
+  }
+
+  static int64_t vid(uint64_t high, uint16_t low) {
+    return static_cast<int64_t>((high << 16) | low);
+  }
+
+  std::unordered_map<uint64_t, Container> containers_;
+  size_t size_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_VIDBITMAP_H_
@@ -0,0 +1,473 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_UTIL_VIDSET_H_
+#define GRAPH_UTIL_VIDSET_H_
+
+#include <cstring>
+
+#include <folly/Range.h>
+#include <folly/hash/Hash.h>
+#include <folly/hash/SpookyHashV2.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "graph/util/VidBitmap.h"
+#include "interface/gen-cpp2/meta_types.h"
+
+namespace nebula {
+namespace graph {
+namespace detail {
+
+// Keys of the int64 vids
+class Int64Keys final {
+ public:
+  using Arg = int64_t;
+
+  static uint64_t hash(int64_t key) {
+    // std::hash of integers is the identity, which clusters the sequential vids
+    return folly::hash::twang_mix64(static_cast<uint64_t>(key));
+  }
+
+  Int64Keys emptyLike() const {
+    return Int64Keys();
+  }
+
+  void resize(size_t capacity) {
+    keys_.assign(capacity, 0);
+    used_.assign(capacity, 0);
+  }
+
+  bool used(size_t i) const {
+    return used_[i] != 0;
+  }
+
+  bool equal(size_t i, int64_t key) const {
+    return keys_[i] == key;
+  }
+
+  void store(size_t i, int64_t key) {
+    keys_[i] = key;
+    used_[i] = 1;
+  }
+
+  int64_t key(size_t i) const {
+    return keys_[i];
+  }
+
+ private:
+  std::vector<int64_t> keys_;
+  std::vector<uint8_t> used_;
+};
+
+// Keys of the fixed string vids, which are kept inline in the slots of the vid length
+class FixedStringKeys final {
+ public:
+  using Arg = folly::StringPiece;
+
+  explicit FixedStringKeys(size_t width = 0) : width_(width) {}
+
+  static uint64_t hash(folly::StringPiece key) {
+    return folly::hash::SpookyHashV2::Hash64(key.data(), key.size(), 0);
+  }
+
+  FixedStringKeys emptyLike() const {
+    return FixedStringKeys(width_);
+  }
+
+  size_t width() const {
+    return width_;
+  }
+
+  void resize(size_t capacity) {
+    bytes_.assign(capacity * width_, '\0');
+    lens_.assign(capacity, 0);
+  }
+
+  bool used(size_t i) const {
+    return lens_[i] != 0;
+  }
+
+  bool equal(size_t i, folly::StringPiece key) const {
+    return lens_[i] == key.size() + 1 &&
+           std::memcmp(&bytes_[i * width_], key.data(), key.size()) == 0;
+  }
+
+  void store(size_t i, folly::StringPiece key) {
+    DCHECK_LE(key.size(), width_);
+    std::memcpy(&bytes_[i * width_], key.data(), key.size());
+    lens_[i] = key.size() + 1;
+  }
+
+  folly::StringPiece key(size_t i) const {
+    return folly::StringPiece(bytes_.data() + i * width_, lens_[i] - 1);
+  }
+
+ private:
+  size_t width_{0};
+  std::vector<char> bytes_;
+  // Length of the key plus 1 of each slot, 0 if the slot is empty
+  std::vector<uint32_t> lens_;
+};
+
+struct Empty {};
+
+// Open addressing hash table with linear probing, the capacity is a power of 2 and at most 7/8
+// of the slots are used
+template <typename Keys, typename Mapped>
+class FlatHashTable final {
+ public:
+  using Arg = typename Keys::Arg;
+
+  explicit FlatHashTable(Keys keys = Keys()) : keys_(std::move(keys)) {}
+
+  // Insert the key if it's not in the table, return the mapped of the key and whether it's
+  // inserted
+  std::pair<Mapped*, bool> emplace(Arg key, Mapped mapped = Mapped()) {
+    if ((size_ + 1) * 8 > capacity() * 7) {
+      rehash(std::max<size_t>(kMinCapacity, capacity() * 2));
+    }
+    auto i = probe(key);
+    if (keys_.used(i)) {
+      return {&values_[i], false};
+    }
+    keys_.store(i, key);
+    values_[i] = std::move(mapped);
+    ++size_;
+    return {&values_[i], true};
+  }
+
+  Mapped* find(Arg key) {
+    return const_cast<Mapped*>(static_cast<const FlatHashTable*>(this)->find(key));
+  }
+
+  const Mapped* find(Arg key) const {
+    if (size_ == 0) {
+      return nullptr;
+    }
+    auto i = probe(key);
+    return keys_.used(i) ? &values_[i] : nullptr;
+  }
+
+  void reserve(size_t size) {
+    size_t capacity = kMinCapacity;
+    while (size * 8 > capacity * 7) {
+      capacity *= 2;
+    }
+    if (capacity > this->capacity()) {
+      rehash(capacity);
+    }
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  const Keys& keys() const {
+    return keys_;
+  }
+
+  void clear() {
+    keys_ = keys_.emptyLike();
+    values_.clear();
+    size_ = 0;
+  }
+
+  // Call `f(key, mapped)' of each key in the table
+  template <typename F>
+  void forEach(F&& f) const {
+    for (size_t i = 0; i < capacity(); ++i) {
+      if (keys_.used(i)) {
+        f(keys_.key(i), values_[i]);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 16;
+
+  size_t capacity() const {
+    return values_.size();
+  }
+
+  // The slot of the key, or the empty one to insert it
+  size_t probe(Arg key) const {
+    size_t mask = capacity() - 1;
+    for (size_t i = Keys::hash(key) & mask;; i = (i + 1) & mask) {
+      if (!keys_.used(i) || keys_.equal(i, key)) {
+        return i;
+      }
+    }
+  }
+
+  void rehash(size_t capacity) {
+    auto oldKeys = std::move(keys_);
+    auto oldValues = std::move(values_);
+    size_t oldCapacity = oldValues.size();
+    keys_ = oldKeys.emptyLike();
+    keys_.resize(capacity);
+    values_.clear();
+    values_.resize(capacity);
+    for (size_t i = 0; i < oldCapacity; ++i) {
+      if (oldKeys.used(i)) {
+        auto j = probe(oldKeys.key(i));
+        keys_.store(j, oldKeys.key(i));
+        values_[j] = std::move(oldValues[i]);
+      }
+    }
+  }
+
+  Keys keys_;
+  std::vector<Mapped> values_;
+  size_t size_{0};
+};
+
+// Set of the int64 vids in the flat hash table
+class Int64Set final {
+ public:
+  // Return false if the vid is in the set already
+  bool add(int64_t vid) {
+    return table_.emplace(vid).second;
+  }
+
+  bool contains(int64_t vid) const {
+    return table_.find(vid) != nullptr;
+  }
+
+  // Call `f(vid)' of each vid in both sets, the larger one is probed with the smaller one
+  template <typename F>
+  void forEachIntersection(const Int64Set& other, F&& f) const {
+    const auto& smaller = size() <= other.size() ? *this : other;
+    const auto& larger = &smaller == this ? other : *this;
+    smaller.table_.forEach([&larger, &f](int64_t vid, const Empty&) {
+      if (larger.contains(vid)) {
+        f(vid);
+      }
+    });
+  }
+
+  void reserve(size_t size) {
+    table_.reserve(size);
+  }
+
+  size_t size() const {
+    return table_.size();
+  }
+
+  void clear() {
+    table_.clear();
+  }
+
+ private:
+  FlatHashTable<Int64Keys, Empty> table_;
+};
+
+// The tables of the vids of a space shared by VidMap and BasicVidSet. The vids of the vid type
+// of the space are kept in `IntTable' or `StrTable', which is selected once when it's
+// constructed, and the other ones in `OtherTable'.
+template <typename IntTable, typename StrTable, typename OtherTable>
+class VidTables {
+ public:
+  void reserve(size_t size) {
+    switch (kind_) {
+      case Kind::kInt:
+        ints_.reserve(size);
+        break;
+      case Kind::kFixedString:
+        strs_.reserve(size);
+        break;
+      default:
+        others_.reserve(size);
+    }
+  }
+
+  size_t size() const {
+    return ints_.size() + strs_.size() + others_.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void clear() {
+    ints_.clear();
+    strs_.clear();
+    others_.clear();
+  }
+
+ protected:
+  enum class Kind : uint8_t {
+    kValue,
+    kInt,
+    kFixedString,
+  };
+
+  VidTables() = default;
+
+  explicit VidTables(const meta::cpp2::ColumnTypeDef& vidType) {
+    if (vidType.get_type() == nebula::cpp2::PropertyType::INT64) {
+      kind_ = Kind::kInt;
+    } else if (vidType.get_type() == nebula::cpp2::PropertyType::FIXED_STRING) {
+      kind_ = Kind::kFixedString;
+      strs_ = StrTable(FixedStringKeys(*vidType.type_length_ref()));
+    }
+  }
+
+  bool isInt(const Value& vid) const {
+    return kind_ == Kind::kInt && vid.isInt();
+  }
+
+  bool isFixedString(const Value& vid) const {
+    return kind_ == Kind::kFixedString && vid.isStr() &&
+           vid.getStr().size() <= strs_.keys().width();
+  }
+
+  Kind kind_{Kind::kValue};
+  IntTable ints_;
+  StrTable strs_;
+  OtherTable others_;
+};
+
+}  // namespace detail
+
+// Map of the vids of a space. The vids are kept in the flat hash table specialized for the vid
+// type of the space, which is selected once when the map is constructed, rather than being hashed
+// and compared as Value. The ones not of the vid type, e.g. the invalid ones, are kept as Value,
+// so it works the same as std::unordered_map<Value, T> with any key.
+template <typename T>
+class VidMap final : public detail::VidTables<detail::FlatHashTable<detail::Int64Keys, T>,
+                                              detail::FlatHashTable<detail::FixedStringKeys, T>,
+                                              std::unordered_map<Value, T>> {
+  using Base = detail::VidTables<detail::FlatHashTable<detail::Int64Keys, T>,
+                                 detail::FlatHashTable<detail::FixedStringKeys, T>,
+                                 std::unordered_map<Value, T>>;
+
+ public:
+  // A map of Value if the vid type is not given
+  VidMap() = default;
+
+  explicit VidMap(const meta::cpp2::ColumnTypeDef& vidType) : Base(vidType) {}
+
+  // Insert the vid if it's not in the map, return the mapped of it and whether it's inserted
+  std::pair<T*, bool> emplace(const Value& vid, T mapped = T()) {
+    if (this->isInt(vid)) {
+      return this->ints_.emplace(vid.getInt(), std::move(mapped));
+    }
+    if (this->isFixedString(vid)) {
+      return this->strs_.emplace(vid.getStr(), std::move(mapped));
+    }
+    auto result = this->others_.emplace(vid, std::move(mapped));
+    return {&result.first->second, result.second};
+  }
+
+  T& operator[](const Value& vid) {
+    return *emplace(vid).first;
+  }
+
+  T* find(const Value& vid) {
+    return const_cast<T*>(static_cast<const VidMap*>(this)->find(vid));
+  }
+
+  const T* find(const Value& vid) const {
+    if (this->isInt(vid)) {
+      return this->ints_.find(vid.getInt());
+    }
+    if (this->isFixedString(vid)) {
+      return this->strs_.find(vid.getStr());
+    }
+    auto iter = this->others_.find(vid);
+    return iter == this->others_.end() ? nullptr : &iter->second;
+  }
+
+  bool contains(const Value& vid) const {
+    return find(vid) != nullptr;
+  }
+
+  // Insert the vids of `other' which are not in the map, they must have the same vid type
+  void merge(const VidMap& other) {
+    DCHECK(this->kind_ == other.kind_);
+    other.ints_.forEach(
+        [this](int64_t vid, const T& mapped) { this->ints_.emplace(vid, mapped); });
+    other.strs_.forEach(
+        [this](folly::StringPiece vid, const T& mapped) { this->strs_.emplace(vid, mapped); });
+    this->others_.insert(other.others_.begin(), other.others_.end());
+  }
+};
+
+// Set of the vids of a space, see VidMap. `IntSet' keeps the int vids, which is the flat hash
+// table of VidSet, or the compressed bitmap of VidBitmapSet.
+template <typename IntSet>
+class BasicVidSet final
+    : public detail::VidTables<IntSet,
+                               detail::FlatHashTable<detail::FixedStringKeys, detail::Empty>,
+                               std::unordered_set<Value>> {
+  using Base = detail::VidTables<IntSet,
+                                 detail::FlatHashTable<detail::FixedStringKeys, detail::Empty>,
+                                 std::unordered_set<Value>>;
+
+ public:
+  BasicVidSet() = default;
+
+  explicit BasicVidSet(const meta::cpp2::ColumnTypeDef& vidType) : Base(vidType) {}
+
+  // Return false if the vid is in the set already
+  bool emplace(const Value& vid) {
+    if (this->isInt(vid)) {
+      return this->ints_.add(vid.getInt());
+    }
+    if (this->isFixedString(vid)) {
+      return this->strs_.emplace(vid.getStr()).second;
+    }
+    return this->others_.emplace(vid).second;
+  }
+
+  bool contains(const Value& vid) const {
+    if (this->isInt(vid)) {
+      return this->ints_.contains(vid.getInt());
+    }
+    if (this->isFixedString(vid)) {
+      return this->strs_.find(vid.getStr()) != nullptr;
+    }
+    return this->others_.find(vid) != this->others_.end();
+  }
+
+  // The vids in both sets, they must have the same vid type
+  std::vector<Value> intersect(const BasicVidSet& other) const {
+    DCHECK(this->kind_ == other.kind_);
+    std::vector<Value> vids;
+    this->ints_.forEachIntersection(other.ints_,
+                                    [&vids](int64_t vid) { vids.emplace_back(vid); });
+    // Probe the larger one with the smaller one
+    const auto& strs = this->strs_;
+    const auto& smallerStrs = strs.size() <= other.strs_.size() ? strs : other.strs_;
+    const auto& largerStrs = &smallerStrs == &strs ? other.strs_ : strs;
+    smallerStrs.forEach([&](folly::StringPiece vid, const detail::Empty&) {
+      if (largerStrs.find(vid) != nullptr) {
+        vids.emplace_back(vid.str());
+      }
+    });
+    const auto& others = this->others_;
+    const auto& smallerOthers = others.size() <= other.others_.size() ? others : other.others_;
+    const auto& largerOthers = &smallerOthers == &others ? other.others_ : others;
+    for (auto& vid : smallerOthers) {
+      if (largerOthers.find(vid) != largerOthers.end()) {
+        vids.emplace_back(vid);
+      }
+    }
+    return vids;
+  }
+};
+
+using VidSet = BasicVidSet<detail::Int64Set>;
+
+// The int vids are kept in the compressed bitmap, which is smaller than the hash table and
+// intersected chunk by chunk when the vids are clustered, e.g. the visited and frontier vids of
+// the shortest path. It costs more than VidSet for the sparse or hashed vids.
+using VidBitmapSet = BasicVidSet<VidBitmap>;
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_VIDSET_H_
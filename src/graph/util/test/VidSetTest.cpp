@@ -0,0 +1,197 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/util/VidSet.h"
+
+namespace nebula {
+namespace graph {
+
+static meta::cpp2::ColumnTypeDef vidType(nebula::cpp2::PropertyType type, int16_t len = 0) {
+  meta::cpp2::ColumnTypeDef def;
+  def.type_ref() = type;
+  if (len > 0) {
+    def.type_length_ref() = len;
+  }
+  return def;
+}
+
+TEST(VidSetTest, Int) {
+  VidSet set(vidType(nebula::cpp2::PropertyType::INT64));
+  // Grows many times
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(set.emplace(i * 1024));
+  }
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_FALSE(set.emplace(i * 1024));
+    EXPECT_TRUE(set.contains(i * 1024));
+    EXPECT_FALSE(set.contains(i * 1024 + 1));
+  }
+  EXPECT_EQ(10000, set.size());
+
+  // Not of the vid type
+  EXPECT_TRUE(set.emplace("1024"));
+  EXPECT_FALSE(set.emplace("1024"));
+  EXPECT_TRUE(set.emplace(Value::kNullValue));
+  EXPECT_TRUE(set.contains("1024"));
+  EXPECT_EQ(10002, set.size());
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_TRUE(set.emplace(0));
+}
+
+TEST(VidSetTest, FixedString) {
+  VidSet set(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8));
+  set.reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(set.emplace(folly::to<std::string>(i)));
+  }
+  EXPECT_TRUE(set.emplace(""));
+  EXPECT_FALSE(set.emplace(""));
+  EXPECT_TRUE(set.emplace("12345678"));
+  // Longer than the vid length
+  EXPECT_TRUE(set.emplace("123456789"));
+  EXPECT_FALSE(set.emplace("123456789"));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(set.contains(folly::to<std::string>(i)));
+    EXPECT_FALSE(set.contains(folly::to<std::string>(i) + "x"));
+  }
+  EXPECT_FALSE(set.contains(1));
+  EXPECT_EQ(1003, set.size());
+}
+
+TEST(VidSetTest, Bitmap) {
+  VidBitmap bitmap;
+  // Dense chunk turned to the bitmap, sparse chunks of the arrays and the negative ones
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(bitmap.add(i));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(bitmap.add(i << 20));
+    EXPECT_TRUE(bitmap.add(-i - 1));
+  }
+  EXPECT_FALSE(bitmap.add(4095));
+  EXPECT_FALSE(bitmap.add(1 << 20));
+  EXPECT_FALSE(bitmap.add(-1));
+  EXPECT_EQ(10199, bitmap.size());
+  EXPECT_TRUE(bitmap.contains(9999));
+  EXPECT_FALSE(bitmap.contains(10000));
+  EXPECT_TRUE(bitmap.contains(-100));
+  EXPECT_FALSE(bitmap.contains(-101));
+  EXPECT_FALSE(bitmap.contains((1 << 20) + 1));
+
+  size_t count = 0;
+  bitmap.forEach([&](int64_t vid) {
+    EXPECT_TRUE(bitmap.contains(vid));
+    ++count;
+  });
+  EXPECT_EQ(bitmap.size(), count);
+
+  VidBitmap other;
+  for (int64_t i = 9990; i < 20000; ++i) {
+    other.add(i);
+  }
+  other.add(5 << 20);
+  other.add(-50);
+  std::set<int64_t> both;
+  bitmap.forEachIntersection(other, [&](int64_t vid) { both.emplace(vid); });
+  std::set<int64_t> expected = {-50, 5 << 20};
+  for (int64_t i = 9990; i < 10000; ++i) {
+    expected.emplace(i);
+  }
+  EXPECT_EQ(expected, both);
+
+  bitmap.clear();
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_FALSE(bitmap.contains(0));
+}
+
+template <typename Set>
+static void testIntersect() {
+  Set left(vidType(nebula::cpp2::PropertyType::INT64));
+  Set right(vidType(nebula::cpp2::PropertyType::INT64));
+  for (int64_t i = 0; i < 100; ++i) {
+    left.emplace(i);
+    right.emplace(i + 90);
+  }
+  left.emplace("a");
+  right.emplace("a");
+  auto vids = left.intersect(right);
+  std::sort(vids.begin(), vids.end());
+  std::vector<Value> expected;
+  for (int64_t i = 90; i < 100; ++i) {
+    expected.emplace_back(i);
+  }
+  expected.emplace_back("a");
+  EXPECT_EQ(expected, vids);
+
+  Set leftStrs(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8));
+  Set rightStrs(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8));
+  leftStrs.emplace("a");
+  leftStrs.emplace("b");
+  rightStrs.emplace("b");
+  rightStrs.emplace("c");
+  EXPECT_EQ(std::vector<Value>{"b"}, leftStrs.intersect(rightStrs));
+  EXPECT_TRUE(
+      leftStrs.intersect(Set(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8))).empty());
+}
+
+TEST(VidSetTest, Intersect) {
+  testIntersect<VidSet>();
+  testIntersect<VidBitmapSet>();
+}
+
+TEST(VidSetTest, BitmapSet) {
+  VidBitmapSet set(vidType(nebula::cpp2::PropertyType::INT64));
+  set.reserve(100);
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(set.emplace(i));
+  }
+  EXPECT_FALSE(set.emplace(9999));
+  EXPECT_TRUE(set.emplace(-1));
+  EXPECT_TRUE(set.emplace("1"));
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_TRUE(set.contains(-1));
+  EXPECT_FALSE(set.contains(10000));
+  EXPECT_TRUE(set.contains("1"));
+  EXPECT_EQ(10002, set.size());
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(VidSetTest, Map) {
+  VidMap<int64_t> map(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8));
+  EXPECT_TRUE(map.emplace("a", 1).second);
+  EXPECT_FALSE(map.emplace("a", 2).second);
+  EXPECT_EQ(1, *map.find("a"));
+  map["b"] = 3;
+  EXPECT_EQ(3, *map.find("b"));
+  EXPECT_EQ(nullptr, map.find("c"));
+
+  VidMap<int64_t> other(vidType(nebula::cpp2::PropertyType::FIXED_STRING, 8));
+  other.emplace("a", 10);
+  other.emplace("c", 11);
+  other.emplace("123456789", 12);
+  map.merge(other);
+  EXPECT_EQ(4, map.size());
+  // The existing ones are kept
+  EXPECT_EQ(1, *map.find("a"));
+  EXPECT_EQ(11, *map.find("c"));
+  EXPECT_EQ(12, *map.find("123456789"));
+
+  // Without the vid type
+  VidMap<int64_t> values;
+  values[Value(1)] = 1;
+  values[Value("1")] = 2;
+  EXPECT_EQ(1, *values.find(1));
+  EXPECT_EQ(2, *values.find("1"));
+  EXPECT_EQ(2, values.size());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -104,6 +104,32 @@ struct VerifyClientVersionResp {
 }
 
 
+struct PrepareResp {
+    1: required common.ErrorCode error_code;
+    2: optional binary           error_msg;
+    // Id of the prepared statement in the session
+    3: optional i64              statement_id;
+}
+
+
+struct CursorResponse {
+    // Response of the statement, with the first batch of the rows in `data'
+    1: required ExecutionResponse response;
+    // Id of the cursor to fetch the following rows, absent if all rows are in the response
+    2: optional i64               cursor_id;
+} (cpp.noncopyable)
+
+
+struct FetchResp {
+    1: required common.ErrorCode error_code;
+    2: optional binary           error_msg;
+    // Next batch of the rows
+    3: optional common.DataSet   data;
+    // Whether there are more rows, the cursor is closed once all rows are fetched
+    4: optional bool             has_more;
+}
+
+
 struct VerifyClientVersionReq {
     1: required binary version = common.version;
 }
@@ -119,6 +145,23 @@ service GraphService {
     // Same as execute(), but response will be a json string
     binary executeJson(1: i64 sessionId, 2: binary stmt)
     binary executeJsonWithParameter(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
+
+    // Save a statement in the session, which is executed later by its id
+    PrepareResp prepare(1: i64 sessionId, 2: binary stmt)
+    ExecutionResponse executePrepared(1: i64 sessionId, 2: i64 statementId, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
+    void deallocatePrepared(1: i64 sessionId, 2: i64 statementId)
+
+    // Same as executeWithParameter(), but only the first `batchSize' rows are in the response,
+    // and the following ones are kept in a cursor of the session to be fetched by fetchNext().
+    // A cursor not fetched for cursor_idle_timeout_secs is closed.
+    // The result is still fully materialized in graphd before the first batch is returned, the
+    // cursor only bounds the rows kept between the fetches. The query is rejected before it's
+    // executed if the session has max_cursors_per_session cursors or its cursors take
+    // max_cursor_bytes_per_session bytes, otherwise a result which doesn't fit the bytes left is
+    // rejected once it's executed.
+    CursorResponse executeWithCursor(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap, 4: i32 batchSize)
+    FetchResp fetchNext(1: i64 sessionId, 2: i64 cursorId, 3: i32 batchSize)
+    oneway void closeCursor(1: i64 sessionId, 2: i64 cursorId)
     
     VerifyClientVersionResp verifyClientVersion(1: VerifyClientVersionReq req)
 }
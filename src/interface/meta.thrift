@@ -308,6 +308,24 @@ struct Correlativity {
     2: double             proportion,
 }
 
+// Statistics of the values of a property, or the degrees of the vertices of an edge type
+struct PropStats {
+    // The number of non-null values
+    1: i64                  count,
+    // The number of null values
+    2: i64                  null_count,
+    // The estimated number of distinct values
+    3: i64                  ndv,
+    // Bounds of the buckets of the equi-depth histogram in ascending order, i.e. the minimum
+    // followed by the upper bound of each bucket, which holds the same number of values
+    4: list<common.Value>   histogram,
+    // The partial results of the partitions, which are merged into the ones above and dropped
+    // when the job is finished. The smallest hashes of the distinct values.
+    5: list<i64>            ndv_sketch,
+    // The values sampled uniformly
+    6: list<common.Value>   samples,
+}
+
 struct StatsItem {
     // The number of vertices of tagName
     1: map<binary, i64>
@@ -328,6 +346,20 @@ struct StatsItem {
     6: map<common.PartitionID, list<Correlativity>>
         (cpp.template = "std::unordered_map") negative_part_correlativity,
     7: JobStatus                              status,
+    // Statistics of the indexed properties, tagName => propName => stats
+    8: map<binary, map<binary, PropStats>
+        (cpp.template = "std::unordered_map")>
+        (cpp.template = "std::unordered_map") tag_props,
+    // Statistics of the indexed properties, edgeName => propName => stats
+    9: map<binary, map<binary, PropStats>
+        (cpp.template = "std::unordered_map")>
+        (cpp.template = "std::unordered_map") edge_props,
+    // Distribution of the out degrees of vertices with the edges of edgeName
+    10: map<binary, PropStats>
+        (cpp.template = "std::unordered_map") out_degrees,
+    // Distribution of the in degrees of vertices with the edges of edgeName
+    11: map<binary, PropStats>
+        (cpp.template = "std::unordered_map") in_degrees,
 }
 
 // Graph space related operations.
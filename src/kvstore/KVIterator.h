@@ -30,6 +30,18 @@ class KVIterator {
    */
   virtual void prev() = 0;
 
+  /**
+   * @brief Move to the first key/value whose key is not less than the target. The default one
+   * moves forward by next, so the target must not be before the key iterator points to
+   *
+   * @param target Key to seek
+   */
+  virtual void seek(folly::StringPiece target) {
+    while (valid() && key() < target) {
+      next();
+    }
+  }
+
   /**
    * @brief Return the key of iterator points to
    *
@@ -203,6 +203,30 @@ void Part::registerOnLeaderLost(LeaderChangeCB cb) {
   leaderLostCB_.emplace_back(std::move(cb));
 }
 
+void Part::registerOnTagsChanged(KeysChangedCB cb) {
+  std::lock_guard<std::mutex> guard(keysChangedCBLock_);
+  tagsChangedCB_.emplace_back(std::move(cb));
+}
+
+void Part::registerOnEdgesChanged(KeysChangedCB cb) {
+  std::lock_guard<std::mutex> guard(keysChangedCBLock_);
+  edgesChangedCB_.emplace_back(std::move(cb));
+}
+
+void Part::onTagsChanged(const std::vector<std::string>* keys) {
+  std::lock_guard<std::mutex> guard(keysChangedCBLock_);
+  for (auto& cb : tagsChangedCB_) {
+    cb(spaceId_, partId_, keys);
+  }
+}
+
+void Part::onEdgesChanged(const std::vector<std::string>* keys) {
+  std::lock_guard<std::mutex> guard(keysChangedCBLock_);
+  for (auto& cb : edgesChangedCB_) {
+    cb(spaceId_, partId_, keys);
+  }
+}
+
 void Part::onDiscoverNewLeader(HostAddr nLeader) {
   VLOG(2) << idStr_ << "Find the new leader " << nLeader;
   if (newLeaderCb_) {
@@ -218,6 +242,25 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   auto batch = engine_->startBatchWrite();
   LogID lastId = kNoCommitLogId;
   TermID lastTerm = kNoCommitLogTerm;
+  // The tags and edges changed are only collected when someone cares about them
+  bool watchTags = false;
+  bool watchEdges = false;
+  {
+    std::lock_guard<std::mutex> guard(keysChangedCBLock_);
+    watchTags = !tagsChangedCB_.empty();
+    watchEdges = !edgesChangedCB_.empty();
+  }
+  bool allChanged = false;
+  std::vector<std::string> tagKeys;
+  std::vector<std::string> edgeKeys;
+  auto keyChanged = [&](folly::StringPiece key) {
+    if (watchTags && NebulaKeyUtils::isTag(vIdLen_, key)) {
+      tagKeys.emplace_back(key.str());
+    } else if (watchEdges &&
+               (NebulaKeyUtils::isEdge(vIdLen_, key) || NebulaKeyUtils::isLock(vIdLen_, key))) {
+      edgeKeys.emplace_back(key.str());
+    }
+  };
   while (iter->valid()) {
     lastId = iter->logId();
     lastTerm = iter->logTerm();
@@ -238,6 +281,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
         }
+        keyChanged(pieces[0]);
         break;
       }
       case OP_MULTI_PUT: {
@@ -252,6 +296,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
             VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
           }
+          keyChanged(kvs[i]);
         }
         break;
       }
@@ -262,6 +307,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
         }
+        keyChanged(key);
         break;
       }
       case OP_MULTI_REMOVE: {
@@ -272,6 +318,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
             VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
           }
+          keyChanged(k);
         }
         break;
       }
@@ -283,6 +330,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           VLOG(3) << idStr_ << "Failed to call WriteBatch::removeRange()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
         }
+        allChanged = true;
         break;
       }
       case OP_BATCH_WRITE: {
@@ -293,10 +341,13 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
           if (op.first == BatchLogType::OP_BATCH_PUT) {
             code = batch->put(op.second.first, op.second.second);
+            keyChanged(op.second.first);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
             code = batch->remove(op.second.first);
+            keyChanged(op.second.first);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
             code = batch->removeRange(op.second.first, op.second.second);
+            allChanged = true;
           }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch";
@@ -353,6 +404,18 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   auto code = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
   if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    // Only after the batch is committed, so the keys read after the callbacks are the new ones
+    if (allChanged) {
+      onTagsChanged(nullptr);
+      onEdgesChanged(nullptr);
+    } else {
+      if (!tagKeys.empty()) {
+        onTagsChanged(&tagKeys);
+      }
+      if (!edgeKeys.empty()) {
+        onEdgesChanged(&edgeKeys);
+      }
+    }
     return {code, lastId, lastTerm};
   } else {
     return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -391,6 +454,8 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     return {code, kNoSnapshotCount, kNoSnapshotSize};
   }
+  onTagsChanged(nullptr);
+  onEdgesChanged(nullptr);
   return {code, count, size};
 }
 
@@ -548,8 +613,13 @@ nebula::cpp2::ErrorCode Part::cleanup() {
             << apache::thrift::util::enumNameSafe(ret);
     return ret;
   }
-  return engine_->commitBatchWrite(
+  ret = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, true);
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    onTagsChanged(nullptr);
+    onEdgesChanged(nullptr);
+  }
+  return ret;
 }
 
 }  // namespace kvstore
@@ -313,6 +313,20 @@ class Part : public raftex::RaftPart {
    */
   nebula::cpp2::ErrorCode cleanup() override;
 
+  /**
+   * @brief Invoke the callbacks of the changed tags
+   *
+   * @param keys Tag keys changed, nullptr if any tag might have been changed
+   */
+  void onTagsChanged(const std::vector<std::string>* keys);
+
+  /**
+   * @brief Invoke the callbacks of the changed edges
+   *
+   * @param keys Edge keys changed, nullptr if any edge might have been changed
+   */
+  void onEdgesChanged(const std::vector<std::string>* keys);
+
  public:
   struct CallbackOptions {
     GraphSpaceID spaceId;
@@ -332,6 +346,26 @@ class Part : public raftex::RaftPart {
    */
   void registerOnLeaderLost(LeaderChangeCB cb);
 
+  /**
+   * @brief Callback with the keys put or removed by the logs applied to the part, on both the
+   * leader and the followers. The keys are nullptr if any key of the part might have been changed,
+   * e.g. by a range removal or a snapshot.
+   */
+  using KeysChangedCB = std::function<void(
+      GraphSpaceID spaceId, PartitionID partId, const std::vector<std::string>* keys)>;
+
+  /**
+   * @brief Register callback when the tags of the part have been changed, it could be registered
+   * while the logs are applied
+   */
+  void registerOnTagsChanged(KeysChangedCB cb);
+
+  /**
+   * @brief Register callback when the edges of the part have been changed, including the locks of
+   * the edges, it could be registered while the logs are applied
+   */
+  void registerOnEdgesChanged(KeysChangedCB cb);
+
  protected:
   GraphSpaceID spaceId_;
   PartitionID partId_;
@@ -339,6 +373,10 @@ class Part : public raftex::RaftPart {
   NewLeaderCallback newLeaderCb_ = nullptr;
   std::vector<LeaderChangeCB> leaderReadyCB_;
   std::vector<LeaderChangeCB> leaderLostCB_;
+  // Guards the callbacks of the keys changed, which are read by the thread applying the logs
+  std::mutex keysChangedCBLock_;
+  std::vector<KeysChangedCB> tagsChangedCB_;
+  std::vector<KeysChangedCB> edgesChangedCB_;
 
  private:
   KVEngine* engine_ = nullptr;
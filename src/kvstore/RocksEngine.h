@@ -41,6 +41,10 @@ class RocksRangeIter : public KVIterator {
     iter_->Prev();
   }
 
+  void seek(folly::StringPiece target) override {
+    iter_->Seek(rocksdb::Slice(target.data(), target.size()));
+  }
+
   folly::StringPiece key() const override {
     return folly::StringPiece(iter_->key().data(), iter_->key().size());
   }
@@ -76,6 +80,10 @@ class RocksPrefixIter : public KVIterator {
     iter_->Prev();
   }
 
+  void seek(folly::StringPiece target) override {
+    iter_->Seek(rocksdb::Slice(target.data(), target.size()));
+  }
+
   folly::StringPiece key() const override {
     return folly::StringPiece(iter_->key().data(), iter_->key().size());
   }
@@ -110,6 +118,10 @@ class RocksCommonIter : public KVIterator {
     iter_->Prev();
   }
 
+  void seek(folly::StringPiece target) override {
+    iter_->Seek(rocksdb::Slice(target.data(), target.size()));
+  }
+
   folly::StringPiece key() const override {
     return folly::StringPiece(iter_->key().data(), iter_->key().size());
   }
@@ -6,6 +6,7 @@
 #include "meta/processors/job/StatsJobExecutor.h"
 
 #include "common/utils/MetaKeyUtils.h"
+#include "common/utils/StatsUtils.h"
 #include "common/utils/Utils.h"
 #include "meta/processors/Common.h"
 
@@ -108,6 +109,8 @@ void StatsJobExecutor::addStats(cpp2::StatsItem& lhs, const cpp2::StatsItem& rhs
   (*lhs.negative_part_correlativity_ref())
       .insert((*rhs.negative_part_correlativity_ref()).begin(),  // NOLINT
               (*rhs.negative_part_correlativity_ref()).end());
+
+  StatsUtils::mergeProps(lhs, rhs);
 }
 
 /**
@@ -162,6 +165,7 @@ nebula::cpp2::ErrorCode StatsJobExecutor::finish(bool exeSuccessed) {
   }
   auto statsItem = MetaKeyUtils::parseStatsVal(val);
   if (exeSuccessed) {
+    StatsUtils::finalizeProps(statsItem);
     statsItem.status_ref() = cpp2::JobStatus::FINISHED;
   } else {
     statsItem.status_ref() = cpp2::JobStatus::FAILED;
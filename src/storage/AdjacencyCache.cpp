@@ -0,0 +1,151 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/AdjacencyCache.h"
+
+#include "common/utils/Types.h"
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+namespace {
+// The stats not collected
+const stats::CounterId kNoStats;
+}  // namespace
+
+EdgeBlock::EdgeBlock(kvstore::KVIterator* iter, size_t maxBytes) {
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    auto val = iter->val();
+    if (data_.size() + key.size() + val.size() + (offsets_.size() + 2) * sizeof(size_t) >
+        maxBytes) {
+      break;
+    }
+    offsets_.emplace_back(data_.size());
+    data_.append(key.data(), key.size());
+    offsets_.emplace_back(data_.size());
+    data_.append(val.data(), val.size());
+  }
+  data_.shrink_to_fit();
+  offsets_.shrink_to_fit();
+}
+
+void EdgeBlockIterator::seek(folly::StringPiece target) {
+  // Binary search the first key not less than the target, the keys are sorted as in the kvstore
+  size_t lo = 0;
+  size_t hi = block_->size();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (block_->key(mid) < target) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  index_ = lo;
+}
+
+AdjacencyCache::AdjacencyCache(size_t capacity,
+                               uint32_t bucketsExp,
+                               size_t minDegree,
+                               uint32_t minAccesses)
+    : cache_(capacity - (capacity >> kUncacheableShareExp),
+             bucketsExp,
+             kNumAdjacencyCacheHits,
+             kNumAdjacencyCacheMisses,
+             kNumAdjacencyCacheEvicts),
+      // The lookups of them have been counted as the misses of cache_
+      uncacheable_(capacity >> kUncacheableShareExp,
+                   bucketsExp,
+                   kNumAdjacencyCacheUncacheableHits,
+                   kNoStats,
+                   kNumAdjacencyCacheUncacheableEvicts),
+      minDegree_(minDegree),
+      // The counters of the sketch saturate at 255
+      minAccesses_(std::min<uint32_t>(minAccesses, std::numeric_limits<uint8_t>::max())),
+      counters_(kSketchWidth * kSketchDepth) {}
+
+std::shared_ptr<const EdgeBlock> AdjacencyCache::get(GraphSpaceID spaceId,
+                                                     const std::string& prefix,
+                                                     uint64_t* version,
+                                                     bool* admit) {
+  auto key = Cache::cacheKey(spaceId, prefix);
+  std::shared_ptr<const EdgeBlock> block;
+  if (cache_.get(key, &block, version)) {
+    *admit = false;
+    return block;
+  }
+  bool uncacheable = false;
+  uint64_t uncacheableVersion = 0;
+  if (uncacheable_.get(key, &uncacheable, &uncacheableVersion)) {
+    *admit = false;
+    return nullptr;
+  }
+  DCHECK_EQ(*version, uncacheableVersion);
+  *admit = access(key) >= minAccesses_;
+  return nullptr;
+}
+
+void AdjacencyCache::insert(GraphSpaceID spaceId,
+                            const std::string& prefix,
+                            std::shared_ptr<const EdgeBlock> block,
+                            uint64_t version) {
+  auto key = Cache::cacheKey(spaceId, prefix);
+  if (block == nullptr || block->size() < minDegree_) {
+    uncacheable_.insert(std::move(key), true, 0, version);
+    return;
+  }
+  auto size = block->bytes();
+  cache_.insert(std::move(key), std::move(block), size, version);
+}
+
+void AdjacencyCache::evict(GraphSpaceID spaceId, const std::vector<std::string>* keys) {
+  if (keys == nullptr) {
+    clear();
+    return;
+  }
+  // The edges changed together are usually the ones of the same prefix
+  folly::StringPiece last;
+  for (const auto& key : *keys) {
+    DCHECK_GT(key.size(), static_cast<size_t>(kEdgeLen));
+    auto vIdLen = (key.size() - kEdgeLen) / 2;
+    folly::StringPiece prefix(key.data(), sizeof(PartitionID) + vIdLen + sizeof(EdgeType));
+    if (prefix == last) {
+      continue;
+    }
+    last = prefix;
+    auto cacheKey = Cache::cacheKey(spaceId, prefix);
+    cache_.evict(cacheKey);
+    uncacheable_.evict(cacheKey);
+  }
+}
+
+uint32_t AdjacencyCache::access(const std::string& key) {
+  if (++accesses_ % kSketchSampleSize == 0) {
+    // Age the sketch, so the prefixes only read long ago are not admitted
+    for (auto& counter : counters_) {
+      counter.store(counter.load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+    }
+  }
+  // Index of each row by double hashing
+  auto hash = std::hash<std::string>()(key);
+  auto h1 = static_cast<uint32_t>(hash);
+  auto h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  uint32_t ret = std::numeric_limits<uint8_t>::max();
+  for (size_t i = 0; i < kSketchDepth; i++) {
+    auto& counter = counters_[i * kSketchWidth + ((h1 + i * h2) & (kSketchWidth - 1))];
+    auto count = counter.load(std::memory_order_relaxed);
+    if (count < std::numeric_limits<uint8_t>::max()) {
+      // Races between the readers only lose some counts
+      counter.store(++count, std::memory_order_relaxed);
+    }
+    ret = std::min<uint32_t>(ret, count);
+  }
+  return ret;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,212 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADJACENCYCACHE_H_
+#define STORAGE_ADJACENCYCACHE_H_
+
+#include "common/base/Base.h"
+#include "kvstore/KVIterator.h"
+#include "storage/VersionedCache.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief The edges of a vertex and an edge type, i.e. the keys and values of an edge prefix, in
+ * one buffer in the order of the keys.
+ */
+class EdgeBlock final {
+ public:
+  /**
+   * @brief Read the edges of the iterator until the block would take more than maxBytes, the
+   * iterator is left at the first edge not read, i.e. it's still valid if the block is incomplete
+   */
+  explicit EdgeBlock(kvstore::KVIterator* iter,
+                     size_t maxBytes = std::numeric_limits<size_t>::max());
+
+  size_t size() const {
+    return offsets_.size() / 2;
+  }
+
+  folly::StringPiece key(size_t index) const {
+    return piece(index * 2);
+  }
+
+  folly::StringPiece val(size_t index) const {
+    return piece(index * 2 + 1);
+  }
+
+  /**
+   * @brief Bytes of the block
+   */
+  size_t bytes() const {
+    return data_.size() + offsets_.size() * sizeof(size_t);
+  }
+
+ private:
+  folly::StringPiece piece(size_t i) const {
+    auto end = i + 1 < offsets_.size() ? offsets_[i + 1] : data_.size();
+    return folly::StringPiece(data_.data() + offsets_[i], end - offsets_[i]);
+  }
+
+  std::string data_;
+  // Offsets of the key and the value of each edge in data_
+  std::vector<size_t> offsets_;
+};
+
+/**
+ * @brief KVIterator over the edges of a block, which keeps the block alive
+ */
+class EdgeBlockIterator final : public kvstore::KVIterator {
+ public:
+  explicit EdgeBlockIterator(std::shared_ptr<const EdgeBlock> block) : block_(std::move(block)) {}
+
+  bool valid() const override {
+    return index_ < block_->size();
+  }
+
+  void next() override {
+    index_++;
+  }
+
+  void prev() override {
+    // It's invalid if it's moved before the first one
+    index_ = index_ == 0 ? block_->size() : index_ - 1;
+  }
+
+  void seek(folly::StringPiece target) override;
+
+  folly::StringPiece key() const override {
+    return block_->key(index_);
+  }
+
+  folly::StringPiece val() const override {
+    return block_->val(index_);
+  }
+
+ private:
+  std::shared_ptr<const EdgeBlock> block_;
+  size_t index_{0};
+};
+
+/**
+ * @brief AdjacencyCache keeps the edges of the hot vertices, so SingleEdgeNode doesn't iterate over
+ * them in the kvstore again and again.
+ *
+ * The cache is keyed by the edge prefix, i.e. the part, the vertex and the edge type. Only the
+ * prefixes accessed often enough and with enough edges are cached, since reading all the edges
+ * into a block costs more than iterating over them once. The accesses are counted by a count-min
+ * sketch, whose counters are halved periodically so the vertices hot long ago are forgotten.
+ *
+ * A prefix with too few edges, or too many to fit in a bucket, is remembered as not cacheable, so
+ * its edges are not read into a block again and again. These prefixes are kept apart from the
+ * blocks in a smaller LRU, so they never evict the blocks, and their lookups are counted as misses
+ * of the cache since the edges are still read from the kvstore. They are evicted like the blocks
+ * once the edges are changed.
+ *
+ * The edges of a prefix are evicted when the logs changing any of them are applied to the part,
+ * see Part::registerOnEdgesChanged. The block read before a change is not inserted after it, see
+ * VersionedCache.
+ */
+class AdjacencyCache final {
+ public:
+  /**
+   * @brief Construct a new Adjacency Cache object
+   *
+   * @param capacity Max bytes of the edges and the prefixes not cacheable in the cache
+   * @param bucketsExp The cache is split into 2^bucketsExp buckets
+   * @param minDegree Min number of the edges of a prefix to be cached
+   * @param minAccesses Min number of the recent accesses of a prefix to be cached
+   */
+  AdjacencyCache(size_t capacity, uint32_t bucketsExp, size_t minDegree, uint32_t minAccesses);
+
+  /**
+   * @brief Get the edges of the prefix
+   *
+   * @param spaceId
+   * @param prefix Edge prefix of a vertex and an edge type
+   * @param version Version of the bucket if not found, to be passed to insert
+   * @param admit Whether the prefix is accessed often enough to be inserted if not found
+   * @return std::shared_ptr<const EdgeBlock> The edges, nullptr if not found or not cacheable
+   */
+  std::shared_ptr<const EdgeBlock> get(GraphSpaceID spaceId,
+                                       const std::string& prefix,
+                                       uint64_t* version,
+                                       bool* admit);
+
+  /**
+   * @brief Max bytes of the block of the prefix to be cached, the edges beyond it are not read
+   */
+  size_t maxBlockBytes(const std::string& prefix) const {
+    return cache_.maxValueSize(sizeof(GraphSpaceID) + prefix.size());
+  }
+
+  /**
+   * @brief Insert the edges of the prefix read from the kvstore if there are enough of them, or
+   * remember that the prefix is not cacheable, unless any prefix of its bucket has been evicted
+   * since the lookup
+   *
+   * @param spaceId
+   * @param prefix Edge prefix of a vertex and an edge type
+   * @param block Edges of the prefix, nullptr if they take more than maxBlockBytes
+   * @param version Version returned by the lookup
+   */
+  void insert(GraphSpaceID spaceId,
+              const std::string& prefix,
+              std::shared_ptr<const EdgeBlock> block,
+              uint64_t version);
+
+  /**
+   * @brief Evict the prefixes of the changed edges
+   *
+   * @param spaceId
+   * @param keys Edge keys, nullptr to evict all the edges in the cache
+   */
+  void evict(GraphSpaceID spaceId, const std::vector<std::string>* keys);
+
+  /**
+   * @brief Evict all the edges in the cache
+   */
+  void clear() {
+    cache_.clear();
+    uncacheable_.clear();
+  }
+
+  /**
+   * @brief Bytes of the edges and the prefixes not cacheable in the cache
+   */
+  size_t bytes() {
+    return cache_.bytes() + uncacheable_.bytes();
+  }
+
+ private:
+  using Cache = VersionedCache<std::shared_ptr<const EdgeBlock>>;
+  using UncacheableSet = VersionedCache<bool>;
+
+  // Count an access of the key and return the estimated number of its recent accesses
+  uint32_t access(const std::string& key);
+
+  // Number of the counters of each row of the sketch
+  static constexpr size_t kSketchWidth = 1UL << 16;
+  static constexpr size_t kSketchDepth = 4;
+  // The counters are halved after so many accesses
+  static constexpr size_t kSketchSampleSize = kSketchWidth * 8;
+  // The prefixes not cacheable take 1/2^kUncacheableShareExp of the capacity
+  static constexpr uint32_t kUncacheableShareExp = 4;
+
+  Cache cache_;
+  // The prefixes not cacheable. It's split into the same buckets and evicted by the same keys as
+  // cache_, so the version of a bucket is always the same in both of them.
+  UncacheableSet uncacheable_;
+  size_t minDegree_;
+  uint32_t minAccesses_;
+  std::vector<std::atomic<uint8_t>> counters_;
+  std::atomic<size_t> accesses_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_ADJACENCYCACHE_H_
@@ -139,11 +139,26 @@ void BaseProcessor<RESP>::doRemoveRange(GraphSpaceID spaceId,
 }
 
 template <typename RESP>
-StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(const meta::NebulaSchemaProvider* schema,
-                                                        const std::vector<std::string>& propNames,
-                                                        const std::vector<Value>& props,
-                                                        WriteResult& wRet) {
-  RowWriterV2 rowWrite(schema);
+StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(
+    const std::shared_ptr<const meta::NebulaSchemaProvider>& schema,
+    const std::vector<std::string>& propNames,
+    const std::vector<Value>& props,
+    WriteResult& wRet) {
+  if (schema->isFixedWidth()) {
+    auto& codec = fixedRowCodecs_[schema.get()];
+    if (codec.second == nullptr) {
+      codec.first = schema;
+      codec.second = std::make_unique<FixedRowCodec>(schema.get());
+    }
+    // Encoded by RowWriterV2 if the codec doesn't handle the props
+    std::string row;
+    if (codec.second->encode(propNames, props, &row)) {
+      wRet = WriteResult::SUCCEEDED;
+      return row;
+    }
+  }
+
+  RowWriterV2 rowWrite(schema.get());
   // If req.prop_names is not empty, use the property name in req.prop_names
   // Otherwise, use property name in schema
   if (!propNames.empty()) {
@@ -11,6 +11,7 @@
 #include <folly/futures/Promise.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include "codec/FixedRowCodec.h"
 #include "codec/RowReaderWrapper.h"
 #include "codec/RowWriterV2.h"
 #include "common/base/Base.h"
@@ -100,10 +101,11 @@ class BaseProcessor {
   nebula::cpp2::ErrorCode checkStatType(const meta::SchemaProviderIf::Field& field,
                                         cpp2::StatType statType);
 
-  StatusOr<std::string> encodeRowVal(const meta::NebulaSchemaProvider* schema,
-                                     const std::vector<std::string>& propNames,
-                                     const std::vector<Value>& props,
-                                     WriteResult& wRet);
+  StatusOr<std::string> encodeRowVal(
+      const std::shared_ptr<const meta::NebulaSchemaProvider>& schema,
+      const std::vector<std::string>& propNames,
+      const std::vector<Value>& props,
+      WriteResult& wRet);
 
   virtual void profileDetail(const std::string& name, int32_t latency) {
     if (!profileDetail_.count(name)) {
@@ -130,6 +132,12 @@ class BaseProcessor {
   std::map<std::string, int32_t> profileDetail_;
   std::mutex profileMut_;
   bool profileDetailFlag_{false};
+  // The codecs of the fixed width schemas encoded by encodeRowVal, which hold the schemas so
+  // that they are not released during the request
+  std::unordered_map<const meta::NebulaSchemaProvider*,
+                     std::pair<std::shared_ptr<const meta::NebulaSchemaProvider>,
+                               std::unique_ptr<FixedRowCodec>>>
+      fixedRowCodecs_;
 };
 
 }  // namespace storage
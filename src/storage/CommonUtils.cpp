@@ -6,6 +6,7 @@
 #include "storage/CommonUtils.h"
 
 #include "common/time/WallClock.h"
+#include "kvstore/Part.h"
 
 namespace nebula {
 namespace storage {
@@ -64,5 +65,10 @@ StatusOr<Value> CommonUtils::ttlValue(const meta::SchemaProviderIf* schema, RowR
   return reader->getValueByName(std::move(ttlProp).second.second);
 }
 
+bool CommonUtils::isLeader(StorageEnv* env, GraphSpaceID spaceId, PartitionID partId) {
+  auto part = env->kvstore_->part(spaceId, partId);
+  return ok(part) && nebula::value(part)->isLeader() && nebula::value(part)->leaseValid();
+}
+
 }  // namespace storage
 }  // namespace nebula
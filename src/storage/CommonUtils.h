@@ -51,7 +51,6 @@ enum class IndexState {
   FINISHED,  // The part is building index successfully.
 };
 
-using VertexCache = ConcurrentLRUCache<std::pair<VertexID, TagID>, std::string>;
 using IndexKey = std::tuple<GraphSpaceID, PartitionID>;
 using IndexGuard = folly::ConcurrentHashMap<IndexKey, IndexState>;
 
@@ -62,6 +61,8 @@ using EdgesMemLock = MemoryLockCore<EMLI>;
 
 class TransactionManager;
 class InternalStorageClient;
+class VertexCache;
+class AdjacencyCache;
 
 // unify TagID, EdgeType
 using SchemaID = TagID;
@@ -77,6 +78,10 @@ class StorageEnv {
   meta::MetaClient* metaClient_{nullptr};
   InternalStorageClient* interClient_{nullptr};
   TransactionManager* txnMan_{nullptr};
+  // nullptr if the vertex cache is disabled
+  VertexCache* vertexCache_{nullptr};
+  // nullptr if the adjacency cache is disabled
+  AdjacencyCache* adjacencyCache_{nullptr};
   std::unique_ptr<VerticesMemLock> verticesML_{nullptr};
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
@@ -237,6 +242,8 @@ struct RuntimeContext {
   // used for GetNeighbors
   size_t columnIdx_ = 0;
   const std::vector<PropContext>* props_ = nullptr;
+  // projection of props_ in value, nullptr if none of them is in value
+  const RowProjection* projection_ = nullptr;
 
   // used for update
   bool insert_ = false;
@@ -264,6 +271,12 @@ class CommonUtils final {
       const meta::SchemaProviderIf* schema);
 
   static StatusOr<Value> ttlValue(const meta::SchemaProviderIf* schema, RowReader* reader);
+
+  /**
+   * @brief Whether the part could be read here, i.e. it's the leader and its lease is valid, in the
+   * same way as kvstore. The caches are only read if it's true.
+   */
+  static bool isLeader(StorageEnv* env, GraphSpaceID spaceId, PartitionID partId);
 };
 
 }  // namespace storage
@@ -46,3 +46,30 @@ DEFINE_bool(query_concurrently,
             false,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
+
+DEFINE_bool(query_batch_scan,
+            false,
+            "whether to go from the vertices of each part in the order of their ids, with the tags "
+            "read by one multiGet per batch and the edges scanned by one iterator");
+DEFINE_int32(query_batch_scan_size, 1024, "number of vertices whose tags are read by one multiGet");
+
+DEFINE_bool(enable_vertex_cache, false, "whether to cache the tags of the vertices read");
+DEFINE_int64(vertex_cache_size, 256, "max size of the keys and values in vertex cache, in MB");
+DEFINE_int32(vertex_cache_bucket_exp,
+             8,
+             "vertex cache is split into 2^vertex_cache_bucket_exp buckets");
+
+DEFINE_bool(enable_adjacency_cache,
+            false,
+            "whether to cache the edges of the vertices with many edges and read often");
+DEFINE_int64(adjacency_cache_size, 512, "max size of the edges in adjacency cache, in MB");
+DEFINE_int32(adjacency_cache_bucket_exp,
+             8,
+             "adjacency cache is split into 2^adjacency_cache_bucket_exp buckets");
+DEFINE_int32(adjacency_cache_min_degree,
+             128,
+             "min number of the edges of a vertex and an edge type to be cached");
+DEFINE_int32(adjacency_cache_min_accesses,
+             4,
+             "min number of the recent reads of the edges of a vertex and an edge type to be "
+             "cached");
@@ -34,4 +34,24 @@ DECLARE_int32(max_edge_returned_per_vertex);
 
 DECLARE_bool(query_concurrently);
 
+DECLARE_bool(query_batch_scan);
+
+DECLARE_int32(query_batch_scan_size);
+
+DECLARE_bool(enable_vertex_cache);
+
+DECLARE_int64(vertex_cache_size);
+
+DECLARE_int32(vertex_cache_bucket_exp);
+
+DECLARE_bool(enable_adjacency_cache);
+
+DECLARE_int64(adjacency_cache_size);
+
+DECLARE_int32(adjacency_cache_bucket_exp);
+
+DECLARE_int32(adjacency_cache_min_degree);
+
+DECLARE_int32(adjacency_cache_min_accesses);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
@@ -78,6 +78,7 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   if (FLAGS_store_type == "nebula") {
     auto nbStore = std::make_unique<kvstore::NebulaStore>(
         std::move(options), ioThreadPool_, localHost_, workers_);
+    registerCacheEvictions(nbStore.get());
     if (!(nbStore->init())) {
       LOG(ERROR) << "nebula store init failed";
       return nullptr;
@@ -91,6 +92,30 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   return nullptr;
 }
 
+void StorageServer::registerCacheEvictions(kvstore::NebulaStore* store) {
+  // No part has been added yet, they are all registered by the callbacks below when added
+  std::vector<std::pair<GraphSpaceID, PartitionID>> existParts;
+  if (vertexCache_ != nullptr) {
+    auto fn = [cache = vertexCache_.get()](std::shared_ptr<kvstore::Part>& part) {
+      part->registerOnTagsChanged(
+          [cache](GraphSpaceID spaceId, PartitionID, const std::vector<std::string>* keys) {
+            cache->evict(spaceId, keys);
+          });
+    };
+    store->registerOnNewPartAdded("VertexCache", fn, existParts);
+  }
+  if (adjacencyCache_ != nullptr) {
+    auto fn = [cache = adjacencyCache_.get()](std::shared_ptr<kvstore::Part>& part) {
+      part->registerOnEdgesChanged(
+          [cache](GraphSpaceID spaceId, PartitionID, const std::vector<std::string>* keys) {
+            cache->evict(spaceId, keys);
+          });
+    };
+    store->registerOnNewPartAdded("AdjacencyCache", fn, existParts);
+  }
+  DCHECK(existParts.empty());
+}
+
 bool StorageServer::initWebService() {
   LOG(INFO) << "Starting Storage HTTP Service";
   hdfsHelper_ = std::make_unique<hdfs::HdfsCommandHelper>();
@@ -212,6 +237,20 @@ bool StorageServer::start() {
   LOG(INFO) << "Init index manager";
   indexMan_ = meta::ServerBasedIndexManager::create(metaClient_.get());
 
+  if (FLAGS_enable_vertex_cache && !FLAGS_storage_kv_mode) {
+    LOG(INFO) << "Init vertex cache of " << FLAGS_vertex_cache_size << " MB";
+    vertexCache_ = std::make_unique<VertexCache>(FLAGS_vertex_cache_size * 1024 * 1024,
+                                                 FLAGS_vertex_cache_bucket_exp);
+  }
+
+  if (FLAGS_enable_adjacency_cache && !FLAGS_storage_kv_mode) {
+    LOG(INFO) << "Init adjacency cache of " << FLAGS_adjacency_cache_size << " MB";
+    adjacencyCache_ = std::make_unique<AdjacencyCache>(FLAGS_adjacency_cache_size * 1024 * 1024,
+                                                       FLAGS_adjacency_cache_bucket_exp,
+                                                       FLAGS_adjacency_cache_min_degree,
+                                                       FLAGS_adjacency_cache_min_accesses);
+  }
+
   LOG(INFO) << "Init kvstore";
   kvstore_ = getStoreInstance();
 
@@ -245,6 +284,9 @@ bool StorageServer::start() {
   }
   env_->txnMan_ = txnMan_.get();
 
+  env_->vertexCache_ = vertexCache_.get();
+  env_->adjacencyCache_ = adjacencyCache_.get();
+
   env_->verticesML_ = std::make_unique<VerticesMemLock>();
   env_->edgesML_ = std::make_unique<EdgesMemLock>();
   env_->adminStore_ = getAdminStoreInstance();
@@ -15,8 +15,10 @@
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
 #include "kvstore/NebulaStore.h"
+#include "storage/AdjacencyCache.h"
 #include "storage/CommonUtils.h"
 #include "storage/GraphStorageLocalServer.h"
+#include "storage/VertexCache.h"
 #include "storage/admin/AdminTaskManager.h"
 #include "storage/transaction/TransactionManager.h"
 #include "webservice/WebService.h"
@@ -50,6 +52,12 @@ class StorageServer final {
  private:
   std::unique_ptr<kvstore::KVStore> getStoreInstance();
 
+  /**
+   * @brief Evict the caches by the keys changed in the parts of the store. It's called before the
+   * store is initialized, so the callbacks are registered to each part before it's started.
+   */
+  void registerCacheEvictions(kvstore::NebulaStore* store);
+
   /**
    * @brief Get the Admin Store Instance object (used for task manager)
    *
@@ -102,6 +110,10 @@ class StorageServer final {
 
   std::unique_ptr<nebula::WebService> webSvc_;
   std::unique_ptr<meta::MetaClient> metaClient_;
+  // Declared before kvstore_, since the parts evict the keys changed from them until they are
+  // stopped
+  std::unique_ptr<VertexCache> vertexCache_;
+  std::unique_ptr<AdjacencyCache> adjacencyCache_;
   std::unique_ptr<kvstore::KVStore> kvstore_;
 
   std::unique_ptr<nebula::hdfs::HdfsHelper> hdfsHelper_;
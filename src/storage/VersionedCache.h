@@ -0,0 +1,245 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_VERSIONEDCACHE_H_
+#define STORAGE_VERSIONEDCACHE_H_
+
+#include <list>
+
+#include "common/base/Base.h"
+#include "common/stats/StatsManager.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief VersionedCache is the LRU cache under VertexCache and AdjacencyCache, which keeps the
+ * values read from the kvstore and is evicted when they are changed.
+ *
+ * The cache is limited by the bytes of the keys and values in it, and split into buckets by the
+ * hash of the key, each of which is an LRU list guarded by its own lock.
+ *
+ * A value read from the kvstore before a change but inserted after the eviction of the change
+ * would stay stale in the cache, so each bucket has a version which is increased by every
+ * eviction. The version is returned by the lookup missing the key, and the value is only inserted
+ * if the version of the bucket is still the same.
+ */
+template <typename V>
+class VersionedCache final {
+ public:
+  /**
+   * @brief Construct a new Versioned Cache object
+   *
+   * @param capacity Max bytes of the keys and values in the cache
+   * @param bucketsExp The cache is split into 2^bucketsExp buckets
+   * @param hits Stats of the hits
+   * @param misses Stats of the misses
+   * @param evicts Stats of the values evicted for the capacity
+   */
+  VersionedCache(size_t capacity,
+                 uint32_t bucketsExp,
+                 const stats::CounterId& hits,
+                 const stats::CounterId& misses,
+                 const stats::CounterId& evicts)
+      : buckets_(1UL << bucketsExp),
+        bucketsMask_((1UL << bucketsExp) - 1),
+        capacityPerBucket_(capacity >> bucketsExp),
+        hitsStats_(hits),
+        missesStats_(misses),
+        evictsStats_(evicts) {
+    CHECK_GT(capacityPerBucket_, 0) << "The capacity of the cache is too small";
+  }
+
+  /**
+   * @brief Key of the cache of the key in the space
+   */
+  static std::string cacheKey(GraphSpaceID spaceId, folly::StringPiece key) {
+    std::string ret;
+    ret.reserve(sizeof(GraphSpaceID) + key.size());
+    ret.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID))
+        .append(key.data(), key.size());
+    return ret;
+  }
+
+  /**
+   * @brief Get the value of the key
+   *
+   * @param key
+   * @param value Value of the key if found
+   * @param version Version of the bucket if not found, to be passed to insert
+   * @return Whether the key is found
+   */
+  bool get(const std::string& key, V* value, uint64_t* version) {
+    auto& b = bucket(key);
+    bool found = false;
+    size_t hits = 0;
+    size_t misses = 0;
+    {
+      std::lock_guard<std::mutex> guard(b.lock_);
+      auto iter = b.entries_.find(key);
+      if (iter == b.entries_.end()) {
+        *version = b.version_;
+        if (++b.misses_ == kStatsBatchSize) {
+          misses = kStatsBatchSize;
+          b.misses_ = 0;
+        }
+      } else {
+        b.lru_.splice(b.lru_.begin(), b.lru_, iter->second.pos_);
+        *value = iter->second.value_;
+        found = true;
+        if (++b.hits_ == kStatsBatchSize) {
+          hits = kStatsBatchSize;
+          b.hits_ = 0;
+        }
+      }
+    }
+    if (hits > 0) {
+      stats::StatsManager::addValue(hitsStats_, hits);
+    }
+    if (misses > 0) {
+      stats::StatsManager::addValue(missesStats_, misses);
+    }
+    return found;
+  }
+
+  /**
+   * @brief Insert the value read from the kvstore, unless any key of its bucket has been evicted
+   * since the lookup
+   *
+   * @param key
+   * @param value
+   * @param size Bytes of the value
+   * @param version Version returned by the lookup
+   */
+  void insert(std::string key, V value, size_t size, uint64_t version) {
+    size += key.size() + kEntryOverhead;
+    if (size > capacityPerBucket_) {
+      return;
+    }
+    auto& b = bucket(key);
+    size_t evicts = 0;
+    {
+      std::lock_guard<std::mutex> guard(b.lock_);
+      if (b.version_ != version) {
+        // Some keys of the bucket have been changed since the value is read
+        return;
+      }
+      auto iter = b.entries_.find(key);
+      if (iter != b.entries_.end()) {
+        remove(b, iter);
+      }
+      while (!b.lru_.empty() && b.bytes_ + size > capacityPerBucket_) {
+        remove(b, b.entries_.find(*b.lru_.back()));
+        evicts++;
+      }
+      auto ret = b.entries_.emplace(std::move(key), Entry{std::move(value), size, b.lru_.end()});
+      b.lru_.push_front(&ret.first->first);
+      ret.first->second.pos_ = b.lru_.begin();
+      b.bytes_ += size;
+    }
+    if (evicts > 0) {
+      stats::StatsManager::addValue(evictsStats_, evicts);
+    }
+  }
+
+  /**
+   * @brief Max bytes of a value of the key to be inserted, the larger ones are dropped by insert
+   *
+   * @param keySize Bytes of the key
+   */
+  size_t maxValueSize(size_t keySize) const {
+    auto overhead = keySize + kEntryOverhead;
+    return capacityPerBucket_ > overhead ? capacityPerBucket_ - overhead : 0;
+  }
+
+  /**
+   * @brief Evict the key since it has been changed
+   */
+  void evict(const std::string& key) {
+    auto& b = bucket(key);
+    std::lock_guard<std::mutex> guard(b.lock_);
+    b.version_++;
+    auto iter = b.entries_.find(key);
+    if (iter != b.entries_.end()) {
+      remove(b, iter);
+    }
+  }
+
+  /**
+   * @brief Evict all the keys
+   */
+  void clear() {
+    for (auto& b : buckets_) {
+      std::lock_guard<std::mutex> guard(b.lock_);
+      b.version_++;
+      b.lru_.clear();
+      b.entries_.clear();
+      b.bytes_ = 0;
+    }
+  }
+
+  /**
+   * @brief Bytes of the keys and values in the cache
+   */
+  size_t bytes() {
+    size_t total = 0;
+    for (auto& b : buckets_) {
+      std::lock_guard<std::mutex> guard(b.lock_);
+      total += b.bytes_;
+    }
+    return total;
+  }
+
+ private:
+  struct Entry {
+    V value_;
+    // Bytes charged for the entry
+    size_t size_;
+    // Position in the LRU list of the bucket
+    std::list<const std::string*>::iterator pos_;
+  };
+
+  struct Bucket {
+    std::mutex lock_;
+    std::unordered_map<std::string, Entry> entries_;
+    // The keys of the entries, from the most recently used one
+    std::list<const std::string*> lru_;
+    size_t bytes_{0};
+    uint64_t version_{0};
+    // Hits and misses not added to the stats yet
+    size_t hits_{0};
+    size_t misses_{0};
+  };
+
+  Bucket& bucket(const std::string& key) {
+    return buckets_[std::hash<std::string>()(key) & bucketsMask_];
+  }
+
+  // Remove the entry, the lock of the bucket must be held
+  void remove(Bucket& b, typename std::unordered_map<std::string, Entry>::iterator iter) {
+    b.bytes_ -= iter->second.size_;
+    b.lru_.erase(iter->second.pos_);
+    b.entries_.erase(iter);
+  }
+
+  // Bytes charged for the nodes of the map and the list of an entry
+  static constexpr size_t kEntryOverhead = 96;
+  // The hits and misses of a bucket are added to the stats by batch, since the stats are much
+  // more expensive than a lookup
+  static constexpr size_t kStatsBatchSize = 64;
+
+  std::vector<Bucket> buckets_;
+  size_t bucketsMask_;
+  size_t capacityPerBucket_;
+  const stats::CounterId& hitsStats_;
+  const stats::CounterId& missesStats_;
+  const stats::CounterId& evictsStats_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_VERSIONEDCACHE_H_
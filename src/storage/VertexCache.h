@@ -0,0 +1,107 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_VERTEXCACHE_H_
+#define STORAGE_VERTEXCACHE_H_
+
+#include "common/base/Base.h"
+#include "storage/VersionedCache.h"
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief VertexCache keeps the values of the tags recently read by TagNode, so the tags of the hot
+ * vertices are not read from the kvstore again and again.
+ *
+ * The tags are evicted when the logs changing them are applied to the part, on both the leader and
+ * the followers, see Part::registerOnTagsChanged. The tag read before a change is not inserted
+ * after it, see VersionedCache.
+ */
+class VertexCache final {
+ public:
+  /**
+   * @brief Construct a new Vertex Cache object
+   *
+   * @param capacity Max bytes of the keys and values in the cache
+   * @param bucketsExp The cache is split into 2^bucketsExp buckets
+   */
+  VertexCache(size_t capacity, uint32_t bucketsExp)
+      : cache_(capacity,
+               bucketsExp,
+               kNumVertexCacheHits,
+               kNumVertexCacheMisses,
+               kNumVertexCacheEvicts) {}
+
+  /**
+   * @brief Get the value of the tag
+   *
+   * @param spaceId
+   * @param key Tag key
+   * @param value Value of the tag if found
+   * @param version Version of the bucket if not found, to be passed to insert
+   * @return Whether the tag is found
+   */
+  bool get(GraphSpaceID spaceId, const std::string& key, std::string* value, uint64_t* version) {
+    return cache_.get(Cache::cacheKey(spaceId, key), value, version);
+  }
+
+  /**
+   * @brief Insert the value of the tag read from the kvstore, unless any tag of its bucket has been
+   * evicted since the lookup
+   *
+   * @param spaceId
+   * @param key Tag key
+   * @param value Value of the tag
+   * @param version Version returned by the lookup
+   */
+  void insert(GraphSpaceID spaceId,
+              const std::string& key,
+              const std::string& value,
+              uint64_t version) {
+    cache_.insert(Cache::cacheKey(spaceId, key), value, value.size(), version);
+  }
+
+  /**
+   * @brief Evict the changed tags
+   *
+   * @param spaceId
+   * @param keys Tag keys, nullptr to evict all the tags in the cache
+   */
+  void evict(GraphSpaceID spaceId, const std::vector<std::string>* keys) {
+    if (keys == nullptr) {
+      cache_.clear();
+      return;
+    }
+    for (const auto& key : *keys) {
+      cache_.evict(Cache::cacheKey(spaceId, key));
+    }
+  }
+
+  /**
+   * @brief Evict all the tags in the cache
+   */
+  void clear() {
+    cache_.clear();
+  }
+
+  /**
+   * @brief Bytes of the keys and values in the cache
+   */
+  size_t bytes() {
+    return cache_.bytes();
+  }
+
+ private:
+  using Cache = VersionedCache<std::string>;
+
+  Cache cache_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_VERTEXCACHE_H_
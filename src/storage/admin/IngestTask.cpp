@@ -6,6 +6,8 @@
 #include "storage/admin/IngestTask.h"
 
 #include "common/fs/FileUtils.h"
+#include "storage/AdjacencyCache.h"
+#include "storage/VertexCache.h"
 
 namespace nebula {
 namespace storage {
@@ -24,7 +26,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
   }
 
   auto space = nebula::value(errOrSpace);
-  results.emplace_back([space = space]() {
+  results.emplace_back([space = space,
+                        vertexCache = env_->vertexCache_,
+                        adjacencyCache = env_->adjacencyCache_]() {
     for (auto& engine : space->engines_) {
       auto parts = engine->allParts();
       for (auto part : parts) {
@@ -37,6 +41,13 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
         auto files = nebula::fs::FileUtils::listAllFilesInDir(path.c_str(), true, "*.sst");
         LOG(INFO) << "Ingest files: " << files.size();
         auto code = engine->ingest(std::vector<std::string>(files));
+        // The files are not ingested by the raft logs, so the keys changed are unknown
+        if (vertexCache != nullptr) {
+          vertexCache->clear();
+        }
+        if (adjacencyCache != nullptr) {
+          adjacencyCache->clear();
+        }
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return code;
         }
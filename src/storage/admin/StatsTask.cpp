@@ -7,8 +7,10 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include "codec/RowReaderWrapper.h"
 #include "common/base/MurmurHash2.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "common/utils/StatsUtils.h"
 #include "kvstore/Common.h"
 
 namespace nebula {
@@ -51,6 +53,35 @@ nebula::cpp2::ErrorCode StatsTask::getSchemas(GraphSpaceID spaceId) {
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+void StatsTask::getIndexedProps(GraphSpaceID spaceId) {
+  if (env_->indexMan_ == nullptr) {
+    return;
+  }
+  auto addFields = [](const meta::cpp2::IndexItem& index, std::vector<std::string>& props) {
+    for (const auto& field : index.get_fields()) {
+      // The geography values are indexed by cells, which are not ordered
+      if (field.get_type().get_type() == nebula::cpp2::PropertyType::GEOGRAPHY) {
+        continue;
+      }
+      if (std::find(props.begin(), props.end(), field.get_name()) == props.end()) {
+        props.emplace_back(field.get_name());
+      }
+    }
+  };
+  auto tagIndexes = env_->indexMan_->getTagIndexes(spaceId);
+  if (tagIndexes.ok()) {
+    for (const auto& index : tagIndexes.value()) {
+      addFields(*index, tagProps_[index->get_schema_id().get_tag_id()]);
+    }
+  }
+  auto edgeIndexes = env_->indexMan_->getEdgeIndexes(spaceId);
+  if (edgeIndexes.ok()) {
+    for (const auto& index : edgeIndexes.value()) {
+      addFields(*index, edgeProps_[index->get_schema_id().get_edge_type()]);
+    }
+  }
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> StatsTask::genSubTasks() {
   spaceId_ = *ctx_.parameters_.space_id_ref();
   auto parts = *ctx_.parameters_.parts_ref();
@@ -61,6 +92,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> StatsTask::genSubTas
     LOG(INFO) << "Space not found, spaceId: " << spaceId_;
     return ret;
   }
+  getIndexedProps(spaceId_);
 
   std::vector<AdminSubTask> tasks;
   for (const auto& part : parts) {
@@ -132,6 +164,11 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   std::unordered_map<PartitionID, int64_t> negativeRelevancy;
   int64_t spaceVertices = 0;
   int64_t spaceEdges = 0;
+  // Values of the indexed properties
+  std::unordered_map<TagID, std::unordered_map<std::string, StatsUtils::Collector>> tagProps;
+  std::unordered_map<EdgeType, std::unordered_map<std::string, StatsUtils::Collector>> edgeProps;
+  // Degrees of the vertices with the edges, the negative edge types are of the in degrees
+  std::unordered_map<EdgeType, StatsUtils::Collector> degrees;
 
   for (auto tag : tags) {
     tagsVertices[tag.first] = 0;
@@ -166,6 +203,18 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
       continue;
     }
     tagsVertices[tagId] += 1;
+
+    auto propsIter = tagProps_.find(tagId);
+    if (propsIter != tagProps_.end()) {
+      auto reader =
+          RowReaderWrapper::getTagPropReader(env_->schemaMan_, spaceId, tagId, tagIter->val());
+      if (reader != nullptr) {
+        auto& collectors = tagProps[tagId];
+        for (const auto& prop : propsIter->second) {
+          collectors[prop].add(reader->getValueByName(prop));
+        }
+      }
+    }
     tagIter->next();
   }
 
@@ -175,6 +224,11 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   // 1    1       1    2
   // 2    2       1    3  (invalid data, for example, edge data without edge
   // schema) 2    3       1    4 2    3       1    5
+  //
+  // The edges of a source vertex and a type are adjacent, so the degree is the length of the run.
+  std::string lastSrc;
+  EdgeType lastType = 0;
+  int64_t degree = 0;
   while (edgeIter && edgeIter->valid()) {
     if (UNLIKELY(canceled_)) {
       LOG(INFO) << "Stats task is canceled";
@@ -193,10 +247,32 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
 
     auto source = NebulaKeyUtils::getSrcId(vIdLen, key).str();
     auto destination = NebulaKeyUtils::getDstId(vIdLen, key).str();
+    if (edgeType != lastType || source != lastSrc) {
+      if (degree > 0) {
+        degrees[lastType].add(degree);
+      }
+      lastSrc = source;
+      lastType = edgeType;
+      degree = 0;
+    }
+    degree++;
+
     if (edgeType > 0) {
       spaceEdges++;
       edgetypeEdges[edgeType] += 1;
 
+      auto propsIter = edgeProps_.find(edgeType);
+      if (propsIter != edgeProps_.end()) {
+        auto reader = RowReaderWrapper::getEdgePropReader(
+            env_->schemaMan_, spaceId, edgeType, edgeIter->val());
+        if (reader != nullptr) {
+          auto& collectors = edgeProps[edgeType];
+          for (const auto& prop : propsIter->second) {
+            collectors[prop].add(reader->getValueByName(prop));
+          }
+        }
+      }
+
       uint64_t destinationVid = 0;
       if (isIntId) {
         memcpy(static_cast<void*>(&destinationVid), destination.data(), 8);
@@ -217,6 +293,9 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     }
     edgeIter->next();
   }
+  if (degree > 0) {
+    degrees[lastType].add(degree);
+  }
   while (vertexIter && vertexIter->valid()) {
     spaceVertices++;
     vertexIter->next();
@@ -237,6 +316,28 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     }
   }
 
+  for (auto& tagElem : tagProps) {
+    auto& props = (*statsItem.tag_props_ref())[tags_.at(tagElem.first)];
+    for (auto& propElem : tagElem.second) {
+      props.emplace(propElem.first, propElem.second.partial());
+    }
+  }
+  for (auto& edgeElem : edgeProps) {
+    auto& props = (*statsItem.edge_props_ref())[edges_.at(edgeElem.first)];
+    for (auto& propElem : edgeElem.second) {
+      props.emplace(propElem.first, propElem.second.partial());
+    }
+  }
+  for (auto& degreeElem : degrees) {
+    auto iter = edges_.find(std::abs(degreeElem.first));
+    if (iter == edges_.end()) {
+      continue;
+    }
+    auto& distribution = degreeElem.first > 0 ? *statsItem.out_degrees_ref()
+                                              : *statsItem.in_degrees_ref();
+    distribution.emplace(iter->second, degreeElem.second.partial());
+  }
+
   statsItem.space_vertices_ref() = spaceVertices;
   statsItem.space_edges_ref() = spaceEdges;
   using Correlativities = std::vector<nebula::meta::cpp2::Correlativity>;
@@ -323,6 +424,7 @@ void StatsTask::finish(nebula::cpp2::ErrorCode rc) {
       (*result.negative_part_correlativity_ref())
           .insert((*item.negative_part_correlativity_ref()).begin(),
                   (*item.negative_part_correlativity_ref()).end());
+      StatsUtils::mergeProps(result, item);
     }
     result.status_ref() = nebula::meta::cpp2::JobStatus::FINISHED;
     ctx_.onFinish_(rc, result);
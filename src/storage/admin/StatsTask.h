@@ -52,6 +52,13 @@ class StatsTask : public AdminTask {
  private:
   nebula::cpp2::ErrorCode getSchemas(GraphSpaceID spaceId);
 
+  /**
+   * @brief Find the properties of tags and edges indexed, whose values are sampled.
+   *
+   * @param spaceId
+   */
+  void getIndexedProps(GraphSpaceID spaceId);
+
  protected:
   GraphSpaceID spaceId_;
 
@@ -61,6 +68,10 @@ class StatsTask : public AdminTask {
   // All edgeTypes and edgeName of the spaceId
   std::unordered_map<EdgeType, std::string> edges_;
 
+  // Names of the indexed properties of tags and edges
+  std::unordered_map<TagID, std::vector<std::string>> tagProps_;
+  std::unordered_map<EdgeType, std::vector<std::string>> edgeProps_;
+
   folly::ConcurrentHashMap<PartitionID, nebula::meta::cpp2::StatsItem> statistics_;
 
   // The number of subtasks equals to the number of parts in request
@@ -0,0 +1,152 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_EXEC_BATCHSCANNER_H_
+#define STORAGE_EXEC_BATCHSCANNER_H_
+
+#include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/KVIterator.h"
+#include "storage/CommonUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief BatchScanner reads the tags and edges of a batch of vertices of a partition.
+ *
+ * By default, TagNode gets the tag of each vertex by a point get, and SingleEdgeNode creates a
+ * prefix iterator of each vertex and edge type, which costs much when going from lots of
+ * vertices. With the scanner, the tags of a batch of vertices are read by one multiGet, and the
+ * edges of all the vertices are read by one iterator over the edges of the partition, which
+ * seeks to the prefix of each vertex and edge type. If the vertices are visited in the order of
+ * their ids, the iterator only moves forward.
+ */
+class BatchScanner final {
+ public:
+  explicit BatchScanner(RuntimeContext* context) : context_(context) {}
+
+  /**
+   * @brief Start scanning the partition, it creates the iterator over the edges of it
+   *
+   * @param partId
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode reset(PartitionID partId) {
+    partId_ = partId;
+    tags_.clear();
+    iter_.reset();
+    partEdgePrefix_ = NebulaKeyUtils::edgePrefix(partId);
+    return context_->env()->kvstore_->prefix(context_->spaceId(), partId, partEdgePrefix_, &iter_);
+  }
+
+  /**
+   * @brief Read the tags of the vertices by one multiGet, the ones read before are dropped
+   *
+   * @param vIds Vertices to read.
+   * @param tagIds Tags to read.
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode prefetchTags(const std::vector<VertexID>& vIds,
+                                       const std::vector<TagID>& tagIds) {
+    tags_.clear();
+    if (tagIds.empty()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    std::vector<std::string> keys;
+    keys.reserve(vIds.size() * tagIds.size());
+    for (const auto& vId : vIds) {
+      for (auto tagId : tagIds) {
+        keys.emplace_back(NebulaKeyUtils::tagKey(context_->vIdLen(), partId_, vId, tagId));
+      }
+    }
+    std::vector<std::string> values;
+    auto ret = context_->env()->kvstore_->multiGet(context_->spaceId(), partId_, keys, &values);
+    if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return ret.first;
+    }
+    const auto& status = ret.second;
+    tags_.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (status[i].ok()) {
+        tags_.emplace(std::move(keys[i]), std::move(values[i]));
+      } else if (!status[i].isKeyNotFound()) {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  /**
+   * @brief Return the value of the tag key read by prefetchTags, nullptr if not found
+   */
+  const std::string* tag(const std::string& key) const {
+    auto iter = tags_.find(key);
+    return iter == tags_.end() ? nullptr : &iter->second;
+  }
+
+  /**
+   * @brief Return an iterator of the edges of the prefix, which is a view of the iterator of
+   * the partition. It's invalidated by the next call since the iterator is shared.
+   *
+   * @param prefix Prefix of the edges of a vertex and edge type
+   * @return std::unique_ptr<kvstore::KVIterator>
+   */
+  std::unique_ptr<kvstore::KVIterator> edges(std::string prefix) {
+    CHECK(!!iter_);
+    return std::make_unique<PrefixIter>(iter_.get(), std::move(prefix));
+  }
+
+ private:
+  class PrefixIter final : public kvstore::KVIterator {
+   public:
+    PrefixIter(kvstore::KVIterator* iter, std::string prefix)
+        : iter_(iter), prefix_(std::move(prefix)) {
+      iter_->seek(prefix_);
+    }
+
+    bool valid() const override {
+      return iter_->valid() && iter_->key().startsWith(prefix_);
+    }
+
+    void next() override {
+      iter_->next();
+    }
+
+    void prev() override {
+      iter_->prev();
+    }
+
+    void seek(folly::StringPiece target) override {
+      iter_->seek(target);
+    }
+
+    folly::StringPiece key() const override {
+      return iter_->key();
+    }
+
+    folly::StringPiece val() const override {
+      return iter_->val();
+    }
+
+   private:
+    kvstore::KVIterator* iter_;
+    std::string prefix_;
+  };
+
+  RuntimeContext* context_;
+  PartitionID partId_{0};
+  // The prefix iterator refers to it
+  std::string partEdgePrefix_;
+  std::unique_ptr<kvstore::KVIterator> iter_;
+  // Tag key => value
+  std::unordered_map<std::string, std::string> tags_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_EXEC_BATCHSCANNER_H_
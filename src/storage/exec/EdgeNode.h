@@ -7,6 +7,7 @@
 #define STORAGE_EXEC_EDGENODE_H_
 
 #include "common/base/Base.h"
+#include "storage/AdjacencyCache.h"
 #include "storage/exec/RelNode.h"
 #include "storage/exec/StorageIterator.h"
 
@@ -34,6 +35,13 @@ class EdgeNode : public IterateNode<T> {
     return edgeType_;
   }
 
+  /**
+   * @brief Projection of the props in value, nullptr if none of them is in value
+   */
+  const RowProjection* projection() const {
+    return projection_.get();
+  }
+
  protected:
   EdgeNode(RuntimeContext* context,
            EdgeContext* edgeContext,
@@ -53,6 +61,7 @@ class EdgeNode : public IterateNode<T> {
     CHECK(schemaIter != edgeContext_->schemas_.end());
     CHECK(!schemaIter->second.empty());
     schemas_ = &(schemaIter->second);
+    projection_ = QueryUtils::buildProjection(*schemas_, props_);
     ttl_ = QueryUtils::getEdgeTTLInfo(edgeContext_, std::abs(edgeType_));
     edgeName_ = edgeContext_->edgeNames_[edgeType_];
     IterateNode<T>::name_ = "EdgeNode";
@@ -70,6 +79,7 @@ class EdgeNode : public IterateNode<T> {
   Expression* exp_;
 
   const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas_ = nullptr;
+  std::unique_ptr<RowProjection> projection_;
   std::optional<std::pair<std::string, int64_t>> ttl_;
   std::string edgeName_;
 };
@@ -209,6 +219,13 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
     return iter_->reader();
   }
 
+  /**
+   * @brief Read the edges by the scanner, the iterator is opened by the MultiEdgeIterator
+   */
+  void setBatchScanner(BatchScanner* scanner) {
+    scanner_ = scanner;
+  }
+
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
     auto ret = RelNode::doExecute(partId, vId);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -217,9 +234,44 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
 
     VLOG(1) << "partId " << partId << ", vId " << vId << ", edgeType " << edgeType_
             << ", prop size " << props_->size();
+    if (scanner_ != nullptr) {
+      iter_.reset(new SingleEdgeIterator(
+          context_,
+          scanner_,
+          NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_),
+          edgeType_,
+          schemas_,
+          &ttl_));
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
     std::unique_ptr<kvstore::KVIterator> iter;
     prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
-    ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+    // The cache is only read on the leader, whose edges are as new as the ones in the kvstore
+    auto* cache = context_->env()->adjacencyCache_;
+    uint64_t version = 0;
+    bool admit = false;
+    std::shared_ptr<const EdgeBlock> block;
+    if (cache != nullptr && CommonUtils::isLeader(context_->env(), context_->spaceId(), partId)) {
+      block = cache->get(context_->spaceId(), prefix_, &version, &admit);
+    }
+    if (block != nullptr) {
+      iter = std::make_unique<EdgeBlockIterator>(std::move(block));
+    } else {
+      ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+      if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && admit) {
+        // The prefix is read often, read its edges into a block and cache it if it has enough, but
+        // not more than a bucket of the cache holds
+        block = std::make_shared<const EdgeBlock>(iter.get(), cache->maxBlockBytes(prefix_));
+        if (iter->valid()) {
+          // Too many edges, which are iterated over in the kvstore from the first one again
+          cache->insert(context_->spaceId(), prefix_, nullptr, version);
+          ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+        } else {
+          cache->insert(context_->spaceId(), prefix_, block, version);
+          iter = std::make_unique<EdgeBlockIterator>(std::move(block));
+        }
+      }
+    }
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter && iter->valid()) {
       iter_.reset(new SingleEdgeIterator(context_, std::move(iter), edgeType_, schemas_, &ttl_));
     } else {
@@ -231,6 +283,7 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
  private:
   std::unique_ptr<SingleEdgeIterator> iter_;
   std::string prefix_;
+  BatchScanner* scanner_ = nullptr;
 };
 
 }  // namespace storage
@@ -7,6 +7,7 @@
 #define STORAGE_EXEC_FILTERNODE_H_
 
 #include "common/base/Base.h"
+#include "common/expression/ExprProgram.h"
 #include "common/expression/Expression.h"
 #include "storage/context/StorageExpressionContext.h"
 #include "storage/exec/HashJoinNode.h"
@@ -42,6 +43,9 @@ class FilterNode : public IterateNode<T> {
              Expression* exp = nullptr)
       : IterateNode<T>(upstream), context_(context), expCtx_(expCtx), filterExp_(exp) {
     IterateNode<T>::name_ = "FilterNode";
+    if (filterExp_ != nullptr) {
+      filter_ = std::make_unique<ExprVM>(filterExp_);
+    }
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const T& vId) override {
@@ -84,7 +88,7 @@ class FilterNode : public IterateNode<T> {
   }
 
   bool checkTagOnly() {
-    auto result = filterExp_->eval(*expCtx_);
+    auto& result = filter_->eval(*expCtx_);
     // NULL is always false
     auto ret = result.toBool();
     return ret.isBool() && ret.getBool();
@@ -94,7 +98,7 @@ class FilterNode : public IterateNode<T> {
   bool checkTagAndEdge() {
     expCtx_->reset(this->reader(), this->key().str());
     // result is false when filter out
-    auto result = filterExp_->eval(*expCtx_);
+    auto& result = filter_->eval(*expCtx_);
     // NULL is always false
     auto ret = result.toBool();
     return ret.isBool() && ret.getBool();
@@ -104,6 +108,8 @@ class FilterNode : public IterateNode<T> {
   RuntimeContext* context_;
   StorageExpressionContext* expCtx_;
   Expression* filterExp_;
+  // The filter compiled once for all the rows scanned by the node
+  std::unique_ptr<ExprVM> filter_;
   FilterMode mode_{FilterMode::TAG_AND_EDGE};
   int32_t callCheck{0};
 };
@@ -110,12 +110,13 @@ class GetNeighborsNode : public QueryNode<VertexID> {
       auto key = upstream_->key();
       auto reader = upstream_->reader();
       auto props = context_->props_;
+      auto projection = context_->projection_;
       auto columnIdx = context_->columnIdx_;
 
       list.reserve(props->size());
       // collect props need to return
       if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader, props, list)
+               key, context_->vIdLen(), context_->isIntId(), reader, props, projection, list)
                .ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
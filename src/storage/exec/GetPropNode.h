@@ -83,8 +83,15 @@ class GetTagPropNode : public QueryNode<VertexID> {
               folly::StringPiece key,
               RowReader* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectVertexProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), tagNode->getTagName());
+            auto status = QueryUtils::collectVertexProps(key,
+                                                         vIdLen,
+                                                         isIntId,
+                                                         reader,
+                                                         props,
+                                                         tagNode->projection(),
+                                                         row,
+                                                         expCtx_.get(),
+                                                         tagNode->getTagName());
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -161,8 +168,15 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
               folly::StringPiece key,
               RowReader* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectEdgeProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), edgeNode->getEdgeName());
+            auto status = QueryUtils::collectEdgeProps(key,
+                                                       vIdLen,
+                                                       isIntId,
+                                                       reader,
+                                                       props,
+                                                       edgeNode->projection(),
+                                                       row,
+                                                       expCtx_.get(),
+                                                       edgeNode->getEdgeName());
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -77,6 +77,7 @@ class HashJoinNode : public IterateNode<VertexID> {
                                                          context_->isIntId(),
                                                          reader,
                                                          props,
+                                                         tagNode->projection(),
                                                          list,
                                                          expCtx_,
                                                          tagName);
@@ -152,6 +153,7 @@ class HashJoinNode : public IterateNode<VertexID> {
       // add the offset of tags and other fields
       context_->columnIdx_ = edgeContext_->offset_ + idx;
       context_->props_ = &(edgeContext_->propContexts_[idx].second);
+      context_->projection_ = edgeNodes_[iter_->getIdx()]->projection();
 
       expCtx_->resetSchema(context_->edgeName_, context_->edgeSchema_, true);
     }
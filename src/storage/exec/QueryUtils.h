@@ -6,6 +6,7 @@
 #ifndef STORAGE_EXEC_QUERYUTILS_H_
 #define STORAGE_EXEC_QUERYUTILS_H_
 
+#include "codec/RowProjection.h"
 #include "common/base/Base.h"
 #include "common/expression/Expression.h"
 #include "common/utils/DefaultValueContext.h"
@@ -66,7 +67,21 @@ class QueryUtils final {
   static StatusOr<nebula::Value> readValue(RowReader* reader,
                                            const std::string& propName,
                                            const meta::SchemaProviderIf::Field* field) {
-    auto value = reader->getValueByName(propName);
+    return toPropValue(reader->getValueByName(propName), propName, field);
+  }
+
+  /**
+   * @brief Check the value read of the prop, and replace the prop not in the schema of the row
+   * with the default value or null value
+   *
+   * @param value Value read from the row
+   * @param propName Filed name
+   * @param field Field definition
+   * @return StatusOr<nebula::Value>
+   */
+  static StatusOr<nebula::Value> toPropValue(Value value,
+                                             const std::string& propName,
+                                             const meta::SchemaProviderIf::Field* field) {
     if (value.type() == Value::Type::NULLVALUE) {
       // read null value
       auto nullType = value.getNull();
@@ -184,6 +199,38 @@ class QueryUtils final {
     return Status::Error(folly::stringPrintf("Invalid property %s", prop.name_.c_str()));
   }
 
+  /**
+   * @brief Build the projection of the props in value which are returned or filtered, the others
+   * are left out by empty names so that the values decoded are in the same order as props.
+   *
+   * @param schemas All versions of the schema of the tag or edge
+   * @param props
+   * @return std::unique_ptr<RowProjection> nullptr if none of the props is in value
+   */
+  static std::unique_ptr<RowProjection> buildProjection(
+      const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& schemas,
+      const std::vector<PropContext>* props) {
+    if (props == nullptr) {
+      return nullptr;
+    }
+    bool inValue = false;
+    std::vector<std::string> names;
+    names.reserve(props->size());
+    for (const auto& prop : *props) {
+      if (prop.propInKeyType_ == PropContext::PropInKeyType::NONE &&
+          (prop.returned_ || prop.filtered_)) {
+        inValue = true;
+        names.emplace_back(prop.name_);
+      } else {
+        names.emplace_back();
+      }
+    }
+    if (!inValue) {
+      return nullptr;
+    }
+    return std::make_unique<RowProjection>(schemas, std::move(names));
+  }
+
   static Status collectVertexProps(folly::StringPiece key,
                                    size_t vIdLen,
                                    bool isIntId,
@@ -192,11 +239,34 @@ class QueryUtils final {
                                    nebula::List& list,
                                    StorageExpressionContext* expCtx = nullptr,
                                    const std::string& tagName = "") {
-    for (const auto& prop : *props) {
+    return collectVertexProps(key, vIdLen, isIntId, reader, props, nullptr, list, expCtx, tagName);
+  }
+
+  /**
+   * @brief Collect the props of the vertex, the props in value are decoded in one pass by the
+   * projection if it's not nullptr, which is built by buildProjection of the props
+   */
+  static Status collectVertexProps(folly::StringPiece key,
+                                   size_t vIdLen,
+                                   bool isIntId,
+                                   RowReader* reader,
+                                   const std::vector<PropContext>* props,
+                                   const RowProjection* projection,
+                                   nebula::List& list,
+                                   StorageExpressionContext* expCtx = nullptr,
+                                   const std::string& tagName = "") {
+    std::vector<Value> values;
+    if (projection != nullptr) {
+      reader->getValues(*projection, &values);
+    }
+    for (size_t i = 0; i < props->size(); ++i) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
+      auto value = projection != nullptr && prop.propInKeyType_ == PropContext::PropInKeyType::NONE
+                       ? toPropValue(std::move(values[i]), prop.name_, prop.field_)
+                       : QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -217,11 +287,34 @@ class QueryUtils final {
                                  nebula::List& list,
                                  StorageExpressionContext* expCtx = nullptr,
                                  const std::string& edgeName = "") {
-    for (const auto& prop : *props) {
+    return collectEdgeProps(key, vIdLen, isIntId, reader, props, nullptr, list, expCtx, edgeName);
+  }
+
+  /**
+   * @brief Collect the props of the edge, the props in value are decoded in one pass by the
+   * projection if it's not nullptr, which is built by buildProjection of the props
+   */
+  static Status collectEdgeProps(folly::StringPiece key,
+                                 size_t vIdLen,
+                                 bool isIntId,
+                                 RowReader* reader,
+                                 const std::vector<PropContext>* props,
+                                 const RowProjection* projection,
+                                 nebula::List& list,
+                                 StorageExpressionContext* expCtx = nullptr,
+                                 const std::string& edgeName = "") {
+    std::vector<Value> values;
+    if (projection != nullptr) {
+      reader->getValues(*projection, &values);
+    }
+    for (size_t i = 0; i < props->size(); ++i) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
+      auto value = projection != nullptr && prop.propInKeyType_ == PropContext::PropInKeyType::NONE
+                       ? toPropValue(std::move(values[i]), prop.name_, prop.field_)
+                       : QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -11,6 +11,8 @@
 #include "kvstore/KVIterator.h"
 #include "storage/CommonUtils.h"
 #include "storage/StorageFlags.h"
+#include "storage/exec/BatchScanner.h"
+
 namespace nebula {
 namespace storage {
 
@@ -82,11 +84,49 @@ class SingleEdgeIterator : public StorageIterator {
                      const std::optional<std::pair<std::string, int64_t>>* ttl)
       : context_(context), iter_(std::move(iter)), edgeType_(edgeType), schemas_(schemas) {
     CHECK(!!iter_);
-    if (ttl->has_value()) {
-      hasTtl_ = true;
-      ttlCol_ = ttl->value().first;
-      ttlDuration_ = ttl->value().second;
+    setTtl(ttl);
+    while (iter_->valid() && !check()) {
+      iter_->next();
     }
+  }
+
+  /**
+   * @brief Construct a Single Edge Iterator which reads the edges of the prefix by the scanner.
+   *
+   * The iterator of the scanner is shared by all the vertices and edge types, so it doesn't seek
+   * to the prefix until open is called, i.e. the edges are going to be read.
+   *
+   * @param context
+   * @param scanner Scanner of the partition.
+   * @param prefix Prefix of the edges of the vertex and edgeType.
+   * @param edgeType EdgeType to be read.
+   * @param schemas EdgeType's all version schemas.
+   * @param ttl
+   */
+  SingleEdgeIterator(RuntimeContext* context,
+                     BatchScanner* scanner,
+                     std::string prefix,
+                     EdgeType edgeType,
+                     const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas,
+                     const std::optional<std::pair<std::string, int64_t>>* ttl)
+      : context_(context),
+        scanner_(scanner),
+        prefix_(std::move(prefix)),
+        edgeType_(edgeType),
+        schemas_(schemas) {
+    CHECK_NOTNULL(scanner_);
+    setTtl(ttl);
+  }
+
+  /**
+   * @brief Seek to the edges if it's constructed by the scanner, nothing to do otherwise
+   */
+  void open() {
+    if (scanner_ == nullptr) {
+      return;
+    }
+    iter_ = scanner_->edges(std::move(prefix_));
+    scanner_ = nullptr;
     while (iter_->valid() && !check()) {
       iter_->next();
     }
@@ -123,6 +163,14 @@ class SingleEdgeIterator : public StorageIterator {
   }
 
  protected:
+  void setTtl(const std::optional<std::pair<std::string, int64_t>>* ttl) {
+    if (ttl->has_value()) {
+      hasTtl_ = true;
+      ttlCol_ = ttl->value().first;
+      ttlDuration_ = ttl->value().second;
+    }
+  }
+
   /**
    * @brief return true when the value iter to a valid edge value
    */
@@ -144,6 +192,9 @@ class SingleEdgeIterator : public StorageIterator {
 
   RuntimeContext* context_;
   std::unique_ptr<kvstore::KVIterator> iter_;
+  // Set until open if the edges are read by the scanner
+  BatchScanner* scanner_ = nullptr;
+  std::string prefix_;
   EdgeType edgeType_;
   const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas_ = nullptr;
   bool hasTtl_ = false;
@@ -204,8 +255,12 @@ class MultiEdgeIterator : public StorageIterator {
  private:
   void moveToNextValidIterator() {
     while (curIter_ < iters_.size()) {
-      if (iters_[curIter_] && iters_[curIter_]->valid()) {
-        return;
+      if (iters_[curIter_]) {
+        // The ones reading by the scanner are opened one by one
+        iters_[curIter_]->open();
+        if (iters_[curIter_]->valid()) {
+          return;
+        }
       }
       ++curIter_;
     }
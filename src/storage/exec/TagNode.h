@@ -7,6 +7,7 @@
 #define STORAGE_EXEC_TAGNODE_H_
 
 #include "common/base/Base.h"
+#include "storage/VertexCache.h"
 #include "storage/exec/RelNode.h"
 #include "storage/exec/StorageIterator.h"
 
@@ -48,6 +49,7 @@ class TagNode final : public IterateNode<VertexID> {
     CHECK(schemaIter != tagContext_->schemas_.end());
     CHECK(!schemaIter->second.empty());
     schemas_ = &(schemaIter->second);
+    projection_ = QueryUtils::buildProjection(*schemas_, props_);
     ttl_ = QueryUtils::getTagTTLInfo(tagContext_, tagId_);
     tagName_ = tagContext_->tagNames_[tagId_];
     name_ = "TagNode";
@@ -63,8 +65,24 @@ class TagNode final : public IterateNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", tagId " << tagId_ << ", prop size "
             << props_->size();
     key_ = NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_);
+    if (scanner_ != nullptr) {
+      // The tag has been read by the scanner with the others of the batch
+      const auto* value = scanner_->tag(key_);
+      return value == nullptr ? nebula::cpp2::ErrorCode::SUCCEEDED : doExecute(key_, *value);
+    }
+    // The tag is read from the vertex cache if it is enabled, and put into it on miss
+    auto* cache = context_->env()->vertexCache_;
+    uint64_t version = 0;
+    bool cacheable =
+        cache != nullptr && CommonUtils::isLeader(context_->env(), context_->spaceId(), partId);
+    if (cacheable && cache->get(context_->spaceId(), key_, &value_, &version)) {
+      return doExecute(key_, value_);
+    }
     ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &value_);
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      if (cacheable) {
+        cache->insert(context_->spaceId(), key_, value_, version);
+      }
       return doExecute(key_, value_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       // regard key not found as succeed as well, upper node will handle it
@@ -73,6 +91,15 @@ class TagNode final : public IterateNode<VertexID> {
     return ret;
   }
 
+  /**
+   * @brief Read the tag from the ones prefetched by the scanner instead of the kvstore
+   *
+   * @param scanner
+   */
+  void setBatchScanner(BatchScanner* scanner) {
+    scanner_ = scanner;
+  }
+
   /**
    * @brief For resuming from a breakpoint.
    *
@@ -131,6 +158,13 @@ class TagNode final : public IterateNode<VertexID> {
     return tagId_;
   }
 
+  /**
+   * @brief Projection of the props in value, nullptr if none of them is in value
+   */
+  const RowProjection* projection() const {
+    return projection_.get();
+  }
+
   void clear() {
     valid_ = false;
     key_.clear();
@@ -158,8 +192,10 @@ class TagNode final : public IterateNode<VertexID> {
   StorageExpressionContext* expCtx_;
   Expression* exp_;
   const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas_ = nullptr;
+  std::unique_ptr<RowProjection> projection_;
   std::optional<std::pair<std::string, int64_t>> ttl_;
   std::string tagName_;
+  BatchScanner* scanner_ = nullptr;
 
   bool valid_ = false;
   std::string key_;
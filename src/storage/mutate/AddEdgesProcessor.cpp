@@ -120,7 +120,7 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
 
       auto props = newEdge.get_props();
       WriteResult wRet;
-      auto retEnc = encodeRowVal(schema.get(), propNames, props, wRet);
+      auto retEnc = encodeRowVal(schema, propNames, props, wRet);
       if (!retEnc.ok()) {
         LOG(ERROR) << retEnc.status();
         code = writeResultTo(wRet, true);
@@ -186,7 +186,7 @@ void AddEdgesProcessor::doProcessWithIndex(const cpp2::AddEdgesRequest& req) {
       // collect values
       WriteResult writeResult;
       const auto& props = edge.get_props();
-      auto encode = encodeRowVal(schema.get(), propNames, props, writeResult);
+      auto encode = encodeRowVal(schema, propNames, props, writeResult);
       if (!encode.ok()) {
         LOG(ERROR) << encode.status();
         code = writeResultTo(writeResult, true);
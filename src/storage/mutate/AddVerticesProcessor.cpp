@@ -116,7 +116,7 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
         }
 
         WriteResult wRet;
-        auto retEnc = encodeRowVal(schema.get(), propNames, props, wRet);
+        auto retEnc = encodeRowVal(schema, propNames, props, wRet);
         if (!retEnc.ok()) {
           LOG(ERROR) << retEnc.status();
           code = writeResultTo(wRet, false);
@@ -182,7 +182,7 @@ void AddVerticesProcessor::doProcessWithIndex(const cpp2::AddVerticesRequest& re
         }
 
         WriteResult writeResult;
-        auto encode = encodeRowVal(schema.get(), propNames, props, writeResult);
+        auto encode = encodeRowVal(schema, propNames, props, writeResult);
         if (!encode.ok()) {
           LOG(ERROR) << encode.status();
           code = writeResultTo(writeResult, false);
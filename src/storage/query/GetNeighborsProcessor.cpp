@@ -77,11 +77,17 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
                                               bool random) {
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
-  auto plan = buildPlan(&contexts_.front(), &expCtxs_.front(), &resultDataSet_, limit, random);
+  std::unique_ptr<BatchScanner> scanner;
+  if (FLAGS_query_batch_scan) {
+    scanner = std::make_unique<BatchScanner>(&contexts_.front());
+  }
+  auto plan = buildPlan(
+      &contexts_.front(), &expCtxs_.front(), &resultDataSet_, limit, random, scanner.get());
   std::unordered_set<PartitionID> failedParts;
   for (const auto& partEntry : req.get_parts()) {
     contexts_.front().resultStat_ = ResultStatus::NORMAL;
     auto partId = partEntry.first;
+    std::vector<VertexID> vIds;
     for (const auto& row : partEntry.second) {
       CHECK_GE(row.values.size(), 1);
       auto vId = row.values[0].getStr();
@@ -93,6 +99,10 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
         onFinished();
         return;
       }
+      if (scanner != nullptr) {
+        vIds.emplace_back(std::move(vId));
+        continue;
+      }
 
       // the first column of each row would be the vertex id
       auto ret = plan.go(partId, vId);
@@ -103,6 +113,12 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
         }
       }
     }
+    if (scanner != nullptr) {
+      auto ret = goInBatch(plan, scanner.get(), partId, std::move(vIds));
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(ret, spaceId_, partId);
+      }
+    }
   }
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan);
@@ -155,7 +171,12 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
     bool random) {
   return folly::via(
       executor_, [this, context, expCtx, result, partId, input = std::move(rows), limit, random]() {
-        auto plan = buildPlan(context, expCtx, result, limit, random);
+        std::unique_ptr<BatchScanner> scanner;
+        if (FLAGS_query_batch_scan) {
+          scanner = std::make_unique<BatchScanner>(context);
+        }
+        auto plan = buildPlan(context, expCtx, result, limit, random, scanner.get());
+        std::vector<VertexID> vIds;
         for (const auto& row : input) {
           CHECK_GE(row.values.size(), 1);
           auto vId = row.values[0].getStr();
@@ -165,6 +186,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                       << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
             return std::make_pair(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
           }
+          if (scanner != nullptr) {
+            vIds.emplace_back(std::move(vId));
+            continue;
+          }
 
           // the first column of each row would be the vertex id
           auto ret = plan.go(partId, vId);
@@ -172,6 +197,12 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
             return std::make_pair(ret, partId);
           }
         }
+        if (scanner != nullptr) {
+          auto ret = goInBatch(plan, scanner.get(), partId, std::move(vIds));
+          if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+            return std::make_pair(ret, partId);
+          }
+        }
         if (UNLIKELY(this->profileDetailFlag_)) {
           profilePlan(plan);
         }
@@ -183,7 +214,8 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
                                                        StorageExpressionContext* expCtx,
                                                        nebula::DataSet* result,
                                                        int64_t limit,
-                                                       bool random) {
+                                                       bool random,
+                                                       BatchScanner* scanner) {
   /*
   The StoragePlan looks like this:
              +------------------+                      or, if there is no edge:
@@ -217,12 +249,14 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
   std::vector<TagNode*> tags;
   for (const auto& tc : tagContext_.propContexts_) {
     auto tag = std::make_unique<TagNode>(context, &tagContext_, tc.first, &tc.second);
+    tag->setBatchScanner(scanner);
     tags.emplace_back(tag.get());
     plan.addNode(std::move(tag));
   }
   std::vector<SingleEdgeNode*> edges;
   for (const auto& ec : edgeContext_.propContexts_) {
     auto edge = std::make_unique<SingleEdgeNode>(context, &edgeContext_, ec.first, &ec.second);
+    edge->setBatchScanner(scanner);
     edges.emplace_back(edge.get());
     plan.addNode(std::move(edge));
   }
@@ -470,5 +504,48 @@ void GetNeighborsProcessor::profilePlan(StoragePlan<VertexID>& plan) {
     profileDetail(node->name_, node->duration_.elapsedInUSec());
   }
 }
+
+nebula::cpp2::ErrorCode GetNeighborsProcessor::goInBatch(StoragePlan<VertexID>& plan,
+                                                         BatchScanner* scanner,
+                                                         PartitionID partId,
+                                                         std::vector<VertexID> vIds) {
+  // The tags and edges of the vertices are ordered by the vertex id in kvstore
+  std::sort(vIds.begin(), vIds.end());
+  auto ret = scanner->reset(partId);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  std::vector<TagID> tagIds;
+  tagIds.reserve(tagContext_.propContexts_.size());
+  for (const auto& tc : tagContext_.propContexts_) {
+    tagIds.emplace_back(tc.first);
+  }
+  // Same as going vertex by vertex, a failed vertex doesn't stop the remaining ones, and the
+  // first error is returned
+  auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+  size_t batchSize = std::max(FLAGS_query_batch_scan_size, 1);
+  for (size_t begin = 0; begin < vIds.size(); begin += batchSize) {
+    auto end = std::min(begin + batchSize, vIds.size());
+    std::vector<VertexID> batch(std::make_move_iterator(vIds.begin() + begin),
+                                std::make_move_iterator(vIds.begin() + end));
+    ret = scanner->prefetchTags(batch, tagIds);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // The tags of the whole batch are unknown, so all of its vertices fail
+      if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        code = ret;
+      }
+      continue;
+    }
+    for (const auto& vId : batch) {
+      // the first column of each row would be the vertex id
+      ret = plan.go(partId, vId);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED && code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        code = ret;
+      }
+    }
+  }
+  return code;
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -9,6 +9,7 @@
 #include <gtest/gtest_prod.h>
 
 #include "common/base/Base.h"
+#include "storage/exec/BatchScanner.h"
 #include "storage/exec/StoragePlan.h"
 #include "storage/query/QueryBaseProcessor.h"
 
@@ -53,7 +54,8 @@ class GetNeighborsProcessor
                                   StorageExpressionContext* expCtx,
                                   nebula::DataSet* result,
                                   int64_t limit = 0,
-                                  bool random = false);
+                                  bool random = false,
+                                  BatchScanner* scanner = nullptr);
 
   void onProcessFinished() override;
 
@@ -85,6 +87,13 @@ class GetNeighborsProcessor
       bool random);
   void profilePlan(StoragePlan<VertexID>& plan);
 
+  // Go from the vertices of the part in the order of their ids, with the tags read by one
+  // multiGet per batch and the edges scanned by one iterator of the scanner
+  nebula::cpp2::ErrorCode goInBatch(StoragePlan<VertexID>& plan,
+                                    BatchScanner* scanner,
+                                    PartitionID partId,
+                                    std::vector<VertexID> vIds);
+
  private:
   std::vector<RuntimeContext> contexts_;
   std::vector<StorageExpressionContext> expCtxs_;
@@ -13,6 +13,14 @@ stats::CounterId kNumVerticesInserted;
 stats::CounterId kNumEdgesDeleted;
 stats::CounterId kNumTagsDeleted;
 stats::CounterId kNumVerticesDeleted;
+stats::CounterId kNumVertexCacheHits;
+stats::CounterId kNumVertexCacheMisses;
+stats::CounterId kNumVertexCacheEvicts;
+stats::CounterId kNumAdjacencyCacheHits;
+stats::CounterId kNumAdjacencyCacheMisses;
+stats::CounterId kNumAdjacencyCacheEvicts;
+stats::CounterId kNumAdjacencyCacheUncacheableHits;
+stats::CounterId kNumAdjacencyCacheUncacheableEvicts;
 
 void initStorageStats() {
   kNumEdgesInserted = stats::StatsManager::registerStats("num_edges_inserted", "rate, sum");
@@ -20,6 +28,21 @@ void initStorageStats() {
   kNumEdgesDeleted = stats::StatsManager::registerStats("num_edges_deleted", "rate, sum");
   kNumTagsDeleted = stats::StatsManager::registerStats("num_tags_deleted", "rate, sum");
   kNumVerticesDeleted = stats::StatsManager::registerStats("num_vertices_deleted", "rate, sum");
+  kNumVertexCacheHits = stats::StatsManager::registerStats("num_vertex_cache_hits", "rate, sum");
+  kNumVertexCacheMisses =
+      stats::StatsManager::registerStats("num_vertex_cache_misses", "rate, sum");
+  kNumVertexCacheEvicts =
+      stats::StatsManager::registerStats("num_vertex_cache_evicts", "rate, sum");
+  kNumAdjacencyCacheHits =
+      stats::StatsManager::registerStats("num_adjacency_cache_hits", "rate, sum");
+  kNumAdjacencyCacheMisses =
+      stats::StatsManager::registerStats("num_adjacency_cache_misses", "rate, sum");
+  kNumAdjacencyCacheEvicts =
+      stats::StatsManager::registerStats("num_adjacency_cache_evicts", "rate, sum");
+  kNumAdjacencyCacheUncacheableHits =
+      stats::StatsManager::registerStats("num_adjacency_cache_uncacheable_hits", "rate, sum");
+  kNumAdjacencyCacheUncacheableEvicts =
+      stats::StatsManager::registerStats("num_adjacency_cache_uncacheable_evicts", "rate, sum");
 
 #ifndef BUILD_STANDALONE
   initMetaClientStats();
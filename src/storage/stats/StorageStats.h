@@ -15,6 +15,14 @@ extern stats::CounterId kNumVerticesInserted;
 extern stats::CounterId kNumEdgesDeleted;
 extern stats::CounterId kNumTagsDeleted;
 extern stats::CounterId kNumVerticesDeleted;
+extern stats::CounterId kNumVertexCacheHits;
+extern stats::CounterId kNumVertexCacheMisses;
+extern stats::CounterId kNumVertexCacheEvicts;
+extern stats::CounterId kNumAdjacencyCacheHits;
+extern stats::CounterId kNumAdjacencyCacheMisses;
+extern stats::CounterId kNumAdjacencyCacheEvicts;
+extern stats::CounterId kNumAdjacencyCacheUncacheableHits;
+extern stats::CounterId kNumAdjacencyCacheUncacheableEvicts;
 
 /**
  * @brief Init storage statistic points for storage/meta client/kv
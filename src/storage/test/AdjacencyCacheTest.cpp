@@ -0,0 +1,227 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "storage/AdjacencyCache.h"
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+constexpr size_t kVIdLen = 8;
+constexpr PartitionID kPartId = 1;
+constexpr EdgeType kEdgeType = 101;
+
+class VectorIterator final : public kvstore::KVIterator {
+ public:
+  explicit VectorIterator(const std::vector<std::pair<std::string, std::string>>& kvs)
+      : kvs_(kvs) {}
+
+  bool valid() const override {
+    return index_ < kvs_.size();
+  }
+
+  void next() override {
+    index_++;
+  }
+
+  void prev() override {
+    index_--;
+  }
+
+  folly::StringPiece key() const override {
+    return kvs_[index_].first;
+  }
+
+  folly::StringPiece val() const override {
+    return kvs_[index_].second;
+  }
+
+ private:
+  const std::vector<std::pair<std::string, std::string>>& kvs_;
+  size_t index_{0};
+};
+
+std::string edgeKey(const VertexID& src, EdgeRanking rank) {
+  return NebulaKeyUtils::edgeKey(kVIdLen, kPartId, src, kEdgeType, rank, "dst");
+}
+
+std::string prefix(const VertexID& src) {
+  return NebulaKeyUtils::edgePrefix(kVIdLen, kPartId, src, kEdgeType);
+}
+
+std::vector<std::pair<std::string, std::string>> edges(const VertexID& src, int32_t degree) {
+  std::vector<std::pair<std::string, std::string>> kvs;
+  for (int32_t i = 0; i < degree; i++) {
+    kvs.emplace_back(edgeKey(src, i), folly::to<std::string>(i));
+  }
+  return kvs;
+}
+
+std::shared_ptr<const EdgeBlock> block(const VertexID& src, int32_t degree) {
+  auto kvs = edges(src, degree);
+  VectorIterator iter(kvs);
+  return std::make_shared<const EdgeBlock>(&iter);
+}
+
+}  // namespace
+
+TEST(AdjacencyCacheTest, EdgeBlockTest) {
+  auto edges = block("src", 10);
+  ASSERT_EQ(10UL, edges->size());
+  EdgeBlockIterator iter(edges);
+  for (int32_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(iter.valid());
+    EXPECT_EQ(edgeKey("src", i), iter.key());
+    EXPECT_EQ(folly::to<std::string>(i), iter.val());
+    iter.next();
+  }
+  EXPECT_FALSE(iter.valid());
+
+  iter.seek(edgeKey("src", 5));
+  ASSERT_TRUE(iter.valid());
+  EXPECT_EQ("5", iter.val());
+  iter.prev();
+  ASSERT_TRUE(iter.valid());
+  EXPECT_EQ("4", iter.val());
+  iter.seek(prefix("src"));
+  ASSERT_TRUE(iter.valid());
+  EXPECT_EQ("0", iter.val());
+  iter.prev();
+  EXPECT_FALSE(iter.valid());
+  iter.seek(prefix("src2"));
+  EXPECT_FALSE(iter.valid());
+
+  EXPECT_EQ(0UL, block("src", 0)->size());
+
+  // Read until the block would be too large
+  auto kvs = edges("src", 10);
+  auto maxBytes = block("src", 4)->bytes();
+  VectorIterator kvIter(kvs);
+  EdgeBlock partial(&kvIter, maxBytes);
+  EXPECT_EQ(4UL, partial.size());
+  EXPECT_EQ(maxBytes, partial.bytes());
+  ASSERT_TRUE(kvIter.valid());
+  EXPECT_EQ(edgeKey("src", 4), kvIter.key());
+}
+
+TEST(AdjacencyCacheTest, AdmissionTest) {
+  AdjacencyCache cache(1024 * 1024, 4, 3, 2);
+  uint64_t version = 0;
+  bool admit = false;
+  // Not admitted until read twice
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src"), &version, &admit));
+  EXPECT_FALSE(admit);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src"), &version, &admit));
+  EXPECT_TRUE(admit);
+  // Not cached without enough edges, which is remembered until the edges are changed
+  cache.insert(1, prefix("src"), block("src", 2), version);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src"), &version, &admit));
+  EXPECT_FALSE(admit);
+  std::vector<std::string> keys = {edgeKey("src", 2)};
+  cache.evict(1, &keys);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src"), &version, &admit));
+  EXPECT_TRUE(admit);
+  cache.insert(1, prefix("src"), block("src", 3), version);
+  auto edges = cache.get(1, prefix("src"), &version, &admit);
+  ASSERT_NE(nullptr, edges);
+  EXPECT_EQ(3UL, edges->size());
+  // The same prefix of another space
+  EXPECT_EQ(nullptr, cache.get(2, prefix("src"), &version, &admit));
+  EXPECT_FALSE(admit);
+}
+
+TEST(AdjacencyCacheTest, LargePrefixTest) {
+  // 2KB in each of the 16 buckets, 1/16 of which for the prefixes not cacheable
+  AdjacencyCache cache(32 * 1024, 4, 1, 1);
+  auto maxBytes = cache.maxBlockBytes(prefix("hub"));
+  ASSERT_GT(maxBytes, 0UL);
+  ASSERT_LT(maxBytes, 2048UL);
+  uint64_t version = 0;
+  bool admit = false;
+  EXPECT_EQ(nullptr, cache.get(1, prefix("hub"), &version, &admit));
+  EXPECT_TRUE(admit);
+
+  // The edges of the hub are not read beyond the capacity of a bucket
+  auto kvs = edges("hub", 1000);
+  VectorIterator iter(kvs);
+  EdgeBlock partial(&iter, maxBytes);
+  EXPECT_TRUE(iter.valid());
+  EXPECT_LE(partial.bytes(), maxBytes);
+  EXPECT_LT(partial.size(), 1000UL);
+
+  // The hub is remembered not to be cacheable, so it's not admitted again
+  cache.insert(1, prefix("hub"), nullptr, version);
+  EXPECT_LT(cache.bytes(), 1024UL);
+  for (int32_t i = 0; i < 3; i++) {
+    EXPECT_EQ(nullptr, cache.get(1, prefix("hub"), &version, &admit));
+    EXPECT_FALSE(admit);
+  }
+  // The edges of a smaller vertex still fit
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src"), &version, &admit));
+  cache.insert(1, prefix("src"), block("src", 10), version);
+  EXPECT_NE(nullptr, cache.get(1, prefix("src"), &version, &admit));
+
+  // The prefixes not cacheable don't evict the edges cached
+  for (int32_t i = 0; i < 1000; i++) {
+    auto vId = folly::stringPrintf("v%d", i);
+    EXPECT_EQ(nullptr, cache.get(1, prefix(vId), &version, &admit));
+    cache.insert(1, prefix(vId), nullptr, version);
+  }
+  EXPECT_NE(nullptr, cache.get(1, prefix("src"), &version, &admit));
+
+  // Until the edges of the hub are changed
+  std::vector<std::string> keys = {edgeKey("hub", 1)};
+  cache.evict(1, &keys);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("hub"), &version, &admit));
+  EXPECT_TRUE(admit);
+}
+
+TEST(AdjacencyCacheTest, EvictTest) {
+  AdjacencyCache cache(1024 * 1024, 0, 1, 1);
+  uint64_t version = 0;
+  bool admit = false;
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  cache.insert(1, prefix("src1"), block("src1", 10), version);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src2"), &version, &admit));
+  cache.insert(1, prefix("src2"), block("src2", 10), version);
+  ASSERT_NE(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  ASSERT_NE(nullptr, cache.get(1, prefix("src2"), &version, &admit));
+
+  // Evicted by the lock of an edge of the prefix
+  std::vector<std::string> keys = {
+      NebulaKeyUtils::edgeKey(kVIdLen, kPartId, "src1", kEdgeType, 20, "dst", 0)};
+  cache.evict(1, &keys);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  EXPECT_NE(nullptr, cache.get(1, prefix("src2"), &version, &admit));
+
+  // The edges read before the change are not inserted
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  keys = {edgeKey("src1", 1), edgeKey("src1", 2)};
+  cache.evict(1, &keys);
+  cache.insert(1, prefix("src1"), block("src1", 10), version);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  cache.insert(1, prefix("src1"), block("src1", 9), version);
+  EXPECT_NE(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+
+  cache.evict(1, nullptr);
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src1"), &version, &admit));
+  EXPECT_EQ(nullptr, cache.get(1, prefix("src2"), &version, &admit));
+  EXPECT_EQ(0UL, cache.bytes());
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -7,6 +7,7 @@
 
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
+#include "storage/AdjacencyCache.h"
 #include "storage/query/GetNeighborsProcessor.h"
 #include "storage/test/QueryTestUtils.h"
 
@@ -2020,6 +2021,180 @@ TEST(GetNeighborsTest, FilterTest) {
   }
 }
 
+// The vertices and their edges in the response, sorted by the vids, since the vertices of a part
+// are visited in different orders in the batch scans
+static nebula::DataSet getNeighbors(StorageEnv* env,
+                                    folly::Executor* executor,
+                                    const cpp2::GetNeighborsRequest& req) {
+  auto* processor = GetNeighborsProcessor::instance(env, nullptr, executor);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+  auto ds = *resp.vertices_ref();
+  std::sort(ds.rows.begin(), ds.rows.end(), [](const Row& lhs, const Row& rhs) {
+    return lhs.values.front() < rhs.values.front();
+  });
+  return ds;
+}
+
+TEST(GetNeighborsTest, BatchScanTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  TagID player = 1;
+  TagID team = 2;
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+
+  auto vertices = mock::MockData::mockVerticeIds();
+  vertices.emplace_back("Not Exist");
+  std::vector<EdgeType> over = {serve, -serve, teammate, -teammate};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  tags.emplace_back(team, std::vector<std::string>{"name"});
+  edges.emplace_back(serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(-serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  edges.emplace_back(-teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+
+  auto expected = getNeighbors(env, threadPool.get(), req);
+  ASSERT_LT(0UL, expected.rowSize());
+
+  gflags::FlagSaver saver;
+  FLAGS_query_batch_scan = true;
+  for (auto batchSize : {1, 3, 1024}) {
+    FLAGS_query_batch_scan_size = batchSize;
+    for (auto concurrently : {false, true}) {
+      FLAGS_query_concurrently = concurrently;
+      LOG(INFO) << "BatchScan, batch size " << batchSize << ", concurrently " << concurrently;
+      EXPECT_EQ(expected, getNeighbors(env, threadPool.get(), req));
+    }
+  }
+}
+
+TEST(GetNeighborsTest, AdjacencyCacheTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  // Outlives the cluster, whose parts evict the changed edges from it
+  AdjacencyCache cache(1024 * 1024, 4, 1, 2);
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  std::vector<std::pair<GraphSpaceID, PartitionID>> existParts;
+  cluster.storageKV_->registerOnNewPartAdded(
+      "AdjacencyCache",
+      [&cache](std::shared_ptr<kvstore::Part>& part) {
+        part->registerOnEdgesChanged(
+            [&cache](GraphSpaceID spaceId, PartitionID, const std::vector<std::string>* keys) {
+              cache.evict(spaceId, keys);
+            });
+      },
+      existParts);
+
+  TagID player = 1;
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+
+  auto vertices = mock::MockData::mockVerticeIds();
+  std::vector<EdgeType> over = {serve, -serve, teammate, -teammate};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name"});
+  edges.emplace_back(serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(-serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  edges.emplace_back(-teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+
+  // Remove an edge of Tim Duncan
+  auto write = [&] {
+    GraphSpaceID spaceId = 1;
+    auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+    PartitionID partId = (std::hash<std::string>()("Tim Duncan") % totalParts) + 1;
+    auto prefix = NebulaKeyUtils::edgePrefix(vIdLen, partId, "Tim Duncan", serve);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env->kvstore_->prefix(spaceId, partId, prefix, &iter));
+    ASSERT_TRUE(iter->valid());
+    auto key = iter->key().str();
+    iter.reset();
+
+    folly::Baton<true, std::atomic> baton;
+    env->kvstore_->asyncRemove(spaceId, partId, key, [&](nebula::cpp2::ErrorCode code) {
+      EXPECT_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
+      baton.post();
+    });
+    baton.wait();
+  };
+
+  // The edges are cached after being read twice
+  QueryTestUtils::checkReadThroughCache(
+      [&] { return getNeighbors(env, threadPool.get(), req); },
+      [&](bool enable) { env->adjacencyCache_ = enable ? &cache : nullptr; },
+      [&] { return cache.bytes(); },
+      2,
+      write);
+}
+
+TEST(GetNeighborsTest, AdjacencyCacheLargePrefixTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  // One bucket, which can't hold the edges of any vertex
+  AdjacencyCache cache(256, 0, 1, 1);
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+
+  GraphSpaceID spaceId = 1;
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+  PartitionID partId = (std::hash<std::string>()("Tim Duncan") % totalParts) + 1;
+  auto prefix = NebulaKeyUtils::edgePrefix(vIdLen, partId, "Tim Duncan", serve);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            env->kvstore_->prefix(spaceId, partId, prefix, &iter));
+  ASSERT_GT(EdgeBlock(iter.get()).bytes(), cache.maxBlockBytes(prefix));
+  iter.reset();
+
+  auto vertices = mock::MockData::mockVerticeIds();
+  std::vector<EdgeType> over = {serve, -serve, teammate, -teammate};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  edges.emplace_back(serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(-serve, std::vector<std::string>{"playerName", "teamName", "startYear"});
+  edges.emplace_back(teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  edges.emplace_back(-teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+
+  auto expected = getNeighbors(env, threadPool.get(), req);
+  // The edges are admitted by every read, but iterated over in the kvstore since they are more
+  // than a bucket holds
+  env->adjacencyCache_ = &cache;
+  for (int32_t i = 0; i < 3; i++) {
+    ASSERT_EQ(expected, getNeighbors(env, threadPool.get(), req));
+    ASSERT_LE(cache.bytes(), 256UL);
+  }
+  env->adjacencyCache_ = nullptr;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
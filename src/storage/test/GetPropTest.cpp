@@ -7,6 +7,7 @@
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
 #include "kvstore/RocksEngineConfig.h"
+#include "storage/VertexCache.h"
 #include "storage/query/GetPropProcessor.h"
 #include "storage/test/QueryTestUtils.h"
 
@@ -969,6 +970,81 @@ TEST(GetPropTest, LimitTest) {
   }
 }
 
+TEST(GetPropTest, VertexCacheTest) {
+  fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
+  // Outlives the cluster, whose parts evict the changed tags from it
+  VertexCache cache(1024 * 1024, 4);
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+
+  std::vector<std::pair<GraphSpaceID, PartitionID>> existParts;
+  cluster.storageKV_->registerOnNewPartAdded(
+      "VertexCache",
+      [&cache](std::shared_ptr<kvstore::Part>& part) {
+        part->registerOnTagsChanged(
+            [&cache](GraphSpaceID spaceId, PartitionID, const std::vector<std::string>* keys) {
+              cache.evict(spaceId, keys);
+            });
+      },
+      existParts);
+
+  TagID player = 1;
+  std::vector<VertexID> vertices = {"Tim Duncan"};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  auto req = buildVertexRequest(totalParts, vertices, tags);
+  auto getProps = [&]() {
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    return *resp.props_ref();
+  };
+
+  // Set the age of Tim Duncan to 45
+  GraphSpaceID spaceId = 1;
+  auto write = [&] {
+    auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+    PartitionID partId = (std::hash<std::string>()("Tim Duncan") % totalParts) + 1;
+    auto key = NebulaKeyUtils::tagKey(vIdLen, partId, "Tim Duncan", player);
+    std::vector<Value> props;
+    for (const auto& vertex : mock::MockData::mockVertices()) {
+      if (vertex.vId_ == "Tim Duncan" && vertex.tId_ == player) {
+        props = vertex.props_;
+      }
+    }
+    ASSERT_FALSE(props.empty());
+    props[1] = 45;
+    std::vector<kvstore::KV> data;
+    auto schema = env->schemaMan_->getTagSchema(spaceId, player);
+    ASSERT_TRUE(QueryTestUtils::encode(schema.get(), key, props, data));
+    folly::Baton<true, std::atomic> baton;
+    env->kvstore_->asyncMultiPut(
+        spaceId, partId, std::move(data), [&](nebula::cpp2::ErrorCode code) {
+          EXPECT_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
+          baton.post();
+        });
+    baton.wait();
+  };
+
+  // The tags are cached by the first read
+  QueryTestUtils::checkReadThroughCache(
+      getProps,
+      [&](bool enable) { env->vertexCache_ = enable ? &cache : nullptr; },
+      [&] { return cache.bytes(); },
+      1,
+      write);
+
+  nebula::DataSet expected;
+  expected.colNames = {kVid, "1.name", "1.age", "1.avgScore"};
+  expected.rows.emplace_back(nebula::Row({"Tim Duncan", "Tim Duncan", 45, 19.0}));
+  ASSERT_EQ(expected, getProps());
+}
+
 }  // namespace storage
 }  // namespace nebula
 
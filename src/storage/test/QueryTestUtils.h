@@ -351,6 +351,51 @@ class QueryTestUtils {
     return req;
   }
 
+  // Check a cache of the storage env, which is filled by the reads and evicted by the writes of
+  // the data read: the results read through it must be the same as the ones read from the kvstore
+  // read: read the data, through the cache if it's enabled
+  // enableCache: turn the cache on or off
+  // cacheBytes: bytes of the cache
+  // numReadsToFill: number of the reads until the data is cached
+  // write: change the data read and wait until it's applied
+  static void checkReadThroughCache(const std::function<nebula::DataSet()>& read,
+                                    const std::function<void(bool)>& enableCache,
+                                    const std::function<size_t()>& cacheBytes,
+                                    size_t numReadsToFill,
+                                    const std::function<void()>& write) {
+    enableCache(false);
+    auto expected = read();
+    enableCache(true);
+    {
+      LOG(INFO) << "ReadFromKVStore";
+      ASSERT_EQ(0UL, cacheBytes());
+      for (size_t i = 1; i < numReadsToFill; i++) {
+        ASSERT_EQ(expected, read());
+        ASSERT_EQ(0UL, cacheBytes());
+      }
+      ASSERT_EQ(expected, read());
+      ASSERT_NE(0UL, cacheBytes());
+    }
+    {
+      LOG(INFO) << "ReadFromCache";
+      ASSERT_EQ(expected, read());
+    }
+    {
+      LOG(INFO) << "EvictedByWrite";
+      auto bytes = cacheBytes();
+      write();
+      ASSERT_LT(cacheBytes(), bytes);
+      enableCache(false);
+      expected = read();
+      ASSERT_NE(0UL, expected.rowSize());
+      enableCache(true);
+      // Read from the kvstore until it's cached again
+      for (size_t i = 0; i <= numReadsToFill; i++) {
+        ASSERT_EQ(expected, read());
+      }
+    }
+  }
+
   // | vId | stat |     tag       |   ...   |      edge      | ...
   //              | prop ... prop |   ...   | prop .... prop |
   // check response when tags or edges is specified
@@ -267,6 +267,13 @@ TEST_F(StatsTaskTest, StatsTagAndEdgeData) {
     // ASSERT_EQ(81, *statsItem.space_vertices_ref());
     EXPECT_EQ(81, *statsItem.space_vertices_ref());
     ASSERT_EQ(167, *statsItem.space_edges_ref());
+
+    // The partial degree distributions to be merged by meta
+    auto& outDegrees = statsItem.get_out_degrees();
+    ASSERT_EQ(1, outDegrees.count("101"));
+    EXPECT_LT(0, outDegrees.at("101").get_count());
+    EXPECT_EQ(0, outDegrees.at("101").get_null_count());
+    EXPECT_FALSE(outDegrees.at("101").get_samples().empty());
   }
 
   // Check the data count
@@ -0,0 +1,90 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "storage/VertexCache.h"
+
+namespace nebula {
+namespace storage {
+
+TEST(VertexCacheTest, SimpleTest) {
+  VertexCache cache(1024 * 1024, 4);
+  std::string value;
+  uint64_t version = 0;
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+  cache.insert(1, "key", "value", version);
+  EXPECT_TRUE(cache.get(1, "key", &value, &version));
+  EXPECT_EQ("value", value);
+  // The same key of another space
+  EXPECT_FALSE(cache.get(2, "key", &value, &version));
+
+  std::vector<std::string> keys = {"key"};
+  cache.evict(1, &keys);
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+  EXPECT_EQ(0, cache.bytes());
+}
+
+TEST(VertexCacheTest, StaleInsertTest) {
+  VertexCache cache(1024 * 1024, 0);
+  std::string value;
+  uint64_t version = 0;
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+  // The tag is changed after being read from the kvstore
+  std::vector<std::string> keys = {"key"};
+  cache.evict(1, &keys);
+  cache.insert(1, "key", "old", version);
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+  cache.insert(1, "key", "new", version);
+  EXPECT_TRUE(cache.get(1, "key", &value, &version));
+  EXPECT_EQ("new", value);
+
+  EXPECT_FALSE(cache.get(1, "other", &value, &version));
+  cache.evict(1, nullptr);
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+  cache.insert(1, "other", "value", version);
+  EXPECT_TRUE(cache.get(1, "other", &value, &version));
+  cache.insert(1, "key", "value", version - 1);
+  EXPECT_FALSE(cache.get(1, "key", &value, &version));
+}
+
+TEST(VertexCacheTest, CapacityTest) {
+  std::string value(1000, 'v');
+  // Room for 10 entries in the only bucket
+  VertexCache cache(11 * 1024, 0);
+  uint64_t version = 0;
+  std::string got;
+  for (int32_t i = 0; i < 10; i++) {
+    auto key = folly::stringPrintf("key%d", i);
+    EXPECT_FALSE(cache.get(1, key, &got, &version));
+    cache.insert(1, key, value, version);
+  }
+  EXPECT_LE(cache.bytes(), 11 * 1024UL);
+  // key2 is the least recently used one after key0 and key1 are read
+  EXPECT_TRUE(cache.get(1, "key0", &got, &version));
+  EXPECT_TRUE(cache.get(1, "key1", &got, &version));
+  EXPECT_FALSE(cache.get(1, "key10", &got, &version));
+  cache.insert(1, "key10", value, version);
+  EXPECT_LE(cache.bytes(), 11 * 1024UL);
+  EXPECT_FALSE(cache.get(1, "key2", &got, &version));
+  EXPECT_TRUE(cache.get(1, "key0", &got, &version));
+  EXPECT_TRUE(cache.get(1, "key10", &got, &version));
+
+  // The value larger than a bucket is not cached
+  EXPECT_FALSE(cache.get(1, "large", &got, &version));
+  cache.insert(1, "large", std::string(20 * 1024, 'v'), version);
+  EXPECT_FALSE(cache.get(1, "large", &got, &version));
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -283,6 +283,8 @@ class NebulaService(object):
         self.graphd_param['password_lock_time_in_secs'] = '10'
         # expression depth limit
         self.graphd_param['max_expression_depth'] = '128'
+        # run the queries on the cached plans too
+        self.graphd_param['plan_cache_capacity'] = '1024'
 
         self.storaged_param = copy.copy(_params)
         self.storaged_param['local_config'] = 'false'
@@ -122,6 +122,7 @@ def exec_ctx(session):
 
 
 @given(parse('parameters: {parameters}'))
+@when(parse('parameters: {parameters}'))
 def preload_parameters(parameters):
     try:
         paramMap = json.loads(parameters)
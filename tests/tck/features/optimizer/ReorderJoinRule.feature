@@ -0,0 +1,46 @@
+# Copyright (c) 2022 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Reorder join rule
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: reorder the joins of pattern parts
+    When profiling query:
+      """
+      MATCH (a:player{name:"Tim Duncan"}), (b:player{name:"Tony Parker"}), (a)-[e:like]->(b)
+      RETURN a.player.name AS a, b.player.name AS b, e.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | a            | b             | likeness |
+      | "Tim Duncan" | "Tony Parker" | 95       |
+    # The edge part starts from the vertices of a, so it's joined with (a) before the cartesian
+    # product of (a) and (b)
+    And the execution plan should be:
+      | id | name           | dependencies | operator info |
+      | 16 | Project        | 20           |               |
+      | 20 | BiInnerJoin    | 19, 8        |               |
+      | 19 | BiInnerJoin    | 4, 14        |               |
+      | 4  | Project        | 3            |               |
+      | 3  | AppendVertices | 2            |               |
+      | 2  | IndexScan      | 1            |               |
+      | 1  | Start          |              |               |
+      | 14 | Project        | 13           |               |
+      | 13 | AppendVertices | 12           |               |
+      | 12 | Traverse       | 11           |               |
+      | 11 | Argument       |              |               |
+      | 10 | Start          |              |               |
+      | 8  | Project        | 7            |               |
+      | 7  | AppendVertices | 6            |               |
+      | 6  | IndexScan      | 5            |               |
+      | 5  | Start          |              |               |
+    When executing query:
+      """
+      MATCH (b:player), (c:team{name:"Spurs"}), (a:player{name:"Tim Duncan"})-[:like]->(b)-[:serve]->(c)
+      RETURN a.player.name AS a, b.player.name AS b, c.team.name AS c
+      """
+    Then the result should be, in any order:
+      | a            | b               | c       |
+      | "Tim Duncan" | "Tony Parker"   | "Spurs" |
+      | "Tim Duncan" | "Manu Ginobili" | "Spurs" |
@@ -0,0 +1,89 @@
+# Copyright (c) 2022 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Plan cache of parameterized statements
+
+  Scenario: reuse the plan with different parameters
+    Given a graph with space named "nba"
+    And parameters: {"plan_cache_age":40}
+    When executing query:
+      """
+      MATCH (v:player{name:"Tim Duncan"})-[:like]->(n) WHERE n.player.age > $plan_cache_age
+      RETURN n.player.name AS name
+      """
+    Then the result should be, in any order:
+      | name            |
+      | "Manu Ginobili" |
+    When parameters: {"plan_cache_age":30}
+    And executing query:
+      """
+      MATCH (v:player{name:"Tim Duncan"})-[:like]->(n) WHERE n.player.age > $plan_cache_age
+      RETURN n.player.name AS name
+      """
+    Then the result should be, in any order:
+      | name            |
+      | "Manu Ginobili" |
+      | "Tony Parker"   |
+    When parameters: {"plan_cache_age":50}
+    And executing query:
+      """
+      MATCH (v:player{name:"Tim Duncan"})-[:like]->(n) WHERE n.player.age > $plan_cache_age
+      RETURN n.player.name AS name
+      """
+    Then the result should be, in any order:
+      | name |
+
+  Scenario: recompile the plan once the schema changed
+    Given an empty graph
+    And create a space with following options:
+      | partition_num  | 1                |
+      | replica_factor | 1                |
+      | vid_type       | FIXED_STRING(20) |
+    And having executed:
+      """
+      CREATE TAG plan_cache_tag(name string)
+      """
+    And wait 3 seconds
+    When executing query:
+      """
+      INSERT VERTEX plan_cache_tag(name) VALUES "a":("a"), "b":("b")
+      """
+    Then the execution should be successful
+    When parameters: {"plan_cache_name":"a"}
+    And executing query:
+      """
+      FETCH PROP ON plan_cache_tag "a", "b" YIELD properties(vertex) AS props
+      | YIELD $-.props AS props WHERE $-.props.name == $plan_cache_name
+      """
+    Then the result should be, in any order:
+      | props      |
+      | {name:"a"} |
+    When parameters: {"plan_cache_name":"b"}
+    And executing query:
+      """
+      FETCH PROP ON plan_cache_tag "a", "b" YIELD properties(vertex) AS props
+      | YIELD $-.props AS props WHERE $-.props.name == $plan_cache_name
+      """
+    Then the result should be, in any order:
+      | props      |
+      | {name:"b"} |
+    When executing query:
+      """
+      ALTER TAG plan_cache_tag ADD (age int)
+      """
+    Then the execution should be successful
+    And wait 3 seconds
+    When executing query:
+      """
+      INSERT VERTEX plan_cache_tag(name, age) VALUES "b":("b", 10)
+      """
+    Then the execution should be successful
+    When executing query:
+      """
+      FETCH PROP ON plan_cache_tag "a", "b" YIELD properties(vertex) AS props
+      | YIELD $-.props AS props WHERE $-.props.name == $plan_cache_name
+      """
+    Then the result should be, in any order:
+      | props              |
+      | {age:10, name:"b"} |
+    Then drop the used space